@@ -0,0 +1,198 @@
+# Ahead-of-time kernel bundles of the reference CPU backend.
+#
+# The first launch of a kernel normally compiles it, then builds its launcher
+# with g++. A bundle packs a set of compiled kernels, their launchers and the
+# runtime they call into a single shared library, built once, e.g. when the
+# service is packaged:
+#
+#     from triton.backends.triton_shared import aot
+#     from triton.backends.triton_shared.compiler import compile_many
+#
+#     kernels = compile_many(srcs)  # or kernel.warmup(...) of a JITFunction
+#     aot.build_bundle(kernels, "kernels.so")
+#
+# and loaded at startup, before the first launch:
+#
+#     aot.load_bundle("kernels.so")
+#
+# Loading a bundle stores the compiled kernels in the Triton cache, so that
+# triton.compile and the JIT find them without running any compilation stage,
+# and registers the launchers with the driver, so that launching them does not
+# run g++. A bundle is only valid for the versions of Triton and of this
+# backend it was built with, on the same kind of CPU; kernels whose source or
+# options differ from the bundled ones are compiled as usual.
+
+import concurrent.futures
+import importlib.util
+import json
+import os
+import pickle
+import subprocess
+import tempfile
+from pathlib import Path
+
+from triton.runtime.cache import get_cache_manager
+from triton.backends.triton_shared import driver
+
+# Bumped when the layout of the manifest changes.
+_BUNDLE_VERSION = 1
+_MODULE_NAME = "__triton_shared_bundle"
+
+
+def _bundle_entry(kernel):
+    # The manifest entry of a CompiledKernel: the files of its Triton cache
+    # group, and the key of its launcher in driver._loaded_launchers.
+    obj = kernel.asm["cpuobj"]
+    name = kernel.src.name
+    launcher_src, _ = driver._launcher_source(kernel.src, kernel.metadata)
+    src = launcher_src.replace(driver._KERNEL_PLACEHOLDER_NAME, kernel.metadata.name)
+    files = {f"{name}.json": json.dumps(kernel.metadata._asdict(), default=vars).encode("utf-8")}
+    for ext, ir in kernel.asm.items():
+        files[f"{name}.{ext}"] = ir if isinstance(ir, bytes) else ir.encode("utf-8")
+    return {
+        "name": name,
+        "kernel_name": kernel.metadata.name,
+        "cache_key": kernel.hash,
+        "launcher_key": driver._launcher_key(src, obj),
+        "files": files,
+    }, launcher_src
+
+
+def _bundle_main(num_launchers, manifest_path):
+    # The module init function of the bundle. The manifest is embedded with
+    # .incbin rather than as a C array, which g++ is slow to compile.
+    decls = "\n".join(f"PyObject *triton_shared_bundle_launcher_{i}(void);" for i in range(num_launchers))
+    inits = ", ".join(f"triton_shared_bundle_launcher_{i}" for i in range(num_launchers))
+    return f"""
+#include <Python.h>
+
+extern "C" {{
+{decls}
+
+__attribute__((visibility("hidden"))) extern const char triton_shared_bundle_manifest[];
+__attribute__((visibility("hidden"))) extern const char triton_shared_bundle_manifest_end[];
+}}
+
+__asm__(".section .rodata\\n"
+        ".balign 16\\n"
+        ".globl triton_shared_bundle_manifest\\n"
+        ".hidden triton_shared_bundle_manifest\\n"
+        "triton_shared_bundle_manifest:\\n"
+        ".incbin \\"{manifest_path}\\"\\n"
+        ".globl triton_shared_bundle_manifest_end\\n"
+        ".hidden triton_shared_bundle_manifest_end\\n"
+        "triton_shared_bundle_manifest_end:\\n"
+        ".previous\\n");
+
+static PyObject *(*const launcherInits[])(void) = {{{inits}}};
+
+static struct PyModuleDef ModuleDef = {{
+  PyModuleDef_HEAD_INIT,
+  \"{_MODULE_NAME}\",
+  NULL, //documentation
+  -1, //size
+  NULL
+}};
+
+PyMODINIT_FUNC PyInit_{_MODULE_NAME}(void) {{
+  PyObject *m = PyModule_Create(&ModuleDef);
+  if (m == NULL) {{
+    return NULL;
+  }}
+  PyObject *launchers = PyList_New({num_launchers});
+  if (launchers == NULL || PyModule_AddObject(m, "launchers", launchers) < 0) {{
+    Py_XDECREF(launchers);
+    Py_DECREF(m);
+    return NULL;
+  }}
+  for (int i = 0; i < {num_launchers}; i++) {{
+    PyObject *launcher = launcherInits[i]();
+    if (launcher == NULL) {{
+      Py_DECREF(m);
+      return NULL;
+    }}
+    PyList_SET_ITEM(launchers, i, launcher);
+  }}
+  PyObject *manifest = PyBytes_FromStringAndSize(
+      triton_shared_bundle_manifest, triton_shared_bundle_manifest_end - triton_shared_bundle_manifest);
+  if (manifest == NULL || PyModule_AddObject(m, "manifest", manifest) < 0) {{
+    Py_XDECREF(manifest);
+    Py_DECREF(m);
+    return NULL;
+  }}
+  return m;
+}}
+"""
+
+
+def build_bundle(kernels, path, max_workers=None):
+    """Build the bundle of the CompiledKernel objects `kernels` into the shared
+    library `path`. The launchers are compiled in parallel on `max_workers`
+    threads."""
+    kernels = list(kernels)
+    assert kernels, "a bundle needs at least one kernel"
+    py_include_dir, include_dir, py_lib_dir, py_lib = driver._build_paths()
+    compile_args = ["g++", "-std=c++17", "-O3", "-fPIC", "-c", f"-I{py_include_dir}", f"-I{include_dir}"]
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        entries = []
+        commands = [compile_args + [driver._runtime_source(), "-o", os.path.join(tmpdir, "runtime.o")]]
+        objects = [os.path.join(tmpdir, "runtime.o")]
+        for i, kernel in enumerate(kernels):
+            entry, launcher_src = _bundle_entry(kernel)
+            entries.append(entry)
+            # Kernels of different specializations share a name: give each
+            # its own symbols, and keep its other symbols local.
+            name = entry["kernel_name"]
+            symbol = f"{name}_bundle{i}"
+            renames = [(name + suffix, symbol + suffix)
+                       for suffix in ("", "_noalias", "_unitstride", "_unitstride_noalias")]
+            kernel_path = os.path.join(tmpdir, f"kernel_{i}.o")
+            Path(kernel_path).write_bytes(kernel.asm["cpuobj"])
+            subprocess.check_call(["objcopy", *[f"--keep-global-symbol={old}" for old, _ in renames], kernel_path])
+            subprocess.check_call(["objcopy", *[f"--redefine-sym={old}={new}" for old, new in renames], kernel_path])
+            launcher_path = os.path.join(tmpdir, f"launcher_{i}.cxx")
+            Path(launcher_path).write_text(launcher_src.replace(driver._KERNEL_PLACEHOLDER_NAME, symbol))
+            commands.append(compile_args + [
+                f"-DTRITON_SHARED_LAUNCHER_INIT=triton_shared_bundle_launcher_{i}", launcher_path, "-o",
+                os.path.join(tmpdir, f"launcher_{i}.o")
+            ])
+            objects += [kernel_path, os.path.join(tmpdir, f"launcher_{i}.o")]
+
+        manifest_path = os.path.join(tmpdir, "manifest.pkl")
+        Path(manifest_path).write_bytes(pickle.dumps({"version": _BUNDLE_VERSION, "kernels": entries}))
+        main_path = os.path.join(tmpdir, "main.cxx")
+        Path(main_path).write_text(_bundle_main(len(kernels), manifest_path))
+        commands.append(compile_args + [main_path, "-o", os.path.join(tmpdir, "main.o")])
+        objects.append(os.path.join(tmpdir, "main.o"))
+
+        with concurrent.futures.ThreadPoolExecutor(max_workers=max_workers) as executor:
+            list(executor.map(subprocess.check_call, commands))
+        so_path = os.path.join(tmpdir, "bundle.so")
+        subprocess.check_call(["g++", "-shared", "-fPIC", *objects, f"-L{py_lib_dir}", f"-l{py_lib}", "-o", so_path])
+        # Replace `path` atomically, a process may be loading it.
+        tmp_path = f"{path}.tmp.{os.getpid()}"
+        Path(tmp_path).write_bytes(Path(so_path).read_bytes())
+        os.replace(tmp_path, path)
+
+
+def load_bundle(path):
+    """Make the kernels of the bundle `path` available without compilation.
+    Return the names of the kernels it contains."""
+    spec = importlib.util.spec_from_file_location(_MODULE_NAME, os.path.abspath(path))
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    manifest = pickle.loads(module.manifest)
+    assert manifest["version"] == _BUNDLE_VERSION, f"{path} was built by an incompatible version of the backend"
+
+    for entry, launcher in zip(manifest["kernels"], module.launchers):
+        cache = get_cache_manager(entry["cache_key"])
+        metadata_filename = f"{entry['name']}.json"
+        if cache.get_group(metadata_filename) is None:
+            group = {
+                filename: cache.put(data, filename, binary=True)
+                for filename, data in entry["files"].items()
+            }
+            cache.put_group(metadata_filename, group)
+        driver._loaded_launchers.setdefault(entry["launcher_key"], launcher)
+    return [entry["kernel_name"] for entry in manifest["kernels"]]
@@ -1,14 +1,18 @@
 from triton.backends.compiler import BaseBackend, GPUTarget
-from triton._C.libtriton import ir, passes
+from triton._C.libtriton import ir, passes, llvm, triton_shared
+from triton.backends.triton_shared import profiler
 from dataclasses import dataclass
 from typing import Any, Dict, Tuple
 from types import ModuleType
+import concurrent.futures
 import hashlib
 import tempfile
 import os
+import platform
 import re
 import subprocess
 import functools
+import time
 from pathlib import Path
 
 def _get_triton_shared_opt_path() -> str:
@@ -25,7 +29,253 @@ def _get_llvm_bin_path(bin_name: str) -> str:
     return os.path.join(path, bin_name)
 
 
-def _ttir_to_ttsharedir(mod):
+def _use_external_tools() -> bool:
+    # Compilation runs in-process by default. Setting
+    # TRITON_SHARED_USE_EXTERNAL_TOOLS=1 runs each step through triton-shared-opt,
+    # mlir-opt, mlir-translate and llc instead, which is handy to reproduce a
+    # failure outside of python.
+    return os.getenv("TRITON_SHARED_USE_EXTERNAL_TOOLS", "0") == "1"
+
+
+# Passes lowering TritonShared-MLIR to LLVM-MLIR, in textual pass pipeline
+# syntax so that they can be handed to both mlir-opt and the in-process pass
+# manager.
+def _ttsharedir_to_llvm_pipeline(options):
+    pipeline = []
+    if options.unit_stride:
+        # Clone the kernel for the innermost strides being 1 before any other
+        # pass, so that the variant goes through the same lowering.
+        pipeline += ["specialize-unit-strides"]
+    pipeline += [
+        # The launcher passes fp16 / bf16 scalars as C floats.
+        "promote-half-args",
+        # Hoist loop-invariant scalar loads, and merge the scalar loads and
+        # stores of neighbouring elements (e.g. the fields of a parameter
+        # struct read through ptr + 0, ptr + 1, ...) into vector accesses.
+        "batch-scalar-accesses",
+    ]
+    if options.grid_loop:
+        # Loop over a range of program instances inside the kernel so that the
+        # work that does not depend on the program id is done once per range.
+        pipeline += [
+            "emit-grid-loop",
+            "loop-invariant-code-motion",
+        ]
+    if _get_math_accuracy(options) != "libm":
+        # Expand transcendental math ops (the lowering of libdevice calls such
+        # as exp, tanh or erf) into polynomials that vectorize, instead of one
+        # scalar libm call per element.
+        pipeline += [
+            f"approximate-math{{accuracy={_get_math_accuracy(options)}}}",
+        ]
+    pipeline += [
+        # Reduce 1-d tensors into several independent vector accumulators
+        # instead of a single dependency chain.
+        f"split-reductions{{vector-bits={_get_vector_width(options)}}}",
+    ]
+    if options.num_stages > 1:
+        # Prefetch the tiles loaded by loops num_stages - 1 iterations ahead,
+        # the CPU counterpart of software pipelining the loads.
+        pipeline += [
+            f"prefetch-loop-loads{{distance={options.num_stages - 1}}}",
+        ]
+    pipeline += [
+        # Compute scans and the elementwise ops producing and consuming them
+        # one tile of rows at a time, so that each tile stays in cache.
+        "ttx-tile-and-fuse",
+        "convert-linalg-to-affine-loops",
+        # eliminate-empty-tensors needs a single func.return per function,
+        # merge those of early returns (see python/examples/test_early_return.py).
+        "unify-returns",
+        # Compute the tiles stored by tts.store (bufferization.materialize_in_destination)
+        # directly into the destination memref instead of into a new buffer
+        # copied to it.
+        "eliminate-empty-tensors",
+        "empty-tensor-to-alloc-tensor",
+        "one-shot-bufferize{allow-return-allocs-from-loops=true}",
+        # Fold the memref.copy of such tiles to themselves left by the stores.
+        "canonicalize",
+        # Scan long cumsum rows a vector of elements at a time.
+        "ttx-to-loops",
+    ]
+    if options.max_stack_alloc_size > 0:
+        # Move small, statically shaped temporaries from the heap to the
+        # stack frame of the kernel.
+        pipeline += [
+            f"promote-allocs-to-stack{{max-alloc-size-in-bytes={options.max_stack_alloc_size}}}",
+        ]
+    pipeline += [
+        # Hand f32 / f64 matmuls, and f16 / bf16 matmuls accumulating into
+        # f32, over to the packed, cache-blocked routines in
+        # backend/include/Runtime/Matmul.h instead of naive loop nests.
+        "linalg-to-cpu-runtime",
+    ]
+    if options.intra_program_parallelism:
+        # Split the large linalg ops of a program along their outermost
+        # parallel dimension, for the launcher to spread over its threads when
+        # the grid is too small to keep them busy.
+        pipeline += ["parallelize-linalg"]
+    if options.vectorize:
+        # Lower the bufferized linalg ops to affine loops and let the affine
+        # super-vectorizer turn their innermost dimension into vector ops of
+        # the target's register width. Reductions are vectorized as well, the
+        # resulting vector.reduction ops are lowered by convert-vector-to-llvm.
+        # The vectorizer takes a single vector size for the whole kernel, and
+        # the pipeline only depends on the options: use the number of f32
+        # lanes of a register. Vectors of wider elements span several
+        # registers and those of narrower elements part of one, which LLVM
+        # splits or widens when legalizing them.
+        f32_lanes = _get_vector_width(options) // 32
+        pipeline += [
+            "convert-linalg-to-affine-loops",
+            f"affine-super-vectorize{{virtual-vector-size={f32_lanes} vectorize-reductions=true}}",
+            "canonicalize",
+        ]
+    pipeline += [
+        "lower-affine",
+        "convert-linalg-to-loops",
+        "expand-strided-metadata",
+    ]
+    if options.vectorize:
+        # Lower the vector.transfer ops that cannot be mapped to a single LLVM
+        # masked load / store.
+        pipeline += ["convert-vector-to-scf"]
+    if options.nontemporal_stores:
+        # Write the outputs the kernel never reads with streaming stores, which
+        # bypass the cache instead of evicting the inputs from it.
+        pipeline += ["mark-nontemporal-stores"]
+    if options.intra_program_parallelism:
+        # Run the scf.forall ops of parallelize-linalg on the thread pool of
+        # the launcher, see backend/include/Runtime/ThreadPool.h.
+        pipeline += ["outline-parallel-loops"]
+    pipeline += ["convert-scf-to-cf"]
+    if not _has_native_bf16(options):
+        # Without AVX512-BF16 / ARMv8.6 BF16, LLVM truncates f32 to bf16 with
+        # one libcall per element. Expand bf16 conversions into integer
+        # operations instead, which vectorize like any other elementwise op.
+        # f16 conversions are left to LLVM, which uses F16C / NEON fcvt.
+        pipeline += ["arith-expand{include-bf16=true}"]
+    pipeline += [
+        "convert-arith-to-llvm",
+        "convert-math-to-llvm",
+        # Math ops without an LLVM intrinsic (tanh, erf, atan2, ...) become
+        # libm calls.
+        "convert-math-to-libm",
+        "convert-complex-to-llvm",
+        "convert-vector-to-llvm",
+        "convert-index-to-llvm",
+        "memref-expand",
+        # Route allocations through _mlir_memref_to_llvm_alloc / free so that
+        # the launcher can serve them from a per-program arena
+        # (backend/include/Runtime/Arena.h).
+        "finalize-memref-to-llvm{use-generic-functions=true}",
+        "convert-func-to-llvm",
+        "convert-cf-to-llvm",
+        # Lowering memrefs creates more affine.apply ops.
+        # Lowering these affine ops again creates further arith ops,
+        # so we have to run these two passes again here.
+        "lower-affine",
+        "convert-arith-to-llvm",
+        # Remove all unrealized casts created
+        "reconcile-unrealized-casts",
+    ]
+    return pipeline
+
+
+@functools.lru_cache()
+def _get_host_vector_width() -> int:
+    # Widest SIMD register width (in bits) available on the host.
+    machine = platform.machine().lower()
+    if machine in ("x86_64", "amd64", "i386", "i686"):
+        try:
+            flags = Path("/proc/cpuinfo").read_text().split()
+        except OSError:
+            flags = []
+        if "avx512f" in flags:
+            return 512
+        if "avx2" in flags or "avx" in flags:
+            return 256
+        return 128
+    # NEON on aarch64, and a conservative default everywhere else.
+    return 128
+
+
+def _get_vector_width(options) -> int:
+    return options.vector_width if options.vector_width > 0 else _get_host_vector_width()
+
+
+@functools.lru_cache()
+def _get_host_has_bf16() -> bool:
+    # Whether the host converts between f32 and bf16 in hardware.
+    machine = platform.machine().lower()
+    try:
+        flags = Path("/proc/cpuinfo").read_text().split()
+    except OSError:
+        flags = []
+    if machine in ("x86_64", "amd64"):
+        return "avx512_bf16" in flags
+    if machine in ("aarch64", "arm64"):
+        return "bf16" in flags
+    return False
+
+
+def _has_native_bf16(options) -> bool:
+    features = options.target_features.split(",")
+    if "+avx512bf16" in features or "+bf16" in features:
+        return True
+    return _get_target_cpu(options) == triton_shared.get_host_cpu_name() and _get_host_has_bf16()
+
+
+def _get_math_accuracy(options) -> str:
+    # Vectorized code approximates the math functions that have accurate
+    # polynomial approximations by default, scalar code keeps calling libm.
+    if options.math_accuracy:
+        return options.math_accuracy
+    return "high" if options.vectorize else "libm"
+
+
+def _get_target_cpu(options) -> str:
+    # Without vectorization we target the generic cpu of the host triple, like
+    # llc without -mcpu. Vectorized code needs the host's cpu so that the
+    # backend is allowed to select AVX2 / AVX-512 / NEON instructions.
+    if options.target_cpu == "native" or (options.target_cpu == "" and options.vectorize):
+        return triton_shared.get_host_cpu_name()
+    return options.target_cpu
+
+
+def _get_external_target_args(options):
+    # Target flags understood by both opt and llc.
+    args = []
+    if options.target_cpu == "native" or (options.target_cpu == "" and options.vectorize):
+        args.append("-mcpu=native")
+    elif options.target_cpu:
+        args.append(f"-mcpu={options.target_cpu}")
+    if options.target_features:
+        args.append(f"-mattr={options.target_features}")
+    return args
+
+
+def _ttir_to_ttsharedir(mod, options):
+    if _use_external_tools():
+        return _ttir_to_ttsharedir_external(mod, options)
+
+    pm = ir.pass_manager(mod.context)
+    pm.enable_debug()
+    triton_shared.passes.add_triton_to_linalg_experimental(pm, options.elementwise_fusion)
+    _run_pass_manager("ttsharedir", pm, mod)
+    return mod
+
+
+def _run_pass_manager(stage, pm, mod):
+    # Record the passes in the compile profile of the kernel when compile
+    # profiling is enabled, see backend/profiler.py.
+    pass_profile = triton_shared.enable_pass_profiling(pm) if profiler.is_compile_profiling_enabled() else None
+    triton_shared.run_pass_manager(pm, mod)
+    if pass_profile is not None:
+        profiler._record_passes(stage, pass_profile.records())
+
+
+def _ttir_to_ttsharedir_external(mod, options):
     # Get Triton-MLIR as string
     ttir_code = str(mod)
     with tempfile.TemporaryDirectory() as tmpdir:
@@ -33,55 +283,121 @@ def _ttir_to_ttsharedir(mod):
         dst_path = os.path.join(tmpdir, "ttshared.mlir")
         Path(src_path).write_text(ttir_code)
         triton_shared_opt_path = _get_triton_shared_opt_path()
-        subprocess.check_call([triton_shared_opt_path, src_path, "--triton-to-linalg-experimental", "-o", dst_path])
+        pass_arg = "--triton-to-linalg-experimental"
+        if options.elementwise_fusion:
+            pass_arg += "=enable-elementwise-fusion=true"
+        subprocess.check_call([triton_shared_opt_path, src_path, pass_arg, "-o", dst_path])
         return Path(dst_path).read_text()
 
 
-def _optimize_ttsharedir(ttsharedir: str):
+def _parse_module(src: str):
+    # The context has to outlive the module, so both are returned.
+    context = ir.context()
+    ir.load_dialects(context)
+    triton_shared.load_dialects(context)
+    with tempfile.TemporaryDirectory() as tmpdir:
+        path = os.path.join(tmpdir, "ttshared.mlir")
+        Path(path).write_text(src)
+        return context, ir.parse_mlir_module(path, context)
+
+
+def _use_stage_cache() -> bool:
+    # The ttsharedir and llir stages are cached on disk by default, see
+    # _cached_stage below. Set TRITON_SHARED_STAGE_CACHE=0 to always recompile.
+    return os.getenv("TRITON_SHARED_STAGE_CACHE", "1") == "1"
+
+
+def _cached_stage(stage: str, src, config: str, compile_fn):
+    # Content-addressed cache of intermediate artifacts. The key only covers
+    # the input of the stage and the options the stage depends on (`config`),
+    # so that changing the options of a later stage reuses the results of the
+    # earlier ones; triton's own cache is keyed by the full CPUOptions.hash().
+    if not _use_stage_cache():
+        return compile_fn()
+
+    from triton.compiler.compiler import triton_key
+    from triton.runtime.cache import get_cache_manager
+
+    key = hashlib.sha256(f"{triton_key()}-{stage}-{config}-{src}".encode("utf-8")).hexdigest()
+    cache_manager = get_cache_manager(key)
+    filename = f"{stage}.mlir" if stage == "ttsharedir" else f"{stage}.ll"
+    path = cache_manager.get_file(filename)
+    if path is not None:
+        profiler._note_cached_stage(stage)
+        return Path(path).read_text()
+
+    result = compile_fn()
+    cache_manager.put(str(result), filename, binary=False)
+    return result
+
+
+def _optimize_ttsharedir(ttsharedir):
     # We don't apply any optimizations now, but we can add passes if needed.
     return ttsharedir
 
 
-def _ttsharedir_to_llir(ttsharedir: str):
+def _ttsharedir_to_llir(ttsharedir, options):
+    pipeline = _ttsharedir_to_llvm_pipeline(options)
+    if _use_external_tools():
+        return _ttsharedir_to_llir_external(str(ttsharedir), pipeline)
+
+    if isinstance(ttsharedir, str):
+        # The ttsharedir stage was served from the stage cache.
+        mlir_context, ttsharedir = _parse_module(ttsharedir)
+
+    # TritonShared-MLIR to LLVM-MLIR
+    pm = ir.pass_manager(ttsharedir.context)
+    pm.enable_debug()
+    triton_shared.passes.add_pipeline(pm, ",".join(pipeline))
+    _run_pass_manager("llir", pm, ttsharedir)
+
+    # LLVM-MLIR to LLVM-IR
+    context = llvm.context()
+    llvm_mod = llvm.to_module(ttsharedir, context)
+    if llvm_mod is None:
+        raise RuntimeError("Failed to translate TritonShared-MLIR to LLVM IR")
+    return str(llvm_mod)
+
+
+# Passes of the pipeline above that are provided by triton-shared rather than
+# upstream mlir, and therefore need to run through triton-shared-opt.
+_TRITON_SHARED_PASSES = {
+    "approximate-math", "batch-scalar-accesses", "emit-grid-loop", "linalg-to-cpu-runtime", "mark-nontemporal-stores",
+    "outline-parallel-loops", "parallelize-linalg", "prefetch-loop-loads", "promote-allocs-to-stack",
+    "promote-half-args", "specialize-unit-strides", "split-reductions", "ttx-tile-and-fuse", "ttx-to-loops",
+    "unify-returns"
+}
+
+
+def _ttsharedir_to_llir_external(ttsharedir: str, pipeline):
     with tempfile.TemporaryDirectory() as tmpdir:
         ttshared_path = os.path.join(tmpdir, "ttshared.mlir")
         llmlir_path = os.path.join(tmpdir, "ll.mlir")
         llir_path = os.path.join(tmpdir, "ll.ir")
         Path(ttshared_path).write_text(ttsharedir)
         mlir_opt_path = _get_llvm_bin_path("mlir-opt")
-        # TritonShared-MLIR to LLVM-MLIR
-        subprocess.check_call([mlir_opt_path, ttshared_path,
-            "--convert-linalg-to-affine-loops",
-            # Note: eliminate-empty-tensors fails when there are multiple func.return ops
-            # in a single kernel which are the results of early returns.
-            # See python/examples/test_early_return.py for examples.
-            # We disable this pass for now since performance on CPU isn't the main
-            # focus at the moment.
-            # "--eliminate-empty-tensors",
-            "--empty-tensor-to-alloc-tensor",
-            "--one-shot-bufferize=allow-return-allocs-from-loops=true",
-            "--lower-affine",
-            "--convert-linalg-to-loops",
-            "--expand-strided-metadata",
-            "--convert-scf-to-cf",
-            "--convert-arith-to-llvm",
-            "--convert-math-to-llvm",
-            "--convert-complex-to-llvm",
-            "--convert-vector-to-llvm",
-            "--convert-index-to-llvm",
-            "--memref-expand",
-            "--finalize-memref-to-llvm",
-            "--convert-func-to-llvm",
-            "--convert-cf-to-llvm",
-            # Lowering memrefs creates more affine.apply ops.
-            # Lowering these affine ops again creates further arith ops,
-            # so we have to run these two passes again here.
-            "--lower-affine",
-            "--convert-arith-to-llvm",
-            # Remove all unrealized casts created
-            "--reconcile-unrealized-casts",
-            "-o",
-            llmlir_path])
+        triton_shared_opt_path = _get_triton_shared_opt_path()
+        # TritonShared-MLIR to LLVM-MLIR, running each consecutive group of
+        # passes with the tool that provides them.
+        groups = []
+        for p in pipeline:
+            tool = triton_shared_opt_path if p.split("{")[0] in _TRITON_SHARED_PASSES else mlir_opt_path
+            if groups and groups[-1][0] == tool:
+                groups[-1][1].append(p)
+            else:
+                groups.append((tool, [p]))
+        src_path = ttshared_path
+        for i, (tool, group) in enumerate(groups):
+            dst_path = llmlir_path if i == len(groups) - 1 else os.path.join(tmpdir, f"ll.{i}.mlir")
+            start = time.perf_counter()
+            subprocess.check_call([tool, src_path,
+                "--pass-pipeline=builtin.module(" + ",".join(group) + ")",
+                "-o",
+                dst_path])
+            # Each subprocess is recorded as one pass of the compile profile.
+            profiler._record_passes("llir", [(f"{os.path.basename(tool)}: {','.join(group)}", 0,
+                                             time.perf_counter() - start)])
+            src_path = dst_path
 
         # LLVM-MLIR to LLVM-IR
         mlir_translate_path = _get_llvm_bin_path("mlir-translate")
@@ -92,25 +408,143 @@ def _ttsharedir_to_llir(ttsharedir: str):
         return Path(llir_path).read_text()
 
 
-def _optimize_llir(llir: str):
-    # We don't apply any optimizations now, but we can add passes if needed.
+def _optimize_llir(llir: str, options):
+    # Run the standard LLVM middle-end pipeline for the requested optimization
+    # level, tuned for the cpu that _llir_to_bin generates code for.
+    if options.opt_level == 0:
+        return llir
+    if _use_external_tools():
+        return _optimize_llir_external(llir, options)
+
+    llvm.init_targets()
+    triple = triton_shared.get_host_target_triple()
+    if not profiler.is_compile_profiling_enabled():
+        return triton_shared.optimize_llir(llir, options.opt_level, triple, _get_target_cpu(options),
+                                           options.target_features, options.noalias)
+    llir, pass_times = triton_shared.optimize_llir(llir, options.opt_level, triple, _get_target_cpu(options),
+                                                   options.target_features, options.noalias,
+                                                   collect_pass_times=True)
+    profiler._record_passes("llir-opt", [(name, 0, seconds, -1, -1, runs) for name, seconds, runs in pass_times])
     return llir
 
 
-def _llir_to_bin(llir: str, metadata):
+def _optimize_llir_external(llir: str, options):
+    with tempfile.TemporaryDirectory() as tmpdir:
+        src_path = os.path.join(tmpdir, "kernel.ll")
+        dst_path = os.path.join(tmpdir, "kernel.opt.ll")
+        Path(src_path).write_text(llir)
+        opt_path = _get_llvm_bin_path("opt")
+        subprocess.check_call([opt_path, src_path, f"-passes=default<O{options.opt_level}>",
+            *_get_external_target_args(options), "-S", "-o", dst_path])
+        return Path(dst_path).read_text()
+
+
+def _llir_config(options) -> str:
+    # Everything the llir stage depends on, used as its stage cache key.
+    return "-".join([
+        ",".join(_ttsharedir_to_llvm_pipeline(options)),
+        f"O{options.opt_level}",
+        _get_target_cpu(options),
+        options.target_features,
+        f"noalias-{options.noalias}",
+    ])
+
+
+# Name suffix of the variant of a kernel that assumes its pointer arguments do
+# not alias, see CPUOptions.noalias and `triton_shared.cc`.
+_NOALIAS_SUFFIX = "_noalias"
+
+# Name suffix of the variant of a kernel that assumes the innermost strides
+# listed in its "triton-shared-unit-stride-args" attribute are 1, see
+# CPUOptions.unit_stride and the specialize-unit-strides pass.
+_UNIT_STRIDE_SUFFIX = "_unitstride"
+
+
+def _llir_to_bin(llir: str, metadata, options):
     pattern = r"define void @(\w+)\(.+"
     matches = re.findall(pattern, llir)
-    assert len(matches) == 1
-    metadata["name"] = matches[0]
+    kernels = [
+        name for name in matches
+        if not name.endswith(_NOALIAS_SUFFIX) and not name.endswith(_UNIT_STRIDE_SUFFIX)
+    ]
+    assert len(kernels) == 1
+    metadata["name"] = kernels[0]
+    metadata["noalias_variant"] = kernels[0] + _NOALIAS_SUFFIX in matches
+    # Positions, among the non-constexpr arguments, of the strides that the
+    # launcher checks before running the unit-stride variant.
+    metadata["unit_stride_args"] = []
+    if kernels[0] + _UNIT_STRIDE_SUFFIX in matches:
+        stride_args = re.search(r'"triton-shared-unit-stride-args"="([0-9,]*)"', llir)
+        assert stride_args is not None
+        metadata["unit_stride_args"] = [int(i) for i in stride_args.group(1).split(",")]
+
+    if _use_external_tools():
+        return _llir_to_bin_external(llir, options)
+
+    # An object file, which the launcher links without running the assembler.
+    llvm.init_targets()
+    triple = triton_shared.get_host_target_triple()
+    return llvm.translate_to_asm(llir, triple, _get_target_cpu(options), options.target_features, [],
+                                 options.enable_fp_fusion, True)
+
+
+def _llir_to_bin_external(llir: str, options):
     with tempfile.TemporaryDirectory() as tmpdir:
         src_path = os.path.join(tmpdir, "kernel.ll")
         dst_path = os.path.join(tmpdir, "kernel.o")
         Path(src_path).write_text(llir)
         llc_path = _get_llvm_bin_path("llc")
-        subprocess.check_call([llc_path, src_path, "-o", dst_path])
-        # Actually it's text-format assembly.  Use read_text().
-        return Path(dst_path).read_text()
-
+        subprocess.check_call([llc_path, src_path, f"-O{options.opt_level}", *_get_external_target_args(options),
+            "-filetype=obj", "-relocation-model=pic", "-o", dst_path])
+        return Path(dst_path).read_bytes()
+
+
+def _profiled_stage(stage, fn):
+    # Time `fn`, one of the stages of CPUBackend.add_stages, into the compile
+    # profile of the kernel when compile profiling is enabled. ttir is the
+    # first stage and cpuobj, which names the kernel, the last one.
+    def run(src, metadata):
+        if not profiler.is_compile_profiling_enabled():
+            return fn(src, metadata)
+        if stage == "ttir":
+            profiler._begin_compile()
+        start = time.perf_counter()
+        result = fn(src, metadata)
+        lines = 0 if isinstance(result, bytes) else str(result).count("\n")
+        profiler._record_stage(stage, time.perf_counter() - start, lines)
+        if stage == "cpuobj":
+            profiler._end_compile(metadata["name"])
+        return result
+
+    return run
+
+
+# Scheduling policies understood by the generated launcher. The values must be
+# kept in sync with triton_shared::LaunchSchedule in
+# backend/include/Runtime/ThreadPool.h.
+_LAUNCH_SCHEDULES = {
+    "static": 0,
+    "chunked": 1,
+    "work_stealing": 2,
+}
+
+# Placements of the threads running a grid. The values must be kept in sync
+# with triton_shared::ThreadAffinity in backend/include/Runtime/Topology.h.
+_THREAD_AFFINITIES = {
+    "": 0,
+    "numa": 1,
+    "cores": 2,
+}
+
+# Orders in which the launcher visits the programs of a grid. The values must be
+# kept in sync with triton_shared::GridOrder in
+# backend/include/Runtime/GridOrder.h.
+_GRID_ORDERS = {
+    "row_major": 0,
+    "grouped": 1,
+    "morton": 2,
+    "hilbert": 3,
+}
 
 
 @dataclass(frozen=True)
@@ -119,6 +553,8 @@ class CPUOptions:
     arch: str = None
     num_warps: int = 0
     num_ctas: int = 0
+    # Loads of loops are prefetched num_stages - 1 iterations before they are
+    # needed. 1 disables prefetching.
     num_stages: int = 1
     enable_warp_specialization: bool = False
     enable_fp_fusion: bool = False
@@ -127,17 +563,129 @@ class CPUOptions:
     shared: bool = False
     allow_fp8e4nv: bool = False
     allowed_dot_input_precisions: Tuple[str] = ("ieee", )
+    # Number of threads used to run the program instances of a grid. 1 runs
+    # all programs serially on the calling thread; 0 uses one thread per
+    # hardware thread.
+    num_threads: int = 1
+    # How program ids are distributed across threads when num_threads != 1:
+    # "static", "chunked" or "work_stealing".
+    launch_schedule: str = "static"
+    # Where the threads of a grid run when num_threads != 1: "" leaves them
+    # to the operating system, "numa" pins each of them to the cpus of a NUMA
+    # node and "cores" to a single cpu. Threads are spread over the nodes so
+    # that each node runs a contiguous range of program ids, see
+    # backend/include/Runtime/Topology.h and numa.py.
+    thread_affinity: str = ""
+    # Order in which the programs of a 2-d or 3-d grid are visited, and so
+    # handed out to the threads by launch_schedule: "row_major" (x slowest, z
+    # fastest), "grouped" (bands of grid_group_size consecutive program ids
+    # along x, x varying fastest within a band), "morton" or "hilbert" (along a
+    # space-filling curve over x and y). The orders other than "row_major"
+    # keep the tiles run one after another by a thread close to each other, so
+    # that those of a 2-d tiled matmul or attention kernel reuse the rows and
+    # columns they load from the cache. grid_loop kernels decode the program
+    # ids themselves and require "row_major".
+    grid_order: str = "row_major"
+    grid_group_size: int = 8
+    # Vectorize the loops produced from linalg ops to the vector dialect before
+    # lowering to LLVM, and compile for the host cpu.
+    vectorize: bool = False
+    # SIMD register width in bits targeted when vectorize is set. 0 uses the
+    # widest width supported by the host (e.g. 256 for AVX2, 512 for AVX-512,
+    # 128 for NEON). Loops are vectorized by vector_width / 32 elements,
+    # whatever their element type.
+    vector_width: int = 0
+    # Accuracy of the math functions called by the kernel (tl.math and
+    # libdevice calls): "libm" calls the scalar libm function of every
+    # element, "high" replaces exp, expm1, log, log2, log1p and tanh by
+    # vectorizable polynomial approximations accurate to a few ulp, "low"
+    # also approximates erf, sin, cos, asin, acos, atan, atan2 and cbrt. An
+    # empty string selects "high" when vectorize is set and "libm" otherwise.
+    math_accuracy: str = ""
+    # Statically shaped buffers of at most this many bytes that do not outlive
+    # the kernel are allocated on the stack instead of the heap. 0 disables
+    # the promotion.
+    max_stack_alloc_size: int = 65536
+    # LLVM optimization level (0 to 3) of the middle-end pipeline run on the
+    # kernel and of the code generator.
+    opt_level: int = 3
+    # CPU and features (e.g. "+avx2,+fma") to generate code for. An empty
+    # target_cpu selects the generic cpu of the host triple, or the host cpu
+    # when vectorize is set; "native" always selects the host cpu.
+    target_cpu: str = ""
+    target_features: str = ""
+    # Also compile a variant of the kernel that assumes the buffers of distinct
+    # pointer arguments do not overlap, which lets LLVM vectorize loops that
+    # load from one argument and store to another. The launcher checks that
+    # the tensors passed in use disjoint storage and runs the conservative
+    # kernel otherwise. Requires opt_level > 0 and in-process compilation.
+    noalias: bool = False
+    # Also compile a variant of the kernel in which the strides it receives as
+    # arguments and uses as the innermost stride of a buffer are 1, so that
+    # the accesses along that dimension are contiguous and vectorize. The
+    # launcher runs it when all of these arguments are 1 at run time, and the
+    # generic kernel otherwise. Strides that triton already specializes on
+    # (integer arguments equal to 1 not listed in do_not_specialize) are
+    # constants of every kernel and need no variant.
+    unit_stride: bool = False
+    # Fuse chains of elementwise ops (and the broadcasts feeding them) into a
+    # single loop nest with one output buffer when lowering to linalg.
+    elementwise_fusion: bool = True
+    # Emit the loop over the program instances of a grid inside the kernel.
+    # The launcher then calls the kernel once per range of programs handed to
+    # a thread instead of once per program, and the computations that do not
+    # depend on the program id are hoisted out of that loop.
+    grid_loop: bool = False
+    # Also split the large linalg ops inside a program (at least 65536
+    # iterations) along their outermost parallel dimension so that they, and
+    # the runtime matmuls of linalg-to-cpu-runtime, can run on several
+    # threads. When a launch has at most half as many programs as threads (see
+    # num_threads), the launcher then runs the programs one after another,
+    # each of them on all the threads, instead of one program per thread.
+    # Larger grids run as usual, with the split ops running on the thread of
+    # their program.
+    intra_program_parallelism: bool = False
+    # Store to the pointer arguments the kernel only writes to with streaming
+    # (nontemporal) stores, which write the lines of the output to memory
+    # without reading them into the cache first and evicting the inputs. This
+    # pays off for kernels writing outputs larger than the last level cache
+    # that nothing reads soon after, and slows down those whose output is read
+    # right away by the next kernel. Only the vector stores of vectorize are
+    # streamed, the option has no effect without it. Streaming stores are
+    # weakly ordered; the kernel fences them (mfence on x86, dmb on AArch64)
+    # before returning, so its output is visible to the launcher and to the
+    # next kernel as with ordinary stores. Within the kernel, they are not
+    # ordered with the atomics to other addresses.
+    nontemporal_stores: bool = False
 
     def __post_init__(self):
-        pass
+        assert self.num_threads >= 0, "num_threads must be non-negative"
+        assert self.launch_schedule in _LAUNCH_SCHEDULES, \
+            f"launch_schedule must be one of {list(_LAUNCH_SCHEDULES.keys())}"
+        assert self.thread_affinity in _THREAD_AFFINITIES, \
+            f"thread_affinity must be one of {list(_THREAD_AFFINITIES.keys())}"
+        assert self.grid_order in _GRID_ORDERS, f"grid_order must be one of {list(_GRID_ORDERS.keys())}"
+        assert self.grid_group_size >= 1, "grid_group_size must be positive"
+        assert self.grid_order == "row_major" or not self.grid_loop, "grid_loop requires the row_major grid_order"
+        assert self.vector_width >= 0 and self.vector_width % 32 == 0, \
+            "vector_width must be a non-negative multiple of 32"
+        assert self.math_accuracy in ("", "high", "low", "libm"), \
+            "math_accuracy must be one of '', 'high', 'low' or 'libm'"
+        assert self.max_stack_alloc_size >= 0, "max_stack_alloc_size must be non-negative"
+        assert 0 <= self.opt_level <= 3, "opt_level must be between 0 and 3"
+        assert self.num_stages >= 1, "num_stages must be positive"
 
     def hash(self):
         key = '_'.join([f'{name}-{val}' for name, val in self.__dict__.items()])
+        # The defaults resolved on the host change the code generated for the
+        # same options, e.g. when the cache directory is shared by machines
+        # with different vector units.
+        key += f"_host-{_get_vector_width(self)}-{_get_target_cpu(self)}-{_has_native_bf16(self)}"
         return hashlib.md5(key.encode("utf-8")).hexdigest()
 
 
 class CPUBackend(BaseBackend):
-    binary_ext = 'cpuasm'
+    binary_ext = 'cpuobj'
 
     @staticmethod
     def supports_target(target: GPUTarget):
@@ -156,9 +704,9 @@ class CPUBackend(BaseBackend):
         return codegen_fns
 
     def pack_metadata(self, metadata):
-        # Note: We actually don't need any of these except for the name which is
-        # used in the launch function in driver.py. Putting these in so we're
-        # consistent with other backends
+        # Note: We actually don't need the first six fields, they are only here
+        # so we're consistent with other backends. The name and the launch
+        # configuration that follows it are used by the launcher in driver.py.
         return (
             metadata.num_warps,
             metadata.num_ctas,
@@ -166,13 +714,18 @@ class CPUBackend(BaseBackend):
             metadata.cluster_dims[0],
             metadata.cluster_dims[1],
             metadata.cluster_dims[2],
-            metadata.name
+            metadata.name,
+            metadata.num_threads,
+            _LAUNCH_SCHEDULES[metadata.launch_schedule],
+            _THREAD_AFFINITIES[metadata.thread_affinity],
+            _GRID_ORDERS[metadata.grid_order],
+            metadata.grid_group_size,
         )
 
-    # Our compilation pipeline isn't in python like nvidia or amd, no need to load
-    # dialects. See `triton_shared.cc`
+    # The dialects and external models used by our pipeline are registered by
+    # the plugin. See `triton_shared.cc`
     def load_dialects(self, ctx):
-        return
+        triton_shared.load_dialects(ctx)
 
     @staticmethod
     def make_ttir(mod, metadata, opt):
@@ -189,10 +742,14 @@ class CPUBackend(BaseBackend):
         return mod
 
     def add_stages(self, stages, options):
-        stages["ttir"] = lambda src, metadata: self.make_ttir(src, metadata, options)
-        stages["ttsharedir"] = lambda src, metadata: _optimize_ttsharedir(_ttir_to_ttsharedir(src))
-        stages["llir"] = lambda src, metadata: _optimize_llir(_ttsharedir_to_llir(src))
-        stages["cpuasm"] = lambda src, metadata: _llir_to_bin(src, metadata)
+        stages["ttir"] = _profiled_stage("ttir", lambda src, metadata: self.make_ttir(src, metadata, options))
+        stages["ttsharedir"] = _profiled_stage("ttsharedir", lambda src, metadata: _cached_stage(
+            "ttsharedir", src, f"elementwise-fusion-{options.elementwise_fusion}",
+            lambda: _optimize_ttsharedir(_ttir_to_ttsharedir(src, options))))
+        stages["llir"] = _profiled_stage("llir", lambda src, metadata: _cached_stage(
+            "llir", src, _llir_config(options),
+            lambda: _optimize_llir(_ttsharedir_to_llir(src, options), options)))
+        stages["cpuobj"] = _profiled_stage("cpuobj", lambda src, metadata: _llir_to_bin(src, metadata, options))
 
 
     @functools.lru_cache()
@@ -202,3 +759,29 @@ class CPUBackend(BaseBackend):
     # The CPU backend does not use any extra python modules, return an empty dictionary
     def get_module_map(self) -> Dict[str, ModuleType]:
         return {}
+
+
+def compile_many(srcs, target=None, options=None, max_workers=None):
+    """Compile several kernels concurrently.
+
+    `srcs` are the sources accepted by `triton.compile` (e.g. ASTSource
+    objects of the configs an autotuner is about to try) and `options` is
+    either one dict of compile options shared by all kernels or a list with one
+    dict per kernel. The pass pipelines and LLVM code generation run without
+    the GIL, so the kernels are lowered in parallel on `max_workers` threads.
+    Launchers are built eagerly as well. Returns the compiled kernels in the
+    order of `srcs`.
+    """
+    import triton
+
+    if options is None or isinstance(options, dict):
+        options = [options] * len(srcs)
+    assert len(options) == len(srcs), "expected one options dict per kernel"
+
+    def compile_one(src, opts):
+        kernel = triton.compile(src, target=target, options=opts)
+        kernel._init_handles()
+        return kernel
+
+    with concurrent.futures.ThreadPoolExecutor(max_workers=max_workers) as executor:
+        return list(executor.map(compile_one, srcs, options))
@@ -2,7 +2,7 @@ import hashlib
 import tempfile
 import sysconfig
 
-import os, subprocess, tempfile
+import os, subprocess, tempfile, threading, time
 import importlib.util
 import sysconfig
 
@@ -11,6 +11,8 @@ from pathlib import Path
 from triton.runtime.cache import get_cache_manager
 from triton.backends.driver import DriverBase
 from triton.backends.compiler import GPUTarget
+from triton.backends.triton_shared import profiler
+from triton.backends.triton_shared import stream as cpu_stream
 
 # -------------------- Launcher ----------------------------
 def _ty_to_cpp(ty):
@@ -27,6 +29,8 @@ def _ty_to_cpp(ty):
         "u16": "uint16_t",
         "u32": "uint32_t",
         "u64": "uint64_t",
+        # The promote-half-args pass makes kernels take 16-bit float scalars
+        # as f32.
         "fp16": "float",
         "bf16": "float",
         "fp32": "float",
@@ -39,27 +43,36 @@ def _extracted_type(ty):
         return "PyObject*"
     return _ty_to_cpp(ty)
 
-def _format_of(ty):
+def _parser_of(ty):
+    # Converter of the generated launcher for a scalar argument of C type `ty`.
     return {
-      "PyObject*": "O",
-      "float": "f",
-      "double": "d",
-      "long": "l",
-      "int8_t": "b",
-      "int16_t": "h",
-      "int32_t": "i",
-      "int64_t": "l",
-      "uint8_t": "B",
-      "uint16_t": "H",
-      "uint32_t": "I",
-      "uint64_t": "K",
+      "float": "parseFloat",
+      "double": "parseFloat",
+      "int8_t": "parseSigned",
+      "int16_t": "parseSigned",
+      "int32_t": "parseSigned",
+      "int64_t": "parseSigned",
+      "uint8_t": "parseUnsigned",
+      "uint16_t": "parseUnsigned",
+      "uint32_t": "parseUnsigned",
+      "uint64_t": "parseUnsigned",
     }[ty]
 
-def _generate_launcher(constants, signature, kernel_name):
+def _generate_launcher(constants, signature, kernel_name, noalias_variant=False, grid_loop=False, unit_stride_args=(),
+                       intra_program=False):
     arg_decls = ', '.join(f"{_ty_to_cpp(ty)} arg{i}" for i, ty in signature.items())
-    args_format = ''.join([_format_of(_extracted_type(ty)) for ty in signature.values()])
-    format = "iiiOOOO" + args_format
-    args_list = ', ' + ', '.join(f"&_arg{i}" for i, ty in signature.items()) if len(signature) > 0 else ''
+    # The launch function takes the grid, the noalias and profile_mode flags,
+    # the kernel and launch metadata, the launch hooks, then the kernel
+    # arguments, see compile_module.
+    num_launch_params = 9
+    num_args = num_launch_params + len(signature)
+    args_parse = ' '.join(
+        f"DevicePtrInfo ptr_info{i} = getPointer(args[{num_launch_params + pos}], {i}); if (!ptr_info{i}.valid) return false; launch->arg{i} = ptr_info{i}.dev_ptr;"
+        if ty[0] == "*" else
+        f"if (!{_parser_of(_extracted_type(ty))}(args[{num_launch_params + pos}], &launch->arg{i})) return false;"
+        for pos, (i, ty) in enumerate(signature.items()))
+    arg_members = ' '.join(f"{_ty_to_cpp(ty)} arg{i};" for i, ty in signature.items())
+    arg_values = ', '.join(f"arg{i}" for i in signature.keys())
 
     kernel_arg_decls = ', '.join(_ty_to_cpp(ty) if ty[0] != "*" else f"int64_t, void*" for i, ty in signature.items() if i not in constants)
     kernel_arg_decls += ', ' if kernel_arg_decls else ''
@@ -67,34 +80,183 @@ def _generate_launcher(constants, signature, kernel_name):
     kernel_parameters = ', '.join(f"static_cast<{_ty_to_cpp(ty)}>(arg{i})" if ty[0] != "*" else f"0, &ptr_arg{i}" for i, ty in signature.items() if i not in constants)
     kernel_parameters += ', ' if kernel_parameters else ''
 
+    # Kernels compiled with CPUOptions.grid_loop take a range of linearized
+    # program ids instead of the ids of a single program, see the
+    # emit-grid-loop pass.
+    program_decls = "int64_t, int64_t" if grid_loop else "int, int, int"
+    program_args = "begin, end" if grid_loop else "x, y, z"
+
+    # The variant that assumes its pointer arguments do not alias, see
+    # CPUOptions.noalias, is only called if they were checked to be disjoint.
+    def declare_kernel(name):
+        decls = [f"void {name}({kernel_arg_decls} int, int, int, {program_decls});"]
+        if noalias_variant:
+            decls.append(f"void {name}_noalias({kernel_arg_decls} int, int, int, {program_decls});")
+        return decls
+
+    def call_kernel(name):
+        call = f"{name}({kernel_parameters} gridX, gridY, gridZ, {program_args});"
+        if not noalias_variant:
+            return call
+        return f"""if (noalias) {{
+        {name}_noalias({kernel_parameters} gridX, gridY, gridZ, {program_args});
+      }} else {{
+        {call}
+      }}"""
+
+    variant_decls = declare_kernel(kernel_name)[1:]
+    kernel_call = call_kernel(kernel_name)
+    # The variant specialized for unit innermost strides, see
+    # CPUOptions.unit_stride, is called if the arguments at these positions
+    # among the non-constexpr ones are all 1.
+    unit_stride_check = "false"
+    if unit_stride_args:
+        kernel_args = [i for i in signature.keys() if i not in constants]
+        unit_stride_check = " && ".join(f"arg{kernel_args[pos]} == 1" for pos in unit_stride_args)
+        variant_decls += declare_kernel(f"{kernel_name}_unitstride")
+        kernel_call = f"""if (unit_stride) {{
+      {call_kernel(f"{kernel_name}_unitstride")}
+      }} else {{
+      {kernel_call}
+      }}"""
+    variant_decls = "\n  ".join(variant_decls)
+
+    # Kernels compiled with CPUOptions.intra_program_parallelism run their
+    # large linalg ops on the threads that the launcher lends to the program,
+    # see IntraProgramScope in Runtime/ThreadPool.h. Small grids run their
+    # programs one after another, each of them on all the threads.
+    intra_program_setup = ""
+    if intra_program:
+        intra_program_setup = """triton_shared::IntraProgramScope intra_program_scope(
+        num_programs, num_threads, static_cast<triton_shared::ThreadAffinity>(affinity));
+    num_threads = intra_program_scope.gridThreads();"""
+
+    ptr_arg_decls = ' '.join(f'StridedMemRefType<char, 0> ptr_arg{i} = {{static_cast<char *>(arg{i}), static_cast<char *>(arg{i}), 0}};' for i, ty in signature.items() if i not in constants and ty[0] == "*")
+    if grid_loop:
+        run_programs = f"""auto run_programs = [&](int64_t begin, int64_t end) {{
+      triton_shared::ProgramTimer timer(profile, end - begin);
+      // The kernel releases the buffers of each program it runs.
+      triton_shared::ArenaScope arena_scope;
+      // Use some random type "char" here.
+      {ptr_arg_decls}
+      {kernel_call}
+    }};
+    triton_shared::parallelForRanges(num_programs, num_threads,
+                                     static_cast<triton_shared::LaunchSchedule>(schedule),
+                                     static_cast<triton_shared::ThreadAffinity>(affinity),
+                                     run_programs);"""
+    else:
+        run_programs = f"""triton_shared::GridTraversal traversal(gridX, gridY, gridZ,
+                                          static_cast<triton_shared::GridOrder>(grid_order), group_size);
+    auto run_program = [&](int64_t pid) {{
+      int x, y, z;
+      traversal.coords(pid, x, y, z);
+      triton_shared::ProgramTimer timer(profile);
+      // Buffers allocated by the kernel live until the program returns.
+      triton_shared::ArenaScope arena_scope;
+      // Use some random type "char" here.
+      {ptr_arg_decls}
+      {kernel_call}
+    }};
+    triton_shared::parallelFor(num_programs, num_threads,
+                               static_cast<triton_shared::LaunchSchedule>(schedule),
+                               static_cast<triton_shared::ThreadAffinity>(affinity),
+                               run_program);"""
+
     return f"""
 #include <assert.h>
 #include <stdbool.h>
+#include <limits>
+#include <memory>
+#include <vector>
 #include <Python.h>
 #include "ExecutionEngine/CRunnerUtils.h"
-#include "ExecutionEngine/CRunnerUtils.cpp"
+#include "Runtime/Arena.h"
+#include "Runtime/BoundLaunch.h"
+#include "Runtime/GridOrder.h"
+#include "Runtime/Profiler.h"
+#include "Runtime/ThreadPool.h"
 
 extern "C" {{
   // Pointer type (=Memref) becomes int64_t + MemRef struct
   // FIXME: understand what this int64_t is used for.
   void {kernel_name}({kernel_arg_decls}
-                       int, int, int, int, int, int);
+                       int, int, int, {program_decls});
+  {variant_decls}
 }}
 
-static void _launch(int gridX, int gridY, int gridZ, {arg_decls}) {{
-  if (gridX*gridY*gridZ > 0) {{
-    // Cast "function" to the real function type.
-    for(int x = 0; x < gridX; x++) {{
-      for(int y = 0; y < gridY; y++) {{
-        for(int z = 0; z < gridZ; z++) {{
-          // Use some random type "char" here.
-          {' '.join(f'StridedMemRefType<char, 0> ptr_arg{i} = {{static_cast<char *>(arg{i}), static_cast<char *>(arg{i}), 0}};' for i, ty in signature.items() if i not in constants and ty[0] == "*")}
-          {kernel_name}({kernel_parameters}
-                        gridX, gridY, gridZ, x, y, z);
-        }}
-      }}
+static void _launch(int num_threads, int schedule, int affinity, int grid_order, int group_size, bool noalias, triton_shared::LaunchProfile *profile, int gridX, int gridY, int gridZ, {arg_decls}) {{
+  int64_t num_programs = static_cast<int64_t>(gridX) * gridY * gridZ;
+  [[maybe_unused]] const bool unit_stride = {unit_stride_check};
+  if (num_programs > 0) {{
+    {intra_program_setup}
+    // Program ids are linearized with z varying fastest; the default grid
+    // order visits the programs in the same order as a nested x/y/z loop.
+    {run_programs}
+  }}
+}}
+
+// Summary of a profiled launch, see backend/profiler.py.
+static PyObject *profileToDict(const triton_shared::LaunchProfile &profile, int64_t wall_ns, int num_threads) {{
+  PyObject *histogram = PyList_New(triton_shared::kNumLatencyBuckets);
+  for (int i = 0; i < triton_shared::kNumLatencyBuckets; i++) {{
+    PyList_SET_ITEM(histogram, i, PyLong_FromLongLong(profile.histogram[i].load()));
+  }}
+  PyObject *counters;
+  if (profile.collectCounters && !profile.countersMissing.load()) {{
+    counters = PyList_New(triton_shared::kNumProfileCounters);
+    for (int i = 0; i < triton_shared::kNumProfileCounters; i++) {{
+      PyList_SET_ITEM(counters, i, PyLong_FromUnsignedLongLong(profile.counters[i].load()));
     }}
+  }} else {{
+    Py_INCREF(Py_None);
+    counters = Py_None;
+  }}
+  return Py_BuildValue("{{s:L,s:L,s:i,s:L,s:L,s:N,s:N}}",
+                       "wall_ns", static_cast<long long>(wall_ns),
+                       "num_programs", static_cast<long long>(profile.numSamples.load()),
+                       "num_threads", num_threads,
+                       "program_ns", static_cast<long long>(profile.totalNs.load()),
+                       "max_program_ns", static_cast<long long>(profile.maxNs.load()),
+                       "latency_histogram", histogram,
+                       "counters", counters);
+}}
+
+// Conversions of the scalar launch arguments. Like the PyArg_ParseTuple format
+// units they replace, they accept any object with __index__ (or __float__),
+// signed integers are range checked and unsigned ones are truncated.
+template <typename T>
+static inline bool parseSigned(PyObject *obj, T *out) {{
+  long long value = PyLong_AsLongLong(obj);
+  if (value == -1 && PyErr_Occurred()) {{
+    return false;
   }}
+  if (value < std::numeric_limits<T>::min() || value > std::numeric_limits<T>::max()) {{
+    PyErr_SetString(PyExc_OverflowError, "integer argument out of range");
+    return false;
+  }}
+  *out = static_cast<T>(value);
+  return true;
+}}
+
+template <typename T>
+static inline bool parseUnsigned(PyObject *obj, T *out) {{
+  unsigned long long value = PyLong_AsUnsignedLongLongMask(obj);
+  if (value == static_cast<unsigned long long>(-1) && PyErr_Occurred()) {{
+    return false;
+  }}
+  *out = static_cast<T>(value);
+  return true;
+}}
+
+template <typename T>
+static inline bool parseFloat(PyObject *obj, T *out) {{
+  double value = PyFloat_AsDouble(obj);
+  if (value == -1.0 && PyErr_Occurred()) {{
+    return false;
+  }}
+  *out = static_cast<T>(value);
+  return true;
 }}
 
 typedef struct _DevicePtrInfo {{
@@ -102,51 +264,128 @@ typedef struct _DevicePtrInfo {{
   bool valid;
 }} DevicePtrInfo;
 
+static PyObject *data_ptr_name = NULL;
+
+// The type of the last tensor whose data pointer was read through the
+// data_ptr method of its type, and that method. Tensors of that type skip the
+// attribute lookup and the creation of a bound method: all the tensors of a
+// launch usually have the same type. Only accessed with the GIL held.
+static PyTypeObject *cached_tensor_type = NULL;
+static PyObject *cached_data_ptr = NULL;
+
 static inline DevicePtrInfo getPointer(PyObject *obj, int idx) {{
   DevicePtrInfo ptr_info;
   ptr_info.dev_ptr = 0;
   ptr_info.valid = true;
   if (PyLong_Check(obj)) {{
     ptr_info.dev_ptr = reinterpret_cast<void *>(PyLong_AsUnsignedLongLong(obj));
+    ptr_info.valid = !PyErr_Occurred();
     return ptr_info;
   }}
   if (obj == Py_None) {{
     // valid nullptr
     return ptr_info;
   }}
-  PyObject *ptr = PyObject_GetAttrString(obj, "data_ptr");
-  if(ptr){{
-    PyObject *empty_tuple = PyTuple_New(0);
-    PyObject *ret = PyObject_Call(ptr, empty_tuple, NULL);
-    Py_DECREF(empty_tuple);
-    Py_DECREF(ptr);
-    if (!PyLong_Check(ret)) {{
-      PyErr_SetString(PyExc_TypeError, "data_ptr method of Pointer object must return 64-bit int");
-      ptr_info.valid = false;
-      return ptr_info;
+  PyObject *ret;
+  if (Py_TYPE(obj) == cached_tensor_type) {{
+    ret = PyObject_Vectorcall(cached_data_ptr, &obj, 1, NULL);
+  }} else {{
+    // Objects exporting a buffer, like NumPy arrays, give their address
+    // without any call. The pointer stays valid as long as the caller holds
+    // the object, i.e. for the duration of the launch. The kernel may write
+    // through any pointer argument, so read-only buffers are rejected.
+    if (PyObject_CheckBuffer(obj)) {{
+      Py_buffer view;
+      if (PyObject_GetBuffer(obj, &view, PyBUF_STRIDES | PyBUF_WRITABLE) == 0) {{
+        ptr_info.dev_ptr = view.buf;
+        PyBuffer_Release(&view);
+        return ptr_info;
+      }}
+      PyErr_Clear();
+      if (PyObject_GetBuffer(obj, &view, PyBUF_STRIDES) == 0) {{
+        PyBuffer_Release(&view);
+        PyErr_Format(PyExc_TypeError, "Pointer argument (at %d) is a read-only buffer", idx);
+        ptr_info.valid = false;
+        return ptr_info;
+      }}
+      PyErr_Clear();
+    }}
+    PyObject *method = PyObject_GetAttr(reinterpret_cast<PyObject *>(Py_TYPE(obj)), data_ptr_name);
+    if (method && (PyFunction_Check(method) || Py_IS_TYPE(method, &PyMethodDescr_Type))) {{
+      Py_INCREF(Py_TYPE(obj));
+      Py_XDECREF(cached_tensor_type);
+      Py_XDECREF(cached_data_ptr);
+      cached_tensor_type = Py_TYPE(obj);
+      cached_data_ptr = method;
+      ret = PyObject_Vectorcall(cached_data_ptr, &obj, 1, NULL);
+    }} else {{
+      // Not a plain method of the type, e.g. an attribute of the instance.
+      Py_XDECREF(method);
+      PyErr_Clear();
+      PyObject *ptr = PyObject_GetAttr(obj, data_ptr_name);
+      if (!ptr) {{
+        PyErr_Format(PyExc_TypeError, "Pointer argument (at %d) must be either uint64 or have data_ptr method", idx);
+        ptr_info.valid = false;
+        return ptr_info;
+      }}
+      ret = PyObject_CallNoArgs(ptr);
+      Py_DECREF(ptr);
     }}
-    ptr_info.dev_ptr = reinterpret_cast<void *>(PyLong_AsUnsignedLongLong(ret));
-    if(!ptr_info.dev_ptr)
-      return ptr_info;
-    Py_DECREF(ret);  // Thanks ChatGPT!
+  }}
+  if (!ret) {{
+    ptr_info.valid = false;
+    return ptr_info;
+  }}
+  if (!PyLong_Check(ret)) {{
+    Py_DECREF(ret);
+    PyErr_SetString(PyExc_TypeError, "data_ptr method of Pointer object must return 64-bit int");
+    ptr_info.valid = false;
     return ptr_info;
   }}
-  PyErr_SetString(PyExc_TypeError, "Pointer argument must be either uint64 or have data_ptr method");
+  ptr_info.dev_ptr = reinterpret_cast<void *>(PyLong_AsUnsignedLongLong(ret));
+  Py_DECREF(ret);
+  ptr_info.valid = !PyErr_Occurred();
   return ptr_info;
 }}
 
-static PyObject* launch(PyObject* self, PyObject* args) {{
+namespace {{
+
+// A launch with its arguments converted. Local to the launcher, as bundles
+// link the launchers of several kernels together, see backend/aot.py.
+struct KernelLaunch final : triton_shared::BoundLaunch {{
   int gridX, gridY, gridZ;
-  PyObject *launch_enter_hook = NULL;
-  PyObject *launch_exit_hook = NULL;
-  PyObject *kernel_metadata = NULL;
-  PyObject *launch_metadata = NULL;
-  {' '.join([f"{_extracted_type(ty)} _arg{i}; " for i, ty in signature.items()])}
-  if(!PyArg_ParseTuple(args, \"{format}\", &gridX, &gridY, &gridZ,
-                                           &kernel_metadata, &launch_metadata,
-                                           &launch_enter_hook, &launch_exit_hook {args_list})) {{
-    return NULL;
+  int num_threads;
+  int schedule;
+  int affinity;
+  int grid_order;
+  int group_size;
+  bool noalias;
+  {arg_members}
+
+  void run(triton_shared::LaunchProfile *profile) override {{
+    _launch(num_threads, schedule, affinity, grid_order, group_size, noalias, profile, gridX, gridY, gridZ, {arg_values});
   }}
+}};
+
+}} // namespace
+
+// Convert the arguments of launch and bind into `launch`, one by one instead
+// of through a PyArg_ParseTuple format string. Return false with a Python
+// exception set if one of them is invalid.
+static bool parseLaunch(PyObject* const* args, Py_ssize_t nargs, const char *name, KernelLaunch *launch,
+                        int *profile_mode) {{
+  if (nargs != {num_args}) {{
+    PyErr_Format(PyExc_TypeError, "%s() takes exactly {num_args} arguments (%zd given)", name, nargs);
+    return false;
+  }}
+  int noalias;
+  if (!parseSigned(args[0], &launch->gridX) || !parseSigned(args[1], &launch->gridY) ||
+      !parseSigned(args[2], &launch->gridZ) || !parseSigned(args[3], &noalias) ||
+      !parseSigned(args[4], profile_mode)) {{
+    return false;
+  }}
+  launch->noalias = noalias != 0;
+  PyObject *kernel_metadata = args[5];
 
   // [CPULauncher-specific]: We don't need the metadata below but just put them
   // here anyway to be consistent with others.
@@ -158,28 +397,71 @@ static PyObject* launch(PyObject* self, PyObject* args) {{
   //    return NULL;
   //  }}
 
+  // The launch configuration follows the kernel name in kernel_metadata,
+  // see pack_metadata in compiler.py.
+  if (!PyTuple_Check(kernel_metadata) || PyTuple_Size(kernel_metadata) < 12) {{
+    PyErr_SetString(PyExc_TypeError, "kernel_metadata must be a tuple");
+    return false;
+  }}
+  launch->num_threads = PyLong_AsLong(PyTuple_GET_ITEM(kernel_metadata, 7));
+  launch->schedule = PyLong_AsLong(PyTuple_GET_ITEM(kernel_metadata, 8));
+  launch->affinity = PyLong_AsLong(PyTuple_GET_ITEM(kernel_metadata, 9));
+  launch->grid_order = PyLong_AsLong(PyTuple_GET_ITEM(kernel_metadata, 10));
+  launch->group_size = PyLong_AsLong(PyTuple_GET_ITEM(kernel_metadata, 11));
+  if (PyErr_Occurred()) {{
+    return false;
+  }}
+
+  // raise exception asap
+  {args_parse}
+  return true;
+}}
+
+// Called with vectorcall, see compile_module.
+static PyObject* launch(PyObject* self, PyObject* const* args, Py_ssize_t nargs) {{
+  KernelLaunch kernel_launch;
+  int profile_mode;
+  if (!parseLaunch(args, nargs, "launch", &kernel_launch, &profile_mode)) {{
+    return NULL;
+  }}
+  PyObject *launch_metadata = args[6];
+  PyObject *launch_enter_hook = args[7];
+  PyObject *launch_exit_hook = args[8];
+
   // extract launch metadata
   if (launch_enter_hook != Py_None){{
-    PyObject* args = Py_BuildValue("(O)", launch_metadata);
-    PyObject* ret = PyObject_CallObject(launch_enter_hook, args);
-    Py_DECREF(args);
+    PyObject* ret = PyObject_CallOneArg(launch_enter_hook, launch_metadata);
     if (!ret)
       return NULL;
+    Py_DECREF(ret);
   }}
 
-  // raise exception asap
-  {"; ".join([f"DevicePtrInfo ptr_info{i} = getPointer(_arg{i}, {i}); if (!ptr_info{i}.valid) return NULL;" if ty[0] == "*" else "" for i, ty in signature.items()])};
-  _launch(gridX, gridY, gridZ, {', '.join(f"ptr_info{i}.dev_ptr" if ty[0]=="*" else f"_arg{i}"for i, ty in signature.items())});
+  // profile_mode is 0 when profiling is off, 1 to time the programs and 2 to
+  // also read their hardware counters.
+  triton_shared::LaunchProfile profile(profile_mode > 1);
+  triton_shared::LaunchProfile *profile_ptr = profile_mode > 0 ? &profile : nullptr;
+  int64_t start_ns = profile_ptr ? triton_shared::profilerNowNs() : 0;
+  // The kernel never touches Python objects, so let other Python threads run
+  // while the grid executes.
+  Py_BEGIN_ALLOW_THREADS;
+  kernel_launch.run(profile_ptr);
+  Py_END_ALLOW_THREADS;
+  int64_t wall_ns = profile_ptr ? triton_shared::profilerNowNs() - start_ns : 0;
 
   if (PyErr_Occurred()) {{
     return NULL;
   }}
   if(launch_exit_hook != Py_None){{
-    PyObject* args = Py_BuildValue("(O)", launch_metadata);
-    PyObject* ret = PyObject_CallObject(launch_exit_hook, args);
-    Py_DECREF(args);
+    PyObject* ret = PyObject_CallOneArg(launch_exit_hook, launch_metadata);
     if (!ret)
       return NULL;
+    Py_DECREF(ret);
+  }}
+
+  if (profile_ptr) {{
+    int threads = kernel_launch.num_threads > 0 ? kernel_launch.num_threads
+                                                : triton_shared::ThreadPool::hardwareConcurrency();
+    return profileToDict(profile, wall_ns, threads);
   }}
 
   // return None
@@ -187,8 +469,78 @@ static PyObject* launch(PyObject* self, PyObject* args) {{
   return Py_None;
 }}
 
+static void destroyBoundLaunch(PyObject *capsule) {{
+  delete static_cast<triton_shared::BoundLaunch *>(
+      PyCapsule_GetPointer(capsule, triton_shared::kBoundLaunchCapsuleName));
+}}
+
+// Convert the arguments of a launch without running it, see backend/stream.py.
+// Takes the arguments of launch; profile_mode and the hooks are ignored.
+static PyObject* bind(PyObject* self, PyObject* const* args, Py_ssize_t nargs) {{
+  std::unique_ptr<KernelLaunch> kernel_launch(new KernelLaunch());
+  int profile_mode;
+  if (!parseLaunch(args, nargs, "bind", kernel_launch.get(), &profile_mode)) {{
+    return NULL;
+  }}
+  PyObject *capsule = PyCapsule_New(static_cast<triton_shared::BoundLaunch *>(kernel_launch.get()),
+                                    triton_shared::kBoundLaunchCapsuleName, destroyBoundLaunch);
+  if (capsule) {{
+    kernel_launch.release();
+  }}
+  return capsule;
+}}
+
+// Run a sequence of bound launches, of any kernel, one after another with the
+// GIL released.
+static PyObject* run_bound(PyObject* self, PyObject* launches) {{
+  PyObject *seq = PySequence_Fast(launches, "run_bound expects a sequence of bound launches");
+  if (!seq) {{
+    return NULL;
+  }}
+  // Keep the capsules alive while the GIL is released, even if the sequence
+  // is modified meanwhile.
+  Py_ssize_t n = PySequence_Fast_GET_SIZE(seq);
+  std::vector<PyObject *> capsules;
+  std::vector<triton_shared::BoundLaunch *> bound;
+  capsules.reserve(n);
+  bound.reserve(n);
+  for (Py_ssize_t i = 0; i < n; i++) {{
+    PyObject *item = PySequence_Fast_GET_ITEM(seq, i);
+    void *ptr = PyCapsule_GetPointer(item, triton_shared::kBoundLaunchCapsuleName);
+    if (!ptr) {{
+      break;
+    }}
+    Py_INCREF(item);
+    capsules.push_back(item);
+    bound.push_back(static_cast<triton_shared::BoundLaunch *>(ptr));
+  }}
+  Py_DECREF(seq);
+  if (PyErr_Occurred()) {{
+    for (PyObject *capsule : capsules) {{
+      Py_DECREF(capsule);
+    }}
+    return NULL;
+  }}
+
+  Py_BEGIN_ALLOW_THREADS;
+  for (triton_shared::BoundLaunch *launch : bound) {{
+    launch->run(nullptr);
+  }}
+  Py_END_ALLOW_THREADS;
+
+  for (PyObject *capsule : capsules) {{
+    Py_DECREF(capsule);
+  }}
+  Py_INCREF(Py_None);
+  return Py_None;
+}}
+
 static PyMethodDef ModuleMethods[] = {{
-  {{"launch", launch, METH_VARARGS, "Entry point for all kernels with this signature"}},
+  {{"launch", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(launch)), METH_FASTCALL,
+    "Entry point for all kernels with this signature"}},
+  {{"bind", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(bind)), METH_FASTCALL,
+    "Bind the arguments of a launch, to be run later by run_bound"}},
+  {{"run_bound", run_bound, METH_O, "Run a sequence of bound launches"}},
   {{NULL, NULL, 0, NULL}} // sentinel
 }};
 
@@ -200,18 +552,30 @@ static struct PyModuleDef ModuleDef = {{
   ModuleMethods
 }};
 
-PyMODINIT_FUNC PyInit___triton_shared_ref_cpu_kernel_launcher(void) {{
+// A bundle names the module init function of each of its launchers.
+#ifndef TRITON_SHARED_LAUNCHER_INIT
+#define TRITON_SHARED_LAUNCHER_INIT PyInit___triton_shared_ref_cpu_kernel_launcher
+#endif
+
+PyMODINIT_FUNC TRITON_SHARED_LAUNCHER_INIT(void) {{
   PyObject *m = PyModule_Create(&ModuleDef);
   if(m == NULL) {{
     return NULL;
   }}
+  data_ptr_name = PyUnicode_InternFromString("data_ptr");
+  if (data_ptr_name == NULL) {{
+    Py_DECREF(m);
+    return NULL;
+  }}
   PyModule_AddFunctions(m, ModuleMethods);
   return m;
 }}
 """
 
 
-def compile_module(launcher_src, kernel_placeholder_name):
+def _build_paths():
+    # The include and library directories, and the Python library, the
+    # launchers are built with.
     # This function was renamed and made public in Python 3.10
     if hasattr(sysconfig, 'get_default_scheme'):
         scheme = sysconfig.get_default_scheme()
@@ -227,67 +591,186 @@ def compile_module(launcher_src, kernel_placeholder_name):
     py_lib = '{name}{py_version}'.format(name="python", py_version=py_version)
     cpu_backend_path = Path(__file__).resolve().parent
     include_dir = os.path.join(cpu_backend_path, "include")
+    return py_include_dir, include_dir, py_lib_dir, py_lib
+
+
+def _runtime_source():
+    return os.path.join(_build_paths()[1], "Runtime", "Runtime.cpp")
+
+
+_RUNTIME_LIBRARY = "libtriton_shared_runtime.so"
+_runtime_lock = threading.Lock()
+_runtime_path = None
+
+
+def _runtime_library():
+    # Path of the shared library with the runtime functions called by the
+    # kernels (memrefCopy, the matmul routines, ...). It is built once per
+    # version of the backend headers and linked by every launcher, instead of
+    # being compiled into each of them.
+    global _runtime_path
+    with _runtime_lock:
+        if _runtime_path is not None and os.path.exists(_runtime_path):
+            return _runtime_path
+        include_dir = _build_paths()[1]
+        key = hashlib.md5()
+        for header_dir in sorted(os.listdir(include_dir)):
+            for name in sorted(os.listdir(os.path.join(include_dir, header_dir))):
+                key.update(Path(include_dir, header_dir, name).read_bytes())
+        cache = get_cache_manager(key.hexdigest())
+        path = cache.get_file(_RUNTIME_LIBRARY)
+        if path is None:
+            with tempfile.TemporaryDirectory() as tmpdir:
+                so_path = os.path.join(tmpdir, _RUNTIME_LIBRARY)
+                subprocess.check_call([
+                    "g++", "-std=c++17", "-O3", _runtime_source(), f"-I{include_dir}", "-shared", "-fPIC",
+                    f"-Wl,-soname,{_RUNTIME_LIBRARY}", "-o", so_path
+                ])
+                path = cache.put(Path(so_path).read_bytes(), _RUNTIME_LIBRARY, binary=True)
+        _runtime_path = path
+        return path
+
+
+# Launcher modules loaded in this process, keyed by the hash of the launcher
+# source and kernel object they were built from. Bundles loaded by
+# aot.load_bundle register their launchers here as well.
+_loaded_launchers = {}
+
+
+def _launcher_key(src, obj):
+    return hashlib.md5(src.encode("utf-8") + obj).hexdigest()
+
+
+def _load_launcher(src, obj):
+    key = _launcher_key(src, obj)
+    if key in _loaded_launchers:
+        return _loaded_launchers[key]
+
+    py_include_dir, include_dir, py_lib_dir, py_lib = _build_paths()
+    runtime_path = _runtime_library()
+
+    cache = get_cache_manager(key)
+    name = "__triton_shared_ref_cpu_kernel_launcher"
+    filename = f"{name}.so"
+    cache_path = cache.get_file(filename)
+
+    if cache_path is None:
+      with tempfile.TemporaryDirectory() as tmpdir:
+          obj_path = os.path.join(tmpdir, "kernel.o")
+          launcher_src_path = os.path.join(tmpdir, "main.cxx")
+          so_path = os.path.join(tmpdir, "kernel.so")
+          Path(obj_path).write_bytes(obj)
+          Path(launcher_src_path).write_text(src)
+          # Compile the launcher and link it with the kernel.
+          subprocess.check_call([
+            "g++", "-std=c++17", "-O3", launcher_src_path, obj_path, runtime_path,
+            f"-I{py_include_dir}", f"-I{include_dir}", f"-L{py_lib_dir}",
+            f"-Wl,-rpath,{os.path.dirname(runtime_path)}",
+            "-shared", f"-l{py_lib}", "-fPIC", "-o", so_path
+          ])
+
+          with open(so_path, "rb") as f:
+            cache_path = cache.put(f.read(), filename, binary=True)
+
+    # Load the compiled kernel.
+    spec = importlib.util.spec_from_file_location(name, cache_path)
+    mod = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(mod)
+    _loaded_launchers[key] = mod
+    return mod
+
+
+def _have_disjoint_storage(args, ptr_arg_positions):
+    # Return true if the tensors passed as pointer arguments use pairwise
+    # disjoint storage. Arguments whose extent is not known, like raw
+    # addresses, are conservatively assumed to overlap with the others.
+    ranges = []
+    for pos in ptr_arg_positions:
+        arg = args[pos]
+        if arg is None:
+            continue
+        if not hasattr(arg, "untyped_storage"):
+            return False
+        storage = arg.untyped_storage()
+        start = storage.data_ptr()
+        ranges.append((start, start + storage.nbytes()))
+    ranges.sort()
+    return all(end <= next_start for (_, end), (next_start, _) in zip(ranges, ranges[1:]))
+
+
+def compile_module(launcher_src, kernel_placeholder_name, ptr_arg_positions=(), noalias_variant=False):
+    # Launcher modules already resolved by this launcher. Python caches the hash
+    # of str and bytes objects, and the kernel metadata and object passed in
+    # are the same objects on every launch of a given kernel, so steady-state
+    # launches only pay for a dictionary lookup.
+    launchers = {}
 
     def launch(
         gridX, gridY, gridZ, stream, cu_function,
         kernel_metadata, launch_metadata,
         launch_enter_hook, launch_exit_hook, *args):
         # Unlike CUDA/HIP, we cannot easily pass function pointer across different pybind libraries.
-        # Let's compile a kernel every time.
-        # The cu_function parameter actually contains our assembly source code.
+        # Let's compile a kernel the first time it is launched.
+        # The cu_function parameter actually contains the object file of the kernel.
         # See CPUUtils.load_binary method.
-        asm_src = cu_function
+        obj = cu_function
         kernel_name = kernel_metadata[6] # see pack_metadata in compiler.py
-        src = launcher_src.replace(kernel_placeholder_name, kernel_name)
-
-        key = hashlib.md5(src.encode("utf-8") + asm_src).hexdigest()
-        cache = get_cache_manager(key)
-        name = "__triton_shared_ref_cpu_kernel_launcher"
-        filename = f"{name}.so"
-        cache_path = cache.get_file(filename)
-
-        if cache_path is None:
-          with tempfile.TemporaryDirectory() as tmpdir:
-              asm_src_path = os.path.join(tmpdir, "kernel.s")
-              launcher_src_path = os.path.join(tmpdir, "main.cxx")
-              so_path = os.path.join(tmpdir, "kernel.so")
-              Path(asm_src_path).write_bytes(asm_src)
-              Path(launcher_src_path).write_text(src)
-              # Compile it together.
-              subprocess.check_call([
-                "g++", "-std=c++17", launcher_src_path, asm_src_path,
-                f"-I{py_include_dir}", f"-I{include_dir}", f"-L{py_lib_dir}",
-                "-shared", f"-l{py_lib}", "-fPIC", "-o", so_path
-              ])
-
-              with open(so_path, "rb") as f:
-                cache_path = cache.put(f.read(), filename, binary=True)
-
-        # Load and launch the compiled kernel.
-        spec = importlib.util.spec_from_file_location(name, cache_path)
-        mod = importlib.util.module_from_spec(spec)
-        spec.loader.exec_module(mod)
-        return mod.launch(gridX, gridY, gridZ,
+        module = launchers.get((kernel_name, obj))
+        if module is None:
+            src = launcher_src.replace(kernel_placeholder_name, kernel_name)
+            start = time.perf_counter()
+            module = _load_launcher(src, obj)
+            if profiler.is_compile_profiling_enabled():
+                profiler._record_launcher_build(kernel_name, time.perf_counter() - start)
+            launchers[(kernel_name, obj)] = module
+
+        noalias = noalias_variant and _have_disjoint_storage(args, ptr_arg_positions)
+        if stream is not None:
+            # A Stream or a capturing Graph, see CPUDriver.get_current_stream:
+            # the launch is only bound here and runs later.
+            bound = module.bind(gridX, gridY, gridZ, noalias, 0, kernel_metadata, launch_metadata, None, None, *args)
+            stream._submit(module, bound, args)
+            return
+        profile_mode = profiler._profile_mode
+        result = module.launch(gridX, gridY, gridZ, noalias, profile_mode,
                           kernel_metadata, launch_metadata,
                           launch_enter_hook, launch_exit_hook,
                           *args)
+        if profile_mode:
+            profiler._record(kernel_name, (gridX, gridY, gridZ), result)
 
     return launch
 
 
+_KERNEL_PLACEHOLDER_NAME = "KERNEL_NAME_PLACEHOLDER"
+
+
+def _launcher_source(src, metadata):
+    # The source of the launcher of a compiled kernel, with
+    # _KERNEL_PLACEHOLDER_NAME in place of the name of the kernel, and the
+    # positions of its pointer arguments.
+    constants = src.constants if hasattr(src, "constants") else dict()
+    cst_key = lambda i: src.fn.arg_names.index(i) if isinstance(i, str) else i
+    constants = {cst_key(key): value for key, value in constants.items()}
+    signature = {cst_key(key): value for key, value in src.signature.items()}
+    noalias_variant = getattr(metadata, "noalias_variant", False)
+    grid_loop = getattr(metadata, "grid_loop", False)
+    unit_stride_args = getattr(metadata, "unit_stride_args", ())
+    intra_program = getattr(metadata, "intra_program_parallelism", False)
+    launcher_src = _generate_launcher(constants, signature, _KERNEL_PLACEHOLDER_NAME, noalias_variant, grid_loop,
+                                      unit_stride_args, intra_program)
+    ptr_arg_positions = [pos for pos, (i, ty) in enumerate(signature.items()) if ty[0] == "*" and i not in constants]
+    return launcher_src, ptr_arg_positions
+
+
 class CPULauncher(object):
 
     def __init__(self, src, metadata):
-        kernel_placeholder_name = "KERNEL_NAME_PLACEHOLDER"
-
-        constants = src.constants if hasattr(src, "constants") else dict()
-        cst_key = lambda i: src.fn.arg_names.index(i) if isinstance(i, str) else i
-        constants = {cst_key(key): value for key, value in constants.items()}
-        signature = {cst_key(key): value for key, value in src.signature.items()}
-        launcher_src = _generate_launcher(constants, signature, kernel_placeholder_name)
+        launcher_src, ptr_arg_positions = _launcher_source(src, metadata)
+        noalias_variant = getattr(metadata, "noalias_variant", False)
         # Later KERNEL_NAME_PLACEHOLDER will be used to assign the kernel name
         # in the following launch function.
-        self.launch = compile_module(launcher_src, kernel_placeholder_name)
+        self.launch = compile_module(launcher_src, _KERNEL_PLACEHOLDER_NAME, ptr_arg_positions, noalias_variant)
 
     def __call__(self, *args, **kwargs):
         self.launch(*args, **kwargs)
@@ -306,8 +789,8 @@ class CPUUtils(object):
     # (see third_party/nvidia/backend/driver.c)
     # These methods are then used in compiler.py to initialize handles before running
     # the triton kernels.
-    # Since we recompile the kernel every time (see compile_module above),
-    # and the metadata generated by these functions aren't applicable to the cpu
+    # Since we compile the kernel together with its launcher (see compile_module
+    # above), and the metadata generated by these functions aren't applicable to the cpu
     # backend, just define the same functions with dummy implementation.
     @staticmethod
     def get_device_properties(device):
@@ -321,13 +804,13 @@ class CPUUtils(object):
 
     # Important note:
     # Since we cannot easy pass function pointers around, we pass along the
-    # assembly source code so that compile_module above can recompile the
-    # module every time.
+    # object file of the kernel so that compile_module above can link it with
+    # the launcher.
     @staticmethod
-    def load_binary(name, kernel_asm, shared, device):
+    def load_binary(name, kernel_obj, shared, device):
         return (
           None,       # module
-          kernel_asm, # function
+          kernel_obj, # function
           None,       # n_regs
           None        # n_spills
         )
@@ -339,7 +822,7 @@ class CPUDriver(DriverBase):
         super().__init__()
         self.utils = CPUUtils()
         self.launcher_cls = CPULauncher
-        self.binary_ext = "cpuasm"
+        self.binary_ext = "cpuobj"
 
     # CPU driver won't be automatically chosen unless explicitly set through
     # triton.runtime.driver.set_active(CPUDriver())
@@ -351,7 +834,9 @@ class CPUDriver(DriverBase):
         return ("cpu", 0)
 
     def get_current_stream(self, device):
-        return None
+        # None, for launches that block until the grid finished, unless a
+        # Stream or a capturing Graph is current, see stream.py.
+        return cpu_stream.current_stream()
 
     def get_current_device(self):
         # CPU doesn't have a device to return. Return something.
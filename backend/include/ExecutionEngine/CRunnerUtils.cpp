@@ -14,6 +14,7 @@
 
 #include "CRunnerUtils.h"
 #include "Msan.h"
+#include "Runtime/Arena.h"
 
 #ifndef _WIN32
 #if defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || \
@@ -134,9 +135,20 @@ extern "C" double rtclock() {
 #endif // _WIN32
 }
 
-extern "C" void *mlirAlloc(uint64_t size) { return malloc(size); }
+// Kernels run by the triton_shared CPU launcher allocate from the per-thread
+// arena of the program instance they belong to (see Runtime/Arena.h); other
+// callers keep using the system allocator.
+extern "C" void *mlirAlloc(uint64_t size) {
+  auto &arena = triton_shared::Arena::get();
+  if (arena.isActive())
+    return arena.allocate(size);
+  return malloc(size);
+}
 
 extern "C" void *mlirAlignedAlloc(uint64_t alignment, uint64_t size) {
+  auto &arena = triton_shared::Arena::get();
+  if (arena.isActive())
+    return arena.allocate(size, alignment);
 #ifdef _WIN32
   return _aligned_malloc(size, alignment);
 #elif defined(__APPLE__)
@@ -150,9 +162,15 @@ extern "C" void *mlirAlignedAlloc(uint64_t alignment, uint64_t size) {
 #endif
 }
 
-extern "C" void mlirFree(void *ptr) { free(ptr); }
+extern "C" void mlirFree(void *ptr) {
+  if (triton_shared::Arena::get().owns(ptr))
+    return;
+  free(ptr);
+}
 
 extern "C" void mlirAlignedFree(void *ptr) {
+  if (triton_shared::Arena::get().owns(ptr))
+    return;
 #ifdef _WIN32
   _aligned_free(ptr);
 #else
@@ -160,6 +178,29 @@ extern "C" void mlirAlignedFree(void *ptr) {
 #endif
 }
 
+// Called by kernels compiled with a grid loop (see the emit-grid-loop pass)
+// around every program instance they run.
+extern "C" int64_t triton_shared_arena_mark() {
+  return static_cast<int64_t>(triton_shared::Arena::get().mark());
+}
+
+extern "C" void triton_shared_arena_release(int64_t mark) {
+  triton_shared::Arena::get().release(static_cast<uint64_t>(mark));
+}
+
+// Entry points called by code lowered with
+// `finalize-memref-to-llvm{use-generic-functions=true}`.
+extern "C" void *_mlir_memref_to_llvm_alloc(uint64_t size) {
+  return mlirAlloc(size);
+}
+
+extern "C" void *_mlir_memref_to_llvm_aligned_alloc(uint64_t alignment,
+                                                    uint64_t size) {
+  return mlirAlignedAlloc(alignment, size);
+}
+
+extern "C" void _mlir_memref_to_llvm_free(void *ptr) { mlirFree(ptr); }
+
 extern "C" void *rtsrand(uint64_t s) {
   // Standard mersenne_twister_engine seeded with s.
   return new std::mt19937(s);
@@ -0,0 +1,175 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// Per-thread bump allocator backing the buffers that kernels allocate while
+// running one program instance. Kernels lowered by the reference CPU backend
+// allocate through mlirAlloc / mlirAlignedAlloc (see
+// ExecutionEngine/CRunnerUtils.cpp); while an ArenaScope is active on the
+// calling thread those requests are served from the thread's arena, frees of
+// arena memory are no-ops, and everything is released at once when the scope
+// ends. Kernels that loop over several program instances themselves (see
+// CPUOptions.grid_loop) release the buffers of each instance with mark() /
+// release().
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef TRITON_SHARED_RUNTIME_ARENA_H
+#define TRITON_SHARED_RUNTIME_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace triton_shared {
+
+class Arena {
+public:
+  // Memory returned by allocate() is at least aligned like malloc's.
+  static constexpr uint64_t kMinAlignment = alignof(std::max_align_t);
+  static constexpr uint64_t kInitialBlockSize = 1 << 20;
+
+  // The arena of the calling thread. Defined once, in the runtime library
+  // (Runtime/Runtime.cpp), so that the scopes opened by the launchers and the
+  // allocation functions of the runtime use the same arena.
+  static Arena &get();
+
+  Arena() = default;
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+
+  bool isActive() const { return depth > 0; }
+
+  // Return `size` bytes aligned to `alignment` (a power of two).
+  void *allocate(uint64_t size, uint64_t alignment = kMinAlignment) {
+    alignment = std::max(alignment, kMinAlignment);
+    if (!blocks.empty()) {
+      if (void *ptr = bump(blocks[current], size, alignment)) {
+        return ptr;
+      }
+    }
+    // Blocks past the current one were emptied by release().
+    if (current + 1 < blocks.size()) {
+      if (void *ptr = bump(blocks[current + 1], size, alignment)) {
+        current++;
+        return ptr;
+      }
+      blocks.resize(current + 1);
+    }
+    // Grow geometrically so that the number of blocks stays logarithmic in
+    // the peak footprint of a program instance.
+    uint64_t blockSize =
+        std::max(blocks.empty() ? kInitialBlockSize : 2 * blocks.back().size,
+                 size + alignment);
+    blocks.push_back(Block{std::make_unique<char[]>(blockSize), blockSize, 0});
+    current = blocks.size() - 1;
+    return bump(blocks.back(), size, alignment);
+  }
+
+  // Position of the next allocation, to be passed to release().
+  uint64_t mark() const {
+    if (blocks.empty()) {
+      return 0;
+    }
+    return (static_cast<uint64_t>(current) << kMarkBlockShift) |
+           blocks[current].used;
+  }
+
+  // Release everything allocated since `mark` was returned by mark(). The
+  // blocks are kept for the allocations that follow.
+  void release(uint64_t mark) {
+    if (blocks.empty()) {
+      return;
+    }
+    size_t block = mark >> kMarkBlockShift;
+    blocks[block].used = mark & ((uint64_t(1) << kMarkBlockShift) - 1);
+    for (size_t i = block + 1; i <= current; i++) {
+      blocks[i].used = 0;
+    }
+    current = block;
+  }
+
+  bool owns(const void *ptr) const {
+    auto addr = reinterpret_cast<uintptr_t>(ptr);
+    for (const Block &block : blocks) {
+      auto begin = reinterpret_cast<uintptr_t>(block.data.get());
+      if (addr >= begin && addr < begin + block.size) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Release everything allocated since the last reset. If the last program
+  // instance needed more than one block, they are merged into a single block
+  // of the combined size so that subsequent instances bump a single pointer.
+  void reset() {
+    if (blocks.size() > 1) {
+      uint64_t total = 0;
+      for (const Block &block : blocks) {
+        total += block.size;
+      }
+      blocks.clear();
+      blocks.push_back(Block{std::make_unique<char[]>(total), total, 0});
+    } else if (!blocks.empty()) {
+      blocks.back().used = 0;
+    }
+    current = 0;
+  }
+
+private:
+  friend class ArenaScope;
+
+  // A mark holds the index of the current block in its upper bits and the
+  // number of bytes used in that block in the lower ones.
+  static constexpr unsigned kMarkBlockShift = 48;
+
+  struct Block {
+    std::unique_ptr<char[]> data;
+    uint64_t size;
+    uint64_t used;
+  };
+
+  static void *bump(Block &block, uint64_t size, uint64_t alignment) {
+    auto base = reinterpret_cast<uintptr_t>(block.data.get());
+    uintptr_t start = (base + block.used + alignment - 1) & ~(alignment - 1);
+    if (start + size > base + block.size) {
+      return nullptr;
+    }
+    block.used = start + size - base;
+    return reinterpret_cast<void *>(start);
+  }
+
+  std::vector<Block> blocks;
+  // Block served by allocate(); the blocks after it are empty.
+  size_t current = 0;
+  int depth = 0;
+};
+
+// Route the kernel allocations made on this thread to its arena until the
+// outermost scope ends, then reset the arena. The launcher opens one scope
+// per program instance.
+class ArenaScope {
+public:
+  ArenaScope() : arena(Arena::get()) { arena.depth++; }
+  ~ArenaScope() {
+    if (--arena.depth == 0) {
+      arena.reset();
+    }
+  }
+  ArenaScope(const ArenaScope &) = delete;
+  ArenaScope &operator=(const ArenaScope &) = delete;
+
+private:
+  Arena &arena;
+};
+
+} // namespace triton_shared
+
+#endif // TRITON_SHARED_RUNTIME_ARENA_H
@@ -0,0 +1,37 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// Launches whose arguments were converted ahead of time by the bind function
+// of a generated CPU launcher, for the streams and graphs of
+// backend/stream.py. A bound launch is handed to Python as a capsule and can
+// be run by the run_bound function of any launcher module, so that a graph
+// mixing several kernels is replayed in a single native call.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef TRITON_SHARED_RUNTIME_BOUNDLAUNCH_H
+#define TRITON_SHARED_RUNTIME_BOUNDLAUNCH_H
+
+#include "Runtime/Profiler.h"
+
+namespace triton_shared {
+
+// Name of the capsules holding a BoundLaunch.
+constexpr const char *kBoundLaunchCapsuleName = "triton_shared.BoundLaunch";
+
+class BoundLaunch {
+public:
+  virtual ~BoundLaunch() = default;
+
+  // Run all the programs of the grid. Must not touch Python objects: it is
+  // called without the GIL.
+  virtual void run(LaunchProfile *profile) = 0;
+};
+
+} // namespace triton_shared
+
+#endif // TRITON_SHARED_RUNTIME_BOUNDLAUNCH_H
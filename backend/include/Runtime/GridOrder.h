@@ -0,0 +1,194 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// Order in which the launcher visits the programs of a grid (see
+// CPUOptions.grid_order). The schedules of Runtime/ThreadPool.h hand out
+// ranges of consecutive linearized program ids to the workers; this header
+// maps each of these ids to the coordinates of a program. Orders other than
+// the default one keep the programs of a range close to each other in the
+// x/y plane, so that the tiles of a 2-d tiled kernel that a worker runs one
+// after another share their rows of A and columns of B in the cache. z always
+// varies fastest.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef TRITON_SHARED_RUNTIME_GRIDORDER_H
+#define TRITON_SHARED_RUNTIME_GRIDORDER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace triton_shared {
+
+// Must be kept in sync with _GRID_ORDERS in backend/compiler.py.
+enum class GridOrder : int {
+  // x slowest, z fastest, the order of a nested x/y/z loop.
+  RowMajor = 0,
+  // Bands of groupSize consecutive x, visited one after another; within a
+  // band, x varies fastest. This is the grouped ordering of the matmul
+  // tutorial of triton, applied by the launcher to 2-d grids.
+  Grouped = 1,
+  // Z-order curve over the x/y plane.
+  Morton = 2,
+  // Hilbert curve over the x/y plane.
+  Hilbert = 3,
+};
+
+class GridTraversal {
+public:
+  GridTraversal(int gridX, int gridY, int gridZ, GridOrder order,
+                int groupSize)
+      : gridX(gridX), gridY(gridY), gridZ(gridZ), order(order),
+        groupSize(std::max(groupSize, 1)) {
+    // Curves over a line are the default order.
+    if (gridX == 1 || gridY == 1) {
+      this->order = GridOrder::RowMajor;
+    }
+    if (this->order == GridOrder::Morton ||
+        this->order == GridOrder::Hilbert) {
+      curve = getCurve(gridX, gridY, this->order);
+    }
+  }
+
+  // Coordinates of the program visited at position `pid` of the launch.
+  void coords(int64_t pid, int &x, int &y, int &z) const {
+    int64_t xy = pid / gridZ;
+    z = static_cast<int>(pid % gridZ);
+    switch (order) {
+    case GridOrder::RowMajor:
+      x = static_cast<int>(xy / gridY);
+      y = static_cast<int>(xy % gridY);
+      return;
+    case GridOrder::Grouped: {
+      int64_t band = static_cast<int64_t>(groupSize) * gridY;
+      int64_t firstX = xy / band * groupSize;
+      int64_t rows = std::min<int64_t>(gridX - firstX, groupSize);
+      int64_t inBand = xy % band;
+      x = static_cast<int>(firstX + inBand % rows);
+      y = static_cast<int>(inBand / rows);
+      return;
+    }
+    case GridOrder::Morton:
+    case GridOrder::Hilbert:
+      x = static_cast<int>((*curve)[xy] / gridY);
+      y = static_cast<int>((*curve)[xy] % gridY);
+      return;
+    }
+  }
+
+private:
+  using Curve = std::vector<int64_t>;
+
+  // Interleave the bits of x and y, y in the even bits.
+  static uint64_t mortonIndex(uint64_t x, uint64_t y) {
+    auto spread = [](uint64_t v) {
+      v &= 0xffffffff;
+      v = (v | (v << 16)) & 0x0000ffff0000ffffull;
+      v = (v | (v << 8)) & 0x00ff00ff00ff00ffull;
+      v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0full;
+      v = (v | (v << 2)) & 0x3333333333333333ull;
+      v = (v | (v << 1)) & 0x5555555555555555ull;
+      return v;
+    };
+    return spread(y) | (spread(x) << 1);
+  }
+
+  // Distance of (x, y) along the Hilbert curve filling a side x side square,
+  // side a power of 2.
+  static uint64_t hilbertIndex(uint64_t side, uint64_t x, uint64_t y) {
+    uint64_t d = 0;
+    for (uint64_t s = side / 2; s > 0; s /= 2) {
+      uint64_t rx = (x & s) > 0;
+      uint64_t ry = (y & s) > 0;
+      d += s * s * ((3 * rx) ^ ry);
+      if (ry == 0) {
+        if (rx == 1) {
+          x = side - 1 - x;
+          y = side - 1 - y;
+        }
+        std::swap(x, y);
+      }
+    }
+    return d;
+  }
+
+  // The programs of a rectangular grid in the order of the curve over the
+  // smallest square of power of 2 side that contains it. Only the points of
+  // the grid are enumerated and sorted by their distance along the curve:
+  // walking the whole square instead would take side^2 steps, far more than
+  // the programs of a skewed grid.
+  static std::shared_ptr<const Curve> buildCurve(int gridX, int gridY,
+                                                 GridOrder order) {
+    uint64_t side = 1;
+    while (side < static_cast<uint64_t>(std::max(gridX, gridY))) {
+      side *= 2;
+    }
+
+    std::vector<std::pair<uint64_t, int64_t>> keys;
+    keys.reserve(static_cast<size_t>(gridX) * gridY);
+    for (int x = 0; x < gridX; x++) {
+      for (int y = 0; y < gridY; y++) {
+        uint64_t key = order == GridOrder::Morton ? mortonIndex(x, y)
+                                                  : hilbertIndex(side, x, y);
+        keys.emplace_back(key, static_cast<int64_t>(x) * gridY + y);
+      }
+    }
+    std::sort(keys.begin(), keys.end());
+
+    auto curve = std::make_shared<Curve>();
+    curve->reserve(keys.size());
+    for (auto &key : keys) {
+      curve->push_back(key.second);
+    }
+    return curve;
+  }
+
+  // Kernels are launched over and over with the same grid, so the curves are
+  // only built once per grid shape. A few shapes are kept; launches over
+  // ever-changing grids rebuild theirs.
+  static std::shared_ptr<const Curve> getCurve(int gridX, int gridY,
+                                               GridOrder order) {
+    static std::mutex mutex;
+    static std::map<std::tuple<int, int, GridOrder>,
+                    std::shared_ptr<const Curve>>
+        cache;
+    constexpr size_t maxCachedCurves = 16;
+
+    auto key = std::make_tuple(gridX, gridY, order);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = cache.find(key);
+      if (it != cache.end()) {
+        return it->second;
+      }
+    }
+
+    auto curve = buildCurve(gridX, gridY, order);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (cache.size() >= maxCachedCurves) {
+      cache.clear();
+    }
+    cache.emplace(key, curve);
+    return curve;
+  }
+
+  int gridX, gridY, gridZ;
+  GridOrder order;
+  int groupSize;
+  // Linearized x/y coordinates of the programs in the order of the curve.
+  std::shared_ptr<const Curve> curve;
+};
+
+} // namespace triton_shared
+
+#endif // TRITON_SHARED_RUNTIME_GRIDORDER_H
@@ -0,0 +1,276 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// Cache-blocked matmul routines called by kernels compiled with the
+// linalg-to-cpu-runtime pass. They compute C += A * B on 2D strided memrefs,
+// like the linalg.matmul ops they replace. A and B may hold f16 or bf16
+// elements accumulated into an f32 C; they are converted while being packed,
+// so the micro-kernel always runs on the accumulator type.
+//
+// The implementation follows the usual Goto / BLIS scheme: the K dimension is
+// split into KC-deep slices and N into NC-wide blocks whose packed B panels
+// stay in L2 (shared by all MC-high blocks of A), each packed MC x KC block of
+// A stays in L1/L2, and an MR x NR micro-kernel keeps its block of C in
+// registers over a full KC slice.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef TRITON_SHARED_RUNTIME_MATMUL_H
+#define TRITON_SHARED_RUNTIME_MATMUL_H
+
+#include "ExecutionEngine/CRunnerUtils.h"
+#include "Runtime/ThreadPool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Build the micro-kernel for the widest x86 vector extension available at run
+// time; other targets rely on the compiler's default vectorization.
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define TRITON_SHARED_MATMUL_TARGET_CLONES                                      \
+  __attribute__((target_clones("avx512f", "avx2,fma", "default")))
+#else
+#define TRITON_SHARED_MATMUL_TARGET_CLONES
+#endif
+
+namespace triton_shared {
+namespace matmul {
+
+// 16-bit floating-point elements, as stored in memory.
+struct Float16 {
+  uint16_t bits;
+};
+struct BFloat16 {
+  uint16_t bits;
+};
+
+template <typename T> inline T toAccumulator(T v) { return v; }
+
+inline float toAccumulator(BFloat16 v) {
+  uint32_t bits = static_cast<uint32_t>(v.bits) << 16;
+  float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+inline float toAccumulator(Float16 v) {
+  uint32_t sign = static_cast<uint32_t>(v.bits & 0x8000) << 16;
+  uint32_t exponent = (v.bits >> 10) & 0x1f;
+  uint32_t mantissa = v.bits & 0x3ff;
+  uint32_t bits;
+  if (exponent == 0x1f) {
+    // Inf and NaN.
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  } else if (exponent != 0) {
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+  } else if (mantissa == 0) {
+    bits = sign;
+  } else {
+    // Subnormal halves are normal floats.
+    exponent = 113;
+    while ((mantissa & 0x400) == 0) {
+      mantissa <<= 1;
+      exponent--;
+    }
+    bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+  }
+  float result;
+  std::memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+constexpr int64_t MR = 6;
+constexpr int64_t NR = 16;
+constexpr int64_t KC = 256;
+constexpr int64_t MC = 96;
+constexpr int64_t NC = 1024;
+
+static_assert(MC % MR == 0 && NC % NR == 0, "blocks must hold whole panels");
+
+// Pack an mc x kc block of A into row panels of MR rows, stored k-major. Rows
+// past the edge of A are zero-filled so that the micro-kernel never needs to
+// special-case them.
+template <typename In, typename T>
+void packA(const In *a, int64_t rowStride, int64_t colStride, int64_t mc,
+           int64_t kc, T *packed) {
+  for (int64_t i0 = 0; i0 < mc; i0 += MR) {
+    int64_t mr = std::min(MR, mc - i0);
+    for (int64_t k = 0; k < kc; k++) {
+      for (int64_t i = 0; i < mr; i++) {
+        packed[i] = toAccumulator(a[(i0 + i) * rowStride + k * colStride]);
+      }
+      for (int64_t i = mr; i < MR; i++) {
+        packed[i] = T(0);
+      }
+      packed += MR;
+    }
+  }
+}
+
+// Pack a kc x nc block of B into column panels of NR columns, stored k-major
+// and zero-filled past the edge of B.
+template <typename In, typename T>
+void packB(const In *b, int64_t rowStride, int64_t colStride, int64_t kc,
+           int64_t nc, T *packed) {
+  for (int64_t j0 = 0; j0 < nc; j0 += NR) {
+    int64_t nr = std::min(NR, nc - j0);
+    for (int64_t k = 0; k < kc; k++) {
+      const In *row = b + k * rowStride + j0 * colStride;
+      for (int64_t j = 0; j < nr; j++) {
+        packed[j] = toAccumulator(row[j * colStride]);
+      }
+      for (int64_t j = nr; j < NR; j++) {
+        packed[j] = T(0);
+      }
+      packed += NR;
+    }
+  }
+}
+
+// C[0:mr, 0:nr] += Ap * Bp over a kc-deep slice. The MR x NR block of C is
+// accumulated in MR vectors of NR elements, which the compiler maps onto as
+// many native vector registers as the target provides.
+template <typename T>
+TRITON_SHARED_MATMUL_TARGET_CLONES void
+microKernel(int64_t kc, const T *__restrict ap, const T *__restrict bp, T *c,
+            int64_t rowStride, int64_t colStride, int64_t mr, int64_t nr) {
+  typedef T Vec __attribute__((vector_size(NR * sizeof(T))));
+
+  Vec acc[MR] = {};
+  for (int64_t k = 0; k < kc; k++) {
+    Vec b;
+    std::memcpy(&b, bp, sizeof(Vec));
+    for (int64_t i = 0; i < MR; i++) {
+      acc[i] += ap[i] * b;
+    }
+    ap += MR;
+    bp += NR;
+  }
+
+  for (int64_t i = 0; i < mr; i++) {
+    for (int64_t j = 0; j < nr; j++) {
+      c[i * rowStride + j * colStride] += acc[i][j];
+    }
+  }
+}
+
+template <typename In, typename T>
+void matmul(StridedMemRefType<In, 2> *a, StridedMemRefType<In, 2> *b,
+            StridedMemRefType<T, 2> *c) {
+  const int64_t m = c->sizes[0];
+  const int64_t n = c->sizes[1];
+  const int64_t k = a->sizes[1];
+  if (m == 0 || n == 0 || k == 0) {
+    return;
+  }
+
+  const In *aData = a->data + a->offset;
+  const In *bData = b->data + b->offset;
+  T *cData = c->data + c->offset;
+
+  // Packing buffers are per thread since program instances of a grid may run
+  // concurrently (see Runtime/ThreadPool.h). They grow to at most
+  // (MC + NC) * KC elements and are reused across calls.
+  thread_local std::vector<T> packedA;
+  thread_local std::vector<T> packedB;
+
+  for (int64_t j0 = 0; j0 < n; j0 += NC) {
+    int64_t nc = std::min(NC, n - j0);
+    int64_t ncPadded = (nc + NR - 1) / NR * NR;
+    for (int64_t p0 = 0; p0 < k; p0 += KC) {
+      int64_t kc = std::min(KC, k - p0);
+      packedB.resize(std::max<size_t>(packedB.size(), ncPadded * kc));
+      packB(bData + p0 * b->strides[0] + j0 * b->strides[1], b->strides[0],
+            b->strides[1], kc, nc, packedB.data());
+
+      for (int64_t i0 = 0; i0 < m; i0 += MC) {
+        int64_t mc = std::min(MC, m - i0);
+        int64_t mcPadded = (mc + MR - 1) / MR * MR;
+        packedA.resize(std::max<size_t>(packedA.size(), mcPadded * kc));
+        packA(aData + i0 * a->strides[0] + p0 * a->strides[1], a->strides[0],
+              a->strides[1], mc, kc, packedA.data());
+
+        for (int64_t j = 0; j < nc; j += NR) {
+          for (int64_t i = 0; i < mc; i += MR) {
+            T *cBlock =
+                cData + (i0 + i) * c->strides[0] + (j0 + j) * c->strides[1];
+            microKernel(kc, packedA.data() + i * kc, packedB.data() + j * kc,
+                        cBlock, c->strides[0], c->strides[1],
+                        std::min(MR, mc - i), std::min(NR, nc - j));
+          }
+        }
+      }
+    }
+  }
+}
+
+// Matmuls of at least this many multiply-adds are worth splitting among
+// threads.
+constexpr int64_t kMinParallelWork = 1 << 20;
+
+// Split the columns of B and C, in whole NR panels, among the threads the
+// launcher lends to the program (see intraProgramParallelFor in
+// Runtime/ThreadPool.h), which each pack their own blocks of A and B. Without
+// such threads, as in grid-parallel launches, this is matmul().
+template <typename In, typename T>
+void parallelMatmul(StridedMemRefType<In, 2> *a, StridedMemRefType<In, 2> *b,
+                    StridedMemRefType<T, 2> *c) {
+  const int64_t n = c->sizes[1];
+  if (c->sizes[0] * n * a->sizes[1] < kMinParallelWork) {
+    matmul(a, b, c);
+    return;
+  }
+
+  intraProgramParallelFor((n + NR - 1) / NR, [&](int64_t begin, int64_t end) {
+    int64_t j0 = begin * NR;
+    int64_t j1 = std::min(end * NR, n);
+    StridedMemRefType<In, 2> bColumns = *b;
+    bColumns.offset += j0 * b->strides[1];
+    bColumns.sizes[1] = j1 - j0;
+    StridedMemRefType<T, 2> cColumns = *c;
+    cColumns.offset += j0 * c->strides[1];
+    cColumns.sizes[1] = j1 - j0;
+    matmul(a, &bColumns, &cColumns);
+  });
+}
+
+} // namespace matmul
+} // namespace triton_shared
+
+extern "C" MLIR_CRUNNERUTILS_EXPORT void
+_mlir_ciface_triton_shared_matmul_f32(StridedMemRefType<float, 2> *a,
+                                      StridedMemRefType<float, 2> *b,
+                                      StridedMemRefType<float, 2> *c) {
+  triton_shared::matmul::parallelMatmul(a, b, c);
+}
+
+extern "C" MLIR_CRUNNERUTILS_EXPORT void
+_mlir_ciface_triton_shared_matmul_f64(StridedMemRefType<double, 2> *a,
+                                      StridedMemRefType<double, 2> *b,
+                                      StridedMemRefType<double, 2> *c) {
+  triton_shared::matmul::parallelMatmul(a, b, c);
+}
+
+extern "C" MLIR_CRUNNERUTILS_EXPORT void
+_mlir_ciface_triton_shared_matmul_f16_f32(
+    StridedMemRefType<triton_shared::matmul::Float16, 2> *a,
+    StridedMemRefType<triton_shared::matmul::Float16, 2> *b,
+    StridedMemRefType<float, 2> *c) {
+  triton_shared::matmul::parallelMatmul(a, b, c);
+}
+
+extern "C" MLIR_CRUNNERUTILS_EXPORT void
+_mlir_ciface_triton_shared_matmul_bf16_f32(
+    StridedMemRefType<triton_shared::matmul::BFloat16, 2> *a,
+    StridedMemRefType<triton_shared::matmul::BFloat16, 2> *b,
+    StridedMemRefType<float, 2> *c) {
+  triton_shared::matmul::parallelMatmul(a, b, c);
+}
+
+#endif // TRITON_SHARED_RUNTIME_MATMUL_H
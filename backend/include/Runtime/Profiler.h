@@ -0,0 +1,218 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// Launch profiling for the generated CPU launcher. While profiling is enabled
+// (see backend/profiler.py), every program instance run by a launch is timed
+// into a LaunchProfile: the total and maximum latency, a histogram with one
+// bucket per power of two of nanoseconds and, optionally, the hardware
+// counters of the thread that ran it, read through perf_event_open(2).
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef TRITON_SHARED_RUNTIME_PROFILER_H
+#define TRITON_SHARED_RUNTIME_PROFILER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace triton_shared {
+
+// Cycles, instructions, last-level cache misses and branch misses. Must be
+// kept in sync with _COUNTER_NAMES in backend/profiler.py.
+constexpr int kNumProfileCounters = 4;
+
+// Bucket i counts the programs that took [2^i, 2^(i+1)) nanoseconds.
+constexpr int kNumLatencyBuckets = 48;
+
+inline int64_t profilerNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// User-space hardware counters of the calling thread. They are opened on the
+// first use by a thread and stay open for the lifetime of the thread.
+class ThreadCounters {
+public:
+  static ThreadCounters &get() {
+    thread_local ThreadCounters counters;
+    return counters;
+  }
+
+  ThreadCounters(const ThreadCounters &) = delete;
+  ThreadCounters &operator=(const ThreadCounters &) = delete;
+
+  bool isAvailable() const { return leader >= 0; }
+
+  // Store the current counts in `values`; counters that could not be opened
+  // read as 0. Return false if no counter is available.
+  bool read(uint64_t values[kNumProfileCounters]) const {
+    std::fill(values, values + kNumProfileCounters, 0);
+#if defined(__linux__)
+    if (leader < 0) {
+      return false;
+    }
+    // PERF_FORMAT_GROUP: the number of counters, then their values in the
+    // order they were added to the group.
+    uint64_t buffer[1 + kNumProfileCounters];
+    if (::read(leader, buffer, sizeof(buffer)) < 0) {
+      return false;
+    }
+    int n = 0;
+    for (int i = 0; i < kNumProfileCounters; i++) {
+      if (fds[i] >= 0 && n < static_cast<int>(buffer[0])) {
+        values[i] = buffer[1 + n++];
+      }
+    }
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  ~ThreadCounters() {
+#if defined(__linux__)
+    for (int fd : fds) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+#endif
+  }
+
+private:
+  ThreadCounters() {
+    std::fill(fds, fds + kNumProfileCounters, -1);
+#if defined(__linux__)
+    const uint64_t configs[kNumProfileCounters] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+    for (int i = 0; i < kNumProfileCounters; i++) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = configs[i];
+      attr.read_format = PERF_FORMAT_GROUP;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.disabled = leader < 0;
+      fds[i] = static_cast<int>(
+          syscall(SYS_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1, leader,
+                  /*flags=*/0));
+      if (fds[i] >= 0 && leader < 0) {
+        leader = fds[i];
+      }
+    }
+    if (leader >= 0) {
+      ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+  }
+
+  int fds[kNumProfileCounters];
+  int leader = -1;
+};
+
+// Statistics of the program instances of one launch, updated concurrently by
+// the threads running the grid.
+struct LaunchProfile {
+  explicit LaunchProfile(bool collectCounters)
+      : collectCounters(collectCounters) {}
+
+  void record(int64_t ns, int64_t numPrograms,
+              const uint64_t *counterDeltas) {
+    numSamples.fetch_add(numPrograms, std::memory_order_relaxed);
+    totalNs.fetch_add(ns, std::memory_order_relaxed);
+    // Programs run together by a grid-looping kernel are attributed the mean
+    // latency of the range.
+    int64_t latency = ns / std::max<int64_t>(numPrograms, 1);
+    int64_t max = maxNs.load(std::memory_order_relaxed);
+    while (latency > max &&
+           !maxNs.compare_exchange_weak(max, latency,
+                                        std::memory_order_relaxed)) {
+    }
+    int bucket = 0;
+    while (bucket + 1 < kNumLatencyBuckets && (latency >> (bucket + 1)) > 0) {
+      bucket++;
+    }
+    histogram[bucket].fetch_add(numPrograms, std::memory_order_relaxed);
+
+    if (counterDeltas) {
+      for (int i = 0; i < kNumProfileCounters; i++) {
+        counters[i].fetch_add(counterDeltas[i], std::memory_order_relaxed);
+      }
+    } else if (collectCounters) {
+      countersMissing.store(true, std::memory_order_relaxed);
+    }
+  }
+
+  const bool collectCounters;
+  std::atomic<int64_t> numSamples{0};
+  std::atomic<int64_t> totalNs{0};
+  std::atomic<int64_t> maxNs{0};
+  std::atomic<int64_t> histogram[kNumLatencyBuckets] = {};
+  std::atomic<uint64_t> counters[kNumProfileCounters] = {};
+  // Set if the counters of a thread could not be read.
+  std::atomic<bool> countersMissing{false};
+};
+
+// Time the programs run in the scope of the timer into `profile`; does
+// nothing if `profile` is null.
+class ProgramTimer {
+public:
+  ProgramTimer(LaunchProfile *profile, int64_t numPrograms = 1)
+      : profile(profile), numPrograms(numPrograms) {
+    if (!profile) {
+      return;
+    }
+    if (profile->collectCounters) {
+      haveCounters = ThreadCounters::get().read(startCounters);
+    }
+    startNs = profilerNowNs();
+  }
+
+  ~ProgramTimer() {
+    if (!profile) {
+      return;
+    }
+    int64_t ns = profilerNowNs() - startNs;
+    uint64_t deltas[kNumProfileCounters];
+    if (haveCounters && ThreadCounters::get().read(deltas)) {
+      for (int i = 0; i < kNumProfileCounters; i++) {
+        deltas[i] -= startCounters[i];
+      }
+      profile->record(ns, numPrograms, deltas);
+    } else {
+      profile->record(ns, numPrograms, nullptr);
+    }
+  }
+
+  ProgramTimer(const ProgramTimer &) = delete;
+  ProgramTimer &operator=(const ProgramTimer &) = delete;
+
+private:
+  LaunchProfile *profile;
+  int64_t numPrograms;
+  int64_t startNs = 0;
+  bool haveCounters = false;
+  uint64_t startCounters[kNumProfileCounters];
+};
+
+} // namespace triton_shared
+
+#endif // TRITON_SHARED_RUNTIME_PROFILER_H
@@ -0,0 +1,124 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// The runtime library of the CPU backend: the C runner utilities and the
+// matmul routines called by compiled kernels, and the NUMA helpers called
+// from backend/numa.py through ctypes. It is built once into a shared library
+// linked by every launcher (see _runtime_library in backend/driver.py), or
+// into each bundle of kernels (see backend/aot.py).
+//
+//===----------------------------------------------------------------------===//
+
+#include "ExecutionEngine/CRunnerUtils.cpp"
+#include "Runtime/Arena.h"
+#include "Runtime/Matmul.h"
+#include "Runtime/ThreadPool.h"
+#include "Runtime/Topology.h"
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace triton_shared {
+
+Arena &Arena::get() {
+  thread_local Arena arena;
+  return arena;
+}
+
+ThreadPool &ThreadPool::get() {
+  static ThreadPool pool;
+  return pool;
+}
+
+IntraProgramThreads &IntraProgramThreads::get() {
+  thread_local IntraProgramThreads threads;
+  return threads;
+}
+
+// Offset of the start of slice `i` of `n` equal slices of `nbytes` bytes,
+// nbytes * i / n without overflowing, 0 <= i <= n.
+static uint64_t sliceOffset(uint64_t nbytes, uint64_t i, uint64_t n) {
+#if defined(__SIZEOF_INT128__)
+  return static_cast<uint64_t>(static_cast<unsigned __int128>(nbytes) * i / n);
+#else
+  // i * (q + r / n), exact as long as n < 2^32, which keeps r * i < 2^64.
+  uint64_t q = nbytes / n, r = nbytes % n;
+  return q * i + r * i / n;
+#endif
+}
+
+} // namespace triton_shared
+
+// Store the cpus the process may run on in `cpus`, and the index of their
+// NUMA node in `nodes`, up to `capacity` of them, in the order threads are
+// placed on them. Return the number of cpus.
+extern "C" MLIR_CRUNNERUTILS_EXPORT int32_t
+triton_shared_cpu_topology(int32_t *cpus, int32_t *nodes, int32_t capacity) {
+  const auto &topology = triton_shared::CpuTopology::get();
+  int32_t n = 0;
+  for (size_t node = 0; node < topology.nodes().size(); node++) {
+    for (int cpu : topology.nodes()[node]) {
+      if (n < capacity) {
+        cpus[n] = cpu;
+        nodes[n] = static_cast<int32_t>(node);
+      }
+      n++;
+    }
+  }
+  return n;
+}
+
+// Write one byte of every page of [ptr, ptr + nbytes) from the thread that
+// runs the matching programs of a launch of `numPrograms` programs on
+// `numThreads` threads placed according to `affinity`, program i writing the
+// i-th of `numPrograms` equal slices of the buffer. Under the first-touch
+// policy the kernel then backs each page with memory of the NUMA node whose
+// threads write it. The static schedule is used; the chunked and
+// work-stealing schedules split the programs among the nodes the same way.
+extern "C" MLIR_CRUNNERUTILS_EXPORT void
+triton_shared_first_touch(void *ptr, int64_t nbytes, int64_t numPrograms,
+                          int32_t numThreads, int32_t affinity) {
+  if (nbytes <= 0 || numPrograms <= 0) {
+    return;
+  }
+#if defined(__linux__)
+  const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+#else
+  const uintptr_t pageSize = 4096;
+#endif
+  auto base = reinterpret_cast<uintptr_t>(ptr);
+  triton_shared::parallelForRanges(
+      numPrograms, numThreads, triton_shared::LaunchSchedule::Static,
+      static_cast<triton_shared::ThreadAffinity>(affinity),
+      [&](int64_t begin, int64_t end) {
+        uintptr_t first =
+            base + triton_shared::sliceOffset(nbytes, begin, numPrograms);
+        uintptr_t last =
+            base + triton_shared::sliceOffset(nbytes, end, numPrograms);
+        // Pages are touched by the slice they start in; the first slice also
+        // takes the page holding the start of the buffer.
+        uintptr_t mask = ~(pageSize - 1);
+        uintptr_t page = begin == 0 ? first : (first + pageSize - 1) & mask;
+        for (; page < last; page = (page & mask) + pageSize) {
+          *reinterpret_cast<volatile char *>(page) = 0;
+        }
+      });
+}
+
+// Run `body(ctx, begin, end)` on ranges of iterations that together cover
+// [0, n), see intraProgramParallelFor in Runtime/ThreadPool.h. Called by the
+// loops that outline-parallel-loops outlines. Each thread allocates the
+// buffers of its range from its own arena.
+extern "C" MLIR_CRUNNERUTILS_EXPORT void
+triton_shared_parallel_for(int64_t n, void (*body)(void *, int64_t, int64_t),
+                           void *ctx) {
+  triton_shared::intraProgramParallelFor(n, [&](int64_t begin, int64_t end) {
+    triton_shared::ArenaScope arena_scope;
+    body(ctx, begin, end);
+  });
+}
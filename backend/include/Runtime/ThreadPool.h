@@ -0,0 +1,454 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// Persistent thread pool used by the generated CPU launcher to run the program
+// instances of a grid in parallel. This header is included directly by the
+// launcher source emitted in backend/driver.py and is header-only on purpose:
+// the launcher is compiled as a single translation unit.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef TRITON_SHARED_RUNTIME_THREADPOOL_H
+#define TRITON_SHARED_RUNTIME_THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Runtime/Topology.h"
+
+namespace triton_shared {
+
+// Must be kept in sync with _LAUNCH_SCHEDULES in backend/compiler.py.
+enum class LaunchSchedule : int {
+  // Each worker gets one contiguous range of program ids of equal size.
+  Static = 0,
+  // Workers grab fixed-size chunks of program ids from a shared counter.
+  Chunked = 1,
+  // Each worker starts with a static range and steals half of the remaining
+  // range of another worker once its own range is exhausted.
+  WorkStealing = 2,
+};
+
+class ThreadPool {
+public:
+  using Task = std::function<void(int)>;
+
+  // The pool of the process. Defined once, in the runtime library
+  // (Runtime/Runtime.cpp), so that the launchers and the parallel loops of
+  // the kernels (triton_shared_parallel_for) share the same threads.
+  static ThreadPool &get();
+
+  static int hardwareConcurrency() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : static_cast<int>(n);
+  }
+
+  // Run `task(workerId)` on `numWorkers` workers and block until all of them
+  // returned. Worker 0 is the calling thread; the remaining workers are taken
+  // from the pool, which grows lazily and is never shrunk. With an affinity,
+  // every worker is pinned according to its id (see Runtime/Topology.h); the
+  // calling thread only for the duration of the call.
+  void run(int numWorkers, const Task &task,
+           ThreadAffinity affinity = ThreadAffinity::None) {
+    if (numWorkers <= 1) {
+      task(0);
+      return;
+    }
+
+    // Launches are serialized; a kernel launched from several Python threads
+    // at once simply waits for the previous grid to finish.
+    std::lock_guard<std::mutex> launchLock(launchMutex);
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (static_cast<int>(workers.size()) < numWorkers - 1) {
+        int id = static_cast<int>(workers.size()) + 1;
+        workers.emplace_back([this, id] { workerLoop(id); });
+      }
+      currentTask = &task;
+      currentAffinity = affinity;
+      activeWorkers = numWorkers - 1;
+      pending = numWorkers - 1;
+      generation++;
+    }
+    wakeup.notify_all();
+
+    {
+      ScopedThreadAffinity pin(0, numWorkers, affinity);
+      task(0);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return pending == 0; });
+    currentTask = nullptr;
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+    }
+    wakeup.notify_all();
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+private:
+  ThreadPool() = default;
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  void workerLoop(int id) {
+    uint64_t seenGeneration = 0;
+    // The placement the thread was last pinned for; pinning again is only
+    // needed when the number of workers or the affinity changes.
+    ThreadAffinity pinnedAffinity = ThreadAffinity::None;
+    int pinnedWorkers = 0;
+    while (true) {
+      const Task *task = nullptr;
+      ThreadAffinity affinity;
+      int numWorkers;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        wakeup.wait(lock, [&] {
+          return stop || (generation != seenGeneration && id <= activeWorkers);
+        });
+        if (stop) {
+          return;
+        }
+        seenGeneration = generation;
+        task = currentTask;
+        affinity = currentAffinity;
+        numWorkers = activeWorkers + 1;
+      }
+
+      if (affinity != pinnedAffinity ||
+          (affinity != ThreadAffinity::None && numWorkers != pinnedWorkers)) {
+        CpuTopology::get().pin(id, numWorkers, affinity);
+        pinnedAffinity = affinity;
+        pinnedWorkers = numWorkers;
+      }
+      (*task)(id);
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--pending == 0) {
+        finished.notify_one();
+      }
+    }
+  }
+
+  std::mutex launchMutex;
+  std::mutex mutex;
+  std::condition_variable wakeup;
+  std::condition_variable finished;
+  std::vector<std::thread> workers;
+  const Task *currentTask = nullptr;
+  ThreadAffinity currentAffinity = ThreadAffinity::None;
+  uint64_t generation = 0;
+  int activeWorkers = 0;
+  int pending = 0;
+  bool stop = false;
+};
+
+// The chunks of program ids handed out by the chunked schedule. Without
+// thread affinity, all the workers take chunks from a single counter. With it,
+// the program ids are first split among the NUMA nodes of the workers, into
+// the ranges the static schedule gives the workers of each node, and workers
+// take the chunks of their own node before helping the other nodes.
+class ChunkQueue {
+public:
+  ChunkQueue(int64_t numPrograms, int numWorkers, ThreadAffinity affinity)
+      : chunk(std::max<int64_t>(1, numPrograms / (numWorkers * 8))),
+        groups(new Group[numWorkers]), groupOfWorker(numWorkers) {
+    const CpuTopology &topology = CpuTopology::get();
+    int first = 0;
+    for (int worker = 1; worker <= numWorkers; worker++) {
+      if (worker < numWorkers &&
+          (affinity == ThreadAffinity::None ||
+           topology.nodeOfWorker(worker, numWorkers) ==
+               topology.nodeOfWorker(first, numWorkers))) {
+        continue;
+      }
+      groups[numGroups].next.store(numPrograms * first / numWorkers,
+                                   std::memory_order_relaxed);
+      groups[numGroups].end = numPrograms * worker / numWorkers;
+      std::fill(groupOfWorker.begin() + first, groupOfWorker.begin() + worker,
+                numGroups);
+      numGroups++;
+      first = worker;
+    }
+  }
+
+  // Take the next chunk [begin, end) for `worker`. Return false once all the
+  // program ids were handed out.
+  bool next(int worker, int64_t &begin, int64_t &end) {
+    int own = groupOfWorker[worker];
+    for (int i = 0; i < numGroups; i++) {
+      Group &group = groups[(own + i) % numGroups];
+      int64_t start = group.next.fetch_add(chunk, std::memory_order_relaxed);
+      if (start < group.end) {
+        begin = start;
+        end = std::min(start + chunk, group.end);
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  struct Group {
+    std::atomic<int64_t> next{0};
+    int64_t end = 0;
+  };
+
+  int64_t chunk;
+  std::unique_ptr<Group[]> groups;
+  int numGroups = 0;
+  std::vector<int> groupOfWorker;
+};
+
+// Invoke `body(pid)` for every pid in [0, numPrograms) using up to
+// `numThreads` threads (0 means one thread per hardware thread), placed
+// according to `affinity`.
+template <typename Body>
+void parallelFor(int64_t numPrograms, int numThreads, LaunchSchedule schedule,
+                 ThreadAffinity affinity, const Body &body) {
+  if (numThreads <= 0) {
+    numThreads = ThreadPool::hardwareConcurrency();
+  }
+  int numWorkers =
+      static_cast<int>(std::min<int64_t>(numThreads, numPrograms));
+
+  if (numWorkers <= 1) {
+    for (int64_t pid = 0; pid < numPrograms; pid++) {
+      body(pid);
+    }
+    return;
+  }
+
+  switch (schedule) {
+  case LaunchSchedule::Static: {
+    ThreadPool::get().run(
+        numWorkers,
+        [&](int worker) {
+          int64_t begin = numPrograms * worker / numWorkers;
+          int64_t end = numPrograms * (worker + 1) / numWorkers;
+          for (int64_t pid = begin; pid < end; pid++) {
+            body(pid);
+          }
+        },
+        affinity);
+    break;
+  }
+  case LaunchSchedule::Chunked: {
+    // Handing out several chunks per worker evens out imbalance between
+    // programs while keeping the traffic on the shared counters low.
+    ChunkQueue queue(numPrograms, numWorkers, affinity);
+    ThreadPool::get().run(
+        numWorkers,
+        [&](int worker) {
+          int64_t begin, end;
+          while (queue.next(worker, begin, end)) {
+            for (int64_t pid = begin; pid < end; pid++) {
+              body(pid);
+            }
+          }
+        },
+        affinity);
+    break;
+  }
+  case LaunchSchedule::WorkStealing: {
+    struct Range {
+      std::mutex mutex;
+      int64_t begin;
+      int64_t end;
+    };
+    std::unique_ptr<Range[]> ranges(new Range[numWorkers]);
+    for (int i = 0; i < numWorkers; i++) {
+      ranges[i].begin = numPrograms * i / numWorkers;
+      ranges[i].end = numPrograms * (i + 1) / numWorkers;
+    }
+
+    // Workers of the same node have consecutive ids, so victims are tried
+    // on the node of the thief first.
+    ThreadPool::get().run(
+        numWorkers,
+        [&](int worker) {
+          Range &own = ranges[worker];
+          while (true) {
+            int64_t pid;
+            {
+              std::lock_guard<std::mutex> lock(own.mutex);
+              pid = own.begin < own.end ? own.begin++ : -1;
+            }
+            if (pid >= 0) {
+              body(pid);
+              continue;
+            }
+
+            // Own range is exhausted: steal the back half of a victim's range.
+            // Only one lock is held at a time so that two workers stealing from
+            // each other cannot deadlock.
+            int64_t stolenBegin = 0, stolenEnd = 0;
+            for (int i = 1; i < numWorkers && stolenBegin == stolenEnd; i++) {
+              Range &victim = ranges[(worker + i) % numWorkers];
+              std::lock_guard<std::mutex> victimLock(victim.mutex);
+              int64_t remaining = victim.end - victim.begin;
+              if (remaining <= 0) {
+                continue;
+              }
+              stolenBegin = victim.end - (remaining + 1) / 2;
+              stolenEnd = victim.end;
+              victim.end = stolenBegin;
+            }
+            if (stolenBegin == stolenEnd) {
+              break;
+            }
+            std::lock_guard<std::mutex> lock(own.mutex);
+            own.begin = stolenBegin;
+            own.end = stolenEnd;
+          }
+        },
+        affinity);
+    break;
+  }
+  }
+}
+
+// Invoke `body(begin, end)` on ranges of pids that together cover
+// [0, numPrograms) exactly once, for kernels that loop over the program
+// instances of a range themselves. The static and chunked schedules hand out
+// the same ranges as parallelFor; work stealing hands out single programs.
+template <typename Body>
+void parallelForRanges(int64_t numPrograms, int numThreads,
+                       LaunchSchedule schedule, ThreadAffinity affinity,
+                       const Body &body) {
+  if (numThreads <= 0) {
+    numThreads = ThreadPool::hardwareConcurrency();
+  }
+  int numWorkers =
+      static_cast<int>(std::min<int64_t>(numThreads, numPrograms));
+
+  if (numWorkers <= 1) {
+    body(int64_t(0), numPrograms);
+    return;
+  }
+
+  switch (schedule) {
+  case LaunchSchedule::Static: {
+    ThreadPool::get().run(
+        numWorkers,
+        [&](int worker) {
+          body(numPrograms * worker / numWorkers,
+               numPrograms * (worker + 1) / numWorkers);
+        },
+        affinity);
+    break;
+  }
+  case LaunchSchedule::Chunked: {
+    ChunkQueue queue(numPrograms, numWorkers, affinity);
+    ThreadPool::get().run(
+        numWorkers,
+        [&](int worker) {
+          int64_t begin, end;
+          while (queue.next(worker, begin, end)) {
+            body(begin, end);
+          }
+        },
+        affinity);
+    break;
+  }
+  case LaunchSchedule::WorkStealing: {
+    parallelFor(numPrograms, numThreads, schedule, affinity,
+                [&](int64_t pid) { body(pid, pid + 1); });
+    break;
+  }
+  }
+}
+
+// The threads the parallel loops of the program instances run by the calling
+// thread may use, see triton_shared_parallel_for in Runtime/Runtime.cpp. Set
+// by IntraProgramScope; 1, the default, runs the loops serially.
+struct IntraProgramThreads {
+  int numThreads = 1;
+  ThreadAffinity affinity = ThreadAffinity::None;
+
+  // The setting of the calling thread. Defined in the runtime library, like
+  // ThreadPool::get().
+  static IntraProgramThreads &get();
+};
+
+// Pick between grid-level and intra-program parallelism for a launch of
+// `numPrograms` programs on `numThreads` threads (0 meaning one per hardware
+// thread) of a kernel whose programs have parallel loops. Grids that would
+// leave at least half of the threads idle run their programs one after
+// another on the calling thread, each of them spreading its loops over all
+// the threads; larger grids run one program per thread, their loops serially.
+class IntraProgramScope {
+public:
+  IntraProgramScope(int64_t numPrograms, int numThreads,
+                    ThreadAffinity affinity)
+      : setting(IntraProgramThreads::get()), saved(setting),
+        numGridThreads(numThreads) {
+    if (numThreads <= 0) {
+      numThreads = ThreadPool::hardwareConcurrency();
+    }
+    if (numThreads > 1 && numPrograms * 2 <= numThreads) {
+      setting.numThreads = numThreads;
+      setting.affinity = affinity;
+      numGridThreads = 1;
+    }
+  }
+  ~IntraProgramScope() { setting = saved; }
+  IntraProgramScope(const IntraProgramScope &) = delete;
+  IntraProgramScope &operator=(const IntraProgramScope &) = delete;
+
+  // The number of threads to run the programs of the grid on.
+  int gridThreads() const { return numGridThreads; }
+
+private:
+  IntraProgramThreads &setting;
+  IntraProgramThreads saved;
+  int numGridThreads;
+};
+
+// Invoke `body(begin, end)` on ranges that together cover [0, n) exactly
+// once, one per thread lent to the programs of the calling thread by
+// IntraProgramScope. The parallel loops reached from `body`, on any of these
+// threads, run serially.
+template <typename Body>
+void intraProgramParallelFor(int64_t n, const Body &body) {
+  IntraProgramThreads &setting = IntraProgramThreads::get();
+  int numWorkers = static_cast<int>(std::min<int64_t>(setting.numThreads, n));
+  if (numWorkers <= 1) {
+    if (n > 0) {
+      body(int64_t(0), n);
+    }
+    return;
+  }
+
+  IntraProgramThreads saved = setting;
+  setting.numThreads = 1;
+  ThreadPool::get().run(
+      numWorkers,
+      [&](int worker) {
+        body(n * worker / numWorkers, n * (worker + 1) / numWorkers);
+      },
+      saved.affinity);
+  setting = saved;
+}
+
+} // namespace triton_shared
+
+#endif // TRITON_SHARED_RUNTIME_THREADPOOL_H
@@ -0,0 +1,239 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// NUMA topology of the host and placement of the threads running a grid (see
+// CPUOptions.thread_affinity). The workers of a launch are spread over the
+// NUMA nodes in proportion to the number of cpus of each node, consecutive
+// workers on the same node, so that the contiguous ranges of program ids that
+// the schedules hand out to consecutive workers stay on one node. The
+// topology is read from /sys/devices/system/node on Linux; elsewhere, or if
+// it cannot be read, all cpus form a single node and threads are not pinned.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef TRITON_SHARED_RUNTIME_TOPOLOGY_H
+#define TRITON_SHARED_RUNTIME_TOPOLOGY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace triton_shared {
+
+// Must be kept in sync with _THREAD_AFFINITIES in backend/compiler.py.
+enum class ThreadAffinity : int {
+  // Threads run wherever the operating system schedules them.
+  None = 0,
+  // Each worker is pinned to the cpus of its NUMA node.
+  Numa = 1,
+  // Each worker is pinned to a single cpu, in the order of the nodes.
+  Cores = 2,
+};
+
+class CpuTopology {
+public:
+  static const CpuTopology &get() {
+    static CpuTopology topology;
+    return topology;
+  }
+
+  // The cpus the process may run on, grouped by NUMA node. Nodes without any
+  // such cpu are left out.
+  const std::vector<std::vector<int>> &nodes() const { return nodeCpus; }
+
+  int numCpus() const { return static_cast<int>(cpus.size()); }
+
+  // Index in nodes() of the node of worker `worker` out of `numWorkers`.
+  int nodeOfWorker(int worker, int numWorkers) const {
+    if (nodeCpus.size() <= 1) {
+      return 0;
+    }
+    return cpuNode[slot(worker, numWorkers)];
+  }
+
+  // Pin the calling thread as worker `worker` out of `numWorkers`, or let it
+  // run on any cpu of the process with ThreadAffinity::None. Return false if
+  // the affinity of the thread could not be set.
+  bool pin(int worker, int numWorkers, ThreadAffinity affinity) const {
+#if defined(__linux__)
+    if (cpus.empty()) {
+      return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    switch (affinity) {
+    case ThreadAffinity::None:
+      for (int cpu : cpus) {
+        CPU_SET(cpu, &set);
+      }
+      break;
+    case ThreadAffinity::Numa:
+      for (int cpu : nodeCpus[nodeOfWorker(worker, numWorkers)]) {
+        CPU_SET(cpu, &set);
+      }
+      break;
+    case ThreadAffinity::Cores:
+      CPU_SET(cpus[slot(worker, numWorkers)], &set);
+      break;
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+  }
+
+private:
+  CpuTopology() {
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+      return;
+    }
+    std::vector<bool> assigned(CPU_SETSIZE, false);
+    for (const auto &node : readNodes()) {
+      std::vector<int> nodeAllowed;
+      for (int cpu : node.second) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed) &&
+            !assigned[cpu]) {
+          assigned[cpu] = true;
+          nodeAllowed.push_back(cpu);
+        }
+      }
+      if (!nodeAllowed.empty()) {
+        nodeCpus.push_back(std::move(nodeAllowed));
+      }
+    }
+    // Cpus missing from sysfs, or all of them without it, form a last node.
+    std::vector<int> rest;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &allowed) && !assigned[cpu]) {
+        rest.push_back(cpu);
+      }
+    }
+    if (!rest.empty()) {
+      nodeCpus.push_back(std::move(rest));
+    }
+    for (size_t node = 0; node < nodeCpus.size(); node++) {
+      for (int cpu : nodeCpus[node]) {
+        cpus.push_back(cpu);
+        cpuNode.push_back(static_cast<int>(node));
+      }
+    }
+#endif
+  }
+
+  // The cpu, as an index in `cpus`, of worker `worker` out of `numWorkers`:
+  // workers are spread evenly over the cpus, in the order of the nodes.
+  int slot(int worker, int numWorkers) const {
+    return static_cast<int>(static_cast<int64_t>(worker) % numWorkers *
+                            numCpus() / numWorkers);
+  }
+
+#if defined(__linux__)
+  // The cpus of each NUMA node listed in sysfs, by increasing node id.
+  static std::vector<std::pair<int, std::vector<int>>> readNodes() {
+    std::vector<std::pair<int, std::vector<int>>> nodes;
+    const std::string root = "/sys/devices/system/node";
+    DIR *dir = opendir(root.c_str());
+    if (!dir) {
+      return nodes;
+    }
+    while (dirent *entry = readdir(dir)) {
+      int id;
+      char rest;
+      if (std::sscanf(entry->d_name, "node%d%c", &id, &rest) != 1) {
+        continue;
+      }
+      std::string path = root + "/" + entry->d_name + "/cpulist";
+      if (FILE *file = std::fopen(path.c_str(), "r")) {
+        nodes.emplace_back(id, parseCpuList(file));
+        std::fclose(file);
+      }
+    }
+    closedir(dir);
+    std::sort(nodes.begin(), nodes.end());
+    return nodes;
+  }
+
+  // Parse a cpu list such as "0-15,32-47".
+  static std::vector<int> parseCpuList(FILE *file) {
+    std::vector<int> result;
+    int first, last;
+    while (std::fscanf(file, "%d", &first) == 1) {
+      last = first;
+      int c = std::fgetc(file);
+      if (c == '-') {
+        if (std::fscanf(file, "%d", &last) != 1) {
+          break;
+        }
+        c = std::fgetc(file);
+      }
+      for (int cpu = first; cpu <= last; cpu++) {
+        result.push_back(cpu);
+      }
+      if (c != ',') {
+        break;
+      }
+    }
+    return result;
+  }
+#endif
+
+  std::vector<std::vector<int>> nodeCpus;
+  // All the cpus of nodeCpus, in order, and the index of their node.
+  std::vector<int> cpus;
+  std::vector<int> cpuNode;
+};
+
+// Pin the calling thread as worker `worker` out of `numWorkers` for the
+// lifetime of the scope, then restore its previous affinity. Used for the
+// thread that launches a grid, which runs worker 0.
+class ScopedThreadAffinity {
+public:
+  ScopedThreadAffinity(int worker, int numWorkers, ThreadAffinity affinity) {
+#if defined(__linux__)
+    if (affinity == ThreadAffinity::None) {
+      return;
+    }
+    CPU_ZERO(&saved);
+    restore = pthread_getaffinity_np(pthread_self(), sizeof(saved), &saved) ==
+                  0 &&
+              CpuTopology::get().pin(worker, numWorkers, affinity);
+#endif
+  }
+
+  ~ScopedThreadAffinity() {
+#if defined(__linux__)
+    if (restore) {
+      pthread_setaffinity_np(pthread_self(), sizeof(saved), &saved);
+    }
+#endif
+  }
+
+  ScopedThreadAffinity(const ScopedThreadAffinity &) = delete;
+  ScopedThreadAffinity &operator=(const ScopedThreadAffinity &) = delete;
+
+private:
+#if defined(__linux__)
+  cpu_set_t saved;
+#endif
+  bool restore = false;
+};
+
+} // namespace triton_shared
+
+#endif // TRITON_SHARED_RUNTIME_TOPOLOGY_H
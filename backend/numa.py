@@ -0,0 +1,92 @@
+# NUMA placement helpers of the reference CPU backend.
+#
+# With thread_affinity="numa" (or "cores"), the threads running a grid are
+# pinned and spread over the NUMA nodes so that each node runs a contiguous
+# range of program ids, see backend/include/Runtime/Topology.h. Linux backs a
+# page with memory of the node of the thread that first writes it, so outputs
+# should be allocated with empty() below, which touches every page of the new
+# buffer from the node of the threads that will write it:
+#
+#     from triton.backends.triton_shared import numa
+#
+#     output = numa.empty(n, num_threads=0)
+#     kernel[grid](x, output, n, num_threads=0, thread_affinity="numa")
+#
+# This assumes that the programs write consecutive slices of the buffer in the
+# order of their program ids, as elementwise kernels indexed by
+# program_id * BLOCK_SIZE do, and that the launch uses the same num_threads
+# and thread_affinity.
+
+import ctypes
+import functools
+import mmap
+from typing import List
+
+from triton.backends.triton_shared import compiler, driver
+
+
+@functools.lru_cache()
+def _runtime():
+    lib = ctypes.CDLL(driver._runtime_library())
+    lib.triton_shared_cpu_topology.restype = ctypes.c_int32
+    lib.triton_shared_cpu_topology.argtypes = [
+        ctypes.POINTER(ctypes.c_int32),
+        ctypes.POINTER(ctypes.c_int32), ctypes.c_int32
+    ]
+    lib.triton_shared_first_touch.restype = None
+    lib.triton_shared_first_touch.argtypes = [
+        ctypes.c_void_p, ctypes.c_int64, ctypes.c_int64, ctypes.c_int32, ctypes.c_int32
+    ]
+    return lib
+
+
+def topology() -> List[List[int]]:
+    # The cpus the process may run on, grouped by NUMA node, in the order the
+    # threads of a grid are placed on them.
+    lib = _runtime()
+    n = lib.triton_shared_cpu_topology(None, None, 0)
+    cpus = (ctypes.c_int32 * n)()
+    nodes = (ctypes.c_int32 * n)()
+    lib.triton_shared_cpu_topology(cpus, nodes, n)
+    result = []
+    for cpu, node in zip(cpus, nodes):
+        if node == len(result):
+            result.append([])
+        result[node].append(cpu)
+    return result
+
+
+def first_touch(tensor, num_threads=0, thread_affinity="numa", num_programs=None):
+    """Touch every page of the storage of `tensor`, a torch tensor or an
+    object exporting __array_interface__, from the threads of a launch with
+    `num_threads` and `thread_affinity` made of `num_programs` programs (by
+    default one per page of the buffer). Only useful before anything was written
+    to a new buffer; the bytes touched are overwritten."""
+    assert thread_affinity in compiler._THREAD_AFFINITIES, \
+        f"thread_affinity must be one of {list(compiler._THREAD_AFFINITIES.keys())}"
+    if hasattr(tensor, "data_ptr"):
+        ptr = tensor.data_ptr()
+    else:
+        ptr = tensor.__array_interface__["data"][0]
+    nbytes = tensor.nbytes
+    if num_programs is None:
+        num_programs = max(1, (nbytes + mmap.PAGESIZE - 1) // mmap.PAGESIZE)
+    _runtime().triton_shared_first_touch(ptr, nbytes, num_programs, num_threads,
+                                         compiler._THREAD_AFFINITIES[thread_affinity])
+    return tensor
+
+
+def empty(*size, num_threads=0, thread_affinity="numa", num_programs=None, **kwargs):
+    # Like torch.empty(*size, **kwargs), with the pages of the tensor placed
+    # on the nodes of the threads that will write them, see first_touch.
+    import torch
+
+    tensor = torch.empty(*size, **kwargs)
+    return first_touch(tensor, num_threads, thread_affinity, num_programs)
+
+
+def empty_like(other, num_threads=0, thread_affinity="numa", num_programs=None, **kwargs):
+    import torch
+
+    tensor = torch.empty_like(other, **kwargs)
+    return first_touch(tensor, num_threads, thread_affinity, num_programs)
@@ -0,0 +1,306 @@
+# Built-in launch and compile profilers of the reference CPU backend.
+#
+# While enabled, every kernel launch records its wall time and the latency of
+# each of its program instances (see backend/include/Runtime/Profiler.h), and
+# optionally the hardware counters of the threads running them:
+#
+#     from triton.backends.triton_shared import profiler
+#
+#     profiler.enable(counters=True)
+#     kernel[grid](...)
+#     print(profiler.report())
+#
+# Setting TRITON_SHARED_PROFILE=1 (or =counters) enables the profiler when the
+# backend is imported. Hardware counters are read through perf_event_open(2);
+# they are reported as None when the kernel does not allow it, see
+# /proc/sys/kernel/perf_event_paranoid.
+#
+# The compile profiler records, for every kernel compiled while it is enabled,
+# the time and output size of each stage (ttir, ttsharedir, llir, cpuobj and
+# the build of the launcher), and the time and IR growth of each MLIR and LLVM
+# pass. Enable it with enable_compile_profiling(), or with
+# TRITON_SHARED_COMPILE_PROFILE=1, which also prints the report of every
+# compiled kernel to stderr.
+
+import os
+import sys
+import threading
+from collections import deque
+from dataclasses import dataclass, field
+from typing import Dict, List, Optional
+
+# Must be kept in sync with backend/include/Runtime/Profiler.h.
+_COUNTER_NAMES = ("cycles", "instructions", "cache_misses", "branch_misses")
+_NUM_LATENCY_BUCKETS = 48
+
+# Read by the launcher on every launch: 0 when profiling is off, 1 to time the
+# programs and 2 to also read their hardware counters.
+_profile_mode = 0
+
+# Number of launches kept per kernel in KernelProfile.launches.
+_MAX_RECORDED_LAUNCHES = 1024
+
+
+@dataclass
+class LaunchRecord:
+    grid: tuple
+    wall_ns: int
+    num_threads: int
+    num_programs: int
+    program_ns: int
+    max_program_ns: int
+    # Bucket i counts the programs that took [2^i, 2^(i+1)) nanoseconds.
+    latency_histogram: List[int]
+    counters: Optional[Dict[str, int]]
+
+
+@dataclass
+class KernelProfile:
+    name: str
+    num_launches: int = 0
+    wall_ns: int = 0
+    num_programs: int = 0
+    program_ns: int = 0
+    max_program_ns: int = 0
+    latency_histogram: List[int] = field(default_factory=lambda: [0] * _NUM_LATENCY_BUCKETS)
+    counters: Optional[Dict[str, int]] = None
+    # The most recent launches, oldest first.
+    launches: deque = field(default_factory=lambda: deque(maxlen=_MAX_RECORDED_LAUNCHES))
+
+    def latency_percentile(self, q: float) -> int:
+        # Upper bound, in nanoseconds, of the latency of the fraction `q` of
+        # the fastest program instances.
+        total = sum(self.latency_histogram)
+        if total == 0:
+            return 0
+        seen = 0
+        for i, count in enumerate(self.latency_histogram):
+            seen += count
+            if seen >= q * total:
+                return 2**(i + 1)
+        return 2**_NUM_LATENCY_BUCKETS
+
+
+_lock = threading.Lock()
+_profiles: Dict[str, KernelProfile] = {}
+
+
+def enable(counters: bool = False):
+    global _profile_mode
+    _profile_mode = 2 if counters else 1
+
+
+def disable():
+    global _profile_mode
+    _profile_mode = 0
+
+
+def is_enabled() -> bool:
+    return _profile_mode != 0
+
+
+def reset():
+    with _lock:
+        _profiles.clear()
+
+
+def get_profiles() -> Dict[str, KernelProfile]:
+    # Snapshot of the profiles recorded so far, keyed by kernel name.
+    with _lock:
+        return dict(_profiles)
+
+
+def _record(kernel_name, grid, result):
+    record = LaunchRecord(
+        grid=grid,
+        wall_ns=result["wall_ns"],
+        num_threads=result["num_threads"],
+        num_programs=result["num_programs"],
+        program_ns=result["program_ns"],
+        max_program_ns=result["max_program_ns"],
+        latency_histogram=result["latency_histogram"],
+        counters=dict(zip(_COUNTER_NAMES, result["counters"])) if result["counters"] is not None else None,
+    )
+    with _lock:
+        profile = _profiles.get(kernel_name)
+        if profile is None:
+            profile = _profiles[kernel_name] = KernelProfile(kernel_name)
+        profile.num_launches += 1
+        profile.wall_ns += record.wall_ns
+        profile.num_programs += record.num_programs
+        profile.program_ns += record.program_ns
+        profile.max_program_ns = max(profile.max_program_ns, record.max_program_ns)
+        for i, count in enumerate(record.latency_histogram):
+            profile.latency_histogram[i] += count
+        if record.counters is not None:
+            if profile.counters is None:
+                profile.counters = dict.fromkeys(_COUNTER_NAMES, 0)
+            for name, value in record.counters.items():
+                profile.counters[name] += value
+        profile.launches.append(record)
+
+
+def report() -> str:
+    # One line per kernel, slowest first.
+    lines = [
+        f"{'kernel':<40} {'launches':>8} {'total ms':>10} {'mean us':>10} {'programs':>10} "
+        f"{'p50 us':>8} {'p99 us':>8} {'max us':>8} {'IPC':>6} {'LLC miss/prog':>14}"
+    ]
+    profiles = sorted(get_profiles().values(), key=lambda p: p.wall_ns, reverse=True)
+    for p in profiles:
+        ipc = ""
+        misses = ""
+        if p.counters is not None and p.counters["cycles"] > 0:
+            ipc = f"{p.counters['instructions'] / p.counters['cycles']:.2f}"
+            misses = f"{p.counters['cache_misses'] / max(p.num_programs, 1):.1f}"
+        lines.append(f"{p.name[:40]:<40} {p.num_launches:>8} {p.wall_ns / 1e6:>10.3f} "
+                     f"{p.wall_ns / max(p.num_launches, 1) / 1e3:>10.1f} {p.num_programs:>10} "
+                     f"{p.latency_percentile(0.5) / 1e3:>8.1f} {p.latency_percentile(0.99) / 1e3:>8.1f} "
+                     f"{p.max_program_ns / 1e3:>8.1f} {ipc:>6} {misses:>14}")
+    return "\n".join(lines)
+
+
+@dataclass
+class StageRecord:
+    stage: str
+    seconds: float
+    # Lines of the textual output of the stage, 0 for the object file.
+    output_lines: int
+    # Served from the stage cache, see _cached_stage in compiler.py.
+    cached: bool = False
+
+
+@dataclass
+class PassRecord:
+    stage: str
+    name: str
+    # Nesting depth of the pass: passes run by a pass of depth 0 (e.g. the
+    # pipeline of triton-to-linalg-experimental) have depth 1. LLVM passes are
+    # summed over all the functions they ran on.
+    depth: int
+    seconds: float
+    # Number of operations (MLIR) before and after the pass, -1 if unknown.
+    ops_before: int = -1
+    ops_after: int = -1
+    runs: int = 1
+
+
+@dataclass
+class CompileProfile:
+    kernel: str = ""
+    stages: List[StageRecord] = field(default_factory=list)
+    passes: List[PassRecord] = field(default_factory=list)
+    # Stages served from the stage cache, until their record is added.
+    _cached_stages: set = field(default_factory=set, repr=False)
+
+    @property
+    def seconds(self) -> float:
+        return sum(stage.seconds for stage in self.stages)
+
+
+_compile_profiling = False
+_print_compile_profiles = False
+_compile_profiles: Dict[str, List[CompileProfile]] = {}
+# Profile of the kernel being compiled by the current thread; the stages of a
+# kernel run one after another on the thread that called triton.compile.
+_current_compile = threading.local()
+
+
+def enable_compile_profiling():
+    global _compile_profiling
+    _compile_profiling = True
+
+
+def disable_compile_profiling():
+    global _compile_profiling
+    _compile_profiling = False
+
+
+def is_compile_profiling_enabled() -> bool:
+    return _compile_profiling
+
+
+def get_compile_profiles() -> Dict[str, List[CompileProfile]]:
+    # Profiles of the kernels compiled so far, keyed by kernel name, oldest
+    # compilation first.
+    with _lock:
+        return {name: list(profiles) for name, profiles in _compile_profiles.items()}
+
+
+def reset_compile_profiles():
+    with _lock:
+        _compile_profiles.clear()
+
+
+def _begin_compile():
+    _current_compile.profile = CompileProfile()
+
+
+def _current_compile_profile() -> Optional[CompileProfile]:
+    return getattr(_current_compile, "profile", None)
+
+
+def _record_stage(stage, seconds, output_lines):
+    profile = _current_compile_profile()
+    if profile is not None:
+        cached = stage in profile._cached_stages
+        profile._cached_stages.discard(stage)
+        profile.stages.append(StageRecord(stage, seconds, output_lines, cached))
+
+
+def _record_passes(stage, records):
+    # `records` are (name, depth, seconds[, ops_before, ops_after[, runs]]).
+    profile = _current_compile_profile()
+    if profile is not None:
+        profile.passes.extend(PassRecord(stage, *record) for record in records)
+
+
+def _note_cached_stage(stage):
+    profile = _current_compile_profile()
+    if profile is not None:
+        profile._cached_stages.add(stage)
+
+
+def _end_compile(kernel_name):
+    profile = _current_compile_profile()
+    _current_compile.profile = None
+    if profile is None:
+        return
+    profile.kernel = kernel_name
+    with _lock:
+        _compile_profiles.setdefault(kernel_name, []).append(profile)
+    if _print_compile_profiles:
+        print(compile_report(profile), file=sys.stderr)
+
+
+def _record_launcher_build(kernel_name, seconds):
+    # The launcher is built on the first launch of a kernel, after the
+    # compilation itself; it is added to the latest profile of the kernel.
+    with _lock:
+        profiles = _compile_profiles.get(kernel_name)
+        if profiles:
+            profiles[-1].stages.append(StageRecord("launcher", seconds, 0))
+
+
+def compile_report(profile: CompileProfile, max_passes: int = 15) -> str:
+    lines = [f"compile profile of {profile.kernel}: {profile.seconds:.3f} s"]
+    for stage in profile.stages:
+        cached = " (cached)" if stage.cached else ""
+        lines.append(f"  {stage.stage:<12} {stage.seconds:>9.3f} s {stage.output_lines:>8} lines{cached}")
+    if profile.passes:
+        lines.append("  slowest passes:")
+        for p in sorted(profile.passes, key=lambda p: p.seconds, reverse=True)[:max_passes]:
+            growth = f"{p.ops_before:>7} -> {p.ops_after:<7} ops" if p.ops_before >= 0 else f"{p.runs:>7} runs"
+            lines.append(f"    {p.stage:<10} {'  ' * p.depth + p.name:<48} {p.seconds:>9.4f} s  {growth}")
+    return "\n".join(lines)
+
+
+if os.getenv("TRITON_SHARED_COMPILE_PROFILE", "0") == "1":
+    enable_compile_profiling()
+    _print_compile_profiles = True
+
+_env = os.getenv("TRITON_SHARED_PROFILE", "0")
+if _env == "counters":
+    enable(counters=True)
+elif _env == "1":
+    enable()
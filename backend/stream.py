@@ -0,0 +1,195 @@
+# Asynchronous streams and launch graphs of the reference CPU backend.
+#
+# By default a kernel launch blocks until all the programs of its grid
+# finished. Launches issued while a Stream is current are queued instead, and
+# run in order by a worker thread of the stream, so that Python can prepare
+# the next launches, or run other work, in the meantime:
+#
+#     from triton.backends.triton_shared import stream as cpu_stream
+#
+#     s = cpu_stream.Stream()
+#     with s:
+#         kernel_a[grid](x, y)
+#         kernel_b[grid](y, z)
+#     event = s.record_event()  # a concurrent.futures.Future
+#     ...
+#     s.synchronize()
+#
+# A Graph records the launches issued while it captures, with their arguments
+# bound, and replays all of them in a single native call, like a CUDA graph:
+#
+#     g = cpu_stream.Graph()
+#     with g.capture():
+#         kernel_a[grid](x, y)
+#         kernel_b[grid](y, z)
+#     g.replay()
+#
+# As with CUDA streams, the caller must synchronize before reading the results
+# of queued launches or modifying their arguments; the tensors passed to a
+# launch are kept alive until it ran (or as long as the graph, for captured
+# launches). Queued and captured launches are neither reported to the launch
+# hooks nor profiled.
+
+import threading
+from collections import deque
+from concurrent.futures import Future
+
+_current = threading.local()
+
+
+def current_stream():
+    # The innermost Stream or capturing Graph of the calling thread, or None.
+    stack = getattr(_current, "stack", None)
+    return stack[-1] if stack else None
+
+
+def _push(stream):
+    if not hasattr(_current, "stack"):
+        _current.stack = []
+    _current.stack.append(stream)
+
+
+def _pop(stream):
+    assert current_stream() is stream, "streams must be exited in the reverse order they were entered"
+    _current.stack.pop()
+
+
+class Stream:
+
+    def __init__(self):
+        self._cond = threading.Condition()
+        # Items are (module, bound launch, args) tuples and the futures of
+        # the events recorded between them.
+        self._queue = deque()
+        # Whether the worker thread runs; it exits once the queue is empty.
+        self._running = False
+        self._error = None
+
+    def __enter__(self):
+        _push(self)
+        return self
+
+    def __exit__(self, *exc):
+        _pop(self)
+        return False
+
+    def _submit(self, module, bound, args):
+        with self._cond:
+            self._raise_error()
+            self._queue.append((module, bound, args))
+            if not self._running:
+                self._running = True
+                threading.Thread(target=self._worker, name="triton_shared-stream", daemon=True).start()
+
+    def record_event(self) -> Future:
+        # A future whose result is set to None once all the launches queued
+        # so far ran.
+        future = Future()
+        with self._cond:
+            if self._running:
+                self._queue.append(future)
+                return future
+            error = self._error
+        if error is not None:
+            future.set_exception(error)
+        else:
+            future.set_result(None)
+        return future
+
+    def synchronize(self):
+        # Block until all the launches queued so far ran. Raise the error of
+        # a failed launch, once.
+        self.record_event().exception()
+        with self._cond:
+            self._raise_error()
+
+    def query(self) -> bool:
+        # Whether all the launches queued so far ran.
+        with self._cond:
+            return not self._running
+
+    def _raise_error(self):
+        if self._error is not None:
+            error, self._error = self._error, None
+            raise error
+
+    def _worker(self):
+        while True:
+            with self._cond:
+                if not self._queue:
+                    self._running = False
+                    return
+                batch = list(self._queue)
+                self._queue.clear()
+            # Consecutive launches run in one native call. run_bound of any
+            # launcher module can run the launches of any kernel.
+            launches = []
+            for item in batch + [None]:
+                if isinstance(item, tuple):
+                    launches.append(item)
+                    continue
+                if launches:
+                    try:
+                        launches[0][0].run_bound([bound for _, bound, _ in launches])
+                    except Exception as e:
+                        with self._cond:
+                            self._error = e
+                    launches = []
+                if isinstance(item, Future):
+                    with self._cond:
+                        error = self._error
+                    if error is not None:
+                        item.set_exception(error)
+                    else:
+                        item.set_result(None)
+
+
+class Graph:
+
+    def __init__(self):
+        # (module, bound launch, args) tuples, in the order of the launches.
+        self._launches = []
+        self._capturing = False
+
+    def __len__(self):
+        return len(self._launches)
+
+    def capture(self):
+        # Context manager recording, instead of running, the launches issued
+        # by this thread; launches captured before are kept.
+        return _Capture(self)
+
+    def _submit(self, module, bound, args):
+        self._launches.append((module, bound, args))
+
+    def replay(self, stream=None):
+        # Run the captured launches in order, with the arguments they were
+        # captured with. Block until they ran, or queue them on `stream`.
+        assert not self._capturing, "cannot replay a graph while it captures"
+        if not self._launches:
+            return
+        if stream is not None:
+            for launch in self._launches:
+                stream._submit(*launch)
+            return
+        self._launches[0][0].run_bound([bound for _, bound, _ in self._launches])
+
+    def reset(self):
+        self._launches.clear()
+
+
+class _Capture:
+
+    def __init__(self, graph):
+        self._graph = graph
+
+    def __enter__(self):
+        assert not self._graph._capturing, "graph is already capturing"
+        self._graph._capturing = True
+        _push(self._graph)
+        return self._graph
+
+    def __exit__(self, *exc):
+        _pop(self._graph)
+        self._graph._capturing = False
+        return False
@@ -0,0 +1,101 @@
+# Compile-time benchmark of the pointer analysis.
+#
+# Generates kernels doing `n` loads and stores through offsets that share a
+# common expression DAG, as the unrolled or hand-written kernels of real
+# workloads do, and reports the time triton-shared-opt takes to run a pass
+# pipeline on them for each `n`:
+#
+#     TRITON_SHARED_OPT_PATH=.../triton-shared-opt python benchmarks/compile_time.py
+#     python benchmarks/compile_time.py --sizes 64,256,1024 --pass-pipeline=--triton-to-linalg-experimental --json results.json
+#
+# The time of a pass whose cost is linear in the size of the kernel grows
+# linearly with `n`; see the `per_op_us` column.
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).resolve().parent))
+
+import harness  # noqa: E402
+
+
+def chained_offsets_kernel(n, block=64):
+    # A kernel copying `n` tiles of arg0 to arg1, the offsets of tile i + 1
+    # being those of tile i plus a constant: visiting the offsets of tile i
+    # visits the offsets of all the tiles before it.
+    lines = [
+        "module {",
+        "  tt.func public @chained_offsets(%arg0: !tt.ptr<f32>, %arg1: !tt.ptr<f32>, %arg2: i32) {",
+        f"    %step = arith.constant {block} : i32",
+        f"    %range = tt.make_range {{end = {block} : i32, start = 0 : i32}} : tensor<{block}xi32>",
+        f"    %rows = tt.expand_dims %range {{axis = 1 : i32}} : tensor<{block}xi32> -> tensor<{block}x1xi32>",
+        f"    %stride = tt.splat %arg2 : i32 -> tensor<{block}x1xi32>",
+        f"    %row_offsets = arith.muli %rows, %stride : tensor<{block}x1xi32>",
+        f"    %cols = tt.expand_dims %range {{axis = 0 : i32}} : tensor<{block}xi32> -> tensor<1x{block}xi32>",
+        f"    %row_tile = tt.broadcast %row_offsets : tensor<{block}x1xi32> -> tensor<{block}x{block}xi32>",
+        f"    %col_tile = tt.broadcast %cols : tensor<1x{block}xi32> -> tensor<{block}x{block}xi32>",
+        f"    %offsets_0 = arith.addi %row_tile, %col_tile : tensor<{block}x{block}xi32>",
+        f"    %steps = tt.splat %step : i32 -> tensor<{block}x{block}xi32>",
+        f"    %src = tt.splat %arg0 : !tt.ptr<f32> -> tensor<{block}x{block}x!tt.ptr<f32>>",
+        f"    %dst = tt.splat %arg1 : !tt.ptr<f32> -> tensor<{block}x{block}x!tt.ptr<f32>>",
+    ]
+    tile = f"tensor<{block}x{block}x!tt.ptr<f32>>"
+    for i in range(n):
+        lines += [
+            f"    %offsets_{i + 1} = arith.addi %offsets_{i}, %steps : tensor<{block}x{block}xi32>",
+            f"    %src_{i} = tt.addptr %src, %offsets_{i + 1} : {tile}, tensor<{block}x{block}xi32>",
+            f"    %value_{i} = tt.load %src_{i} : {tile}",
+            f"    %dst_{i} = tt.addptr %dst, %offsets_{i + 1} : {tile}, tensor<{block}x{block}xi32>",
+            f"    tt.store %dst_{i}, %value_{i} : {tile}",
+        ]
+    lines += ["    tt.return", "  }", "}", ""]
+    return "\n".join(lines)
+
+
+def time_pass(opt_path, src_path, pipeline, reps):
+    # Minimum wall time, in seconds, of `reps` runs of triton-shared-opt.
+    times = []
+    for _ in range(reps):
+        t0 = time.perf_counter()
+        subprocess.check_call([opt_path, src_path, *pipeline, "-o", os.devnull])
+        times.append(time.perf_counter() - t0)
+    return min(times)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compile-time benchmark of the pointer analysis.")
+    parser.add_argument("--sizes", default="16,64,256,1024", help="comma-separated numbers of loads and stores")
+    parser.add_argument("--block", type=int, default=64, help="size of the square tiles")
+    parser.add_argument("--pass-pipeline", action="append", default=None,
+                        help="triton-shared-opt pass argument, may be repeated (default: --triton-to-structured)")
+    parser.add_argument("--reps", type=int, default=3)
+    parser.add_argument("--json", help="write the results and the machine info to this file")
+    args = parser.parse_args()
+
+    opt_path = os.getenv("TRITON_SHARED_OPT_PATH", "")
+    if opt_path == "":
+        raise Exception("TRITON_SHARED_OPT_PATH is not set.")
+    pipeline = args.pass_pipeline or ["--triton-to-structured"]
+
+    results = []
+    print(f"{'n':>6} {'seconds':>9} {'per_op_us':>10}")
+    with tempfile.TemporaryDirectory() as tmpdir:
+        for n in (int(s) for s in args.sizes.split(",")):
+            src_path = os.path.join(tmpdir, f"chained_offsets_{n}.ttir")
+            Path(src_path).write_text(chained_offsets_kernel(n, args.block))
+            seconds = time_pass(opt_path, src_path, pipeline, args.reps)
+            results.append({"n": n, "block": args.block, "pipeline": pipeline, "seconds": seconds})
+            print(f"{n:>6} {seconds:>9.3f} {seconds / n * 1e6:>10.1f}")
+
+    if args.json:
+        Path(args.json).write_text(json.dumps({"machine": harness.machine_info(), "results": results}, indent=2))
+
+
+if __name__ == "__main__":
+    main()
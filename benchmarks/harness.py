@@ -0,0 +1,138 @@
+# Timing, roofline and reporting helpers shared by the benchmarks in run.py.
+
+import os
+import platform
+import statistics
+import time
+from dataclasses import asdict, dataclass, field
+from typing import Callable, Dict, List, Optional
+
+import numpy as np
+
+
+@dataclass
+class Measurement:
+    median_us: float
+    min_us: float
+    reps: int
+
+
+def measure(fn: Callable[[], object], min_time_s: float = 0.2, min_reps: int = 5, warmup: int = 2) -> Measurement:
+    # Warm-launch time: run `fn` until both `min_reps` runs and `min_time_s`
+    # seconds have been measured, after `warmup` untimed runs.
+    for _ in range(warmup):
+        fn()
+    times = []
+    start = time.perf_counter()
+    while len(times) < min_reps or time.perf_counter() - start < min_time_s:
+        t0 = time.perf_counter()
+        fn()
+        times.append(time.perf_counter() - t0)
+    return Measurement(statistics.median(times) * 1e6, min(times) * 1e6, len(times))
+
+
+def time_first_call(fn: Callable[[], object]) -> float:
+    # Time, in seconds, of the first call of `fn`. For a kernel that was not
+    # compiled yet in this process and cache directory, this is dominated by
+    # the compilation and the build of its launcher.
+    t0 = time.perf_counter()
+    fn()
+    return time.perf_counter() - t0
+
+
+@dataclass
+class Roofline:
+    # Peak f32 compute throughput and memory bandwidth of the machine.
+    peak_gflops: float
+    peak_gbs: float
+    measured: bool
+
+    def attainable_gflops(self, flops: float, nbytes: float) -> float:
+        if nbytes == 0:
+            return self.peak_gflops
+        return min(self.peak_gflops, flops / nbytes * self.peak_gbs)
+
+
+def measure_roofline() -> Roofline:
+    # Approximate the roofline with NumPy: a large BLAS sgemm for compute and
+    # a copy much larger than the last-level cache for bandwidth.
+    n = 2048
+    a = np.random.rand(n, n).astype(np.float32)
+    b = np.random.rand(n, n).astype(np.float32)
+    gemm = measure(lambda: a @ b, min_time_s=0.5)
+    src = np.ones(64 * 1024 * 1024 // 4, dtype=np.float32)
+    dst = np.empty_like(src)
+    copy = measure(lambda: np.copyto(dst, src), min_time_s=0.5)
+    return Roofline(peak_gflops=2 * n**3 / (gemm.min_us * 1e3), peak_gbs=2 * src.nbytes / (copy.min_us * 1e3),
+                    measured=True)
+
+
+@dataclass
+class Result:
+    benchmark: str
+    dtype: str
+    shape: List[int]
+    flops: float
+    bytes: float
+    first_call_s: float
+    warm: Measurement
+    gflops: float
+    gbs: float
+    roofline_fraction: float
+    baselines: Dict[str, Dict[str, float]] = field(default_factory=dict)
+    error: Optional[str] = None
+    # The num_threads the case was run with by --threads, if any.
+    num_threads: Optional[int] = None
+    # The grid_order the case was run with by --grid-orders, if any.
+    grid_order: Optional[str] = None
+
+
+def make_result(benchmark, dtype, shape, flops, nbytes, first_call_s, warm, roofline, baselines):
+    seconds = warm.median_us * 1e-6
+    gflops = flops / seconds / 1e9
+    gbs = nbytes / seconds / 1e9
+    attainable = roofline.attainable_gflops(flops, nbytes)
+    # Kernels without floating-point work are judged against the bandwidth.
+    fraction = gflops / attainable if flops > 0 else gbs / roofline.peak_gbs
+    return Result(benchmark, dtype, list(shape), flops, nbytes, first_call_s, warm, gflops, gbs, fraction, baselines)
+
+
+def baseline_entry(warm: Measurement, flops: float, nbytes: float) -> Dict[str, float]:
+    seconds = warm.median_us * 1e-6
+    return {"median_us": warm.median_us, "gflops": flops / seconds / 1e9, "gbs": nbytes / seconds / 1e9}
+
+
+def machine_info() -> Dict[str, object]:
+    return {
+        "platform": platform.platform(),
+        "machine": platform.machine(),
+        "processor": platform.processor(),
+        "cpu_count": os.cpu_count(),
+        "python": platform.python_version(),
+        "numpy": np.__version__,
+    }
+
+
+def to_json(results: List[Result]) -> List[Dict[str, object]]:
+    return [asdict(r) for r in results]
+
+
+def format_table(results: List[Result]) -> str:
+    lines = [
+        f"{'benchmark':<12} {'dtype':<9} {'shape':<18} {'first s':>8} {'warm us':>10} {'GFLOP/s':>9} {'GB/s':>8} "
+        f"{'roofline':>8} {'numpy us':>10} {'torch us':>10}"
+    ]
+    for r in results:
+        shape = "x".join(str(s) for s in r.shape)
+        name = r.benchmark if r.num_threads is None else f"{r.benchmark}@{r.num_threads}"
+        name = name if r.grid_order is None else f"{name}/{r.grid_order}"
+        if r.error is not None:
+            lines.append(f"{name:<12} {r.dtype:<9} {shape:<18} failed: {r.error}")
+            continue
+        numpy_us = r.baselines.get("numpy", {}).get("median_us")
+        torch_us = r.baselines.get("torch", {}).get("median_us")
+        lines.append(f"{name:<12} {r.dtype:<9} {shape:<18} {r.first_call_s:>8.2f} {r.warm.median_us:>10.1f} "
+                     f"{r.gflops:>9.2f} {r.gbs:>8.2f} {r.roofline_fraction:>7.1%} "
+                     f"{numpy_us if numpy_us is not None else float('nan'):>10.1f} "
+                     f"{torch_us if torch_us is not None else float('nan'):>10.1f}")
+    return "\n".join(lines)
@@ -0,0 +1,410 @@
+# Throughput benchmarks of the reference CPU backend.
+#
+# Runs the kernels of python/examples over several sizes and dtypes and
+# reports, for each case, the time of the first (compiling) call, the warm
+# launch time, the achieved GFLOP/s and GB/s, the fraction of the roofline of
+# the machine, and the time of the equivalent NumPy and torch (oneDNN / MKL
+# backed) operations:
+#
+#     python benchmarks/run.py --json results.json
+#     python benchmarks/run.py --benchmarks matmul,softmax --option vectorize=True --option num_threads=0
+#     python benchmarks/run.py --benchmarks histogram --threads 1,2,4,8
+#     python benchmarks/run.py --benchmarks matmul_2d --threads 0 --grid-orders row_major,grouped,morton,hilbert
+#
+# Kernels are compiled into a fresh cache directory unless --keep-cache is
+# given, so that first_call_s measures a cold compile.
+
+import argparse
+import ast
+import itertools
+import json
+import os
+import sys
+import tempfile
+import traceback
+from pathlib import Path
+
+import numpy as np
+import torch
+
+sys.path.insert(0, str(Path(__file__).resolve().parent.parent / "python" / "examples"))
+sys.path.insert(0, str(Path(__file__).resolve().parent))
+
+import harness  # noqa: E402
+
+_DTYPES = {"float32": torch.float32, "float16": torch.float16, "bfloat16": torch.bfloat16, "int32": torch.int32}
+
+
+def _numpy(t):
+    # NumPy has no bfloat16, its baselines run in float32.
+    return t.float().numpy() if t.dtype == torch.bfloat16 else t.numpy()
+
+
+class Benchmark:
+    # Subclasses describe one kernel: the cases it runs, how to launch it with
+    # the compilation options given on the command line, its floating-point
+    # work and memory traffic, and its baselines.
+    name = ""
+    dtypes = ("float32", )
+
+    def shapes(self, quick):
+        raise NotImplementedError
+
+    def setup(self, shape, dtype):
+        raise NotImplementedError
+
+    def launch(self, data, options):
+        raise NotImplementedError
+
+    def work(self, shape, dtype):
+        # (flops, bytes) of one launch.
+        raise NotImplementedError
+
+    def baselines(self, data):
+        return {}
+
+
+class VecAdd(Benchmark):
+    name = "vec_add"
+    dtypes = ("float32", "float16")
+
+    def shapes(self, quick):
+        return [(1 << 16, ), (1 << 20, )] if quick else [(1 << 16, ), (1 << 20, ), (1 << 24, )]
+
+    def setup(self, shape, dtype):
+        x = torch.rand(shape, dtype=dtype)
+        y = torch.rand(shape, dtype=dtype)
+        return x, y, torch.empty_like(x)
+
+    def launch(self, data, options):
+        from test_vec_add import add_kernel
+        import triton
+        x, y, out = data
+        n = out.numel()
+        add_kernel[(triton.cdiv(n, 1024), )](x, y, out, n, BLOCK_SIZE=1024, **options)
+
+    def work(self, shape, dtype):
+        n = shape[0]
+        return n, 3 * n * dtype.itemsize
+
+    def baselines(self, data):
+        x, y, out = data
+        xn, yn = _numpy(x), _numpy(y)
+        on = np.empty_like(xn)
+        return {"numpy": lambda: np.add(xn, yn, out=on), "torch": lambda: torch.add(x, y, out=out)}
+
+
+class Softmax(Benchmark):
+    name = "softmax"
+
+    def shapes(self, quick):
+        return [(1823, 781)] if quick else [(1823, 781), (4096, 1024), (1024, 4096)]
+
+    def setup(self, shape, dtype):
+        x = torch.randn(shape, dtype=dtype)
+        return x, torch.empty_like(x)
+
+    def launch(self, data, options):
+        from test_softmax import softmax_kernel
+        import triton
+        x, y = data
+        n_rows, n_cols = x.shape
+        softmax_kernel[(n_rows, )](y, x, x.stride(0), y.stride(0), n_cols, BLOCK_SIZE=triton.next_power_of_2(n_cols),
+                                   **options)
+
+    def work(self, shape, dtype):
+        # max, subtract, exp, sum and divide per element.
+        m, n = shape
+        return 5 * m * n, 2 * m * n * dtype.itemsize
+
+    def baselines(self, data):
+        x, y = data
+        xn = _numpy(x)
+
+        def numpy_softmax():
+            e = np.exp(xn - xn.max(axis=1, keepdims=True))
+            return e / e.sum(axis=1, keepdims=True)
+
+        return {"numpy": numpy_softmax, "torch": lambda: torch.softmax(x, dim=1, out=y)}
+
+
+class LayerNorm(Benchmark):
+    name = "layer_norm"
+    dtypes = ("float32", "float16")
+
+    def shapes(self, quick):
+        return [(1151, 8192)] if quick else [(1151, 8192), (4096, 1024)]
+
+    def setup(self, shape, dtype):
+        m, n = shape
+        x = -2.3 + 0.5 * torch.randn(shape, dtype=dtype)
+        w = torch.rand((n, ), dtype=dtype)
+        b = torch.rand((n, ), dtype=dtype)
+        mean = torch.empty((m, ), dtype=torch.float32)
+        rstd = torch.empty((m, ), dtype=torch.float32)
+        return x, w, b, torch.empty_like(x), mean, rstd
+
+    def launch(self, data, options):
+        from test_layernorm import _layer_norm_fwd_fused
+        import triton
+        x, w, b, y, mean, rstd = data
+        m, n = x.shape
+        block_size = min(65536 // x.element_size(), triton.next_power_of_2(n))
+        _layer_norm_fwd_fused[(m, )](x, y, w, b, mean, rstd, x.stride(0), n, 1e-5, BLOCK_SIZE=block_size, **options)
+
+    def work(self, shape, dtype):
+        # The kernel reads its row three times; only the first read is
+        # counted as memory traffic.
+        m, n = shape
+        return 8 * m * n, (2 * m * n + 2 * n) * dtype.itemsize + 8 * m
+
+    def baselines(self, data):
+        x, w, b, y, _, _ = data
+        xn, wn, bn = _numpy(x), _numpy(w), _numpy(b)
+
+        def numpy_layer_norm():
+            mean = xn.mean(axis=1, keepdims=True)
+            var = ((xn - mean)**2).mean(axis=1, keepdims=True)
+            return (xn - mean) / np.sqrt(var + 1e-5) * wn + bn
+
+        baselines = {"numpy": numpy_layer_norm}
+        if x.dtype == torch.float32:
+            # torch does not implement float16 layer_norm on CPU.
+            baselines["torch"] = lambda: torch.nn.functional.layer_norm(x, (x.shape[1], ), w, b, 1e-5)
+        return baselines
+
+
+class Matmul(Benchmark):
+    name = "matmul"
+    dtypes = ("float32", "float16")
+
+    def shapes(self, quick):
+        return [(256, 256, 256)] if quick else [(256, 256, 256), (512, 512, 512), (1024, 1024, 1024)]
+
+    def setup(self, shape, dtype):
+        m, n, k = shape
+        a = torch.randn((m, k), dtype=dtype)
+        b = torch.randn((k, n), dtype=dtype)
+        return a, b, torch.empty((m, n), dtype=dtype)
+
+    def launch(self, data, options):
+        from test_matmul import matmul_kernel
+        import triton
+        a, b, c = data
+        (m, k), (_, n) = a.shape, b.shape
+        grid = (triton.cdiv(m, 32) * triton.cdiv(n, 64), )
+        matmul_kernel[grid](a, b, c, m, n, k, a.stride(0), a.stride(1), b.stride(0), b.stride(1), c.stride(0),
+                            c.stride(1), ACTIVATION="", BLOCK_SIZE_M=32, BLOCK_SIZE_N=64, BLOCK_SIZE_K=16,
+                            GROUP_SIZE_M=8, **options)
+
+    def work(self, shape, dtype):
+        m, n, k = shape
+        return 2 * m * n * k, (m * k + k * n + m * n) * dtype.itemsize
+
+    def baselines(self, data):
+        a, b, c = data
+        an, bn = _numpy(a), _numpy(b)
+        return {"numpy": lambda: an @ bn, "torch": lambda: torch.matmul(a, b, out=c)}
+
+
+class Matmul2D(Benchmark):
+    # One program per tile of C on a 2-d grid, so that the order in which
+    # the launcher visits the tiles (--grid-orders) decides how the tiles of A
+    # and B are reused from the cache.
+    name = "matmul_2d"
+
+    def shapes(self, quick):
+        return [(512, 512, 512)] if quick else [(512, 512, 512), (1024, 1024, 1024), (2048, 2048, 512)]
+
+    def setup(self, shape, dtype):
+        m, n, k = shape
+        a = torch.randn((m, k), dtype=dtype)
+        b = torch.randn((k, n), dtype=dtype)
+        return a, b, torch.empty((m, n), dtype=dtype)
+
+    def launch(self, data, options):
+        from test_grid_order import matmul_2d
+        matmul_2d(*data, **options)
+
+    def work(self, shape, dtype):
+        m, n, k = shape
+        return 2 * m * n * k, (m * k + k * n + m * n) * dtype.itemsize
+
+    def baselines(self, data):
+        a, b, c = data
+        return {"torch": lambda: torch.matmul(a, b, out=c)}
+
+
+class RowSum(Benchmark):
+    name = "reduce"
+
+    def shapes(self, quick):
+        return [(4096, 1024)] if quick else [(4096, 1024), (16384, 256), (256, 16384)]
+
+    def setup(self, shape, dtype):
+        x = torch.rand(shape, dtype=dtype)
+        return x, torch.empty((shape[0], ), dtype=dtype)
+
+    def launch(self, data, options):
+        from test_reduce import reduce_kernel_2d
+        x, out = data
+        n_rows, n_cols = x.shape
+        reduce_kernel_2d[(n_rows, )](x, out, x.stride(0), n_cols, BLOCK_SIZE=n_cols, **options)
+
+    def work(self, shape, dtype):
+        m, n = shape
+        return m * n, (m * n + m) * dtype.itemsize
+
+    def baselines(self, data):
+        x, out = data
+        xn = _numpy(x)
+        return {"numpy": lambda: xn.sum(axis=1), "torch": lambda: torch.sum(x, dim=1, out=out)}
+
+
+class Histogram(Benchmark):
+    # Atomic adds into a few shared bins; with --threads, shows how the
+    # atomics scale with the number of threads running the grid.
+    name = "histogram"
+    dtypes = ("int32", "float32")
+
+    def shapes(self, quick):
+        # (elements, bins): the fewer bins, the more contention.
+        return [(1 << 20, 256)] if quick else [(1 << 20, 256), (1 << 20, 16), (1 << 22, 4096)]
+
+    def setup(self, shape, dtype):
+        n, num_bins = shape
+        x = torch.randint(0, num_bins, (n, ), dtype=torch.int32)
+        return x, torch.zeros(num_bins, dtype=dtype)
+
+    def launch(self, data, options):
+        from test_atomics import histogram_kernel
+        import triton
+        x, bins = data
+        n = x.numel()
+        histogram_kernel[(triton.cdiv(n, 1024), )](x, bins, n, BLOCK_SIZE=1024, **options)
+
+    def work(self, shape, dtype):
+        n, num_bins = shape
+        return n, n * 4 + 2 * num_bins * dtype.itemsize
+
+    def baselines(self, data):
+        x, bins = data
+        xn = x.numpy()
+        return {
+            "numpy": lambda: np.bincount(xn, minlength=bins.numel()),
+            "torch": lambda: torch.bincount(x, minlength=bins.numel()),
+        }
+
+
+BENCHMARKS = {b.name: b for b in (VecAdd(), Softmax(), LayerNorm(), Matmul(), Matmul2D(), RowSum(), Histogram())}
+
+
+def _parse_options(values):
+    # key=value pairs of compilation / launch options, e.g. vectorize=True.
+    options = {}
+    for value in values:
+        key, _, literal = value.partition("=")
+        try:
+            options[key] = ast.literal_eval(literal)
+        except (ValueError, SyntaxError):
+            options[key] = literal
+    return options
+
+
+def run_case(benchmark, shape, dtype_name, options, roofline, args):
+    dtype = _DTYPES[dtype_name]
+    torch.manual_seed(0)
+    data = benchmark.setup(shape, dtype)
+    flops, nbytes = benchmark.work(shape, dtype)
+    launch = lambda: benchmark.launch(data, options)
+    first_call_s = harness.time_first_call(launch)
+    warm = harness.measure(launch, min_time_s=args.min_time)
+    baselines = {}
+    if not args.no_baselines:
+        for name, fn in benchmark.baselines(data).items():
+            baselines[name] = harness.baseline_entry(harness.measure(fn, min_time_s=args.min_time), flops, nbytes)
+    return harness.make_result(benchmark.name, dtype_name, shape, flops, nbytes, first_call_s, warm, roofline,
+                               baselines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Throughput benchmarks of the reference CPU backend.")
+    parser.add_argument("--benchmarks", default=",".join(BENCHMARKS),
+                        help=f"comma-separated subset of {', '.join(BENCHMARKS)}")
+    parser.add_argument("--dtypes", default=None, help="comma-separated dtypes (default: all supported per kernel)")
+    parser.add_argument("--option", action="append", default=[],
+                        help="compilation or launch option passed to every kernel, e.g. vectorize=True")
+    parser.add_argument("--threads", default=None,
+                        help="comma-separated num_threads values to run every case with (0: all hardware threads)")
+    parser.add_argument("--grid-orders", default=None,
+                        help="comma-separated grid_order values to run every case with, e.g. row_major,hilbert")
+    parser.add_argument("--quick", action="store_true", help="only run the smallest sizes")
+    parser.add_argument("--min-time", type=float, default=0.2, help="minimum seconds measured per case")
+    parser.add_argument("--no-baselines", action="store_true", help="skip the NumPy and torch baselines")
+    parser.add_argument("--peak-gflops", type=float, default=None, help="peak GFLOP/s instead of measuring it")
+    parser.add_argument("--peak-gbs", type=float, default=None, help="peak GB/s instead of measuring it")
+    parser.add_argument("--keep-cache", action="store_true", help="reuse the triton cache directory")
+    parser.add_argument("--json", default=None, help="write the results to this JSON file")
+    args = parser.parse_args()
+
+    cache_dir = None
+    if not args.keep_cache:
+        cache_dir = tempfile.TemporaryDirectory(prefix="triton-shared-bench-")
+        os.environ["TRITON_CACHE_DIR"] = cache_dir.name
+
+    import triton
+    from triton.backends.triton_shared.driver import CPUDriver
+    triton.runtime.driver.set_active(CPUDriver())
+
+    options = _parse_options(args.option)
+    if args.peak_gflops is not None and args.peak_gbs is not None:
+        roofline = harness.Roofline(args.peak_gflops, args.peak_gbs, measured=False)
+    else:
+        roofline = harness.measure_roofline()
+        roofline.peak_gflops = args.peak_gflops or roofline.peak_gflops
+        roofline.peak_gbs = args.peak_gbs or roofline.peak_gbs
+
+    threads = [None] if args.threads is None else [int(t) for t in args.threads.split(",")]
+    grid_orders = [None] if args.grid_orders is None else args.grid_orders.split(",")
+    results = []
+    for name in args.benchmarks.split(","):
+        benchmark = BENCHMARKS[name]
+        dtypes = benchmark.dtypes if args.dtypes is None else [d for d in args.dtypes.split(",") if d in _DTYPES]
+        for dtype_name in dtypes:
+            for shape in benchmark.shapes(args.quick):
+                for num_threads, grid_order in itertools.product(threads, grid_orders):
+                    case_options = options if num_threads is None else {**options, "num_threads": num_threads}
+                    case_options = case_options if grid_order is None else {**case_options, "grid_order": grid_order}
+                    try:
+                        result = run_case(benchmark, shape, dtype_name, case_options, roofline, args)
+                    except Exception as e:
+                        traceback.print_exc()
+                        result = harness.Result(name, dtype_name, list(shape), 0, 0, 0, harness.Measurement(0, 0, 0),
+                                                0, 0, 0, error=f"{type(e).__name__}: {e}")
+                    result.num_threads = num_threads
+                    result.grid_order = grid_order
+                    results.append(result)
+                    print(harness.format_table([result]).splitlines()[1], flush=True)
+
+    print()
+    print(f"roofline: {roofline.peak_gflops:.1f} GFLOP/s, {roofline.peak_gbs:.1f} GB/s"
+          f"{' (measured with NumPy)' if roofline.measured else ''}")
+    print(harness.format_table(results))
+
+    if args.json:
+        report = {
+            "machine": harness.machine_info(),
+            "roofline": {"peak_gflops": roofline.peak_gflops, "peak_gbs": roofline.peak_gbs,
+                         "measured": roofline.measured},
+            "options": options,
+            "results": harness.to_json(results),
+        }
+        Path(args.json).write_text(json.dumps(report, indent=2))
+
+    if cache_dir is not None:
+        cache_dir.cleanup()
+    return 1 if any(r.error is not None for r in results) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -44,10 +44,19 @@ namespace triton {
 //
 // Example of creating 2D mask:
 //  mask = (rows[:, None] < M) & (cols[None, :] < N)
+//
+// Lower bounds (e.g. cols >= K) move the start of the accessed box away from
+// the origin of the tensor, in which case offsets holds the start of the box
+// in each dimension. Masks that are only made of upper bounds leave offsets
+// empty.
+//
+// Example of creating a two-sided 1D mask:
+//  mask = (cols >= lo) & (cols < hi)
 struct MaskState {
   OpFoldResult start;
   OpFoldResult end;
   SmallVector<OpFoldResult> dims;
+  SmallVector<OpFoldResult> offsets;
   OpFoldResult scalar;
   const bool useUnsafeMask;
 
@@ -55,7 +64,14 @@ struct MaskState {
 
   int64_t getRank() const { return dims.size(); }
 
-  bool isEmpty() const { return getRank() == 0 && !scalar && !start && !end; }
+  bool isEmpty() const {
+    return getRank() == 0 && offsets.empty() && !scalar && !start && !end;
+  }
+
+  bool hasOffsets() const { return !offsets.empty(); }
+
+  // Return the start of the box in each dimension, zeros if offsets is empty.
+  SmallVector<OpFoldResult> getMixedOffsets(OpBuilder &builder) const;
 
   bool isMask() const { return !start && !end && !scalar && dims.size() != 0; }
 
@@ -90,6 +106,18 @@ private:
 
   LogicalResult minStates(const MaskState &lhsState, const MaskState &rhsState,
                           Location loc, OpBuilder &builder);
+
+  // Intersection of the boxes of two masks of the same rank.
+  LogicalResult intersectStates(const MaskState &lhsState,
+                                const MaskState &rhsState, Location loc,
+                                OpBuilder &builder);
+
+  // Union of the boxes of two masks of the same rank. Only supported when the
+  // union is known to be a box at compile time: one box contains the other,
+  // or the boxes only differ in one dimension, in which they overlap or touch.
+  LogicalResult unionStates(const MaskState &lhsState,
+                            const MaskState &rhsState, Location loc,
+                            OpBuilder &builder);
   // -------
   // Helper functions to parse values to populate MaskState
   // -------
@@ -117,10 +145,31 @@ private:
   LogicalResult parseAnd(arith::AndIOp andOp, const Location loc,
                          OpBuilder &builder);
 
+  // Operand is the result of ori
+  // The result state is the union of the two operands' boxes, see
+  // unionStates.
+  LogicalResult parseOr(arith::OrIOp orOp, const Location loc,
+                        OpBuilder &builder);
+
+  // Operand is the result of select on masks
+  // select(cond, mask, false) is cond & mask and select(cond, true, mask) is
+  // cond | mask; other forms are not supported.
+  LogicalResult parseSelect(arith::SelectOp selectOp, const Location loc,
+                            OpBuilder &builder);
+
+  // Operand is the result of remsi
+  // Only supported on ranges with static bounds that lie within a single
+  // period of the static divisor, which simply shifts the range.
+  LogicalResult parseRem(arith::RemSIOp remOp, const Location loc,
+                         OpBuilder &builder);
+
   // Operand is the result of cmpi
-  // Assume only of the dimensions have size > 1. Only support slt for now.
-  // For that dimension, calculate this new dim as: dim = min(end, value) -
-  // start
+  // Assume only of the dimensions have size > 1. The comparison is between
+  // the range and a scalar, on either side. For that dimension, an upper bound
+  // (slt, sle, ult, ule) calculates the new dim as:
+  //   dim = min(end, value) - start
+  // and a lower bound (sgt, sge, ugt, uge) moves the offset of the box:
+  //   offset = max(value, start) - start, dim = end - start - offset
   LogicalResult parseCmp(arith::CmpIOp cmpOp, const Location loc,
                          OpBuilder &builder);
   // Operand is the result of make_range
@@ -94,6 +94,23 @@ class PtrAnalysis {
 
   DenseSet<Value> maybeStructuredArgs;
 
+  // The states of the operands visited by visitOperand in the current
+  // function, excluding those in knownPtrs. A state is reused, together with
+  // the values built for it, wherever these values are available; this keeps
+  // the analysis linear in the size of the expression DAGs shared by the
+  // loads and stores of a kernel, and avoids materializing the same offsets
+  // and strides once per use.
+  llvm::DenseMap<Value, PtrState> operandStates;
+
+  // Compute the state of `operand` from its defining op, see visitOperand.
+  LogicalResult visitOperandUncached(Value operand, PtrState &state,
+                                     const Location loc, OpBuilder &builder);
+
+  // Drop the states of the results of `op`, which is about to be erased, and
+  // the states referring to these results: a value created later may reuse
+  // their storage. Every op erased by the rewrite must go through this.
+  void forgetOperandStates(Operation *op);
+
 public:
   void initializeMaybeStructuredArgs(Operation *op);
 
@@ -234,7 +251,8 @@ public:
 
   // After PtrAnalysis finishes, rewrite the GetStructuredStateOp by creating
   // the correct initialization ops for offsets and strides and passing them to
-  // any loop's init-args.
+  // any loop's init-args. The offsets of a structured tensor of pointers are
+  // folded into the first one, see canLinearizeLoopState.
   LogicalResult rewriteGetStructuredStateOp(tts::GetStructuredStateOp op);
 
   // Parse the state of AddPtrOp, insert any instruction needed to
@@ -262,6 +280,10 @@ public:
 
   LogicalResult rewriteStoreOp(triton::StoreOp op, bool useUnsafeMask = false);
 
+  LogicalResult rewriteAtomicRMWOp(triton::AtomicRMWOp op);
+
+  LogicalResult rewriteAtomicCASOp(triton::AtomicCASOp op);
+
   LogicalResult rewriteOp(Operation *op, bool useUnsafeMask = false);
 };
 
@@ -0,0 +1,19 @@
+#ifndef TRITON_CONVERSION_APPROXIMATEMATH_APPROXIMATEMATH_H
+#define TRITON_CONVERSION_APPROXIMATEMATH_APPROXIMATEMATH_H
+
+#include "mlir/Dialect/Math/IR/Math.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_DECL
+#include "triton-shared/Conversion/ApproximateMath/Passes.h.inc"
+
+std::unique_ptr<OperationPass<ModuleOp>> createApproximateMathPass();
+
+} // namespace triton
+} // namespace mlir
+
+#endif // TRITON_CONVERSION_APPROXIMATEMATH_APPROXIMATEMATH_H
@@ -0,0 +1,15 @@
+#ifndef APPROXIMATE_MATH_CONVERSION_PASSES_H
+#define APPROXIMATE_MATH_CONVERSION_PASSES_H
+
+#include "triton-shared/Conversion/ApproximateMath/ApproximateMath.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_REGISTRATION
+#include "triton-shared/Conversion/ApproximateMath/Passes.h.inc"
+
+} // namespace triton
+} // namespace mlir
+
+#endif
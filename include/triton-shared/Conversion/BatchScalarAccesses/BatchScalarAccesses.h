@@ -0,0 +1,22 @@
+#ifndef TRITON_CONVERSION_BATCHSCALARACCESSES_BATCHSCALARACCESSES_H
+#define TRITON_CONVERSION_BATCHSCALARACCESSES_BATCHSCALARACCESSES_H
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_DECL
+#include "triton-shared/Conversion/BatchScalarAccesses/Passes.h.inc"
+
+std::unique_ptr<OperationPass<ModuleOp>> createBatchScalarAccessesPass();
+
+} // namespace triton
+} // namespace mlir
+
+#endif // TRITON_CONVERSION_BATCHSCALARACCESSES_BATCHSCALARACCESSES_H
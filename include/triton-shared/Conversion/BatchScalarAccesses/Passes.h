@@ -0,0 +1,15 @@
+#ifndef BATCH_SCALAR_ACCESSES_CONVERSION_PASSES_H
+#define BATCH_SCALAR_ACCESSES_CONVERSION_PASSES_H
+
+#include "triton-shared/Conversion/BatchScalarAccesses/BatchScalarAccesses.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_REGISTRATION
+#include "triton-shared/Conversion/BatchScalarAccesses/Passes.h.inc"
+
+} // namespace triton
+} // namespace mlir
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef TRITON_CONVERSION_EMITGRIDLOOP_EMITGRIDLOOP_H
+#define TRITON_CONVERSION_EMITGRIDLOOP_EMITGRIDLOOP_H
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_DECL
+#include "triton-shared/Conversion/EmitGridLoop/Passes.h.inc"
+
+std::unique_ptr<OperationPass<ModuleOp>> createEmitGridLoopPass();
+
+} // namespace triton
+} // namespace mlir
+
+#endif // TRITON_CONVERSION_EMITGRIDLOOP_EMITGRIDLOOP_H
@@ -0,0 +1,15 @@
+#ifndef EMIT_GRID_LOOP_CONVERSION_PASSES_H
+#define EMIT_GRID_LOOP_CONVERSION_PASSES_H
+
+#include "triton-shared/Conversion/EmitGridLoop/EmitGridLoop.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_REGISTRATION
+#include "triton-shared/Conversion/EmitGridLoop/Passes.h.inc"
+
+} // namespace triton
+} // namespace mlir
+
+#endif
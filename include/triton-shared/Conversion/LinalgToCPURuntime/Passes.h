@@ -0,0 +1,15 @@
+#ifndef LINALG_TO_CPU_RUNTIME_CONVERSION_PASSES_H
+#define LINALG_TO_CPU_RUNTIME_CONVERSION_PASSES_H
+
+#include "triton-shared/Conversion/LinalgToCPURuntime/LinalgToCPURuntime.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_REGISTRATION
+#include "triton-shared/Conversion/LinalgToCPURuntime/Passes.h.inc"
+
+} // namespace triton
+} // namespace mlir
+
+#endif
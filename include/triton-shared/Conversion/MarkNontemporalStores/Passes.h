@@ -0,0 +1,15 @@
+#ifndef MARK_NONTEMPORAL_STORES_CONVERSION_PASSES_H
+#define MARK_NONTEMPORAL_STORES_CONVERSION_PASSES_H
+
+#include "triton-shared/Conversion/MarkNontemporalStores/MarkNontemporalStores.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_REGISTRATION
+#include "triton-shared/Conversion/MarkNontemporalStores/Passes.h.inc"
+
+} // namespace triton
+} // namespace mlir
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef TRITON_CONVERSION_OUTLINEPARALLELLOOPS_OUTLINEPARALLELLOOPS_H
+#define TRITON_CONVERSION_OUTLINEPARALLELLOOPS_OUTLINEPARALLELLOOPS_H
+
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_DECL
+#include "triton-shared/Conversion/OutlineParallelLoops/Passes.h.inc"
+
+std::unique_ptr<OperationPass<ModuleOp>> createOutlineParallelLoopsPass();
+
+} // namespace triton
+} // namespace mlir
+
+#endif // TRITON_CONVERSION_OUTLINEPARALLELLOOPS_OUTLINEPARALLELLOOPS_H
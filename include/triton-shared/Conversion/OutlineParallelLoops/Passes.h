@@ -0,0 +1,15 @@
+#ifndef OUTLINE_PARALLEL_LOOPS_CONVERSION_PASSES_H
+#define OUTLINE_PARALLEL_LOOPS_CONVERSION_PASSES_H
+
+#include "triton-shared/Conversion/OutlineParallelLoops/OutlineParallelLoops.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_REGISTRATION
+#include "triton-shared/Conversion/OutlineParallelLoops/Passes.h.inc"
+
+} // namespace triton
+} // namespace mlir
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef TRITON_CONVERSION_PARALLELIZELINALG_PARALLELIZELINALG_H
+#define TRITON_CONVERSION_PARALLELIZELINALG_PARALLELIZELINALG_H
+
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_DECL
+#include "triton-shared/Conversion/ParallelizeLinalg/Passes.h.inc"
+
+std::unique_ptr<OperationPass<ModuleOp>> createParallelizeLinalgPass();
+
+} // namespace triton
+} // namespace mlir
+
+#endif // TRITON_CONVERSION_PARALLELIZELINALG_PARALLELIZELINALG_H
@@ -0,0 +1,15 @@
+#ifndef PARALLELIZE_LINALG_CONVERSION_PASSES_H
+#define PARALLELIZE_LINALG_CONVERSION_PASSES_H
+
+#include "triton-shared/Conversion/ParallelizeLinalg/ParallelizeLinalg.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_REGISTRATION
+#include "triton-shared/Conversion/ParallelizeLinalg/Passes.h.inc"
+
+} // namespace triton
+} // namespace mlir
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef PREFETCH_LOOP_LOADS_CONVERSION_PASSES_H
+#define PREFETCH_LOOP_LOADS_CONVERSION_PASSES_H
+
+#include "triton-shared/Conversion/PrefetchLoopLoads/PrefetchLoopLoads.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_REGISTRATION
+#include "triton-shared/Conversion/PrefetchLoopLoads/Passes.h.inc"
+
+} // namespace triton
+} // namespace mlir
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef TRITON_CONVERSION_PREFETCHLOOPLOADS_PREFETCHLOOPLOADS_H
+#define TRITON_CONVERSION_PREFETCHLOOPLOADS_PREFETCHLOOPLOADS_H
+
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_DECL
+#include "triton-shared/Conversion/PrefetchLoopLoads/Passes.h.inc"
+
+std::unique_ptr<OperationPass<ModuleOp>> createPrefetchLoopLoadsPass();
+
+} // namespace triton
+} // namespace mlir
+
+#endif // TRITON_CONVERSION_PREFETCHLOOPLOADS_PREFETCHLOOPLOADS_H
@@ -0,0 +1,15 @@
+#ifndef PROMOTE_ALLOCS_TO_STACK_CONVERSION_PASSES_H
+#define PROMOTE_ALLOCS_TO_STACK_CONVERSION_PASSES_H
+
+#include "triton-shared/Conversion/PromoteAllocsToStack/PromoteAllocsToStack.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_REGISTRATION
+#include "triton-shared/Conversion/PromoteAllocsToStack/Passes.h.inc"
+
+} // namespace triton
+} // namespace mlir
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef PROMOTE_HALF_ARGS_CONVERSION_PASSES_H
+#define PROMOTE_HALF_ARGS_CONVERSION_PASSES_H
+
+#include "triton-shared/Conversion/PromoteHalfArgs/PromoteHalfArgs.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_REGISTRATION
+#include "triton-shared/Conversion/PromoteHalfArgs/Passes.h.inc"
+
+} // namespace triton
+} // namespace mlir
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef TRITON_CONVERSION_PROMOTEHALFARGS_PROMOTEHALFARGS_H
+#define TRITON_CONVERSION_PROMOTEHALFARGS_PROMOTEHALFARGS_H
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_DECL
+#include "triton-shared/Conversion/PromoteHalfArgs/Passes.h.inc"
+
+std::unique_ptr<OperationPass<ModuleOp>> createPromoteHalfArgsPass();
+
+} // namespace triton
+} // namespace mlir
+
+#endif // TRITON_CONVERSION_PROMOTEHALFARGS_PROMOTEHALFARGS_H
@@ -0,0 +1,15 @@
+#ifndef SPECIALIZE_UNIT_STRIDES_CONVERSION_PASSES_H
+#define SPECIALIZE_UNIT_STRIDES_CONVERSION_PASSES_H
+
+#include "triton-shared/Conversion/SpecializeUnitStrides/SpecializeUnitStrides.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_REGISTRATION
+#include "triton-shared/Conversion/SpecializeUnitStrides/Passes.h.inc"
+
+} // namespace triton
+} // namespace mlir
+
+#endif
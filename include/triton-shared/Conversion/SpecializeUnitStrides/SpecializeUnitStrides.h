@@ -0,0 +1,19 @@
+#ifndef TRITON_CONVERSION_SPECIALIZEUNITSTRIDES_SPECIALIZEUNITSTRIDES_H
+#define TRITON_CONVERSION_SPECIALIZEUNITSTRIDES_SPECIALIZEUNITSTRIDES_H
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_DECL
+#include "triton-shared/Conversion/SpecializeUnitStrides/Passes.h.inc"
+
+std::unique_ptr<OperationPass<ModuleOp>> createSpecializeUnitStridesPass();
+
+} // namespace triton
+} // namespace mlir
+
+#endif // TRITON_CONVERSION_SPECIALIZEUNITSTRIDES_SPECIALIZEUNITSTRIDES_H
@@ -0,0 +1,15 @@
+#ifndef SPLIT_REDUCTIONS_CONVERSION_PASSES_H
+#define SPLIT_REDUCTIONS_CONVERSION_PASSES_H
+
+#include "triton-shared/Conversion/SplitReductions/SplitReductions.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_REGISTRATION
+#include "triton-shared/Conversion/SplitReductions/Passes.h.inc"
+
+} // namespace triton
+} // namespace mlir
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef TRITON_CONVERSION_SPLITREDUCTIONS_SPLITREDUCTIONS_H
+#define TRITON_CONVERSION_SPLITREDUCTIONS_SPLITREDUCTIONS_H
+
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_DECL
+#include "triton-shared/Conversion/SplitReductions/Passes.h.inc"
+
+std::unique_ptr<OperationPass<ModuleOp>> createSplitReductionsPass();
+
+} // namespace triton
+} // namespace mlir
+
+#endif // TRITON_CONVERSION_SPLITREDUCTIONS_SPLITREDUCTIONS_H
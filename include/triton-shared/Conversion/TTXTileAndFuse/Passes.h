@@ -0,0 +1,15 @@
+#ifndef TTX_TILE_AND_FUSE_CONVERSION_PASSES_H
+#define TTX_TILE_AND_FUSE_CONVERSION_PASSES_H
+
+#include "triton-shared/Conversion/TTXTileAndFuse/TTXTileAndFuse.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_REGISTRATION
+#include "triton-shared/Conversion/TTXTileAndFuse/Passes.h.inc"
+
+} // namespace triton
+} // namespace mlir
+
+#endif
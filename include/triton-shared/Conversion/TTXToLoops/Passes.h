@@ -0,0 +1,15 @@
+#ifndef TTX_TO_LOOPS_CONVERSION_PASSES_H
+#define TTX_TO_LOOPS_CONVERSION_PASSES_H
+
+#include "triton-shared/Conversion/TTXToLoops/TTXToLoops.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_REGISTRATION
+#include "triton-shared/Conversion/TTXToLoops/Passes.h.inc"
+
+} // namespace triton
+} // namespace mlir
+
+#endif
@@ -21,6 +21,7 @@
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
 #include "mlir/Dialect/Linalg/Passes.h"
 #include "mlir/Dialect/Utils/ReshapeOpsUtils.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
 
 #include "llvm/ADT/SmallVectorExtras.h"
 #include "llvm/ADT/TypeSwitch.h"
@@ -416,6 +417,18 @@ public:
           op, "Cannot lower continuous masked loads");
     }
 
+    // The split copies of wraparound pointers assume the mask starts at the
+    // origin of the block.
+    if (mstate.hasOffsets()) {
+      if (auto unrealizedCast =
+              ptr.getDefiningOp<UnrealizedConversionCastOp>()) {
+        if (unrealizedCast->hasAttr(ModuloState::WraparoundAttr)) {
+          return rewriter.notifyMatchFailure(
+              op, "Cannot lower wraparound loads with lower-bounded masks");
+        }
+      }
+    }
+
     // fill load destination with other value
     if (other) {
       auto scalarOther = getScalarValue(other, loc, rewriter);
@@ -1142,6 +1155,21 @@ struct MatmulConverter : public OpConversionPattern<triton::DotOp> {
     auto elementType = dstType.getElementType();
     bool integers = elementType.isInteger();
     bool skipC = isZeroTensor(opc, integers);
+
+    // linalg.matmul accumulates into its init operand, so a non-zero
+    // accumulator of the result type is passed as `outs` directly. When `C` is
+    // the iter_arg of a K loop, bufferization then updates the same buffer in
+    // place on every iteration instead of materializing and adding a fresh
+    // zero-filled tile.
+    if (!skipC && opc.getType() == dstType) {
+      auto res = rewriter
+                     .create<linalg::MatmulOp>(loc, ValueRange{opa, opb},
+                                               ValueRange{opc})
+                     .getResult(0);
+      rewriter.replaceOp(op, res);
+      return success();
+    }
+
     auto init =
         rewriter.create<tensor::EmptyOp>(loc, dstType.getShape(), elementType);
     TypedAttr constantAttr = integers ?
@@ -1184,9 +1212,10 @@ private:
   }
 
   bool isReductionOpSupported(Operation *redOp) const {
-    return isa<arith::AddFOp, arith::AddIOp, arith::MaximumFOp,
-               arith::MaxNumFOp, arith::MinimumFOp, arith::MinNumFOp,
-               arith::MinSIOp, arith::MinUIOp, arith::MaxSIOp, arith::MaxUIOp>(
+    return isa<arith::AddFOp, arith::AddIOp, arith::MulFOp, arith::MulIOp,
+               arith::MaximumFOp, arith::MaxNumFOp, arith::MinimumFOp,
+               arith::MinNumFOp, arith::MinSIOp, arith::MinUIOp, arith::MaxSIOp,
+               arith::MaxUIOp, arith::OrIOp, arith::XOrIOp, arith::AndIOp>(
         redOp);
   }
 
@@ -1200,9 +1229,19 @@ private:
             .Case([&](arith::AddFOp) {
               return rewriter.getFloatAttr(constantType, 0.f);
             })
-            .Case([&](arith::AddIOp) {
+            .Case<arith::AddIOp, arith::OrIOp, arith::XOrIOp>([&](auto) {
               return rewriter.getIntegerAttr(constantType, 0);
             })
+            .Case([&](arith::MulFOp) {
+              return rewriter.getFloatAttr(constantType, 1.f);
+            })
+            .Case([&](arith::MulIOp) {
+              return rewriter.getIntegerAttr(constantType, 1);
+            })
+            .Case([&](arith::AndIOp) {
+              return rewriter.getIntegerAttr(constantType,
+                                             llvm::APInt::getAllOnes(bitWidth));
+            })
             .Case<arith::MaximumFOp, arith::MaxNumFOp>([&](auto) {
               return rewriter.getFloatAttr(
                   constantType, -std::numeric_limits<float>::infinity());
@@ -1254,9 +1293,10 @@ private:
           }
           return b.create<arith::AddFOp>(loc, lhs, rhs);
         })
-        .Case<arith::AddIOp, arith::MaximumFOp, arith::MaxNumFOp,
-              arith::MinimumFOp, arith::MinNumFOp, arith::MinSIOp,
-              arith::MinUIOp, arith::MaxSIOp, arith::MaxUIOp>([&](auto redOp) {
+        .Case<arith::AddIOp, arith::MulFOp, arith::MulIOp, arith::MaximumFOp,
+              arith::MaxNumFOp, arith::MinimumFOp, arith::MinNumFOp,
+              arith::MinSIOp, arith::MinUIOp, arith::MaxSIOp, arith::MaxUIOp,
+              arith::OrIOp, arith::XOrIOp, arith::AndIOp>([&](auto redOp) {
           return b.create<decltype(redOp)>(loc, lhs, rhs);
         })
         .Default([](Operation *op) {
@@ -1277,16 +1317,6 @@ private:
     auto loc = op.getLoc();
     auto reductionOps = getRedOps(op);
 
-    // Reduction of arbitrary operations isn't supported because using the first
-    // element across the reduction dimension requires us to iterate over a
-    // subview that skips over each first element.
-    if (reductionOps.size() != 1 ||
-        !isReductionOpSupported(reductionOps.front())) {
-      return rewriter.notifyMatchFailure(
-          op, "Only support lowering reduction with body "
-              "containing 1 max(i/f) or addf.");
-    }
-
     auto rop = reductionOps.front();
     auto axis = op.getAxis();
     auto isVectorReduce = sourceType.getRank() == 1;
@@ -1352,6 +1382,93 @@ private:
     return success();
   }
 
+  // Combiners without a known identity element, made of several ops, or
+  // reducing several tensors at once (e.g. Welford's mean / m2 / weight) are
+  // seeded with the first slice along the reduction axis. The remaining
+  // slices are then combined into it by a clone of the tt.reduce body.
+  LogicalResult
+  convertToSeededLinalgReduce(triton::ReduceOp op,
+                              typename triton::ReduceOp::Adaptor adaptor,
+                              ConversionPatternRewriter &rewriter) const {
+    auto loc = op.getLoc();
+    SmallVector<Value> sources(adaptor.getOperands());
+    auto sourceType = cast<RankedTensorType>(sources.front().getType());
+    auto rank = sourceType.getRank();
+    int64_t axis = op.getAxis();
+    auto isVectorReduce = rank == 1;
+
+    if (ShapedType::isDynamic(sourceType.getShape()[axis])) {
+      return rewriter.notifyMatchFailure(
+          op, "Seeded reduction requires a static reduction axis.");
+    }
+
+    if (axis == rank - 1 && !isVectorReduce) {
+      for (auto &source : sources) {
+        source = getTransposedValue(source, loc, rewriter);
+      }
+      axis = rank - 2;
+    }
+
+    auto shape = cast<RankedTensorType>(sources.front().getType()).getShape();
+    int64_t axisSize = shape[axis];
+    SmallVector<int64_t> resShape(shape);
+    resShape.erase(resShape.begin() + axis);
+
+    SmallVector<OpFoldResult> offsets(rank, rewriter.getIndexAttr(0));
+    SmallVector<OpFoldResult> sizes =
+        getAsIndexOpFoldResult(rewriter.getContext(), shape);
+    SmallVector<OpFoldResult> strides(rank, rewriter.getIndexAttr(1));
+
+    SmallVector<Value> inits, inputs;
+    for (auto source : sources) {
+      auto elemType = cast<RankedTensorType>(source.getType()).getElementType();
+      sizes[axis] = rewriter.getIndexAttr(1);
+      inits.push_back(rewriter.create<tensor::ExtractSliceOp>(
+          loc, RankedTensorType::get(resShape, elemType), source, offsets,
+          sizes, strides));
+
+      offsets[axis] = rewriter.getIndexAttr(1);
+      sizes[axis] = rewriter.getIndexAttr(axisSize - 1);
+      inputs.push_back(rewriter.create<tensor::ExtractSliceOp>(
+          loc, source, offsets, sizes, strides));
+      offsets[axis] = rewriter.getIndexAttr(0);
+    }
+
+    SmallVector<Value> results(inits);
+    if (axisSize > 1) {
+      auto numOperands = sources.size();
+      auto reduceOp = rewriter.create<linalg::ReduceOp>(
+          loc, inputs, inits, SmallVector<int64_t>{axis},
+          [&](OpBuilder &opBuilder, Location loc, ValueRange args) {
+            // The lhs operands of the combiner are the running values, the
+            // rhs operands the elements being combined into them.
+            Block *body = op.getBody();
+            IRMapping mapping;
+            for (size_t i = 0; i < numOperands; i++) {
+              mapping.map(body->getArgument(i), args[numOperands + i]);
+              mapping.map(body->getArgument(numOperands + i), args[i]);
+            }
+            for (auto &bodyOp : body->without_terminator()) {
+              opBuilder.clone(bodyOp, mapping);
+            }
+            SmallVector<Value> yields = llvm::map_to_vector(
+                body->getTerminator()->getOperands(),
+                [&](Value v) { return mapping.lookupOrDefault(v); });
+            opBuilder.create<linalg::YieldOp>(loc, yields);
+          });
+      results = reduceOp.getResults();
+    }
+
+    if (isVectorReduce) {
+      for (auto &result : results) {
+        result = rewriter.create<tensor::ExtractOp>(loc, result, ValueRange{});
+      }
+    }
+
+    rewriter.replaceOp(op, results);
+    return success();
+  }
+
 public:
   LogicalResult
   matchAndRewrite(triton::ReduceOp op,
@@ -1368,7 +1485,12 @@ public:
            "axis is within "
            "operand's rank");
 
-    return convertToLinalgReduce(op, adaptor, rewriter);
+    auto reductionOps = getRedOps(op);
+    if (op.getNumOperands() == 1 && reductionOps.size() == 1 &&
+        isReductionOpSupported(reductionOps.front())) {
+      return convertToLinalgReduce(op, adaptor, rewriter);
+    }
+    return convertToSeededLinalgReduce(op, adaptor, rewriter);
   }
 };
 
@@ -2077,25 +2199,31 @@ public:
     POPULATE_UNARY_OP("__nv_coshf", math::CoshOp);
     POPULATE_UNARY_OP("__nv_cosh", math::CoshOp);
     POPULATE_UNARY_OP("__nv_tanhf", math::TanhOp);
-    POPULATE_UNARY_OP("__nv_tanhf", math::TanhOp);
+    POPULATE_UNARY_OP("__nv_tanh", math::TanhOp);
     POPULATE_UNARY_OP("__nv_acoshf", math::AcoshOp);
     POPULATE_UNARY_OP("__nv_acosh", math::AcoshOp);
     POPULATE_UNARY_OP("__nv_asinhf", math::AsinhOp);
     POPULATE_UNARY_OP("__nv_asinh", math::AsinhOp);
     POPULATE_UNARY_OP("__nv_atanhf", math::AtanhOp);
-    POPULATE_UNARY_OP("__nv_atanhf", math::AtanhOp);
+    POPULATE_UNARY_OP("__nv_atanh", math::AtanhOp);
     POPULATE_UNARY_OP("__nv_logf", math::LogOp);
     POPULATE_UNARY_OP("__nv_log", math::LogOp);
+    POPULATE_UNARY_OP("__nv_log2f", math::Log2Op);
+    POPULATE_UNARY_OP("__nv_log2", math::Log2Op);
     POPULATE_UNARY_OP("__nv_log10f", math::Log10Op);
     POPULATE_UNARY_OP("__nv_log10", math::Log10Op);
     POPULATE_UNARY_OP("__nv_log1pf", math::Log1pOp);
     POPULATE_UNARY_OP("__nv_log1p", math::Log1pOp);
     POPULATE_UNARY_OP("__nv_expf", math::ExpOp);
     POPULATE_UNARY_OP("__nv_exp", math::ExpOp);
+    POPULATE_UNARY_OP("__nv_expm1f", math::ExpM1Op);
+    POPULATE_UNARY_OP("__nv_expm1", math::ExpM1Op);
     POPULATE_UNARY_OP("__nv_exp2f", math::Exp2Op);
     POPULATE_UNARY_OP("__nv_exp2", math::Exp2Op);
     POPULATE_UNARY_OP("__nv_erff", math::ErfOp);
     POPULATE_UNARY_OP("__nv_erf", math::ErfOp);
+    POPULATE_UNARY_OP("__nv_cbrtf", math::CbrtOp);
+    POPULATE_UNARY_OP("__nv_cbrt", math::CbrtOp);
     POPULATE_UNARY_OP("__nv_sqrtf", math::SqrtOp);
     POPULATE_UNARY_OP("__nv_sqrt", math::SqrtOp);
     POPULATE_UNARY_OP("__nv_rsqrtf", math::RsqrtOp);
@@ -15,6 +15,8 @@ namespace mlir {
 namespace triton {
 
 std::unique_ptr<OperationPass<ModuleOp>> createTritonToLinalgExperimentalPass();
+std::unique_ptr<OperationPass<ModuleOp>>
+createTritonToLinalgExperimentalPass(bool enableElementwiseFusion);
 
 } // namespace triton
 } // namespace mlir
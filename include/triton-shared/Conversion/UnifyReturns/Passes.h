@@ -0,0 +1,15 @@
+#ifndef UNIFY_RETURNS_CONVERSION_PASSES_H
+#define UNIFY_RETURNS_CONVERSION_PASSES_H
+
+#include "triton-shared/Conversion/UnifyReturns/UnifyReturns.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_REGISTRATION
+#include "triton-shared/Conversion/UnifyReturns/Passes.h.inc"
+
+} // namespace triton
+} // namespace mlir
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef TRITON_CONVERSION_UNIFYRETURNS_UNIFYRETURNS_H
+#define TRITON_CONVERSION_UNIFYRETURNS_UNIFYRETURNS_H
+
+#include "mlir/Dialect/ControlFlow/IR/ControlFlow.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Pass/Pass.h"
+
+namespace mlir {
+namespace triton {
+
+#define GEN_PASS_DECL
+#include "triton-shared/Conversion/UnifyReturns/Passes.h.inc"
+
+std::unique_ptr<OperationPass<ModuleOp>> createUnifyReturnsPass();
+
+} // namespace triton
+} // namespace mlir
+
+#endif // TRITON_CONVERSION_UNIFYRETURNS_UNIFYRETURNS_H
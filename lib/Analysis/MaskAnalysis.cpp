@@ -8,6 +8,7 @@
 #include "triton-shared/Analysis/MaskAnalysis.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
 #include "mlir/Support/LogicalResult.h"
 
 #include "triton-shared/Analysis/OpFoldResultUtils.h"
@@ -20,7 +21,9 @@
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/LogicalResult.h"
+#include <algorithm>
 #include <cassert>
+#include <optional>
 
 namespace mlir {
 
@@ -36,6 +39,12 @@ LogicalResult MaskState::parse(Value operand, const Location loc,
     return this->parseAdd(op, loc, builder);
   } else if (auto op = operand.getDefiningOp<arith::AndIOp>()) {
     return this->parseAnd(op, loc, builder);
+  } else if (auto op = operand.getDefiningOp<arith::OrIOp>()) {
+    return this->parseOr(op, loc, builder);
+  } else if (auto op = operand.getDefiningOp<arith::SelectOp>()) {
+    return this->parseSelect(op, loc, builder);
+  } else if (auto op = operand.getDefiningOp<arith::RemSIOp>()) {
+    return this->parseRem(op, loc, builder);
   } else if (auto op = operand.getDefiningOp<arith::CmpIOp>()) {
     return this->parseCmp(op, loc, builder);
   } else if (auto op = operand.getDefiningOp<triton::MakeRangeOp>()) {
@@ -55,11 +64,19 @@ LogicalResult MaskState::parse(Value operand, const Location loc,
   }
 }
 
+SmallVector<OpFoldResult>
+MaskState::getMixedOffsets(OpBuilder &builder) const {
+  if (hasOffsets()) {
+    return offsets;
+  }
+  return SmallVector<OpFoldResult>(getRank(), builder.getIndexAttr(0));
+}
+
 tensor::ExtractSliceOp MaskState::getExtractSlice(Value source,
                                                   const Location loc,
                                                   OpBuilder &builder) const {
   auto sourceType = cast<RankedTensorType>(source.getType());
-  SmallVector<OpFoldResult> offsets(getRank(), builder.getIndexAttr(0));
+  SmallVector<OpFoldResult> offsets = getMixedOffsets(builder);
   SmallVector<OpFoldResult> strides(getRank(), builder.getIndexAttr(1));
 
   auto dstType = tensor::ExtractSliceOp::inferResultType(sourceType, offsets,
@@ -72,7 +89,7 @@ tensor::ExtractSliceOp MaskState::getExtractSlice(Value source,
 memref::SubViewOp MaskState::getSubview(Value source, const Location loc,
                                         OpBuilder &builder) const {
   auto sourceType = cast<MemRefType>(source.getType());
-  SmallVector<OpFoldResult> offsets(getRank(), builder.getIndexAttr(0));
+  SmallVector<OpFoldResult> offsets = getMixedOffsets(builder);
   SmallVector<OpFoldResult> strides(getRank(), builder.getIndexAttr(1));
   auto dstType =
       memref::SubViewOp::inferResultType(sourceType, offsets, dims, strides);
@@ -184,12 +201,23 @@ MaskState::getStackedSubviews(Value block1, Value block2, const Location loc,
   return {sv1, sv2};
 }
 
+// Return `ofr` as an attribute when it is a constant, so that the bounds
+// computed from it stay static: unionStates and parseRem need them to be.
+static OpFoldResult foldConstant(OpFoldResult ofr, OpBuilder &builder) {
+  if (auto value = getConstantIntValue(ofr)) {
+    return builder.getIndexAttr(*value);
+  }
+  return ofr;
+}
+
 LogicalResult MaskState::addStateScalar(const MaskState &state,
                                         const OpFoldResult scalar, Location loc,
                                         OpBuilder &builder) {
-  start = addOFRs(state.start, scalar, loc, builder);
-  end = addOFRs(state.end, scalar, loc, builder);
+  auto shift = foldConstant(scalar, builder);
+  start = addOFRs(state.start, shift, loc, builder);
+  end = addOFRs(state.end, shift, loc, builder);
   dims = state.dims;
+  offsets = state.offsets;
   return success();
 }
 
@@ -233,6 +261,116 @@ LogicalResult MaskState::minStates(const MaskState &lhsState,
   return success();
 }
 
+LogicalResult MaskState::intersectStates(const MaskState &lhsState,
+                                         const MaskState &rhsState,
+                                         Location loc, OpBuilder &builder) {
+  if (lhsState.getRank() != rhsState.getRank()) {
+    InFlightDiagnostic diag =
+        emitError(loc)
+        << "Unexpected case where lhs and rhs have different ranks";
+    return failure();
+  }
+
+  auto lhsOffsets = lhsState.getMixedOffsets(builder);
+  auto rhsOffsets = rhsState.getMixedOffsets(builder);
+  for (uint32_t i = 0; i < lhsState.getRank(); i++) {
+    auto lhsEnd = addOFRs(lhsOffsets[i], lhsState.dims[i], loc, builder);
+    auto rhsEnd = addOFRs(rhsOffsets[i], rhsState.dims[i], loc, builder);
+    auto newOffset = maxOFRs(lhsOffsets[i], rhsOffsets[i], loc, builder);
+    // Disjoint boxes result in an empty box at newOffset.
+    auto newEnd = minOFRs(lhsEnd, rhsEnd, loc, builder);
+    newEnd = maxOFRs(newEnd, newOffset, loc, builder);
+    offsets.push_back(newOffset);
+    dims.push_back(subOFRs(newEnd, newOffset, loc, builder));
+  }
+  return success();
+}
+
+LogicalResult MaskState::unionStates(const MaskState &lhsState,
+                                     const MaskState &rhsState, Location loc,
+                                     OpBuilder &builder) {
+  if (lhsState.getRank() != rhsState.getRank()) {
+    InFlightDiagnostic diag =
+        emitError(loc)
+        << "Unexpected case where lhs and rhs have different ranks";
+    return failure();
+  }
+
+  auto rank = lhsState.getRank();
+  auto lhsOffsets = lhsState.getMixedOffsets(builder);
+  auto rhsOffsets = rhsState.getMixedOffsets(builder);
+
+  SmallVector<int64_t> lhsStart, lhsEnd, rhsStart, rhsEnd;
+  for (int64_t i = 0; i < rank; i++) {
+    auto lhsOffset = getIntAttr(lhsOffsets[i]);
+    auto lhsDim = getIntAttr(lhsState.dims[i]);
+    auto rhsOffset = getIntAttr(rhsOffsets[i]);
+    auto rhsDim = getIntAttr(rhsState.dims[i]);
+    if (!lhsOffset || !lhsDim || !rhsOffset || !rhsDim) {
+      InFlightDiagnostic diag =
+          emitError(loc) << "Unsupported ori of masks with dynamic bounds";
+      return failure();
+    }
+    lhsStart.push_back(*lhsOffset);
+    lhsEnd.push_back(*lhsOffset + *lhsDim);
+    rhsStart.push_back(*rhsOffset);
+    rhsEnd.push_back(*rhsOffset + *rhsDim);
+  }
+
+  auto contains = [&](ArrayRef<int64_t> outerStart, ArrayRef<int64_t> outerEnd,
+                      ArrayRef<int64_t> innerStart,
+                      ArrayRef<int64_t> innerEnd) {
+    for (int64_t i = 0; i < rank; i++) {
+      if (innerStart[i] < innerEnd[i] &&
+          (innerStart[i] < outerStart[i] || innerEnd[i] > outerEnd[i])) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  SmallVector<int64_t> newStart, newEnd;
+  if (contains(lhsStart, lhsEnd, rhsStart, rhsEnd)) {
+    newStart = lhsStart;
+    newEnd = lhsEnd;
+  } else if (contains(rhsStart, rhsEnd, lhsStart, lhsEnd)) {
+    newStart = rhsStart;
+    newEnd = rhsEnd;
+  } else {
+    int64_t unionDim = -1;
+    for (int64_t i = 0; i < rank; i++) {
+      if (lhsStart[i] == rhsStart[i] && lhsEnd[i] == rhsEnd[i]) {
+        continue;
+      }
+      if (unionDim != -1) {
+        unionDim = -1;
+        break;
+      }
+      unionDim = i;
+    }
+    if (unionDim == -1 || lhsStart[unionDim] > rhsEnd[unionDim] ||
+        rhsStart[unionDim] > lhsEnd[unionDim]) {
+      InFlightDiagnostic diag =
+          emitError(loc) << "Unsupported ori of masks whose union is not "
+                            "contiguous";
+      return failure();
+    }
+    newStart = lhsStart;
+    newEnd = lhsEnd;
+    newStart[unionDim] = std::min(lhsStart[unionDim], rhsStart[unionDim]);
+    newEnd[unionDim] = std::max(lhsEnd[unionDim], rhsEnd[unionDim]);
+  }
+
+  bool isAtOrigin = llvm::all_of(newStart, [](int64_t s) { return s == 0; });
+  for (int64_t i = 0; i < rank; i++) {
+    if (!isAtOrigin) {
+      offsets.push_back(builder.getIndexAttr(newStart[i]));
+    }
+    dims.push_back(builder.getIndexAttr(newEnd[i] - newStart[i]));
+  }
+  return success();
+}
+
 LogicalResult MaskState::parseConstant(arith::ConstantOp constOp,
                                        const Location loc, OpBuilder &builder) {
   assert(this->isEmpty());
@@ -240,6 +378,16 @@ LogicalResult MaskState::parseConstant(arith::ConstantOp constOp,
   if (isa<DenseElementsAttr>(constOp.getValue())) {
     auto attr = cast<DenseElementsAttr>(constOp.getValue());
     auto elementType = attr.getElementType();
+
+    // A constant mask either covers the whole tensor or nothing.
+    if (attr.isSplat() && elementType.isInteger(1)) {
+      bool value = attr.getSplatValue<bool>();
+      for (auto s : attr.getType().getShape()) {
+        this->dims.push_back(builder.getIndexAttr(value ? s : 0));
+      }
+      return success();
+    }
+
     assert(attr.isSplat() && isa<IntegerType>(elementType) &&
            "All elements must share a single integer constant value");
     auto values = attr.getValues<IntegerAttr>();
@@ -294,7 +442,112 @@ LogicalResult MaskState::parseAnd(arith::AndIOp andOp, const Location loc,
       !rhsState.isMask())
     return failure();
 
-  return this->minStates(lhsState, rhsState, loc, builder);
+  if (!lhsState.hasOffsets() && !rhsState.hasOffsets())
+    return this->minStates(lhsState, rhsState, loc, builder);
+
+  return this->intersectStates(lhsState, rhsState, loc, builder);
+}
+
+LogicalResult MaskState::parseOr(arith::OrIOp orOp, const Location loc,
+                                 OpBuilder &builder) {
+  assert(this->isEmpty());
+
+  MaskState lhsState;
+  if (failed(lhsState.parse(orOp.getLhs(), loc, builder)) ||
+      !lhsState.isMask())
+    return failure();
+
+  MaskState rhsState;
+  if (failed(rhsState.parse(orOp.getRhs(), loc, builder)) ||
+      !rhsState.isMask())
+    return failure();
+
+  return this->unionStates(lhsState, rhsState, loc, builder);
+}
+
+// Return the value of a splat i1 constant, std::nullopt for any other value.
+static std::optional<bool> getConstantMaskValue(Value v) {
+  auto constOp = v.getDefiningOp<arith::ConstantOp>();
+  if (!constOp) {
+    return std::nullopt;
+  }
+  auto attr = dyn_cast<DenseElementsAttr>(constOp.getValue());
+  if (!attr || !attr.isSplat() || !attr.getElementType().isInteger(1)) {
+    return std::nullopt;
+  }
+  return attr.getSplatValue<bool>();
+}
+
+LogicalResult MaskState::parseSelect(arith::SelectOp selectOp,
+                                     const Location loc, OpBuilder &builder) {
+  assert(this->isEmpty());
+
+  auto resultType = dyn_cast<ShapedType>(selectOp.getType());
+  if (!resultType || !resultType.getElementType().isInteger(1) ||
+      !isa<ShapedType>(selectOp.getCondition().getType())) {
+    InFlightDiagnostic diag = emitError(loc) << "Unsupported select";
+    return failure();
+  }
+
+  auto trueValue = getConstantMaskValue(selectOp.getTrueValue());
+  auto falseValue = getConstantMaskValue(selectOp.getFalseValue());
+
+  bool isAnd = falseValue.has_value() && !falseValue.value();
+  bool isOr = trueValue.has_value() && trueValue.value();
+  if (!isAnd && !isOr) {
+    InFlightDiagnostic diag =
+        emitError(loc) << "Unsupported select that is neither an and nor an or "
+                          "of masks";
+    return failure();
+  }
+
+  MaskState condState;
+  if (failed(condState.parse(selectOp.getCondition(), loc, builder)) ||
+      !condState.isMask())
+    return failure();
+
+  MaskState valueState;
+  Value value = isAnd ? selectOp.getTrueValue() : selectOp.getFalseValue();
+  if (failed(valueState.parse(value, loc, builder)) || !valueState.isMask())
+    return failure();
+
+  if (isOr)
+    return this->unionStates(condState, valueState, loc, builder);
+
+  if (!condState.hasOffsets() && !valueState.hasOffsets())
+    return this->minStates(condState, valueState, loc, builder);
+
+  return this->intersectStates(condState, valueState, loc, builder);
+}
+
+LogicalResult MaskState::parseRem(arith::RemSIOp remOp, const Location loc,
+                                  OpBuilder &builder) {
+  assert(this->isEmpty());
+
+  MaskState lhsState;
+  if (failed(lhsState.parse(remOp.getLhs(), loc, builder)))
+    return failure();
+
+  MaskState rhsState;
+  if (failed(rhsState.parse(remOp.getRhs(), loc, builder)))
+    return failure();
+
+  auto start = getIntAttr(lhsState.start);
+  auto end = getIntAttr(lhsState.end);
+  auto divisor = rhsState.scalar ? getConstantIntValue(rhsState.scalar)
+                                 : std::nullopt;
+  if (!start || !end || !divisor || *divisor <= 0 || *start < 0 ||
+      *start / *divisor != (*end - 1) / *divisor) {
+    InFlightDiagnostic diag =
+        emitError(loc) << "Unsupported remsi of a range that may wrap around";
+    return failure();
+  }
+
+  auto shift = (*start / *divisor) * *divisor;
+  this->start = builder.getIndexAttr(*start - shift);
+  this->end = builder.getIndexAttr(*end - shift);
+  this->dims = lhsState.dims;
+  return success();
 }
 
 LogicalResult MaskState::parseExtSI(arith::ExtSIOp op, const Location loc,
@@ -303,12 +556,36 @@ LogicalResult MaskState::parseExtSI(arith::ExtSIOp op, const Location loc,
   return parse(op.getIn(), loc, builder);
 }
 
+// Return the predicate of the comparison with swapped operands.
+static arith::CmpIPredicate getSwappedPredicate(arith::CmpIPredicate pred) {
+  switch (pred) {
+  case arith::CmpIPredicate::slt:
+    return arith::CmpIPredicate::sgt;
+  case arith::CmpIPredicate::sle:
+    return arith::CmpIPredicate::sge;
+  case arith::CmpIPredicate::sgt:
+    return arith::CmpIPredicate::slt;
+  case arith::CmpIPredicate::sge:
+    return arith::CmpIPredicate::sle;
+  case arith::CmpIPredicate::ult:
+    return arith::CmpIPredicate::ugt;
+  case arith::CmpIPredicate::ule:
+    return arith::CmpIPredicate::uge;
+  case arith::CmpIPredicate::ugt:
+    return arith::CmpIPredicate::ult;
+  case arith::CmpIPredicate::uge:
+    return arith::CmpIPredicate::ule;
+  default:
+    return pred;
+  }
+}
+
 LogicalResult MaskState::parseCmp(arith::CmpIOp cmpOp, const Location loc,
                                   OpBuilder &builder) {
   assert(this->isEmpty());
 
-  if (cmpOp.getPredicate() != arith::CmpIPredicate::slt &&
-      cmpOp.getPredicate() != arith::CmpIPredicate::ult) {
+  auto pred = cmpOp.getPredicate();
+  if (pred == arith::CmpIPredicate::eq || pred == arith::CmpIPredicate::ne) {
     InFlightDiagnostic diag = emitError(loc) << "Unsupported cmpi";
     return failure();
   }
@@ -321,7 +598,21 @@ LogicalResult MaskState::parseCmp(arith::CmpIOp cmpOp, const Location loc,
   if (failed(rhsState.parse(cmpOp.getRhs(), loc, builder)))
     return failure();
 
-  assert((!lhsState.scalar && rhsState.scalar) && "Unsupported cmpi scenario");
+  // Canonicalize to `range pred scalar`.
+  if (lhsState.scalar && !rhsState.scalar) {
+    std::swap(lhsState.start, rhsState.start);
+    std::swap(lhsState.end, rhsState.end);
+    std::swap(lhsState.dims, rhsState.dims);
+    std::swap(lhsState.offsets, rhsState.offsets);
+    std::swap(lhsState.scalar, rhsState.scalar);
+    pred = getSwappedPredicate(pred);
+  }
+
+  if (lhsState.scalar || !rhsState.scalar || !lhsState.start ||
+      !lhsState.end) {
+    InFlightDiagnostic diag = emitError(loc) << "Unsupported cmpi scenario";
+    return failure();
+  }
 
   int32_t cmpDim = -1;
   for (int32_t i = 0; i < lhsState.getRank(); i++) {
@@ -339,22 +630,62 @@ LogicalResult MaskState::parseCmp(arith::CmpIOp cmpOp, const Location loc,
   assert(cmpDim != -1 &&
          "Unexpected case where no dimension has size larger than 1");
 
-  // Important:
-  // In the case where the values we are loading are entirely masked off like
-  // the following:
-  //
-  // ---|-------|-----------|
-  //    ^       ^           ^
-  //   scalar  start       end
-  //
-  // newEnd = min(end, scalar) = scalar
-  // Now scalar < start, so simply doing dim = newEnd - start is incorrect.
-  //
-  // The correct formula is to optionally move `newDim` back to `start` using
-  // max(newEnd, start).
-  auto newEnd = minOFRs(lhsState.end, rhsState.scalar, loc, builder);
-  newEnd = maxOFRs(newEnd, lhsState.start, loc, builder);
-  auto newDim = subOFRs(newEnd, lhsState.start, loc, builder);
+  rhsState.scalar = foldConstant(rhsState.scalar, builder);
+
+  auto one = builder.getIndexAttr(1);
+  bool isUpperBound = false;
+  OpFoldResult bound;
+  switch (pred) {
+  case arith::CmpIPredicate::slt:
+  case arith::CmpIPredicate::ult:
+    isUpperBound = true;
+    bound = rhsState.scalar;
+    break;
+  case arith::CmpIPredicate::sle:
+  case arith::CmpIPredicate::ule:
+    isUpperBound = true;
+    bound = addOFRs(rhsState.scalar, one, loc, builder);
+    break;
+  case arith::CmpIPredicate::sgt:
+  case arith::CmpIPredicate::ugt:
+    bound = addOFRs(rhsState.scalar, one, loc, builder);
+    break;
+  case arith::CmpIPredicate::sge:
+  case arith::CmpIPredicate::uge:
+    bound = rhsState.scalar;
+    break;
+  default:
+    InFlightDiagnostic diag = emitError(loc) << "Unsupported cmpi";
+    return failure();
+  }
+
+  OpFoldResult newDim;
+  OpFoldResult newOffset;
+  if (isUpperBound) {
+    // Important:
+    // In the case where the values we are loading are entirely masked off
+    // like the following:
+    //
+    // ---|-------|-----------|
+    //    ^       ^           ^
+    //   scalar  start       end
+    //
+    // newEnd = min(end, scalar) = scalar
+    // Now scalar < start, so simply doing dim = newEnd - start is incorrect.
+    //
+    // The correct formula is to optionally move `newDim` back to `start` using
+    // max(newEnd, start).
+    auto newEnd = minOFRs(lhsState.end, bound, loc, builder);
+    newEnd = maxOFRs(newEnd, lhsState.start, loc, builder);
+    newDim = subOFRs(newEnd, lhsState.start, loc, builder);
+  } else {
+    // Symmetrically, clamp the new start of the range to [start, end] so that
+    // a range that is entirely masked off results in an empty box.
+    auto newStart = maxOFRs(lhsState.start, bound, loc, builder);
+    newStart = minOFRs(newStart, lhsState.end, loc, builder);
+    newOffset = subOFRs(newStart, lhsState.start, loc, builder);
+    newDim = subOFRs(lhsState.end, newStart, loc, builder);
+  }
 
   for (int32_t i = 0; i < lhsState.getRank(); i++) {
     if (i == cmpDim)
@@ -363,6 +694,11 @@ LogicalResult MaskState::parseCmp(arith::CmpIOp cmpOp, const Location loc,
       this->dims.push_back(lhsState.dims[i]);
   }
 
+  if (newOffset) {
+    this->offsets.assign(lhsState.getRank(), builder.getIndexAttr(0));
+    this->offsets[cmpDim] = newOffset;
+  }
+
   return success();
 }
 
@@ -464,9 +800,11 @@ LogicalResult MaskState::parseBroadcast(triton::BroadcastOp broadcastOp,
   for (size_t i = 0; i < srcShape.size(); i++) {
     if (srcShape[i] == dstShape[i])
       continue;
-    else if (srcShape[i] < dstShape[i])
+    else if (srcShape[i] < dstShape[i]) {
       this->dims[i] = builder.getIndexAttr(dstShape[i]);
-    else
+      if (this->hasOffsets())
+        this->offsets[i] = builder.getIndexAttr(0);
+    } else
       llvm_unreachable("unexpected dimensions used in broadcast");
   }
 
@@ -511,6 +849,9 @@ LogicalResult MaskState::parseExpandDims(triton::ExpandDimsOp expandDimsOp,
   assert(dstShape[axis] == 1 &&
          "expect changed dimension to be 1 in expand_dims");
   this->dims.insert(this->dims.begin() + axis, builder.getIndexAttr(1));
+  if (this->hasOffsets())
+    this->offsets.insert(this->offsets.begin() + axis,
+                         builder.getIndexAttr(0));
 
   return success();
 }
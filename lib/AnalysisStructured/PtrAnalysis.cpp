@@ -8,6 +8,7 @@
 #include "triton-shared/AnalysisStructured/PtrAnalysis.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
 #include "mlir/Dialect/Utils/StaticValueUtils.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/BuiltinTypes.h"
@@ -702,6 +703,68 @@ LogicalResult PtrAnalysis::visitOperandForOp(scf::ForOp forOp, Value operand,
   return success();
 }
 
+// Whether `value` can be used at the insertion point of `builder`: it is
+// defined in the insertion block, before the insertion point, or in the block
+// of one of its ancestors, before the op containing the insertion point.
+static bool isAvailableAt(Value value, OpBuilder &builder) {
+  Block *defBlock = value.getParentBlock();
+  Block *block = builder.getInsertionBlock();
+  Block::iterator point = builder.getInsertionPoint();
+  while (block != defBlock) {
+    Operation *parentOp = block->getParentOp();
+    if (!parentOp || !parentOp->getBlock()) {
+      return false;
+    }
+    point = Block::iterator(parentOp);
+    block = parentOp->getBlock();
+  }
+  auto defOp = value.getDefiningOp();
+  return !defOp || point == block->end() || defOp->isBeforeInBlock(&*point);
+}
+
+static bool isAvailableAt(const PtrState &state, OpBuilder &builder) {
+  auto available = [&](OpFoldResult ofr) {
+    auto value = dyn_cast<Value>(ofr);
+    return !value || isAvailableAt(value, builder);
+  };
+  return (!state.source || isAvailableAt(state.source, builder)) &&
+         (!state.scalar || isAvailableAt(state.scalar, builder)) &&
+         llvm::all_of(state.offsets, available) &&
+         llvm::all_of(state.sizes, available) &&
+         llvm::all_of(state.strides, available) &&
+         llvm::all_of(state.shape, available);
+}
+
+void PtrAnalysis::forgetOperandStates(Operation *op) {
+  if (op->getNumResults() == 0 || operandStates.empty()) {
+    return;
+  }
+  auto definedByOp = [&](Value value) {
+    return value && value.getDefiningOp() == op;
+  };
+  auto refersToOp = [&](const PtrState &state) {
+    auto defined = [&](OpFoldResult ofr) {
+      return definedByOp(dyn_cast<Value>(ofr));
+    };
+    return definedByOp(state.source) || definedByOp(state.scalar) ||
+           llvm::any_of(state.offsets, defined) ||
+           llvm::any_of(state.sizes, defined) ||
+           llvm::any_of(state.strides, defined) ||
+           llvm::any_of(state.shape, defined);
+  };
+  // Drop the states of the results of `op`, and the states built from them:
+  // these would otherwise refer to values of an erased op.
+  SmallVector<Value> stale;
+  for (auto &[value, state] : operandStates) {
+    if (definedByOp(value) || refersToOp(state)) {
+      stale.push_back(value);
+    }
+  }
+  for (auto value : stale) {
+    operandStates.erase(value);
+  }
+}
+
 LogicalResult PtrAnalysis::visitOperand(Value operand, PtrState &state,
                                         const Location loc,
                                         OpBuilder &builder) {
@@ -711,6 +774,25 @@ LogicalResult PtrAnalysis::visitOperand(Value operand, PtrState &state,
     return success();
   }
 
+  // The offsets of the loads and stores of a kernel usually share most of
+  // their expression DAG. Reuse the state of an operand visited before, along
+  // with the ops built for it, if these ops can be used here.
+  auto cached = operandStates.find(operand);
+  if (cached != operandStates.end() && isAvailableAt(cached->second, builder)) {
+    state = cached->second;
+    return success();
+  }
+
+  if (visitOperandUncached(operand, state, loc, builder).failed()) {
+    return failure();
+  }
+  operandStates[operand] = state;
+  return success();
+}
+
+LogicalResult PtrAnalysis::visitOperandUncached(Value operand, PtrState &state,
+                                                const Location loc,
+                                                OpBuilder &builder) {
   if (isa<IntegerType>(operand.getType())) {
     OpBuilder::InsertionGuard guard(builder);
     if (!isa<BlockArgument>(operand) && operand.getDefiningOp()) {
@@ -1036,6 +1118,71 @@ LogicalResult PtrAnalysis::rewriteForOp(scf::ForOp op) {
   return success();
 }
 
+// Whether the offsets of `state`, the PtrState of the tensor of pointers
+// `tritonValue`, can be carried by a loop as a single linear offset. The
+// iter-args of a structured pointer only contribute the sum of their offsets to
+// the tts.make_tptr ops built from them; modulo and block pointer states
+// instead address each dimension on its own.
+static bool canLinearizeLoopState(Value tritonValue, const PtrState &state) {
+  return isa<RankedTensorType>(tritonValue.getType()) &&
+         isPointerType(tritonValue.getType()) && state.source &&
+         state.getRank() > 1 && !state.hasModulo() && !state.isBlockPtr();
+}
+
+// Whether the values of `op` are only used as the init-args or yielded values
+// of scf.for ops.
+static bool feedsForOpsOnly(tts::GetStructuredStateOp op) {
+  return llvm::all_of(op->getUsers(), [](Operation *user) {
+    if (isa<scf::ForOp>(user)) {
+      return true;
+    }
+    auto yieldOp = dyn_cast<scf::YieldOp>(user);
+    return yieldOp && isa<scf::ForOp>(yieldOp->getParentOp());
+  });
+}
+
+// The iter-arg that carries the first offset of `op` if `op` computes the
+// values yielded by an scf.for, null otherwise.
+static Value getRunningOffsetIterArg(tts::GetStructuredStateOp op) {
+  for (OpOperand &use : op->getResult(1).getUses()) {
+    if (auto yieldOp = dyn_cast<scf::YieldOp>(use.getOwner())) {
+      return cast<scf::ForOp>(yieldOp->getParentOp())
+          .getRegionIterArg(use.getOperandNumber());
+    }
+  }
+  return nullptr;
+}
+
+// The sum of the offsets of `state`. When the first offset is `runningOffset`
+// plus an increment, the increment is added to the other offsets first: these
+// do not depend on the loop iteration for a pointer advanced by a constant
+// step, so that the loop advances its running offset with a single add.
+static OpFoldResult getLinearOffset(const PtrState &state, Value runningOffset,
+                                    Location loc, OpBuilder &builder) {
+  SmallVector<OpFoldResult> terms = state.offsets;
+  OpFoldResult base = builder.getIndexAttr(0);
+  if (auto first = dyn_cast<Value>(terms[0]); first && runningOffset) {
+    if (first == runningOffset) {
+      base = runningOffset;
+      terms[0] = builder.getIndexAttr(0);
+    } else if (auto addOp = first.getDefiningOp<arith::AddIOp>()) {
+      if (addOp.getLhs() == runningOffset) {
+        base = runningOffset;
+        terms[0] = addOp.getRhs();
+      } else if (addOp.getRhs() == runningOffset) {
+        base = runningOffset;
+        terms[0] = addOp.getLhs();
+      }
+    }
+  }
+
+  OpFoldResult increment = builder.getIndexAttr(0);
+  for (auto term : terms) {
+    increment = addOFRs(increment, term, loc, builder);
+  }
+  return addOFRs(base, increment, loc, builder);
+}
+
 LogicalResult
 PtrAnalysis::rewriteGetStructuredStateOp(tts::GetStructuredStateOp op) {
   auto tritonValue = op->getOperand(0);
@@ -1070,7 +1217,17 @@ PtrAnalysis::rewriteGetStructuredStateOp(tts::GetStructuredStateOp op) {
           op.getLoc(), builder.getIndexAttr(0)));
     }
   } else {
-    for (auto [j, s] : llvm::enumerate(state.offsets)) {
+    // Loops carry the linear offset of a structured tensor of pointers in the
+    // first offset and zeros in the others, instead of rebuilding all the
+    // offsets of the pointer at each iteration.
+    SmallVector<OpFoldResult> offsets = state.offsets;
+    if (canLinearizeLoopState(tritonValue, state) && feedsForOpsOnly(op)) {
+      offsets.assign(state.getRank(), builder.getIndexAttr(0));
+      offsets[0] = getLinearOffset(state, getRunningOffsetIterArg(op),
+                                   op.getLoc(), builder);
+    }
+
+    for (auto [j, s] : llvm::enumerate(offsets)) {
       auto sIntAttr = getIntAttr(s);
       if (sIntAttr) {
         auto constOp = builder.create<arith::ConstantOp>(
@@ -1094,10 +1251,132 @@ PtrAnalysis::rewriteGetStructuredStateOp(tts::GetStructuredStateOp op) {
   }
 
   op->replaceAllUsesWith(replacements);
+  forgetOperandStates(op);
   op->erase();
   return success();
 }
 
+// Decompose a tensor of pointers that PtrAnalysis could not structure into a
+// scalar base pointer and a tensor of element offsets from that base, by
+// walking back through the splat, addptr, broadcast and expand_dims ops that
+// produced it. The offsets are computed with new ops inserted at the current
+// insertion point of `builder`.
+static FailureOr<std::pair<Value, Value>>
+getBaseAndOffsets(Value ptr, Location loc, OpBuilder &builder) {
+  auto ptrType = dyn_cast<RankedTensorType>(ptr.getType());
+  if (!ptrType || !isa<triton::PointerType>(ptrType.getElementType())) {
+    return failure();
+  }
+
+  auto getOffsetType = [&](Type elemType) {
+    return RankedTensorType::get(ptrType.getShape(), elemType);
+  };
+
+  auto extendTo = [&](Value offsets, Type elemType) -> Value {
+    auto offsetsType = cast<RankedTensorType>(offsets.getType());
+    if (offsetsType.getElementType().getIntOrFloatBitWidth() >=
+        elemType.getIntOrFloatBitWidth()) {
+      return offsets;
+    }
+    return builder.create<arith::ExtSIOp>(loc, getOffsetType(elemType),
+                                          offsets);
+  };
+
+  Operation *defOp = ptr.getDefiningOp();
+  if (!defOp) {
+    return failure();
+  }
+
+  if (auto splatOp = dyn_cast<triton::SplatOp>(defOp)) {
+    auto offsetType = getOffsetType(builder.getI32Type());
+    Value zeros = builder.create<arith::ConstantOp>(
+        loc, DenseElementsAttr::get(offsetType, builder.getI32IntegerAttr(0)));
+    return std::make_pair(splatOp.getSrc(), zeros);
+  }
+
+  if (auto addptrOp = dyn_cast<triton::AddPtrOp>(defOp)) {
+    auto src = getBaseAndOffsets(addptrOp.getPtr(), loc, builder);
+    if (failed(src)) {
+      return failure();
+    }
+    auto [base, offsets] = *src;
+    Value offset = addptrOp.getOffset();
+    auto offsetElemType =
+        cast<RankedTensorType>(offset.getType()).getElementType();
+    auto srcElemType =
+        cast<RankedTensorType>(offsets.getType()).getElementType();
+    Type elemType =
+        offsetElemType.getIntOrFloatBitWidth() >
+                srcElemType.getIntOrFloatBitWidth()
+            ? offsetElemType
+            : srcElemType;
+    Value sum = builder.create<arith::AddIOp>(
+        loc, extendTo(offsets, elemType), extendTo(offset, elemType));
+    return std::make_pair(base, sum);
+  }
+
+  if (auto broadcastOp = dyn_cast<triton::BroadcastOp>(defOp)) {
+    auto src = getBaseAndOffsets(broadcastOp.getSrc(), loc, builder);
+    if (failed(src)) {
+      return failure();
+    }
+    auto [base, offsets] = *src;
+    auto elemType = cast<RankedTensorType>(offsets.getType()).getElementType();
+    Value broadcast = builder.create<triton::BroadcastOp>(
+        loc, getOffsetType(elemType), offsets);
+    return std::make_pair(base, broadcast);
+  }
+
+  if (auto expandDimsOp = dyn_cast<triton::ExpandDimsOp>(defOp)) {
+    auto src = getBaseAndOffsets(expandDimsOp.getSrc(), loc, builder);
+    if (failed(src)) {
+      return failure();
+    }
+    auto [base, offsets] = *src;
+    Value expanded = builder.create<triton::ExpandDimsOp>(
+        loc, offsets, expandDimsOp.getAxis());
+    return std::make_pair(base, expanded);
+  }
+
+  return failure();
+}
+
+// Masks such as `offs >= lo && offs < hi` select a box that does not start at
+// the origin of the tensor. tts.load and tts.store only take the sizes of the
+// box, so move the pointer to the first element of the box instead. Only
+// structured pointers are supported; the offsets of a block pointer are
+// bounds-checked against its shape and those of a wraparound pointer are
+// brought back into the wrapped region.
+static FailureOr<Value> shiftToMaskOffsets(Value ptr,
+                                           const triton::MaskState &mstate,
+                                           const Location loc,
+                                           OpBuilder &builder) {
+  auto makeTPtrOp = ptr.getDefiningOp<tts::MakeTensorPtrOp>();
+  if (!makeTPtrOp || !makeTPtrOp.isStructuredPtr()) {
+    return failure();
+  }
+
+  auto offsets = makeTPtrOp.getMixedOffsets();
+  auto strides = makeTPtrOp.getMixedStrides();
+  for (auto [i, maskOffset] : llvm::enumerate(mstate.offsets)) {
+    auto staticOffset = getIntAttr(maskOffset);
+    if (staticOffset && staticOffset.value() == 0) {
+      continue;
+    }
+    auto scaled = mulOFRValue(strides[i],
+                              ofrToIndexValue(maskOffset, loc, builder), loc,
+                              builder);
+    offsets[i] = addOFRs(offsets[i], scaled, loc, builder);
+  }
+
+  return builder
+      .create<tts::MakeTensorPtrOp>(loc, makeTPtrOp.getBase(),
+                                    makeTPtrOp.getSizes(), strides, offsets,
+                                    makeTPtrOp.getMixedShape(),
+                                    makeTPtrOp.getOrder())
+      .getResult();
+}
+
 LogicalResult PtrAnalysis::rewriteLoadOp(triton::LoadOp op,
                                          bool useUnsafeMask) {
   auto ptr = ptrMap.lookupOrNull(op.getPtr());
@@ -1106,9 +1385,28 @@ LogicalResult PtrAnalysis::rewriteLoadOp(triton::LoadOp op,
   auto loc = op.getLoc();
 
   if (!ptr) {
-    op->emitRemark("PtrAnalysis: pointer is not replace with tts.make_tptr so "
-                   "loadOp cannot be rewritten");
-    return failure();
+    // Fall back to a gather when the tensor of pointers is not structured,
+    // e.g. when it is indexed by the result of another load.
+    OpBuilder builder(op);
+    auto baseAndOffsets = getBaseAndOffsets(op.getPtr(), loc, builder);
+    if (failed(baseAndOffsets)) {
+      op->emitRemark("PtrAnalysis: pointer is not replace with tts.make_tptr "
+                     "so loadOp cannot be rewritten");
+      return failure();
+    }
+    auto [base, offsets] = *baseAndOffsets;
+    auto gatherOp = builder.create<tts::GatherOp>(
+        loc, op.getType(), base, offsets, mask, mask ? other : Value());
+
+    LLVM_DEBUG({
+      llvm::dbgs() << "creating tts::gather:\n";
+      gatherOp->dump();
+    });
+
+    op.replaceAllUsesWith(gatherOp.getResult());
+    forgetOperandStates(op);
+    op->erase();
+    return success();
   }
 
   auto ptrType = dyn_cast<triton::PointerType>(ptr.getType());
@@ -1143,6 +1441,16 @@ LogicalResult PtrAnalysis::rewriteLoadOp(triton::LoadOp op,
     }
   }
 
+  if (mstate.hasOffsets()) {
+    auto shifted = shiftToMaskOffsets(ptr, mstate, loc, builder);
+    if (failed(shifted)) {
+      op->emitRemark("PtrAnalysis: mask with a lower bound is only supported "
+                     "on structured pointers");
+      return failure();
+    }
+    ptr = *shifted;
+  }
+
   auto loadOp = builder.create<tts::LoadOp>(loc, ptr, dims, scalarOther);
 
   LLVM_DEBUG({
@@ -1150,7 +1458,28 @@ LogicalResult PtrAnalysis::rewriteLoadOp(triton::LoadOp op,
     loadOp->dump();
   });
 
-  op.replaceAllUsesWith(loadOp.getResult());
+  Value result = loadOp.getResult();
+  if (mstate.hasOffsets()) {
+    // The box was loaded to the origin of the result, move it back in place.
+    Value dst;
+    if (scalarOther) {
+      dst = builder.create<triton::SplatOp>(loc, op.getType(), scalarOther);
+    } else {
+      auto resultType = cast<RankedTensorType>(op.getType());
+      dst = builder.create<tensor::EmptyOp>(loc, resultType.getShape(),
+                                            resultType.getElementType());
+    }
+    SmallVector<OpFoldResult> zeros(mstate.getRank(), builder.getIndexAttr(0));
+    SmallVector<OpFoldResult> ones(mstate.getRank(), builder.getIndexAttr(1));
+    auto box = builder.create<tensor::ExtractSliceOp>(loc, result, zeros,
+                                                      mstate.dims, ones);
+    result = builder.create<tensor::InsertSliceOp>(loc, box, dst,
+                                                   mstate.offsets, mstate.dims,
+                                                   ones);
+  }
+
+  op.replaceAllUsesWith(result);
+  forgetOperandStates(op);
   op->erase();
   return success();
 }
@@ -1243,9 +1572,25 @@ LogicalResult PtrAnalysis::rewriteStoreOp(triton::StoreOp op,
   auto loc = op.getLoc();
 
   if (!ptr) {
-    op->emitRemark("PtrAnalysis: pointer is not replace with tts.make_tptr so "
-                   "storeOp cannot be rewritten");
-    return failure();
+    OpBuilder builder(op);
+    auto baseAndOffsets = getBaseAndOffsets(op.getPtr(), loc, builder);
+    if (failed(baseAndOffsets)) {
+      op->emitRemark("PtrAnalysis: pointer is not replace with tts.make_tptr "
+                     "so storeOp cannot be rewritten");
+      return failure();
+    }
+    auto [base, offsets] = *baseAndOffsets;
+    auto scatterOp =
+        builder.create<tts::ScatterOp>(loc, base, offsets, val, mask);
+
+    LLVM_DEBUG({
+      llvm::dbgs() << "creating tts::scatter:\n";
+      scatterOp->dump();
+    });
+
+    forgetOperandStates(op);
+    op->erase();
+    return success();
   }
 
   auto ptrType = dyn_cast<triton::PointerType>(ptr.getType());
@@ -1269,6 +1614,24 @@ LogicalResult PtrAnalysis::rewriteStoreOp(triton::StoreOp op,
     dims = mstate.dims;
   }
 
+  if (mstate.hasOffsets()) {
+    auto shifted = shiftToMaskOffsets(ptr, mstate, loc, builder);
+    if (failed(shifted)) {
+      op->emitRemark("PtrAnalysis: mask with a lower bound is only supported "
+                     "on structured pointers");
+      return failure();
+    }
+    ptr = *shifted;
+
+    // Move the box of stored values to the origin of the tensor to match the
+    // shifted pointer.
+    SmallVector<OpFoldResult> zeros(mstate.getRank(), builder.getIndexAttr(0));
+    SmallVector<OpFoldResult> ones(mstate.getRank(), builder.getIndexAttr(1));
+    auto box = mstate.getExtractSlice(val, loc, builder);
+    val = builder.create<tensor::InsertSliceOp>(loc, box, val, zeros,
+                                                mstate.dims, ones);
+  }
+
   auto storeOp = builder.create<tts::StoreOp>(loc, ptr, val, dims);
 
   LLVM_DEBUG({
@@ -1276,6 +1639,68 @@ LogicalResult PtrAnalysis::rewriteStoreOp(triton::StoreOp op,
     storeOp->dump();
   });
 
+  forgetOperandStates(op);
+  op->erase();
+  return success();
+}
+
+// Atomics on tensors of pointers are rewritten to tts.atomic_rmw and
+// tts.atomic_cas on a scalar base and element offsets, like unstructured
+// loads are rewritten to tts.gather: each element is updated independently,
+// so whether the pointers are structured does not matter. Atomics on scalar
+// pointers are left to StructuredToMemref.
+LogicalResult PtrAnalysis::rewriteAtomicRMWOp(triton::AtomicRMWOp op) {
+  if (!isa<RankedTensorType>(op.getPtr().getType())) {
+    return success();
+  }
+
+  OpBuilder builder(op);
+  auto loc = op.getLoc();
+  auto baseAndOffsets = getBaseAndOffsets(op.getPtr(), loc, builder);
+  if (failed(baseAndOffsets)) {
+    op->emitRemark("PtrAnalysis: cannot decompose the pointer of atomicRMWOp");
+    return failure();
+  }
+  auto [base, offsets] = *baseAndOffsets;
+  auto atomicOp = builder.create<tts::AtomicRMWOp>(
+      loc, op.getType(), op.getAtomicRmwOp(), base, offsets, op.getVal(),
+      op.getMask(), op.getSem(), op.getScope());
+
+  LLVM_DEBUG({
+    llvm::dbgs() << "creating tts::atomic_rmw:\n";
+    atomicOp->dump();
+  });
+
+  op.replaceAllUsesWith(atomicOp.getResult());
+  forgetOperandStates(op);
+  op->erase();
+  return success();
+}
+
+LogicalResult PtrAnalysis::rewriteAtomicCASOp(triton::AtomicCASOp op) {
+  if (!isa<RankedTensorType>(op.getPtr().getType())) {
+    return success();
+  }
+
+  OpBuilder builder(op);
+  auto loc = op.getLoc();
+  auto baseAndOffsets = getBaseAndOffsets(op.getPtr(), loc, builder);
+  if (failed(baseAndOffsets)) {
+    op->emitRemark("PtrAnalysis: cannot decompose the pointer of atomicCASOp");
+    return failure();
+  }
+  auto [base, offsets] = *baseAndOffsets;
+  auto atomicOp = builder.create<tts::AtomicCASOp>(
+      loc, op.getType(), base, offsets, op.getCmp(), op.getVal(), op.getSem(),
+      op.getScope());
+
+  LLVM_DEBUG({
+    llvm::dbgs() << "creating tts::atomic_cas:\n";
+    atomicOp->dump();
+  });
+
+  op.replaceAllUsesWith(atomicOp.getResult());
+  forgetOperandStates(op);
   op->erase();
   return success();
 }
@@ -1291,6 +1716,11 @@ LogicalResult PtrAnalysis::rewriteOp(Operation *rootOp, bool useUnsafeMask) {
       return WalkResult::advance();
     }
     return TypeSwitch<Operation *, WalkResult>(op)
+        .Case<triton::FuncOp>([&](auto) {
+          // The states of operands are only reused within a function.
+          operandStates.clear();
+          return WalkResult::advance();
+        })
         .Case<triton::AddPtrOp>([&](auto addptr) {
           if (rewriteAddptrOp(addptr).failed()) {
             addptr->emitRemark("PtrAnalysis: Failed to rewrite AddPtrOp");
@@ -1324,6 +1754,20 @@ LogicalResult PtrAnalysis::rewriteOp(Operation *rootOp, bool useUnsafeMask) {
           }
           return WalkResult::skip();
         })
+        .Case<triton::AtomicRMWOp>([&](auto atomic) {
+          if (rewriteAtomicRMWOp(atomic).failed()) {
+            atomic->emitRemark("PtrAnalysis: Failed to rewrite AtomicRMWOp");
+            return WalkResult::advance();
+          }
+          return WalkResult::skip();
+        })
+        .Case<triton::AtomicCASOp>([&](auto atomic) {
+          if (rewriteAtomicCASOp(atomic).failed()) {
+            atomic->emitRemark("PtrAnalysis: Failed to rewrite AtomicCASOp");
+            return WalkResult::advance();
+          }
+          return WalkResult::skip();
+        })
         .Case<scf::ForOp>([&](auto forOp) {
           // `rewriteForOp` recursively visits its children, so regardless
           // whether the rewrite succeeds or not, we need to return "skip" so
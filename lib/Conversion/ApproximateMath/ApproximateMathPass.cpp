@@ -0,0 +1,94 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// Transcendental math ops have no vector lowering on CPU: LLVM scalarizes
+// them into one libm call per element, which dominates elementwise kernels
+// such as GELU and softmax. This pass expands the selected ops into the
+// polynomial approximations provided by the math dialect instead.
+//
+//===----------------------------------------------------------------------===//
+
+#include "triton-shared/Conversion/ApproximateMath/ApproximateMath.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Math/IR/Math.h"
+#include "mlir/Dialect/Math/Transforms/Passes.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+#include "llvm/Support/Debug.h"
+
+#define DEBUG_TYPE "approximate-math"
+
+using namespace mlir;
+using namespace triton;
+
+namespace mlir {
+namespace triton {
+#define GEN_PASS_DEF_APPROXIMATEMATH
+#include "triton-shared/Conversion/ApproximateMath/Passes.h.inc"
+} // namespace triton
+} // namespace mlir
+
+namespace {
+
+static bool isHighAccuracyApproximation(Operation *op) {
+  return isa<math::ExpOp, math::ExpM1Op, math::LogOp, math::Log2Op,
+             math::Log1pOp, math::TanhOp>(op);
+}
+
+static bool isLowAccuracyApproximation(Operation *op) {
+  return isa<math::ErfOp, math::SinOp, math::CosOp, math::AsinOp,
+             math::AcosOp, math::AtanOp, math::Atan2Op, math::CbrtOp>(op);
+}
+
+class ApproximateMathPass
+    : public triton::impl::ApproximateMathBase<ApproximateMathPass> {
+  using ApproximateMathBase<ApproximateMathPass>::ApproximateMathBase;
+
+public:
+  void runOnOperation() override {
+    auto moduleOp = getOperation();
+    if (accuracy != "high" && accuracy != "low" && accuracy != "libm") {
+      moduleOp.emitError("approximate-math: accuracy must be one of high, "
+                         "low or libm");
+      return signalPassFailure();
+    }
+    if (accuracy == "libm") {
+      return;
+    }
+
+    SmallVector<Operation *> ops;
+    moduleOp.walk([&](Operation *op) {
+      if (isHighAccuracyApproximation(op) ||
+          (accuracy == "low" && isLowAccuracyApproximation(op))) {
+        ops.push_back(op);
+      }
+    });
+    if (ops.empty()) {
+      return;
+    }
+
+    RewritePatternSet patterns(&getContext());
+    populateMathPolynomialApproximationPatterns(patterns);
+    // The selected ops are rewritten along with the ops their expansion
+    // creates, e.g. the f32 op computing an f16 one; other math ops are left
+    // to libm.
+    GreedyRewriteConfig config;
+    config.strictMode = GreedyRewriteStrictness::ExistingAndNewOps;
+    if (failed(applyOpPatternsAndFold(ops, std::move(patterns), config))) {
+      return signalPassFailure();
+    }
+  }
+};
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>>
+triton::createApproximateMathPass() {
+  return std::make_unique<ApproximateMathPass>();
+}
@@ -0,0 +1,444 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// Scalar tt.load and tt.store ops are lowered one at a time to an access of a
+// one-element view of the buffer. This pass hoists the loop-invariant scalar
+// loads out of loops, and merges scalar accesses of neighbouring elements of
+// a buffer into vector accesses.
+//
+//===----------------------------------------------------------------------===//
+
+#include "triton-shared/Conversion/BatchScalarAccesses/BatchScalarAccesses.h"
+
+#include "mlir/Dialect/Affine/IR/AffineOps.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+
+#include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/Support/Debug.h"
+
+#include <map>
+#include <optional>
+
+#define DEBUG_TYPE "batch-scalar-accesses"
+
+using namespace mlir;
+using namespace triton;
+
+namespace mlir {
+namespace triton {
+#define GEN_PASS_DEF_BATCHSCALARACCESSES
+#include "triton-shared/Conversion/BatchScalarAccesses/Passes.h.inc"
+} // namespace triton
+} // namespace mlir
+
+namespace {
+
+// The buffer a scalar access goes through a view of, and the dynamic part of
+// the offset of that view, null if the offset is a constant.
+using AccessKey = std::pair<Value, Value>;
+
+// An affine.load or affine.store of the single element of `view`, at `key`
+// plus `offset` elements.
+struct ScalarAccess {
+  Operation *op;
+  memref::ReinterpretCastOp view;
+  AccessKey key;
+  int64_t offset;
+};
+
+static std::optional<ScalarAccess> getScalarAccess(Operation *op) {
+  Value memref;
+  AffineMap map;
+  if (auto load = dyn_cast<affine::AffineLoadOp>(op)) {
+    memref = load.getMemRef();
+    map = load.getAffineMap();
+  } else if (auto store = dyn_cast<affine::AffineStoreOp>(op)) {
+    memref = store.getMemRef();
+    map = store.getAffineMap();
+  } else {
+    return std::nullopt;
+  }
+  if (!map.isSingleConstant() || map.getSingleConstantResult() != 0) {
+    return std::nullopt;
+  }
+
+  // The one-element views created by the scalar load and store converters of
+  // StructuredToMemref.
+  auto view = memref.getDefiningOp<memref::ReinterpretCastOp>();
+  if (!view || view.getType().getShape() != ArrayRef<int64_t>{1} ||
+      view.getMixedOffsets().size() != 1 ||
+      getConstantIntValue(view.getMixedStrides()[0]) != 1) {
+    return std::nullopt;
+  }
+
+  Value source = view.getSource();
+  OpFoldResult offset = view.getMixedOffsets()[0];
+  if (auto constant = getConstantIntValue(offset)) {
+    return ScalarAccess{op, view, {source, Value()}, *constant};
+  }
+  auto dynamic = cast<Value>(offset);
+  if (auto add = dynamic.getDefiningOp<arith::AddIOp>()) {
+    if (auto constant = getConstantIntValue(add.getRhs())) {
+      return ScalarAccess{op, view, {source, add.getLhs()}, *constant};
+    }
+    if (auto constant = getConstantIntValue(add.getLhs())) {
+      return ScalarAccess{op, view, {source, add.getRhs()}, *constant};
+    }
+  }
+  return ScalarAccess{op, view, {source, dynamic}, 0};
+}
+
+// Whether `op`, or an op nested in it, may write memory or, unless
+// `writesOnly`, read it. Allocations are not accesses.
+static bool mayAccessMemory(Operation *op, bool writesOnly) {
+  if (auto iface = dyn_cast<MemoryEffectOpInterface>(op)) {
+    SmallVector<MemoryEffects::EffectInstance> effects;
+    iface.getEffects(effects);
+    for (auto &effect : effects) {
+      if (isa<MemoryEffects::Allocate>(effect.getEffect()) ||
+          (writesOnly && isa<MemoryEffects::Read>(effect.getEffect()))) {
+        continue;
+      }
+      return true;
+    }
+  } else if (!op->hasTrait<OpTrait::HasRecursiveMemoryEffects>()) {
+    return true;
+  }
+  if (op->hasTrait<OpTrait::HasRecursiveMemoryEffects>()) {
+    for (Region &region : op->getRegions()) {
+      for (Operation &nested : region.getOps()) {
+        if (mayAccessMemory(&nested, writesOnly)) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+static bool mayWriteMemory(Operation *op) { return mayAccessMemory(op, true); }
+
+// Whether the value is available before `loop`, or computed by pure ops of
+// its body from such values, in which case these ops are added to `ops`
+// after the ops computing their operands.
+static bool isLoopInvariant(Value v, scf::ForOp loop,
+                            llvm::SetVector<Operation *> &ops) {
+  if (loop.isDefinedOutsideOfLoop(v)) {
+    return true;
+  }
+  Operation *op = v.getDefiningOp();
+  if (!op || op->getBlock() != loop.getBody() || op->getNumRegions() != 0 ||
+      !isPure(op)) {
+    return false;
+  }
+  if (ops.contains(op)) {
+    return true;
+  }
+  for (Value operand : op->getOperands()) {
+    if (!isLoopInvariant(operand, loop, ops)) {
+      return false;
+    }
+  }
+  ops.insert(op);
+  return true;
+}
+
+static Operation *getFirstInBlock(ArrayRef<ScalarAccess> accesses) {
+  Operation *first = accesses.front().op;
+  for (auto &access : accesses) {
+    if (access.op->isBeforeInBlock(first)) {
+      first = access.op;
+    }
+  }
+  return first;
+}
+
+// A view of the `size` elements of the buffer of `key` starting at `start`.
+static Value createVectorView(const ScalarAccess &access, int64_t start,
+                              int64_t size, OpBuilder &b) {
+  Location loc = access.op->getLoc();
+  auto [source, base] = access.key;
+  OpFoldResult offset = b.getIndexAttr(start);
+  int64_t layoutOffset = start;
+  if (base) {
+    offset = base;
+    if (start != 0) {
+      offset = b.create<arith::AddIOp>(
+                    loc, base, b.create<arith::ConstantIndexOp>(loc, start))
+                   .getResult();
+    }
+    layoutOffset = ShapedType::kDynamic;
+  }
+  auto viewType = access.view.getType();
+  auto layout = StridedLayoutAttr::get(b.getContext(), layoutOffset, {1});
+  auto type = MemRefType::get({size}, viewType.getElementType(), layout,
+                              viewType.getMemorySpace());
+  return b.create<memref::ReinterpretCastOp>(
+      loc, type, source, offset, ArrayRef<OpFoldResult>{b.getIndexAttr(size)},
+      ArrayRef<OpFoldResult>{b.getIndexAttr(1)});
+}
+
+class BatchScalarAccessesPass
+    : public triton::impl::BatchScalarAccessesBase<BatchScalarAccessesPass> {
+  using BatchScalarAccessesBase<
+      BatchScalarAccessesPass>::BatchScalarAccessesBase;
+
+public:
+  void runOnOperation() override {
+    if (maxVectorElements < 2) {
+      getOperation().emitError(
+          "batch-scalar-accesses: max-vector-elements must be at least 2");
+      return signalPassFailure();
+    }
+
+    // Inner loops first, so that their hoisted loads can be hoisted out of
+    // the outer loops as well.
+    SmallVector<scf::ForOp> loops;
+    getOperation().walk([&](scf::ForOp loop) { loops.push_back(loop); });
+    for (auto loop : loops) {
+      hoistInvariantLoads(loop);
+    }
+
+    SmallVector<Block *> blocks;
+    getOperation().walk([&](Block *block) { blocks.push_back(block); });
+    for (Block *block : blocks) {
+      batchAccesses(*block);
+    }
+  }
+
+private:
+  void hoistInvariantLoads(scf::ForOp loop) {
+    Block *body = loop.getBody();
+    for (Operation &op : *body) {
+      if (mayWriteMemory(&op)) {
+        return;
+      }
+    }
+
+    llvm::SetVector<Operation *> invariantOps;
+    SmallVector<affine::AffineLoadOp> loads;
+    for (auto load : body->getOps<affine::AffineLoadOp>()) {
+      llvm::SetVector<Operation *> ops = invariantOps;
+      if (getScalarAccess(load) &&
+          isLoopInvariant(load.getMemRef(), loop, ops)) {
+        invariantOps = std::move(ops);
+        loads.push_back(load);
+      }
+    }
+    if (loads.empty()) {
+      return;
+    }
+
+    LLVM_DEBUG(llvm::dbgs() << "hoisting " << loads.size()
+                            << " scalar loads out of loop at " << loop.getLoc()
+                            << "\n");
+
+    for (Operation *op : invariantOps) {
+      op->moveBefore(loop);
+    }
+
+    auto lowerBound = getConstantIntValue(loop.getLowerBound());
+    auto upperBound = getConstantIntValue(loop.getUpperBound());
+    if (lowerBound && upperBound && *lowerBound < *upperBound) {
+      for (auto load : loads) {
+        load->moveBefore(loop);
+      }
+      return;
+    }
+
+    // The loop may not run, in which case its loads might not be valid
+    // accesses: only load if it runs at least once.
+    Location loc = loop.getLoc();
+    OpBuilder b(loop);
+    Value runs = b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::slt,
+                                         loop.getLowerBound(),
+                                         loop.getUpperBound());
+    SmallVector<Type> types;
+    for (auto load : loads) {
+      types.push_back(load.getType());
+    }
+    auto ifOp = b.create<scf::IfOp>(loc, types, runs, /*addThenBlock=*/true,
+                                    /*addElseBlock=*/true);
+    SmallVector<Value> loaded;
+    for (auto [load, result] : llvm::zip(loads, ifOp.getResults())) {
+      load.getResult().replaceAllUsesWith(result);
+      load->moveBefore(ifOp.thenBlock(), ifOp.thenBlock()->end());
+      loaded.push_back(load.getResult());
+    }
+    b.setInsertionPointToEnd(ifOp.thenBlock());
+    b.create<scf::YieldOp>(loc, loaded);
+
+    b.setInsertionPointToEnd(ifOp.elseBlock());
+    SmallVector<Value> zeros;
+    for (Type type : types) {
+      zeros.push_back(b.create<arith::ConstantOp>(
+          loc, cast<TypedAttr>(b.getZeroAttr(type))));
+    }
+    b.create<scf::YieldOp>(loc, zeros);
+  }
+
+  void batchAccesses(Block &block) {
+    // Loads may be merged across ops that do not write memory, stores across
+    // ops that do not access memory. Stores of different buffers may alias,
+    // so only the stores of a single buffer are merged at a time.
+    llvm::MapVector<AccessKey, SmallVector<ScalarAccess>> loads;
+    SmallVector<ScalarAccess> stores;
+
+    auto flushLoads = [&]() {
+      for (auto &[key, group] : loads) {
+        batchLoads(group);
+      }
+      loads.clear();
+    };
+    auto flushStores = [&]() {
+      batchStores(stores);
+      stores.clear();
+    };
+
+    for (Operation &op : llvm::make_early_inc_range(block)) {
+      auto access = getScalarAccess(&op);
+      if (!access) {
+        if (mayWriteMemory(&op)) {
+          flushLoads();
+          flushStores();
+        } else if (mayAccessMemory(&op, /*writesOnly=*/false)) {
+          flushStores();
+        }
+        continue;
+      }
+      if (isa<affine::AffineLoadOp>(op)) {
+        flushStores();
+        loads[access->key].push_back(*access);
+        continue;
+      }
+      flushLoads();
+      if (!stores.empty() && stores.front().key != access->key) {
+        flushStores();
+      }
+      stores.push_back(*access);
+    }
+    flushLoads();
+    flushStores();
+  }
+
+  // Replace the loads of `group`, which have the same key, by vector loads of
+  // windows of at most maxVectorElements elements.
+  void batchLoads(ArrayRef<ScalarAccess> group) {
+    SmallVector<ScalarAccess> sorted(group);
+    llvm::stable_sort(sorted, [](const ScalarAccess &a, const ScalarAccess &b) {
+      return a.offset < b.offset;
+    });
+    for (size_t begin = 0; begin < sorted.size();) {
+      size_t end = begin + 1;
+      while (end < sorted.size() &&
+             sorted[end].offset - sorted[begin].offset < maxVectorElements) {
+        end++;
+      }
+      auto window = ArrayRef<ScalarAccess>(sorted).slice(begin, end - begin);
+      int64_t start = window.front().offset;
+      int64_t size = window.back().offset - start + 1;
+      if (size > 1) {
+        Operation *first = getFirstInBlock(window);
+        OpBuilder b(first);
+        Location loc = first->getLoc();
+        Value view = createVectorView(window.front(), start, size, b);
+        auto elementType = window.front().view.getType().getElementType();
+        auto vectorType = VectorType::get({size}, elementType);
+        Value zero = b.create<arith::ConstantIndexOp>(loc, 0);
+        Value vector =
+            b.create<vector::LoadOp>(loc, vectorType, view, ValueRange{zero});
+        for (auto &access : window) {
+          b.setInsertionPoint(access.op);
+          Value element = b.create<vector::ExtractOp>(
+              access.op->getLoc(), vector,
+              ArrayRef<int64_t>{access.offset - start});
+          access.op->getResult(0).replaceAllUsesWith(element);
+          access.op->erase();
+        }
+        LLVM_DEBUG(llvm::dbgs() << "merged " << window.size()
+                                << " scalar loads into a vector<" << size
+                                << "> load\n");
+      }
+      begin = end;
+    }
+  }
+
+  // Replace the stores of `group`, which have the same key and are in program
+  // order, by vector stores of runs of consecutive elements at the position
+  // of the last store of the group.
+  void batchStores(ArrayRef<ScalarAccess> group) {
+    if (group.size() < 2) {
+      return;
+    }
+    // The last store of each element; the earlier ones are overwritten.
+    std::map<int64_t, SmallVector<Operation *>> storesByOffset;
+    for (auto &access : group) {
+      storesByOffset[access.offset].push_back(access.op);
+    }
+    // The stores erased below may include the last one: insert after it.
+    Operation *last = group.back().op;
+    OpBuilder b(last->getBlock(), std::next(Block::iterator(last)));
+    Location loc = last->getLoc();
+
+    SmallVector<int64_t> offsets;
+    for (auto &[offset, stores] : storesByOffset) {
+      offsets.push_back(offset);
+    }
+    for (size_t begin = 0; begin < offsets.size();) {
+      size_t end = begin + 1;
+      while (end < offsets.size() && offsets[end] == offsets[end - 1] + 1 &&
+             offsets[end] - offsets[begin] < maxVectorElements) {
+        end++;
+      }
+      int64_t start = offsets[begin];
+      int64_t size = end - begin;
+      if (size > 1) {
+        auto elementType = group.front().view.getType().getElementType();
+        auto vectorType = VectorType::get({size}, elementType);
+        auto valueAt = [&](int64_t i) {
+          auto store =
+              cast<affine::AffineStoreOp>(storesByOffset[start + i].back());
+          return store.getValueToStore();
+        };
+        Value vector =
+            b.create<vector::BroadcastOp>(loc, vectorType, valueAt(0));
+        for (int64_t i = 1; i < size; i++) {
+          vector = b.create<vector::InsertOp>(loc, valueAt(i), vector,
+                                              ArrayRef<int64_t>{i});
+        }
+        Value view = createVectorView(group.front(), start, size, b);
+        Value zero = b.create<arith::ConstantIndexOp>(loc, 0);
+        b.create<vector::StoreOp>(loc, vector, view, ValueRange{zero});
+        for (int64_t i = 0; i < size; i++) {
+          for (Operation *store : storesByOffset[start + i]) {
+            store->erase();
+          }
+        }
+        LLVM_DEBUG(llvm::dbgs() << "merged the scalar stores of " << size
+                                << " elements into a vector store\n");
+      }
+      begin = end;
+    }
+  }
+};
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>>
+triton::createBatchScalarAccessesPass() {
+  return std::make_unique<BatchScalarAccessesPass>();
+}
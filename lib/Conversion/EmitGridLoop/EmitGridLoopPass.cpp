@@ -0,0 +1,204 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// The launcher calls a kernel once per program instance, so everything the
+// kernel computes before it reads its program ids (base offsets, strides,
+// constant tensors) is recomputed by every instance behind an opaque call.
+// This pass moves the loop over the program instances into the kernel, where
+// that work is visible as loop-invariant code.
+//
+//===----------------------------------------------------------------------===//
+
+#include "triton-shared/Conversion/EmitGridLoop/EmitGridLoop.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+
+#include "llvm/Support/Debug.h"
+
+#define DEBUG_TYPE "emit-grid-loop"
+
+using namespace mlir;
+using namespace triton;
+
+namespace mlir {
+namespace triton {
+#define GEN_PASS_DEF_EMITGRIDLOOP
+#include "triton-shared/Conversion/EmitGridLoop/Passes.h.inc"
+} // namespace triton
+} // namespace mlir
+
+namespace {
+
+// num_programs and program_id along each axis of the launch grid, appended to
+// the kernel arguments by TritonArithToLinalg's addProgramInfo.
+static constexpr unsigned kLaunchGridRank = 3;
+static constexpr unsigned kProgramInfoArgCount = 2 * kLaunchGridRank;
+
+static constexpr StringLiteral kArenaMarkFunc = "triton_shared_arena_mark";
+static constexpr StringLiteral kArenaReleaseFunc =
+    "triton_shared_arena_release";
+
+static func::FuncOp getOrCreateRuntimeFunc(ModuleOp module, StringRef name,
+                                           FunctionType type) {
+  if (auto func = module.lookupSymbol<func::FuncOp>(name)) {
+    return func;
+  }
+
+  auto builder = OpBuilder::atBlockBegin(module.getBody());
+  auto func = builder.create<func::FuncOp>(module.getLoc(), name, type);
+  func.setPrivate();
+  return func;
+}
+
+static bool hasProgramInfoArgs(func::FuncOp func) {
+  auto inputs = func.getArgumentTypes();
+  if (inputs.size() < kProgramInfoArgCount) {
+    return false;
+  }
+  return llvm::all_of(inputs.take_back(kProgramInfoArgCount),
+                      [](Type type) { return type.isInteger(32); });
+}
+
+class EmitGridLoopPass
+    : public triton::impl::EmitGridLoopBase<EmitGridLoopPass> {
+  using EmitGridLoopBase<EmitGridLoopPass>::EmitGridLoopBase;
+
+public:
+  void runOnOperation() override {
+    auto moduleOp = getOperation();
+
+    SmallVector<func::FuncOp> kernels;
+    moduleOp.walk([&](func::FuncOp func) {
+      if (!func.isExternal() && func.isPublic() &&
+          func.getNumResults() == 0 && hasProgramInfoArgs(func)) {
+        kernels.push_back(func);
+      }
+    });
+
+    for (auto func : kernels) {
+      emitGridLoop(moduleOp, func);
+    }
+  }
+
+private:
+  // kernel(args..., gridX, gridY, gridZ, x, y, z) becomes
+  // kernel(args..., gridX, gridY, gridZ, begin, end) running the program ids
+  // begin to end - 1 in the order of the launcher.
+  void emitGridLoop(ModuleOp moduleOp, func::FuncOp func) {
+    OpBuilder b(func.getContext());
+    Location loc = func.getLoc();
+    Type i32 = b.getI32Type();
+    Type i64 = b.getI64Type();
+    Type indexType = b.getIndexType();
+    unsigned numArgs = func.getNumArguments();
+    unsigned numKeptArgs = numArgs - kLaunchGridRank;
+
+    SmallVector<Type> inputs(func.getArgumentTypes().take_front(numKeptArgs));
+    inputs.append(2, i64);
+    SmallVector<DictionaryAttr> argAttrs;
+    bool hasArgAttrs = static_cast<bool>(func.getAllArgAttrs());
+    if (hasArgAttrs) {
+      func.getAllArgAttrs(argAttrs);
+    }
+
+    Region &funcBody = func.getBody();
+    Block *body = &funcBody.front();
+    Block *entry = new Block();
+    funcBody.push_front(entry);
+    for (Type type : inputs) {
+      entry->addArgument(type, loc);
+    }
+
+    b.setInsertionPointToStart(entry);
+    auto toIndex = [&](Value v) {
+      return b.create<arith::IndexCastOp>(loc, indexType, v).getResult();
+    };
+    Value gridY = toIndex(entry->getArgument(numKeptArgs - 2));
+    Value gridZ = toIndex(entry->getArgument(numKeptArgs - 1));
+    Value begin = toIndex(entry->getArgument(numKeptArgs));
+    Value end = toIndex(entry->getArgument(numKeptArgs + 1));
+    Value one = b.create<arith::ConstantIndexOp>(loc, 1);
+    auto loop = b.create<scf::ForOp>(loc, begin, end, one);
+    b.create<func::ReturnOp>(loc);
+
+    // Program ids are linearized with z varying fastest, like in the
+    // launcher.
+    b.setInsertionPointToStart(loop.getBody());
+    Value pid = loop.getInductionVar();
+    Value gridYZ = b.create<arith::MulIOp>(loc, gridY, gridZ);
+    Value x = b.create<arith::DivUIOp>(loc, pid, gridYZ);
+    Value y = b.create<arith::RemUIOp>(
+        loc, b.create<arith::DivUIOp>(loc, pid, gridZ), gridY);
+    Value z = b.create<arith::RemUIOp>(loc, pid, gridZ);
+    SmallVector<Value> programIds;
+    for (Value id : {x, y, z}) {
+      programIds.push_back(b.create<arith::IndexCastOp>(loc, i32, id));
+    }
+
+    Value mark;
+    if (releaseBuffers) {
+      auto markFunc = getOrCreateRuntimeFunc(
+          moduleOp, kArenaMarkFunc, b.getFunctionType({}, {i64}));
+      mark = b.create<func::CallOp>(loc, markFunc).getResult(0);
+    }
+
+    for (unsigned i = 0; i < numArgs; i++) {
+      Value replacement = i < numKeptArgs ? entry->getArgument(i)
+                                          : programIds[i - numKeptArgs];
+      body->getArgument(i).replaceAllUsesWith(replacement);
+    }
+    body->eraseArguments(0, numArgs);
+
+    Operation *yield = loop.getBody()->getTerminator();
+    if (std::next(funcBody.begin(), 2) == funcBody.end()) {
+      body->getTerminator()->erase();
+      loop.getBody()->getOperations().splice(Block::iterator(yield),
+                                             body->getOperations());
+      body->erase();
+    } else {
+      // Early returns leave the kernel with several blocks, which the scf.for
+      // body cannot hold.
+      b.setInsertionPoint(yield);
+      auto region = b.create<scf::ExecuteRegionOp>(loc, TypeRange{});
+      region.getRegion().getBlocks().splice(region.getRegion().end(),
+                                            funcBody.getBlocks(),
+                                            std::next(funcBody.begin()),
+                                            funcBody.end());
+      SmallVector<func::ReturnOp> returns;
+      region.walk([&](func::ReturnOp op) { returns.push_back(op); });
+      for (auto op : returns) {
+        OpBuilder rb(op);
+        rb.create<scf::YieldOp>(op.getLoc());
+        op->erase();
+      }
+    }
+
+    if (releaseBuffers) {
+      b.setInsertionPoint(yield);
+      auto releaseFunc = getOrCreateRuntimeFunc(
+          moduleOp, kArenaReleaseFunc, b.getFunctionType({i64}, {}));
+      b.create<func::CallOp>(loc, releaseFunc, mark);
+    }
+
+    func.setFunctionType(b.getFunctionType(inputs, {}));
+    if (hasArgAttrs) {
+      argAttrs.resize(numKeptArgs);
+      argAttrs.append(2, DictionaryAttr());
+      func.setAllArgAttrs(argAttrs);
+    }
+  }
+};
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> triton::createEmitGridLoopPass() {
+  return std::make_unique<EmitGridLoopPass>();
+}
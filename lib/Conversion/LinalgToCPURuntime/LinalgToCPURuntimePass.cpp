@@ -0,0 +1,176 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// The reference CPU backend otherwise lowers linalg.matmul to a naive triple
+// loop nest. This pass hands bufferized matmuls over to the runtime routines
+// of the runtime library (backend/include/Runtime/Matmul.h), which tile for
+// the cache hierarchy, pack A and B panels and use a register-blocked
+// micro-kernel. f16 and bf16 inputs accumulated into f32 are handled too: the
+// runtime widens them while packing.
+//
+//===----------------------------------------------------------------------===//
+
+#include "triton-shared/Conversion/LinalgToCPURuntime/LinalgToCPURuntime.h"
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/IR/AffineMap.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/TypeUtilities.h"
+
+#include "llvm/Support/Debug.h"
+
+#include <optional>
+
+#define DEBUG_TYPE "linalg-to-cpu-runtime"
+
+using namespace mlir;
+using namespace triton;
+
+namespace mlir {
+namespace triton {
+#define GEN_PASS_DEF_LINALGTOCPURUNTIME
+#include "triton-shared/Conversion/LinalgToCPURuntime/Passes.h.inc"
+} // namespace triton
+} // namespace mlir
+
+namespace {
+
+// Runtime functions are declared with llvm.emit_c_interface so that they are
+// called through `_mlir_ciface_<name>(StridedMemRefType<T, 2> *...)`.
+static constexpr StringLiteral kEmitCInterfaceAttrName =
+    "llvm.emit_c_interface";
+
+// memref<?x?xT, strided<[?, ?], offset: ?>>: every 2D strided memref can be
+// cast to this type, so a single runtime entry point per element type covers
+// all matmuls.
+static MemRefType getRuntimeMemRefType(Type elemType) {
+  auto layout = StridedLayoutAttr::get(
+      elemType.getContext(), ShapedType::kDynamic,
+      {ShapedType::kDynamic, ShapedType::kDynamic});
+  return MemRefType::get({ShapedType::kDynamic, ShapedType::kDynamic},
+                         elemType, layout);
+}
+
+// Return the name of the runtime function implementing `op`, or std::nullopt
+// if `op` has to go through the default lowering.
+static std::optional<StringRef> getMatmulRuntimeFunc(linalg::MatmulOp op) {
+  if (!op.hasPureBufferSemantics() || op.getNumDpsInputs() != 2 ||
+      op.getNumDpsInits() != 1) {
+    return std::nullopt;
+  }
+
+  // Only handle the canonical C(m, n) += A(m, k) * B(k, n) form.
+  MLIRContext *ctx = op.getContext();
+  AffineExpr m, n, k;
+  bindDims(ctx, m, n, k);
+  SmallVector<AffineMap> expectedMaps{
+      AffineMap::get(3, 0, {m, k}, ctx), AffineMap::get(3, 0, {k, n}, ctx),
+      AffineMap::get(3, 0, {m, n}, ctx)};
+  if (op.getIndexingMapsArray() != expectedMaps) {
+    return std::nullopt;
+  }
+
+  // A and B share an element type; C either has the same one or is the f32
+  // accumulator of 16-bit inputs.
+  for (Value operand : op->getOperands()) {
+    auto type = dyn_cast<MemRefType>(operand.getType());
+    if (!type || !memref::CastOp::areCastCompatible(
+                     type, getRuntimeMemRefType(type.getElementType()))) {
+      return std::nullopt;
+    }
+  }
+  Type inType = getElementTypeOrSelf(op.getDpsInputs()[0].getType());
+  Type bType = getElementTypeOrSelf(op.getDpsInputs()[1].getType());
+  Type accType = getElementTypeOrSelf(op.getDpsInits()[0].getType());
+  if (inType != bType) {
+    return std::nullopt;
+  }
+
+  if (inType == accType && accType.isF32()) {
+    return StringRef("triton_shared_matmul_f32");
+  }
+  if (inType == accType && accType.isF64()) {
+    return StringRef("triton_shared_matmul_f64");
+  }
+  if (accType.isF32() && inType.isF16()) {
+    return StringRef("triton_shared_matmul_f16_f32");
+  }
+  if (accType.isF32() && inType.isBF16()) {
+    return StringRef("triton_shared_matmul_bf16_f32");
+  }
+  return std::nullopt;
+}
+
+static func::FuncOp getOrCreateRuntimeFunc(ModuleOp module, StringRef name,
+                                           TypeRange argTypes) {
+  if (auto func = module.lookupSymbol<func::FuncOp>(name)) {
+    return func;
+  }
+
+  auto builder = OpBuilder::atBlockBegin(module.getBody());
+  auto funcType = builder.getFunctionType(argTypes, {});
+  auto func = builder.create<func::FuncOp>(module.getLoc(), name, funcType);
+  func.setPrivate();
+  func->setAttr(kEmitCInterfaceAttrName, builder.getUnitAttr());
+  return func;
+}
+
+class LinalgToCPURuntimePass
+    : public triton::impl::LinalgToCPURuntimeBase<LinalgToCPURuntimePass> {
+  using LinalgToCPURuntimeBase<LinalgToCPURuntimePass>::LinalgToCPURuntimeBase;
+
+public:
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<func::FuncDialect, linalg::LinalgDialect,
+                    memref::MemRefDialect>();
+  }
+
+  void runOnOperation() override {
+    auto moduleOp = getOperation();
+
+    SmallVector<linalg::MatmulOp> matmuls;
+    moduleOp.walk([&](linalg::MatmulOp op) { matmuls.push_back(op); });
+
+    for (auto op : matmuls) {
+      auto name = getMatmulRuntimeFunc(op);
+      if (!name) {
+        LLVM_DEBUG({
+          llvm::dbgs() << "keeping default lowering for:\n";
+          op->dump();
+        });
+        continue;
+      }
+
+      OpBuilder builder(op);
+      auto loc = op.getLoc();
+      // Operands are ordered A, B, C; the runtime computes C += A * B.
+      SmallVector<Value> args;
+      SmallVector<Type> argTypes;
+      for (Value operand : op->getOperands()) {
+        auto runtimeType = getRuntimeMemRefType(
+            cast<MemRefType>(operand.getType()).getElementType());
+        args.push_back(
+            builder.create<memref::CastOp>(loc, runtimeType, operand));
+        argTypes.push_back(runtimeType);
+      }
+      auto func = getOrCreateRuntimeFunc(moduleOp, *name, argTypes);
+      builder.create<func::CallOp>(loc, func, args);
+      op->erase();
+    }
+  }
+};
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>>
+triton::createLinalgToCPURuntimePass() {
+  return std::make_unique<LinalgToCPURuntimePass>();
+}
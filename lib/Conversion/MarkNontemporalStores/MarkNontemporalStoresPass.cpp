@@ -0,0 +1,261 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// Kernels streaming a large output (elementwise ops, copies, the epilogue of
+// a matmul) write every line of it once and never read it back. Ordinary
+// stores first read each line into the cache, where it evicts the inputs
+// still to be read, and then write it back. This pass finds the memref
+// arguments a kernel only writes to and turns the vector stores to them into
+// nontemporal stores, which LLVM lowers to streaming stores that write the
+// lines to memory directly.
+//
+// Streaming stores are weakly ordered: they may become visible to other
+// threads after the stores and atomics that follow them. A function with
+// streaming stores therefore ends with a sequentially consistent fence
+// (mfence on x86, dmb on AArch64), which waits for them to reach memory, so
+// that whoever synchronizes with the end of the kernel sees its output. So
+// does every iteration of an scf.forall with streaming stores, which runs on
+// another thread.
+//
+//===----------------------------------------------------------------------===//
+
+#include "triton-shared/Conversion/MarkNontemporalStores/MarkNontemporalStores.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/LLVMIR/LLVMDialect.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/Interfaces/ViewLikeInterface.h"
+
+#include "llvm/ADT/SetVector.h"
+#include "llvm/Support/Debug.h"
+
+#define DEBUG_TYPE "mark-nontemporal-stores"
+
+using namespace mlir;
+using namespace triton;
+
+namespace mlir {
+namespace triton {
+#define GEN_PASS_DEF_MARKNONTEMPORALSTORES
+#include "triton-shared/Conversion/MarkNontemporalStores/Passes.h.inc"
+} // namespace triton
+} // namespace mlir
+
+namespace {
+
+// Whether every access to `arg`, or to a view of it, writes memory. The
+// stores through the argument are appended to `stores`.
+static bool isWriteOnly(Value arg, SmallVectorImpl<Operation *> &stores) {
+  SmallVector<Value> worklist{arg};
+  while (!worklist.empty()) {
+    Value value = worklist.pop_back_val();
+    for (OpOperand &use : value.getUses()) {
+      Operation *user = use.getOwner();
+      if (auto metadata = dyn_cast<memref::ExtractStridedMetadataOp>(user)) {
+        // The sizes and strides are not accesses.
+        worklist.push_back(metadata.getBaseBuffer());
+        continue;
+      }
+      if (auto view = dyn_cast<ViewLikeOpInterface>(user)) {
+        if (view.getViewSource() == value) {
+          worklist.push_back(user->getResult(0));
+          continue;
+        }
+      }
+      if (isa<memref::DimOp>(user)) {
+        continue;
+      }
+      if (auto store = dyn_cast<memref::StoreOp>(user)) {
+        if (store.getMemRef() == value) {
+          stores.push_back(user);
+          continue;
+        }
+      }
+      if (auto store = dyn_cast<vector::StoreOp>(user)) {
+        if (store.getBase() == value) {
+          stores.push_back(user);
+          continue;
+        }
+      }
+      if (auto store = dyn_cast<vector::MaskedStoreOp>(user)) {
+        if (store.getBase() == value) {
+          stores.push_back(user);
+          continue;
+        }
+      }
+      if (auto write = dyn_cast<vector::TransferWriteOp>(user)) {
+        if (write.getSource() == value) {
+          stores.push_back(user);
+          continue;
+        }
+      }
+      if (auto copy = dyn_cast<memref::CopyOp>(user)) {
+        if (copy.getTarget() == value && copy.getSource() != value) {
+          continue;
+        }
+      }
+      LLVM_DEBUG(llvm::dbgs() << "argument read by " << *user << "\n");
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether `type` has a unit innermost stride, so that a vector of its
+// innermost dimension is contiguous.
+static bool hasUnitInnermostStride(MemRefType type) {
+  SmallVector<int64_t> strides;
+  int64_t offset;
+  if (type.getRank() == 0 ||
+      failed(getStridesAndOffset(type, strides, offset))) {
+    return false;
+  }
+  return strides.back() == 1;
+}
+
+// Whether `write` stores a contiguous vector without a mask, which
+// vector.store can do.
+static bool isContiguousWrite(vector::TransferWriteOp write) {
+  auto memrefType = dyn_cast<MemRefType>(write.getShapedType());
+  VectorType vectorType = write.getVectorType();
+  return memrefType && !write.getMask() && vectorType.getRank() == 1 &&
+         !vectorType.isScalable() &&
+         vectorType.getElementType() == memrefType.getElementType() &&
+         write.getPermutationMap().isMinorIdentity() &&
+         hasUnitInnermostStride(memrefType);
+}
+
+static void createNontemporalStore(OpBuilder &b, Location loc,
+                                   vector::TransferWriteOp write) {
+  auto store = b.create<vector::StoreOp>(loc, write.getVector(),
+                                         write.getSource(), write.getIndices());
+  store.setNontemporal(true);
+}
+
+class MarkNontemporalStoresPass
+    : public triton::impl::MarkNontemporalStoresBase<
+          MarkNontemporalStoresPass> {
+  using MarkNontemporalStoresBase<
+      MarkNontemporalStoresPass>::MarkNontemporalStoresBase;
+
+public:
+  void runOnOperation() override {
+    getOperation().walk([&](func::FuncOp func) {
+      if (func.isExternal()) {
+        return;
+      }
+      bool marked = false;
+      llvm::SetVector<scf::ForallOp> foralls;
+      for (BlockArgument arg : func.getArguments()) {
+        SmallVector<Operation *> stores;
+        if (!isa<BaseMemRefType>(arg.getType()) ||
+            !isWriteOnly(arg, stores)) {
+          continue;
+        }
+        LLVM_DEBUG(llvm::dbgs() << "argument " << arg.getArgNumber() << " of "
+                                << func.getName() << " is write-only, "
+                                << stores.size() << " stores\n");
+        for (Operation *op : stores) {
+          auto forall = getOutermostForall(op);
+          bool streamed = false;
+          if (auto store = dyn_cast<vector::StoreOp>(op)) {
+            store.setNontemporal(true);
+            streamed = true;
+          } else if (auto write = dyn_cast<vector::TransferWriteOp>(op)) {
+            streamed = rewriteTransferWrite(write);
+          }
+          marked |= streamed;
+          if (streamed && forall) {
+            foralls.insert(forall);
+          }
+        }
+      }
+      if (marked) {
+        fenceStreamingStores(func, foralls.getArrayRef());
+      }
+    });
+  }
+
+private:
+  static scf::ForallOp getOutermostForall(Operation *op) {
+    scf::ForallOp outermost;
+    for (auto forall = op->getParentOfType<scf::ForallOp>(); forall;
+         forall = forall->getParentOfType<scf::ForallOp>()) {
+      outermost = forall;
+    }
+    return outermost;
+  }
+
+  // Order the streaming stores of `func` before its exits. The bodies of the
+  // scf.forall ops with streaming stores run on the threads of the runtime
+  // thread pool once outlined, and fence their own stores.
+  static void fenceStreamingStores(func::FuncOp func,
+                                   ArrayRef<scf::ForallOp> foralls) {
+    auto ordering = LLVM::AtomicOrderingAttr::get(
+        func.getContext(), LLVM::AtomicOrdering::seq_cst);
+    auto createFence = [&](Operation *before) {
+      OpBuilder b(before);
+      b.create<LLVM::FenceOp>(before->getLoc(), ordering,
+                              /*syncscope=*/StringAttr());
+    };
+    for (scf::ForallOp forall : foralls) {
+      createFence(forall.getBody()->getTerminator());
+    }
+    func.walk([&](func::ReturnOp ret) { createFence(ret); });
+  }
+
+  // Replace `write` by a nontemporal vector.store. When `write` may run out
+  // of bounds, only the vectors that fit in the buffer are stored that way;
+  // the tail keeps the masked store of the transfer_write. Return whether
+  // `write` was replaced.
+  bool rewriteTransferWrite(vector::TransferWriteOp write) {
+    if (!isContiguousWrite(write)) {
+      return false;
+    }
+
+    Location loc = write.getLoc();
+    OpBuilder b(write);
+    if (write.isDimInBounds(0)) {
+      createNontemporalStore(b, loc, write);
+      write.erase();
+      return true;
+    }
+
+    Value memref = write.getSource();
+    int64_t rank = cast<MemRefType>(memref.getType()).getRank();
+    Value size = b.create<memref::DimOp>(loc, memref, rank - 1);
+    Value length = b.create<arith::ConstantIndexOp>(
+        loc, write.getVectorType().getNumElements());
+    Value end = b.create<arith::AddIOp>(loc, write.getIndices().back(), length);
+    Value fits =
+        b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::sle, end, size);
+    b.create<scf::IfOp>(
+        loc, fits,
+        [&](OpBuilder &b, Location loc) {
+          createNontemporalStore(b, loc, write);
+          b.create<scf::YieldOp>(loc);
+        },
+        [&](OpBuilder &b, Location loc) {
+          b.clone(*write);
+          b.create<scf::YieldOp>(loc);
+        });
+    write.erase();
+    return true;
+  }
+};
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>>
+triton::createMarkNontemporalStoresPass() {
+  return std::make_unique<MarkNontemporalStoresPass>();
+}
@@ -0,0 +1,230 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// The scf.forall ops created by parallelize-linalg run on the thread pool of
+// the launcher (backend/include/Runtime/ThreadPool.h), not on a separate
+// OpenMP runtime, so that a launch never has more threads than it asked for.
+// This pass outlines the body of each of them into a function that runs a
+// range of iterations and calls the runtime with that function and a pointer
+// to the values the body captures.
+//
+//===----------------------------------------------------------------------===//
+
+#include "triton-shared/Conversion/OutlineParallelLoops/OutlineParallelLoops.h"
+
+#include "mlir/Conversion/LLVMCommon/TypeConverter.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Arith/Utils/Utils.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/LLVMIR/LLVMDialect.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Transforms/RegionUtils.h"
+
+#include "llvm/ADT/SetVector.h"
+#include "llvm/Support/Debug.h"
+
+#define DEBUG_TYPE "outline-parallel-loops"
+
+using namespace mlir;
+using namespace triton;
+
+namespace mlir {
+namespace triton {
+#define GEN_PASS_DEF_OUTLINEPARALLELLOOPS
+#include "triton-shared/Conversion/OutlineParallelLoops/Passes.h.inc"
+} // namespace triton
+} // namespace mlir
+
+namespace {
+
+// void triton_shared_parallel_for(int64_t n,
+//                                 void (*body)(void *ctx, int64_t, int64_t),
+//                                 void *ctx), see Runtime/Runtime.cpp.
+static constexpr StringLiteral kParallelForFunc = "triton_shared_parallel_for";
+
+static func::FuncOp getOrCreateRuntimeFunc(ModuleOp module, StringRef name,
+                                           FunctionType type) {
+  if (auto func = module.lookupSymbol<func::FuncOp>(name)) {
+    return func;
+  }
+
+  auto builder = OpBuilder::atBlockBegin(module.getBody());
+  auto func = builder.create<func::FuncOp>(module.getLoc(), name, type);
+  func.setPrivate();
+  return func;
+}
+
+static bool isSupported(scf::ForallOp forall) {
+  return forall.getRank() == 1 && forall.getOutputs().empty() &&
+         isConstantIntValue(forall.getMixedLowerBound()[0], 0) &&
+         isConstantIntValue(forall.getMixedStep()[0], 1);
+}
+
+// Cast `value` to `type` if it does not have it already.
+static Value castTo(OpBuilder &b, Location loc, Value value, Type type) {
+  if (value.getType() == type) {
+    return value;
+  }
+  return b.create<UnrealizedConversionCastOp>(loc, type, value).getResult(0);
+}
+
+class OutlineParallelLoopsPass
+    : public triton::impl::OutlineParallelLoopsBase<OutlineParallelLoopsPass> {
+  using OutlineParallelLoopsBase<
+      OutlineParallelLoopsPass>::OutlineParallelLoopsBase;
+
+public:
+  void runOnOperation() override {
+    auto moduleOp = getOperation();
+
+    SmallVector<scf::ForallOp> loops;
+    moduleOp.walk([&](scf::ForallOp forall) { loops.push_back(forall); });
+
+    LLVMTypeConverter converter(&getContext());
+    for (auto forall : loops) {
+      if (!isSupported(forall)) {
+        forall.emitError("outline-parallel-loops: expected a normalized 1-d "
+                         "scf.forall without shared outputs");
+        return signalPassFailure();
+      }
+      if (forall->getParentOfType<scf::ForallOp>()) {
+        forall.emitError("outline-parallel-loops: nested scf.forall ops are "
+                         "not supported");
+        return signalPassFailure();
+      }
+      if (failed(outline(moduleOp, forall, converter))) {
+        return signalPassFailure();
+      }
+    }
+  }
+
+private:
+  LogicalResult outline(ModuleOp moduleOp, scf::ForallOp forall,
+                        const LLVMTypeConverter &converter) {
+    MLIRContext *ctx = forall.getContext();
+    Location loc = forall.getLoc();
+    auto parent = forall->getParentOfType<func::FuncOp>();
+    Type i64 = IntegerType::get(ctx, 64);
+    Type indexType = IndexType::get(ctx);
+    auto ptrType = LLVM::LLVMPointerType::get(ctx);
+
+    // Constants are rematerialized in the outlined function, everything else
+    // the body uses from above goes through the context struct.
+    llvm::SetVector<Value> used;
+    getUsedValuesDefinedAbove(forall.getRegion(), used);
+    SmallVector<Value> constants, captures;
+    SmallVector<Type> fieldTypes;
+    for (Value value : used) {
+      if (matchPattern(value, m_Constant())) {
+        constants.push_back(value);
+        continue;
+      }
+      Type fieldType = converter.convertType(value.getType());
+      if (!fieldType || !LLVM::isCompatibleType(fieldType)) {
+        return forall.emitError("outline-parallel-loops: cannot pass a value "
+                                "of type ")
+               << value.getType() << " to the outlined body";
+      }
+      captures.push_back(value);
+      fieldTypes.push_back(fieldType);
+    }
+    auto structType = LLVM::LLVMStructType::getLiteral(ctx, fieldTypes);
+
+    // ctx, begin, end.
+    auto bodyType = FunctionType::get(ctx, {ptrType, i64, i64}, {});
+    std::string name;
+    do {
+      name = (parent.getName() + "_parallel" + Twine(counter++)).str();
+    } while (moduleOp.lookupSymbol(name));
+
+    OpBuilder b(parent);
+    b.setInsertionPointAfter(parent);
+    auto body = b.create<func::FuncOp>(loc, name, bodyType);
+    body.setPrivate();
+    body->setAttr("llvm.linkage",
+                  LLVM::LinkageAttr::get(ctx, LLVM::Linkage::Internal));
+    Block *entry = body.addEntryBlock();
+    b.setInsertionPointToStart(entry);
+
+    IRMapping mapping;
+    if (!captures.empty()) {
+      Value fields =
+          b.create<LLVM::LoadOp>(loc, structType, entry->getArgument(0));
+      for (auto [i, value] : llvm::enumerate(captures)) {
+        Value field = b.create<LLVM::ExtractValueOp>(loc, fields, i);
+        mapping.map(value, castTo(b, loc, field, value.getType()));
+      }
+    }
+    for (Value value : constants) {
+      b.clone(*value.getDefiningOp(), mapping);
+    }
+    Value begin =
+        b.create<arith::IndexCastOp>(loc, indexType, entry->getArgument(1));
+    Value end =
+        b.create<arith::IndexCastOp>(loc, indexType, entry->getArgument(2));
+    Value one = b.create<arith::ConstantIndexOp>(loc, 1);
+    auto loop = b.create<scf::ForOp>(loc, begin, end, one);
+    b.create<func::ReturnOp>(loc);
+
+    mapping.map(forall.getInductionVar(0), loop.getInductionVar());
+    b.setInsertionPoint(loop.getBody()->getTerminator());
+    for (Operation &op : forall.getBody()->without_terminator()) {
+      b.clone(op, mapping);
+    }
+
+    // The context struct lives in the frame of the caller, which waits for
+    // all the iterations to finish.
+    b.setInsertionPoint(forall);
+    Value context;
+    if (captures.empty()) {
+      context = b.create<LLVM::ZeroOp>(loc, ptrType);
+    } else {
+      OpBuilder entryBuilder = OpBuilder::atBlockBegin(&parent.front());
+      Value count = entryBuilder.create<LLVM::ConstantOp>(
+          loc, i64, entryBuilder.getI64IntegerAttr(1));
+      context = entryBuilder.create<LLVM::AllocaOp>(loc, ptrType, structType,
+                                                    count);
+      Value fields = b.create<LLVM::UndefOp>(loc, structType);
+      for (auto [i, value] : llvm::enumerate(captures)) {
+        fields = b.create<LLVM::InsertValueOp>(
+            loc, fields, castTo(b, loc, value, fieldTypes[i]), i);
+      }
+      b.create<LLVM::StoreOp>(loc, fields, context);
+    }
+
+    Value upperBound = getValueOrCreateConstantIndexOp(
+        b, loc, forall.getMixedUpperBound()[0]);
+    Value numIterations = b.create<arith::IndexCastOp>(loc, i64, upperBound);
+    Value function =
+        b.create<func::ConstantOp>(loc, bodyType, FlatSymbolRefAttr::get(body));
+    auto parallelFor = getOrCreateRuntimeFunc(
+        moduleOp, kParallelForFunc,
+        FunctionType::get(ctx, {i64, ptrType, ptrType}, {}));
+    b.create<func::CallOp>(
+        loc, parallelFor,
+        ValueRange{numIterations, castTo(b, loc, function, ptrType), context});
+
+    LLVM_DEBUG(llvm::dbgs() << "outlined a loop of " << parent.getName()
+                            << " into " << name << " with "
+                            << captures.size() << " captured values\n");
+    forall.erase();
+    return success();
+  }
+
+  unsigned counter = 0;
+};
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>>
+triton::createOutlineParallelLoopsPass() {
+  return std::make_unique<OutlineParallelLoopsPass>();
+}
@@ -0,0 +1,148 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// The launcher runs the program instances of a grid in parallel, which keeps
+// the threads busy as long as there are more programs than threads. Kernels
+// launched on small grids with large tiles (a single program reducing a
+// 4096x4096 block, a batch-1 matmul epilogue) instead run on one thread. This
+// pass exposes the parallelism inside a program: large linalg ops are split
+// into an scf.forall over their outermost parallel dimension, which
+// outline-parallel-loops hands over to the runtime thread pool.
+//
+//===----------------------------------------------------------------------===//
+
+#include "triton-shared/Conversion/ParallelizeLinalg/ParallelizeLinalg.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/IR/AffineExpr.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Interfaces/TilingInterface.h"
+
+#include "llvm/Support/Debug.h"
+
+#include <optional>
+
+#define DEBUG_TYPE "parallelize-linalg"
+
+using namespace mlir;
+using namespace triton;
+
+namespace mlir {
+namespace triton {
+#define GEN_PASS_DEF_PARALLELIZELINALG
+#include "triton-shared/Conversion/ParallelizeLinalg/Passes.h.inc"
+} // namespace triton
+} // namespace mlir
+
+namespace {
+
+// Whether every output of `op` is indexed by the loop dimension `dim`, so that
+// distinct iterations along it write distinct elements.
+static bool indexesAllOutputs(linalg::LinalgOp op, unsigned dim) {
+  AffineExpr dimExpr = getAffineDimExpr(dim, op.getContext());
+  return llvm::all_of(op.getDpsInitsMutable(), [&](OpOperand &init) {
+    return llvm::is_contained(op.getMatchingIndexingMap(&init).getResults(),
+                              dimExpr);
+  });
+}
+
+// The outermost parallel dimension of `op` to split, if `op` is large enough.
+static std::optional<unsigned> getParallelDim(linalg::LinalgOp op,
+                                              int64_t minIterations) {
+  if (!op.hasPureBufferSemantics() || !isa<TilingInterface>(op.getOperation())) {
+    return std::nullopt;
+  }
+
+  SmallVector<int64_t> ranges = op.getStaticLoopRanges();
+  int64_t iterations = 1;
+  for (int64_t range : ranges) {
+    if (ShapedType::isDynamic(range)) {
+      return std::nullopt;
+    }
+    iterations *= range;
+  }
+  if (iterations < minIterations) {
+    return std::nullopt;
+  }
+
+  for (auto [dim, iterator] : llvm::enumerate(op.getIteratorTypesArray())) {
+    if (iterator == utils::IteratorType::parallel && ranges[dim] > 1 &&
+        indexesAllOutputs(op, dim)) {
+      return dim;
+    }
+  }
+  return std::nullopt;
+}
+
+class ParallelizeLinalgPass
+    : public triton::impl::ParallelizeLinalgBase<ParallelizeLinalgPass> {
+  using ParallelizeLinalgBase<ParallelizeLinalgPass>::ParallelizeLinalgBase;
+
+public:
+  void runOnOperation() override {
+    SmallVector<std::pair<linalg::LinalgOp, unsigned>> candidates;
+    getOperation().walk([&](linalg::LinalgOp op) {
+      if (op->getParentOfType<scf::ForallOp>() ||
+          op->getParentOfType<scf::ParallelOp>()) {
+        return;
+      }
+      if (auto dim = getParallelDim(op, minIterations)) {
+        candidates.emplace_back(op, *dim);
+      }
+    });
+
+    IRRewriter rewriter(&getContext());
+    for (auto [op, dim] : candidates) {
+      if (failed(parallelize(rewriter, op, dim))) {
+        return signalPassFailure();
+      }
+    }
+  }
+
+private:
+  // Replace `op` by an scf.forall over its loop dimension `dim` running the
+  // slice of `op` at each index of it.
+  LogicalResult parallelize(RewriterBase &rewriter, linalg::LinalgOp op,
+                            unsigned dim) {
+    Location loc = op.getLoc();
+    SmallVector<int64_t> ranges = op.getStaticLoopRanges();
+
+    rewriter.setInsertionPoint(op);
+    auto forall = rewriter.create<scf::ForallOp>(
+        loc, ArrayRef<OpFoldResult>{rewriter.getIndexAttr(ranges[dim])},
+        ValueRange{}, /*mapping=*/std::nullopt);
+
+    rewriter.setInsertionPoint(forall.getBody()->getTerminator());
+    SmallVector<OpFoldResult> offsets(ranges.size(), rewriter.getIndexAttr(0));
+    SmallVector<OpFoldResult> sizes;
+    for (int64_t range : ranges) {
+      sizes.push_back(rewriter.getIndexAttr(range));
+    }
+    offsets[dim] = forall.getInductionVar(0);
+    sizes[dim] = rewriter.getIndexAttr(1);
+    FailureOr<TilingResult> tiled =
+        cast<TilingInterface>(op.getOperation())
+            .getTiledImplementation(rewriter, offsets, sizes);
+    if (failed(tiled)) {
+      return op.emitError("parallelize-linalg: failed to slice the op");
+    }
+
+    LLVM_DEBUG(llvm::dbgs() << "split " << op->getName() << " along d" << dim
+                            << " into " << ranges[dim] << " iterations\n");
+    rewriter.eraseOp(op);
+    return success();
+  }
+};
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> triton::createParallelizeLinalgPass() {
+  return std::make_unique<ParallelizeLinalgPass>();
+}
@@ -0,0 +1,280 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// Tiles loaded in a loop are only read from memory when they are about to be
+// consumed, so every iteration of a bandwidth-bound loop first waits for its
+// loads to miss the caches. This pass prefetches the tiles of a later
+// iteration instead, using the loop-carried offsets that PtrAnalysis set up
+// for the pointers advanced by the loop.
+//
+//===----------------------------------------------------------------------===//
+
+#include "triton-shared/Conversion/PrefetchLoopLoads/PrefetchLoopLoads.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/Support/Debug.h"
+
+#include <algorithm>
+
+#define DEBUG_TYPE "prefetch-loop-loads"
+
+using namespace mlir;
+using namespace triton;
+
+namespace mlir {
+namespace triton {
+#define GEN_PASS_DEF_PREFETCHLOOPLOADS
+#include "triton-shared/Conversion/PrefetchLoopLoads/Passes.h.inc"
+} // namespace triton
+} // namespace mlir
+
+namespace {
+
+// Rebuild values of the body of `loop` as they will be `distance` iterations
+// after the current one, at the insertion point of `b`.
+class NextIterationValues {
+public:
+  NextIterationValues(scf::ForOp loop, int64_t distance, OpBuilder &b)
+      : loop(loop), distance(distance), b(b) {}
+
+  // Return null if `v` is not computed, without reading memory, from
+  // loop-invariant values, the induction variable and iter args that are
+  // advanced by a loop-invariant amount.
+  Value get(Value v) {
+    if (loop.isDefinedOutsideOfLoop(v)) {
+      return v;
+    }
+    if (Value next = mapping.lookupOrNull(v)) {
+      return next;
+    }
+    Value next = compute(v);
+    if (next) {
+      mapping.map(v, next);
+    }
+    return next;
+  }
+
+  OpFoldResult get(OpFoldResult ofr) {
+    if (auto v = dyn_cast<Value>(ofr)) {
+      if (Value next = get(v)) {
+        return next;
+      }
+      return OpFoldResult();
+    }
+    return ofr;
+  }
+
+private:
+  // v + distance * step
+  Value advance(Value v, Value step) {
+    Location loc = loop.getLoc();
+    Value delta;
+    APInt stepValue;
+    if (matchPattern(step, m_ConstantInt(&stepValue))) {
+      delta = b.create<arith::ConstantOp>(
+          loc, b.getIntegerAttr(v.getType(),
+                                stepValue.getSExtValue() * distance));
+    } else {
+      Value n = b.create<arith::ConstantOp>(
+          loc, b.getIntegerAttr(v.getType(), distance));
+      delta = b.create<arith::MulIOp>(loc, step, n);
+    }
+    return b.create<arith::AddIOp>(loc, v, delta);
+  }
+
+  Value compute(Value v) {
+    if (!v.getType().isIntOrIndex()) {
+      return nullptr;
+    }
+
+    if (v == loop.getInductionVar()) {
+      return advance(v, loop.getStep());
+    }
+
+    if (auto arg = dyn_cast<BlockArgument>(v)) {
+      auto iterArgs = loop.getRegionIterArgs();
+      auto it = llvm::find(iterArgs, arg);
+      if (it == iterArgs.end()) {
+        return nullptr;
+      }
+      auto yield = cast<scf::YieldOp>(loop.getBody()->getTerminator());
+      Value yielded = yield.getOperand(std::distance(iterArgs.begin(), it));
+      auto add = yielded.getDefiningOp<arith::AddIOp>();
+      if (!add) {
+        return nullptr;
+      }
+      if (add.getLhs() == arg && loop.isDefinedOutsideOfLoop(add.getRhs())) {
+        return advance(arg, add.getRhs());
+      }
+      if (add.getRhs() == arg && loop.isDefinedOutsideOfLoop(add.getLhs())) {
+        return advance(arg, add.getLhs());
+      }
+      return nullptr;
+    }
+
+    // Recompute pure arith ops of the loop body from the next values of
+    // their operands.
+    Operation *op = v.getDefiningOp();
+    if (op->getBlock() != loop.getBody() || op->getNumRegions() != 0 ||
+        !isa<arith::ArithDialect>(op->getDialect()) || !isPure(op)) {
+      return nullptr;
+    }
+    IRMapping operands;
+    for (Value operand : op->getOperands()) {
+      Value next = get(operand);
+      if (!next) {
+        return nullptr;
+      }
+      operands.map(operand, next);
+    }
+    Operation *clone = b.clone(*op, operands);
+    return clone->getResult(cast<OpResult>(v).getResultNumber());
+  }
+
+  scf::ForOp loop;
+  int64_t distance;
+  OpBuilder &b;
+  IRMapping mapping;
+};
+
+// The full tile read by `copy`, if it is a view of a loop-invariant buffer
+// created inside `loop`.
+static memref::ReinterpretCastOp getLoadedTile(memref::CopyOp copy,
+                                               scf::ForOp loop) {
+  Value source = copy.getSource();
+  // Masked loads copy a subview of the tile.
+  if (auto subview = source.getDefiningOp<memref::SubViewOp>()) {
+    source = subview.getSource();
+  }
+  auto tile = source.getDefiningOp<memref::ReinterpretCastOp>();
+  if (!tile || tile->getBlock() != loop.getBody() ||
+      !loop.isDefinedOutsideOfLoop(tile.getSource()) ||
+      !tile.getType().hasStaticShape()) {
+    return nullptr;
+  }
+  return tile;
+}
+
+class PrefetchLoopLoadsPass
+    : public triton::impl::PrefetchLoopLoadsBase<PrefetchLoopLoadsPass> {
+  using PrefetchLoopLoadsBase<PrefetchLoopLoadsPass>::PrefetchLoopLoadsBase;
+
+public:
+  void runOnOperation() override {
+    if (distance < 1 || cacheLineBytes < 1) {
+      getOperation().emitError("prefetch-loop-loads: distance and "
+                               "cache-line-bytes must be positive");
+      return signalPassFailure();
+    }
+
+    SmallVector<scf::ForOp> loops;
+    getOperation().walk([&](scf::ForOp loop) { loops.push_back(loop); });
+    for (auto loop : loops) {
+      prefetchLoads(loop);
+    }
+  }
+
+private:
+  void prefetchLoads(scf::ForOp loop) {
+    llvm::SmallPtrSet<Operation *, 4> prefetched;
+    for (auto copy : loop.getBody()->getOps<memref::CopyOp>()) {
+      auto tile = getLoadedTile(copy, loop);
+      if (!tile || !prefetched.insert(tile).second) {
+        continue;
+      }
+
+      OpBuilder b(copy);
+      NextIterationValues next(loop, distance, b);
+      OpFoldResult offset = next.get(tile.getMixedOffsets()[0]);
+      SmallVector<OpFoldResult> strides;
+      for (OpFoldResult stride : tile.getMixedStrides()) {
+        strides.push_back(next.get(stride));
+      }
+      if (!offset || llvm::is_contained(strides, OpFoldResult())) {
+        LLVM_DEBUG({
+          llvm::dbgs() << "cannot compute the next tile of:\n";
+          tile->dump();
+        });
+        continue;
+      }
+
+      Location loc = tile.getLoc();
+      auto nextTile = b.create<memref::ReinterpretCastOp>(
+          loc, tile.getType(), tile.getSource(), offset,
+          tile.getMixedSizes(), strides);
+      createPrefetches(b, loc, nextTile);
+    }
+  }
+
+  // One prefetch per cache line of every innermost row of `tile` when its
+  // rows are contiguous, one per element otherwise. Rows do not have to start
+  // on a line, so the last element of each row is prefetched as well to cover
+  // its trailing partial line.
+  void createPrefetches(OpBuilder &b, Location loc,
+                        memref::ReinterpretCastOp tile) {
+    auto type = tile.getType();
+    int64_t rank = type.getRank();
+    if (rank == 0) {
+      return;
+    }
+    int64_t elemBytes = (type.getElementTypeBitWidth() + 7) / 8;
+    int64_t rowElems = type.getShape().back();
+    int64_t step = 1;
+    if (getConstantIntValue(tile.getMixedStrides().back()) == 1) {
+      step = std::max<int64_t>(1, cacheLineBytes / elemBytes);
+    }
+
+    SmallVector<Value> lbs, ubs, steps;
+    Value zero = b.create<arith::ConstantIndexOp>(loc, 0);
+    Value one = b.create<arith::ConstantIndexOp>(loc, 1);
+    for (int64_t size : type.getShape().drop_back()) {
+      lbs.push_back(zero);
+      ubs.push_back(b.create<arith::ConstantIndexOp>(loc, size));
+      steps.push_back(one);
+    }
+    auto prefetch = [&](OpBuilder &b, Location loc, ValueRange rowIvs,
+                        Value iv) {
+      SmallVector<Value> indices(rowIvs);
+      indices.push_back(iv);
+      b.create<memref::PrefetchOp>(loc, tile, indices, /*isWrite=*/false,
+                                   /*localityHint=*/3, /*isDataCache=*/true);
+    };
+    scf::buildLoopNest(
+        b, loc, lbs, ubs, steps,
+        [&](OpBuilder &b, Location loc, ValueRange ivs) {
+          Value rowEnd = b.create<arith::ConstantIndexOp>(loc, rowElems);
+          Value rowStep = b.create<arith::ConstantIndexOp>(loc, step);
+          b.create<scf::ForOp>(
+              loc, zero, rowEnd, rowStep, std::nullopt,
+              [&](OpBuilder &b, Location loc, Value iv, ValueRange) {
+                prefetch(b, loc, ivs, iv);
+                b.create<scf::YieldOp>(loc);
+              });
+          if ((rowElems - 1) % step != 0) {
+            Value last = b.create<arith::ConstantIndexOp>(loc, rowElems - 1);
+            prefetch(b, loc, ivs, last);
+          }
+        });
+  }
+};
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>>
+triton::createPrefetchLoopLoadsPass() {
+  return std::make_unique<PrefetchLoopLoadsPass>();
+}
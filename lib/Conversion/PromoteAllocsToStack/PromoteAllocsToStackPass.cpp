@@ -0,0 +1,166 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// One-shot bufferization allocates a fresh heap buffer for nearly every
+// kernel temporary, typically once per iteration of the K loop of every
+// program instance. This pass moves the small, statically shaped ones to the
+// stack frame of the kernel.
+//
+//===----------------------------------------------------------------------===//
+
+#include "triton-shared/Conversion/PromoteAllocsToStack/PromoteAllocsToStack.h"
+
+#include "mlir/Dialect/Affine/IR/AffineOps.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/Interfaces/CallInterfaces.h"
+#include "mlir/Interfaces/ViewLikeInterface.h"
+
+#include "llvm/Support/Debug.h"
+
+#include <optional>
+
+#define DEBUG_TYPE "promote-allocs-to-stack"
+
+using namespace mlir;
+using namespace triton;
+
+namespace mlir {
+namespace triton {
+#define GEN_PASS_DEF_PROMOTEALLOCSTOSTACK
+#include "triton-shared/Conversion/PromoteAllocsToStack/Passes.h.inc"
+} // namespace triton
+} // namespace mlir
+
+namespace {
+
+// Size in bytes of a statically shaped allocation, std::nullopt if unknown.
+static std::optional<uint64_t> getStaticSizeInBytes(memref::AllocOp op) {
+  MemRefType type = op.getType();
+  if (!type.hasStaticShape() || !op.getSymbolOperands().empty() ||
+      type.getMemorySpace() || !type.getElementType().isIntOrFloat()) {
+    return std::nullopt;
+  }
+  uint64_t elemBytes = (type.getElementTypeBitWidth() + 7) / 8;
+  return type.getNumElements() * elemBytes;
+}
+
+// An alloca at function entry is shared by all iterations of the loops that
+// contained the allocation, which is only valid if those iterations run one
+// after another.
+static bool isInSequentialControlFlow(memref::AllocOp op,
+                                      func::FuncOp func) {
+  for (Operation *parent = op->getParentOp(); parent != func;
+       parent = parent->getParentOp()) {
+    if (!isa<scf::ForOp, scf::IfOp, scf::WhileOp, scf::ExecuteRegionOp,
+             affine::AffineForOp, affine::AffineIfOp>(parent)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Return true if the buffer allocated by `op` may be accessed after the
+// allocation goes out of scope. Views of the buffer are followed; the buffer
+// escapes if it, or one of its views, is returned or yielded from a region,
+// passed to a call, or forwarded into the region of a control flow op.
+// Deallocations of the buffer are collected in `deallocs`.
+static bool mayEscape(memref::AllocOp op,
+                      SmallVectorImpl<memref::DeallocOp> &deallocs) {
+  SmallVector<Value> worklist{op.getResult()};
+  while (!worklist.empty()) {
+    Value v = worklist.pop_back_val();
+    for (Operation *user : v.getUsers()) {
+      if (auto dealloc = dyn_cast<memref::DeallocOp>(user)) {
+        deallocs.push_back(dealloc);
+        continue;
+      }
+
+      if (isa<memref::CastOp, memref::ReinterpretCastOp, memref::SubViewOp,
+              memref::ExpandShapeOp, memref::CollapseShapeOp,
+              memref::TransposeOp, memref::ExtractStridedMetadataOp>(user) ||
+          isa<ViewLikeOpInterface>(user)) {
+        for (Value result : user->getResults()) {
+          if (isa<BaseMemRefType>(result.getType())) {
+            worklist.push_back(result);
+          }
+        }
+        continue;
+      }
+
+      if (user->hasTrait<OpTrait::IsTerminator>() ||
+          isa<CallOpInterface, RegionBranchOpInterface,
+              memref::ExtractAlignedPointerAsIndexOp>(user)) {
+        LLVM_DEBUG({
+          llvm::dbgs() << "buffer escapes through:\n";
+          user->dump();
+        });
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+class PromoteAllocsToStackPass
+    : public triton::impl::PromoteAllocsToStackBase<PromoteAllocsToStackPass> {
+  using PromoteAllocsToStackBase<
+      PromoteAllocsToStackPass>::PromoteAllocsToStackBase;
+
+public:
+  void runOnOperation() override {
+    auto moduleOp = getOperation();
+    moduleOp.walk([&](func::FuncOp func) {
+      if (!func.isExternal()) {
+        promoteAllocs(func);
+      }
+    });
+  }
+
+private:
+  void promoteAllocs(func::FuncOp func) {
+    SmallVector<memref::AllocOp> allocs;
+    func.walk([&](memref::AllocOp op) { allocs.push_back(op); });
+
+    auto builder = OpBuilder::atBlockBegin(&func.getBody().front());
+    uint64_t totalSize = 0;
+    for (auto op : allocs) {
+      auto size = getStaticSizeInBytes(op);
+      if (!size || *size > maxAllocSizeInBytes ||
+          totalSize + *size > maxTotalSizeInBytes ||
+          !isInSequentialControlFlow(op, func)) {
+        continue;
+      }
+
+      SmallVector<memref::DeallocOp> deallocs;
+      if (mayEscape(op, deallocs)) {
+        continue;
+      }
+
+      auto alloca = builder.create<memref::AllocaOp>(
+          op.getLoc(), op.getType(), op.getAlignmentAttr());
+      builder.setInsertionPointAfter(alloca);
+      totalSize += *size;
+
+      for (auto dealloc : deallocs) {
+        dealloc->erase();
+      }
+      op.replaceAllUsesWith(alloca.getResult());
+      op->erase();
+    }
+  }
+};
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>>
+triton::createPromoteAllocsToStackPass() {
+  return std::make_unique<PromoteAllocsToStackPass>();
+}
@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// The launcher hands 16-bit float scalars to kernels as C floats. This pass
+// makes the kernels take them as f32, so that caller and callee agree on the
+// calling convention.
+//
+//===----------------------------------------------------------------------===//
+
+#include "triton-shared/Conversion/PromoteHalfArgs/PromoteHalfArgs.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+
+#define DEBUG_TYPE "promote-half-args"
+
+using namespace mlir;
+using namespace triton;
+
+namespace mlir {
+namespace triton {
+#define GEN_PASS_DEF_PROMOTEHALFARGS
+#include "triton-shared/Conversion/PromoteHalfArgs/Passes.h.inc"
+} // namespace triton
+} // namespace mlir
+
+namespace {
+
+class PromoteHalfArgsPass
+    : public triton::impl::PromoteHalfArgsBase<PromoteHalfArgsPass> {
+  using PromoteHalfArgsBase<PromoteHalfArgsPass>::PromoteHalfArgsBase;
+
+public:
+  void runOnOperation() override {
+    auto moduleOp = getOperation();
+    moduleOp.walk([&](func::FuncOp func) {
+      if (func.isPublic() && !func.isExternal()) {
+        promoteArgs(func);
+      }
+    });
+  }
+
+private:
+  void promoteArgs(func::FuncOp func) {
+    Block &entry = func.getBody().front();
+    auto builder = OpBuilder::atBlockBegin(&entry);
+    Type f32 = builder.getF32Type();
+
+    bool changed = false;
+    for (BlockArgument arg : entry.getArguments()) {
+      Type type = arg.getType();
+      if (!type.isF16() && !type.isBF16()) {
+        continue;
+      }
+      arg.setType(f32);
+      auto trunc = builder.create<arith::TruncFOp>(func.getLoc(), type, arg);
+      arg.replaceAllUsesExcept(trunc.getResult(), trunc);
+      changed = true;
+    }
+
+    if (changed) {
+      func.setFunctionType(builder.getFunctionType(
+          entry.getArgumentTypes(), func.getFunctionType().getResults()));
+    }
+  }
+};
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> triton::createPromoteHalfArgsPass() {
+  return std::make_unique<PromoteHalfArgsPass>();
+}
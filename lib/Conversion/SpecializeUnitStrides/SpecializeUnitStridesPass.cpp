@@ -0,0 +1,181 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// Strides passed as kernel arguments give the buffers of a kernel a dynamic
+// layout, which keeps the loads and stores of its innermost dimension from
+// being vectorized as contiguous accesses. This pass compiles a copy of each
+// kernel for the common case where these strides are 1; the launcher picks
+// it at run time from the actual arguments.
+//
+//===----------------------------------------------------------------------===//
+
+#include "triton-shared/Conversion/SpecializeUnitStrides/SpecializeUnitStrides.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/Debug.h"
+
+#include <optional>
+#include <string>
+
+#define DEBUG_TYPE "specialize-unit-strides"
+
+using namespace mlir;
+using namespace triton;
+
+namespace mlir {
+namespace triton {
+#define GEN_PASS_DEF_SPECIALIZEUNITSTRIDES
+#include "triton-shared/Conversion/SpecializeUnitStrides/Passes.h.inc"
+} // namespace triton
+} // namespace mlir
+
+namespace {
+
+// num_programs and program_id along each axis of the launch grid, appended to
+// the kernel arguments by TritonArithToLinalg's addProgramInfo.
+static constexpr unsigned kProgramInfoArgCount = 6;
+
+// Name suffix of the specialized variant and LLVM function attribute listing
+// its specialized arguments, must be kept in sync with backend/compiler.py.
+static constexpr StringLiteral kUnitStrideSuffix = "_unitstride";
+static constexpr StringLiteral kUnitStrideArgsAttr =
+    "triton-shared-unit-stride-args";
+
+// The argument of `func` that `value` is computed from by integer casts only.
+static std::optional<unsigned> getSourceArg(Value value, func::FuncOp func) {
+  while (auto op = value.getDefiningOp()) {
+    if (!isa<arith::IndexCastOp, arith::IndexCastUIOp, arith::ExtSIOp,
+             arith::ExtUIOp>(op)) {
+      return std::nullopt;
+    }
+    value = op->getOperand(0);
+  }
+  auto arg = dyn_cast<BlockArgument>(value);
+  if (!arg || arg.getOwner() != &func.getBody().front() ||
+      !isa<IntegerType>(arg.getType())) {
+    return std::nullopt;
+  }
+  return arg.getArgNumber();
+}
+
+class SpecializeUnitStridesPass
+    : public triton::impl::SpecializeUnitStridesBase<
+          SpecializeUnitStridesPass> {
+  using SpecializeUnitStridesBase<
+      SpecializeUnitStridesPass>::SpecializeUnitStridesBase;
+
+public:
+  void runOnOperation() override {
+    auto moduleOp = getOperation();
+
+    SmallVector<func::FuncOp> kernels;
+    moduleOp.walk([&](func::FuncOp func) {
+      if (!func.isExternal() && func.isPublic() &&
+          func.getNumResults() == 0 &&
+          func.getNumArguments() >= kProgramInfoArgCount &&
+          !func.getName().ends_with(kUnitStrideSuffix)) {
+        kernels.push_back(func);
+      }
+    });
+
+    SymbolTable symbolTable(moduleOp);
+    for (auto func : kernels) {
+      specialize(func, symbolTable);
+    }
+  }
+
+private:
+  // The kernel arguments used as the innermost stride of a memref.
+  llvm::SmallSetVector<unsigned, 4> getStrideArgs(func::FuncOp func) {
+    llvm::SmallSetVector<unsigned, 4> args;
+    unsigned numKernelArgs = func.getNumArguments() - kProgramInfoArgCount;
+    func.walk([&](memref::ReinterpretCastOp op) {
+      auto strides = op.getMixedStrides();
+      if (strides.empty()) {
+        return;
+      }
+      auto stride = dyn_cast<Value>(strides.back());
+      if (!stride) {
+        return;
+      }
+      if (auto arg = getSourceArg(stride, func);
+          arg && *arg < numKernelArgs) {
+        args.insert(*arg);
+      }
+    });
+    return args;
+  }
+
+  void specialize(func::FuncOp func, SymbolTable &symbolTable) {
+    auto strideArgs = getStrideArgs(func);
+    if (strideArgs.empty()) {
+      return;
+    }
+    SmallVector<unsigned> sortedArgs(strideArgs.begin(), strideArgs.end());
+    llvm::sort(sortedArgs);
+
+    auto variant = func.clone();
+    variant.setName((func.getName() + kUnitStrideSuffix).str());
+    symbolTable.insert(variant, std::next(Block::iterator(func)));
+
+    Block &entry = variant.getBody().front();
+    auto builder = OpBuilder::atBlockBegin(&entry);
+    for (unsigned i : sortedArgs) {
+      BlockArgument arg = entry.getArgument(i);
+      auto one = builder.create<arith::ConstantOp>(
+          variant.getLoc(), builder.getIntegerAttr(arg.getType(), 1));
+      arg.replaceAllUsesWith(one.getResult());
+    }
+
+    SmallVector<std::string> argNumbers;
+    for (unsigned i : sortedArgs) {
+      argNumbers.push_back(std::to_string(i));
+    }
+    std::string indices = llvm::join(argNumbers, ",");
+    SmallVector<Attribute> passthrough;
+    if (auto existing = variant->getAttrOfType<ArrayAttr>("passthrough")) {
+      passthrough.append(existing.begin(), existing.end());
+    }
+    passthrough.push_back(builder.getArrayAttr(
+        {builder.getStringAttr(kUnitStrideArgsAttr),
+         builder.getStringAttr(indices)}));
+    variant->setAttr("passthrough", builder.getArrayAttr(passthrough));
+
+    LLVM_DEBUG(llvm::dbgs() << "specializing " << func.getName()
+                            << " for unit strides of arguments " << indices
+                            << "\n");
+
+    // Fold the constant strides into the layouts of the memrefs of the
+    // variant, as the canonicalizer would. Not converging only leaves some
+    // folding opportunities to LLVM.
+    MLIRContext *context = &getContext();
+    RewritePatternSet patterns(context);
+    for (Dialect *dialect : context->getLoadedDialects()) {
+      dialect->getCanonicalizationPatterns(patterns);
+    }
+    for (RegisteredOperationName op : context->getRegisteredOperations()) {
+      op.getCanonicalizationPatterns(patterns, context);
+    }
+    (void)applyPatternsAndFoldGreedily(variant, std::move(patterns));
+  }
+};
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>>
+triton::createSpecializeUnitStridesPass() {
+  return std::make_unique<SpecializeUnitStridesPass>();
+}
@@ -0,0 +1,325 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// The linalg.reduce of a 1-d tensor combines every element into the same
+// accumulator, so each iteration waits for the previous one, even once the
+// loop is vectorized. This pass reduces the tensor into several independent
+// partial results first and only combines those at the end. Besides plain
+// arith combiners this covers the fused value / index reductions of argmax
+// and argmin.
+//
+//===----------------------------------------------------------------------===//
+
+#include "triton-shared/Conversion/SplitReductions/SplitReductions.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/TypeUtilities.h"
+
+#include "llvm/ADT/SmallVectorExtras.h"
+#include "llvm/Support/Debug.h"
+
+#include <algorithm>
+
+#define DEBUG_TYPE "split-reductions"
+
+using namespace mlir;
+using namespace triton;
+
+namespace mlir {
+namespace triton {
+#define GEN_PASS_DEF_SPLITREDUCTIONS
+#include "triton-shared/Conversion/SplitReductions/Passes.h.inc"
+} // namespace triton
+} // namespace mlir
+
+namespace {
+
+// Return the op combining the element into the accumulator if the body of
+// `op` is `yield combiner(acc, in)` or `yield combiner(in, acc)`, where `in`
+// may be extended to the accumulator type first, and the combiner has a
+// neutral element. Return nullptr otherwise.
+static Operation *getCombiner(linalg::ReduceOp op) {
+  Block &body = op.getCombiner().front();
+  Value in = body.getArgument(0);
+  Value acc = body.getArgument(1);
+  auto yield = cast<linalg::YieldOp>(body.getTerminator());
+
+  Operation *combiner = yield.getOperand(0).getDefiningOp();
+  if (!combiner || combiner->getBlock() != &body ||
+      combiner->getNumOperands() != 2 || combiner->getNumResults() != 1 ||
+      !arith::getNeutralElement(combiner)) {
+    return nullptr;
+  }
+
+  auto isElement = [&](Value v) {
+    if (v == in) {
+      return true;
+    }
+    Operation *ext = v.getDefiningOp();
+    return isa_and_nonnull<arith::ExtFOp, arith::ExtSIOp, arith::ExtUIOp>(
+               ext) &&
+           ext->getOperand(0) == in;
+  };
+  Value lhs = combiner->getOperand(0);
+  Value rhs = combiner->getOperand(1);
+  if (!(lhs == acc && isElement(rhs)) && !(rhs == acc && isElement(lhs))) {
+    return nullptr;
+  }
+
+  // Nothing but the combiner, the extension and the yield.
+  size_t expectedNumOps = (lhs == in || rhs == in) ? 2 : 3;
+  if (body.getOperations().size() != expectedNumOps) {
+    return nullptr;
+  }
+  return combiner;
+}
+
+// Return true if the body of `op` is the argmax / argmin combiner produced
+// for tt.reduce by ArgMinMaxBaseConverter:
+//
+//   (%v, %i, %acc_v, %acc_i)
+//   %gt = cmpf ogt (or olt), %v, %acc_v
+//   %tie = andi (cmpf oeq, %v, %acc_v), (cmpi slt, %i, %acc_i)
+//   %pick = ori %gt, %tie
+//   yield (select %pick, %v, %acc_v), (select %pick, %i, %acc_i)
+//
+// It picks whichever pair orders first, lowest index first on ties, so the
+// pairs may be combined in any order and combining a pair with itself is a
+// no-op.
+static bool isArgMinMaxCombiner(linalg::ReduceOp op) {
+  if (op.getNumDpsInputs() != 2) {
+    return false;
+  }
+  Block &body = op.getCombiner().front();
+  Value value = body.getArgument(0);
+  Value index = body.getArgument(1);
+  Value accValue = body.getArgument(2);
+  Value accIndex = body.getArgument(3);
+  auto yield = cast<linalg::YieldOp>(body.getTerminator());
+
+  auto valueSelect = yield.getOperand(0).getDefiningOp<arith::SelectOp>();
+  auto indexSelect = yield.getOperand(1).getDefiningOp<arith::SelectOp>();
+  if (!valueSelect || !indexSelect ||
+      valueSelect.getCondition() != indexSelect.getCondition() ||
+      valueSelect.getTrueValue() != value ||
+      valueSelect.getFalseValue() != accValue ||
+      indexSelect.getTrueValue() != index ||
+      indexSelect.getFalseValue() != accIndex) {
+    return false;
+  }
+
+  auto pick = valueSelect.getCondition().getDefiningOp<arith::OrIOp>();
+  if (!pick) {
+    return false;
+  }
+  auto gt = pick.getLhs().getDefiningOp<arith::CmpFOp>();
+  auto tie = pick.getRhs().getDefiningOp<arith::AndIOp>();
+  if (!gt || !tie ||
+      (gt.getPredicate() != arith::CmpFPredicate::OGT &&
+       gt.getPredicate() != arith::CmpFPredicate::OLT) ||
+      gt.getLhs() != value || gt.getRhs() != accValue) {
+    return false;
+  }
+  auto eq = tie.getLhs().getDefiningOp<arith::CmpFOp>();
+  auto lt = tie.getRhs().getDefiningOp<arith::CmpIOp>();
+  return eq && lt && eq.getPredicate() == arith::CmpFPredicate::OEQ &&
+         eq.getLhs() == value && eq.getRhs() == accValue &&
+         lt.getPredicate() == arith::CmpIPredicate::slt &&
+         lt.getLhs() == index && lt.getRhs() == accIndex &&
+         body.getOperations().size() == 8;
+}
+
+// Clone the body of `op` with its arguments replaced by `args`, return the
+// yielded values.
+static SmallVector<Value> cloneBody(OpBuilder &b, linalg::ReduceOp op,
+                                    ValueRange args) {
+  Block &body = op.getCombiner().front();
+  IRMapping mapping;
+  mapping.map(body.getArguments(), args);
+  for (auto &bodyOp : body.without_terminator()) {
+    b.clone(bodyOp, mapping);
+  }
+  return llvm::map_to_vector(body.getTerminator()->getOperands(),
+                             [&](Value v) { return mapping.lookup(v); });
+}
+
+using BodyBuilderFn =
+    function_ref<SmallVector<Value>(OpBuilder &, ValueRange)>;
+
+static SmallVector<Value> createReduce(OpBuilder &b, Location loc,
+                                       ValueRange inputs, ValueRange inits,
+                                       BodyBuilderFn body) {
+  auto reduceOp = b.create<linalg::ReduceOp>(
+      loc, inputs, inits, SmallVector<int64_t>{0},
+      [&](OpBuilder &nestedBuilder, Location nestedLoc, ValueRange args) {
+        nestedBuilder.create<linalg::YieldOp>(nestedLoc,
+                                              body(nestedBuilder, args));
+      });
+  return SmallVector<Value>(reduceOp.getResults().begin(),
+                            reduceOp.getResults().end());
+}
+
+static Value createSlice(OpBuilder &b, Location loc, Value input,
+                         int64_t offset, int64_t size) {
+  return b.create<tensor::ExtractSliceOp>(
+      loc, input, ArrayRef<OpFoldResult>{b.getIndexAttr(offset)},
+      ArrayRef<OpFoldResult>{b.getIndexAttr(size)},
+      ArrayRef<OpFoldResult>{b.getIndexAttr(1)});
+}
+
+static Value createFill(OpBuilder &b, Location loc, Value value,
+                        int64_t size) {
+  Value empty = b.create<tensor::EmptyOp>(loc, ArrayRef<int64_t>{size},
+                                          value.getType());
+  return b.create<linalg::FillOp>(loc, ValueRange{value}, ValueRange{empty})
+      .result();
+}
+
+class SplitReductionsPass
+    : public triton::impl::SplitReductionsBase<SplitReductionsPass> {
+  using SplitReductionsBase<SplitReductionsPass>::SplitReductionsBase;
+
+public:
+  void runOnOperation() override {
+    if (numAccumulators < 1 || vectorBits < 1) {
+      getOperation().emitError("split-reductions: num-accumulators and "
+                               "vector-bits must be positive");
+      return signalPassFailure();
+    }
+
+    SmallVector<linalg::ReduceOp> reduces;
+    getOperation().walk([&](linalg::ReduceOp op) { reduces.push_back(op); });
+    for (auto op : reduces) {
+      splitReduction(op);
+    }
+  }
+
+private:
+  void splitReduction(linalg::ReduceOp op) {
+    if (!op.hasPureTensorSemantics()) {
+      return;
+    }
+    auto inputType = dyn_cast<RankedTensorType>(op.getInputs()[0].getType());
+    if (!inputType || inputType.getRank() != 1 ||
+        inputType.isDynamicDim(0)) {
+      return;
+    }
+
+    Operation *combiner = nullptr;
+    bool isArgMinMax = isArgMinMaxCombiner(op);
+    if (!isArgMinMax) {
+      combiner = op.getNumDpsInputs() == 1 ? getCombiner(op) : nullptr;
+      if (!combiner) {
+        return;
+      }
+    }
+
+    unsigned accBits = 0;
+    for (Value init : op.getInits()) {
+      Type accType = getElementTypeOrSelf(init.getType());
+      if (!accType.isIntOrFloat()) {
+        return;
+      }
+      accBits = std::max(accBits, accType.getIntOrFloatBitWidth());
+    }
+
+    // k lanes fill the requested number of vector accumulators; the input
+    // needs at least two rows of k elements.
+    int64_t lanes =
+        std::max<int64_t>(numAccumulators * vectorBits / accBits, 2);
+    int64_t size = inputType.getDimSize(0);
+    int64_t rows = size / lanes;
+    if (rows < 2) {
+      return;
+    }
+    int64_t splitSize = rows * lanes;
+
+    LLVM_DEBUG({
+      llvm::dbgs() << "splitting into " << lanes << " partial results:\n";
+      op->dump();
+    });
+
+    OpBuilder b(op);
+    Location loc = op.getLoc();
+    SmallVector<Value> accs(op.getInits());
+
+    SmallVector<Value> matrices;
+    for (Value input : op.getInputs()) {
+      auto elemType = cast<RankedTensorType>(input.getType()).getElementType();
+      Value head =
+          splitSize < size ? createSlice(b, loc, input, 0, splitSize) : input;
+      matrices.push_back(b.create<tensor::ExpandShapeOp>(
+          loc, RankedTensorType::get({rows, lanes}, elemType), head,
+          SmallVector<ReassociationIndices>{{0, 1}}));
+    }
+
+    // Every lane starts from the neutral element of the combiner. An argmax /
+    // argmin lane starts from the initial pair instead, which is harmless to
+    // combine twice.
+    SmallVector<Value> partials;
+    if (isArgMinMax) {
+      for (Value acc : accs) {
+        Value init = b.create<tensor::ExtractOp>(loc, acc, ValueRange{});
+        partials.push_back(createFill(b, loc, init, lanes));
+      }
+    } else {
+      Value neutral = b.create<arith::ConstantOp>(
+          loc, *arith::getNeutralElement(combiner));
+      partials.push_back(createFill(b, loc, neutral, lanes));
+    }
+
+    // Reduce the rows into the partial results with the original body; for
+    // argmax / argmin the value and index lanes become a compare and two
+    // selects per vector once vectorized.
+    auto originalBody = [&](OpBuilder &b, ValueRange args) {
+      return cloneBody(b, op, args);
+    };
+    partials = createReduce(b, loc, matrices, partials, originalBody);
+
+    // The elements past the last full row go into the accumulator directly.
+    if (splitSize < size) {
+      SmallVector<Value> tails = llvm::map_to_vector(
+          op.getInputs(), [&](Value input) {
+            return createSlice(b, loc, input, splitSize, size - splitSize);
+          });
+      accs = createReduce(b, loc, tails, accs, originalBody);
+    }
+
+    // Combine the partial results. They already have the accumulator type:
+    // a single combiner is cloned without the extension of the original body,
+    // the argmax / argmin body already combines pairs of the same types.
+    SmallVector<Value> results;
+    if (isArgMinMax) {
+      results = createReduce(b, loc, partials, accs, originalBody);
+    } else {
+      Value accArg = op.getCombiner().front().getArgument(1);
+      results = createReduce(
+          b, loc, partials, accs,
+          [&](OpBuilder &b, ValueRange args) -> SmallVector<Value> {
+            IRMapping mapping;
+            for (Value operand : combiner->getOperands()) {
+              mapping.map(operand, operand == accArg ? args[1] : args[0]);
+            }
+            return {b.clone(*combiner, mapping)->getResult(0)};
+          });
+    }
+
+    op->replaceAllUsesWith(results);
+    op->erase();
+  }
+};
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> triton::createSplitReductionsPass() {
+  return std::make_unique<SplitReductionsPass>();
+}
@@ -13,9 +13,11 @@
 #include "mlir/IR/BuiltinTypeInterfaces.h"
 #include "mlir/IR/BuiltinTypes.h"
 #include "mlir/IR/MLIRContext.h"
+#include "mlir/IR/Matchers.h"
 #include "mlir/IR/OpDefinition.h"
 #include "mlir/IR/TypeUtilities.h"
 #include "mlir/IR/Types.h"
+#include "mlir/Interfaces/FunctionInterfaces.h"
 #include "mlir/Support/LogicalResult.h"
 #include "mlir/Transforms/DialectConversion.h"
 #include "triton-shared/Analysis/OpFoldResultUtils.h"
@@ -27,6 +29,8 @@
 #include "mlir/Dialect/Bufferization/IR/Bufferization.h"
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
 #include "mlir/Dialect/MemRef/IR//MemRef.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
 #include "triton/Dialect/Triton/IR/Types.h"
 
 #include "mlir/Dialect/Utils/StaticValueUtils.h"
@@ -34,10 +38,13 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Debug.h"
+#include "llvm/Support/MathExtras.h"
 
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <numeric>
+#include <optional>
 
 #define DEBUG_TYPE "structured-to-memref"
 
@@ -49,6 +56,85 @@ using namespace mlir;
 static const std::string WRAP_SIDE_BY_SIDE = "wrap_side_by_side";
 static const std::string WRAP_STACKED = "wrap_stacked";
 
+// Divisibility hint attached by the Triton frontend to pointer (in bytes) and
+// integer kernel arguments.
+static constexpr llvm::StringLiteral kDivisibilityAttr = "tt.divisibility";
+
+// Alignments are only tracked up to this many bytes, which is enough for the
+// widest vector loads.
+static constexpr int64_t kMaxKnownAlignment = 128;
+
+// Return the largest power of two dividing `value`, capped at
+// kMaxKnownAlignment. Zero is divisible by anything.
+static int64_t getPowerOfTwoDivisor(int64_t value) {
+  if (value == 0) {
+    return kMaxKnownAlignment;
+  }
+  uint64_t magnitude = value < 0 ? -static_cast<uint64_t>(value) : value;
+  return std::min<int64_t>(magnitude & -magnitude, kMaxKnownAlignment);
+}
+
+// Return the tt.divisibility hint of `v` if it is an argument of the enclosing
+// function.
+static std::optional<int64_t> getArgDivisibility(Value v) {
+  auto arg = dyn_cast<BlockArgument>(v);
+  if (!arg || !arg.getOwner()->isEntryBlock()) {
+    return std::nullopt;
+  }
+  auto func = dyn_cast<FunctionOpInterface>(arg.getOwner()->getParentOp());
+  if (!func) {
+    return std::nullopt;
+  }
+  auto attr =
+      func.getArgAttrOfType<IntegerAttr>(arg.getArgNumber(), kDivisibilityAttr);
+  if (!attr) {
+    return std::nullopt;
+  }
+  return attr.getInt();
+}
+
+// Return a power of two known to divide the integer `ofr`, following the
+// arithmetic that offsets are typically computed with.
+static int64_t getKnownDivisor(OpFoldResult ofr, int depth = 0) {
+  if (auto intAttr = getIntAttr(ofr)) {
+    return getPowerOfTwoDivisor(intAttr.value());
+  }
+
+  auto v = dyn_cast<Value>(ofr);
+  if (!v || depth > 8) {
+    return 1;
+  }
+
+  if (auto divisibility = getArgDivisibility(v)) {
+    return getPowerOfTwoDivisor(divisibility.value());
+  }
+
+  auto op = v.getDefiningOp();
+  if (!op) {
+    return 1;
+  }
+
+  if (auto constOp = dyn_cast<arith::ConstantOp>(op)) {
+    if (auto intAttr = dyn_cast<IntegerAttr>(constOp.getValue())) {
+      return getPowerOfTwoDivisor(intAttr.getInt());
+    }
+    return 1;
+  }
+  if (isa<arith::IndexCastOp, arith::ExtSIOp, arith::ExtUIOp>(op)) {
+    return getKnownDivisor(op->getOperand(0), depth + 1);
+  }
+  if (isa<arith::MulIOp>(op)) {
+    return std::min(getKnownDivisor(op->getOperand(0), depth + 1) *
+                        getKnownDivisor(op->getOperand(1), depth + 1),
+                    kMaxKnownAlignment);
+  }
+  if (isa<arith::AddIOp, arith::SubIOp>(op)) {
+    return std::min(getKnownDivisor(op->getOperand(0), depth + 1),
+                    getKnownDivisor(op->getOperand(1), depth + 1));
+  }
+  return 1;
+}
+
 static memref::SubViewOp getSubview(int rank, ArrayRef<OpFoldResult> dims,
                                     Value source, Location loc, OpBuilder &b) {
   auto sourceType = cast<MemRefType>(source.getType());
@@ -358,6 +444,35 @@ private:
     return success();
   }
 
+  // Return the alignment in bytes of the first element of `base` at
+  // `offset` if the tt.divisibility hint of the kernel argument that `base`
+  // comes from proves it to be larger than the alignment of the element type.
+  static std::optional<int64_t> getKnownAlignment(Value base,
+                                                  OpFoldResult offset,
+                                                  MemRefType resultType) {
+    if (auto reinterpretCast =
+            base.getDefiningOp<memref::ReinterpretCastOp>()) {
+      base = reinterpretCast.getSource();
+    }
+    auto baseDivisibility = getArgDivisibility(base);
+    auto elemType = resultType.getElementType();
+    if (!baseDivisibility || !elemType.isIntOrFloat()) {
+      return std::nullopt;
+    }
+
+    int64_t elemBytes = llvm::divideCeil(elemType.getIntOrFloatBitWidth(), 8);
+    if (!llvm::isPowerOf2_64(elemBytes)) {
+      return std::nullopt;
+    }
+    int64_t alignment =
+        std::min(getPowerOfTwoDivisor(baseDivisibility.value()),
+                 getKnownDivisor(offset) * elemBytes);
+    if (alignment <= elemBytes) {
+      return std::nullopt;
+    }
+    return alignment;
+  }
+
   LogicalResult rewritePtr(ArrayRef<int64_t> resultShape, bool isBlockPtr,
                            tts::MakeTensorPtrOp op, OpAdaptor adaptor,
                            ConversionPatternRewriter &rewriter) const {
@@ -396,6 +511,11 @@ private:
         op.getLoc(), resultType, ptr, targetOffset, op.getMixedSizes(),
         mixedStrides);
 
+    if (auto alignment = getKnownAlignment(ptr, targetOffset, resultType)) {
+      rewriter.create<memref::AssumeAlignmentOp>(op.getLoc(), castOp,
+                                                 alignment.value());
+    }
+
     rewriter.replaceOp(op, castOp);
 
     return success();
@@ -522,6 +642,62 @@ private:
     rewriter.create<memref::CopyOp>(loc, block2, block2Dst);
   }
 
+  void createSingleCopy(Value block, Value dst, Location loc,
+                        ConversionPatternRewriter &rewriter) const {
+    auto zero =
+        rewriter.create<arith::ConstantOp>(loc, rewriter.getIndexAttr(0));
+    auto one =
+        rewriter.create<arith::ConstantOp>(loc, rewriter.getIndexAttr(1));
+
+    Value blockRow = rewriter.create<memref::DimOp>(loc, block, 0);
+    Value blockCol = rewriter.create<memref::DimOp>(loc, block, 1);
+
+    auto blockDst =
+        rewriter.create<memref::SubViewOp>(loc, dst, /* offsets */
+                                           ValueRange{zero, zero},
+                                           /* sizes */
+                                           ValueRange{blockRow, blockCol},
+                                           /* strides */
+                                           ValueRange{one, one});
+
+    rewriter.create<memref::CopyOp>(loc, block, blockDst);
+  }
+
+  // A block of a wraparound pointer only spans both chunks if the second one
+  // is not empty, which for ring buffers is rarely the case. Check for this at
+  // runtime and only do the split copies when the block actually wraps around;
+  // otherwise the first chunk is the whole block and is copied directly.
+  void createWraparoundCopies(UnrealizedConversionCastOp unrealizedCast,
+                              Value block1, Value block2, Value dst,
+                              Location loc,
+                              ConversionPatternRewriter &rewriter) const {
+    bool sideBySide = unrealizedCast->hasAttr(WRAP_SIDE_BY_SIDE);
+    if (!sideBySide && !unrealizedCast->hasAttr(WRAP_STACKED)) {
+      llvm_unreachable("unexpected wraparound type");
+    }
+
+    auto zero =
+        rewriter.create<arith::ConstantOp>(loc, rewriter.getIndexAttr(0));
+    Value block2Size =
+        rewriter.create<memref::DimOp>(loc, block2, sideBySide ? 1 : 0);
+    Value wraps = rewriter.create<arith::CmpIOp>(
+        loc, arith::CmpIPredicate::ne, block2Size, zero);
+
+    auto ifOp =
+        rewriter.create<scf::IfOp>(loc, wraps, /*withElseRegion=*/true);
+
+    OpBuilder::InsertionGuard guard(rewriter);
+    rewriter.setInsertionPointToStart(ifOp.thenBlock());
+    if (sideBySide) {
+      createSideBySideCopies(block1, block2, dst, loc, rewriter);
+    } else {
+      createStackedCopies(block1, block2, dst, loc, rewriter);
+    }
+
+    rewriter.setInsertionPointToStart(ifOp.elseBlock());
+    createSingleCopy(block1, dst, loc, rewriter);
+  }
+
   memref::SubViewOp createSubview(Value src, ArrayRef<OpFoldResult> offsets,
                                   ArrayRef<OpFoldResult> sizes,
                                   ArrayRef<OpFoldResult> strides, Location loc,
@@ -599,13 +775,8 @@ private:
       auto block1 = memrefs[0];
       auto block2 = memrefs[1];
 
-      if (unrealizedCast->hasAttr(WRAP_SIDE_BY_SIDE)) {
-        createSideBySideCopies(block1, block2, alloc, loc, rewriter);
-      } else if (unrealizedCast->hasAttr(WRAP_STACKED)) {
-        createStackedCopies(block1, block2, alloc, loc, rewriter);
-      } else {
-        llvm_unreachable("unexpected wraparound type");
-      }
+      createWraparoundCopies(unrealizedCast, block1, block2, alloc, loc,
+                             rewriter);
     } else {
       rewriter.create<memref::CopyOp>(loc, ptr, alloc);
     }
@@ -617,6 +788,42 @@ private:
     return success();
   }
 
+  // Fill the elements of `dst` outside of the [0, dims) box with `other`.
+  // The complement of the box is split into one slab per dimension: slab i
+  // covers [dims[i], shape[i]) along dimension i, the valid range [0, dims[j])
+  // along the preceding dimensions and the full range along the following
+  // ones. This writes every masked off element exactly once and leaves the
+  // elements that are about to be copied over untouched.
+  void fillMaskedOffRegion(Value other, Value dst,
+                           ArrayRef<OpFoldResult> dims, Location loc,
+                           OpBuilder &b) const {
+    auto dstType = cast<MemRefType>(dst.getType());
+    auto shape = dstType.getShape();
+    auto rank = dstType.getRank();
+    SmallVector<OpFoldResult> strides(rank, b.getIndexAttr(1));
+
+    for (int64_t i = 0; i < rank; i++) {
+      SmallVector<OpFoldResult> offsets(rank, b.getIndexAttr(0));
+      SmallVector<OpFoldResult> sizes;
+      for (int64_t j = 0; j < rank; j++) {
+        if (j < i) {
+          sizes.push_back(dims[j]);
+        } else if (j == i) {
+          offsets[j] = dims[j];
+          sizes.push_back(subOFRs(b.getIndexAttr(shape[j]), dims[j], loc, b));
+        } else {
+          sizes.push_back(b.getIndexAttr(shape[j]));
+        }
+      }
+
+      auto slabType =
+          memref::SubViewOp::inferResultType(dstType, offsets, sizes, strides);
+      auto slab = b.create<memref::SubViewOp>(loc, cast<MemRefType>(slabType),
+                                              dst, offsets, sizes, strides);
+      b.create<linalg::FillOp>(loc, ValueRange{other}, ValueRange{slab});
+    }
+  }
+
   LogicalResult rewriteMaskedLoad(tts::LoadOp op, OpAdaptor adaptor,
                                   ConversionPatternRewriter &rewriter) const {
     assert(op.hasMask());
@@ -658,8 +865,7 @@ private:
       // condition the memset on the or-accumulation
       // initialize with padding prior to CopyOp
       rewriter.create<scf::IfOp>(loc, accBase, [&](OpBuilder &b, Location loc) {
-        b.create<linalg::FillOp>(loc, ValueRange{op.getOther()},
-                                 ValueRange{alloc});
+        fillMaskedOffRegion(op.getOther(), alloc, mixedDims, loc, b);
         b.create<scf::YieldOp>(loc);
       });
     }
@@ -673,11 +879,13 @@ private:
       if (unrealizedCast->hasAttr(WRAP_SIDE_BY_SIDE)) {
         auto [subview1, subview2] =
             getSideBySideSubviews(mixedDims, block1, block2, loc, rewriter);
-        createSideBySideCopies(subview1, subview2, alloc, loc, rewriter);
+        createWraparoundCopies(unrealizedCast, subview1, subview2, alloc, loc,
+                               rewriter);
       } else if (unrealizedCast->hasAttr(WRAP_STACKED)) {
         auto [subview1, subview2] =
             getStackedSubviews(mixedDims, block1, block2, loc, rewriter);
-        createStackedCopies(subview1, subview2, alloc, loc, rewriter);
+        createWraparoundCopies(unrealizedCast, subview1, subview2, alloc, loc,
+                               rewriter);
       } else {
         llvm_unreachable("unexpected wraparound type");
       }
@@ -806,6 +1014,553 @@ public:
   }
 };
 
+// Gathers and scatters are emitted as 1-D vector.gather / vector.scatter ops
+// over chunks of at most this many elements, which keeps the vectors within a
+// few native registers regardless of the tensor size.
+static constexpr int64_t kGatherScatterChunkSize = 16;
+
+// Return a 1-D view of the buffer behind the scalar pointer `base` (converted
+// to a memref) starting at the element the pointer points to. How far the
+// buffer extends is unknown, so the view is dynamically sized and covers the
+// `extent` elements read or written through it. Only the base pointer of the
+// view is used once lowered, so computing `extent` costs nothing at runtime.
+static Value getGatherScatterBuffer(Value base, Type elemType, Value extent,
+                                    Location loc, OpBuilder &b) {
+  OpFoldResult offset = b.getIndexAttr(0);
+  if (auto reinterpretCast = base.getDefiningOp<memref::ReinterpretCastOp>()) {
+    offset = reinterpretCast.getMixedOffsets()[0];
+  }
+  int64_t staticOffset =
+      getConstantIntValue(offset).value_or(ShapedType::kDynamic);
+  auto layout = StridedLayoutAttr::get(b.getContext(), staticOffset, {1});
+  auto bufferType =
+      MemRefType::get({ShapedType::kDynamic}, elemType, layout);
+  return b.create<memref::ReinterpretCastOp>(
+      loc, bufferType, base, offset, ArrayRef<OpFoldResult>{extent},
+      ArrayRef<OpFoldResult>{b.getIndexAttr(1)});
+}
+
+// The number of elements a gather or scatter with the offsets `chunkOffsets`
+// may access: one past the largest offset.
+static Value getChunkExtent(Value chunkOffsets, Location loc, OpBuilder &b) {
+  Value maxOffset = b.create<vector::ReductionOp>(
+      loc, vector::CombiningKind::MAXSI, chunkOffsets);
+  Value maxIndex =
+      b.create<arith::IndexCastOp>(loc, b.getIndexType(), maxOffset);
+  Value one = b.create<arith::ConstantIndexOp>(loc, 1);
+  return b.create<arith::AddIOp>(loc, maxIndex, one);
+}
+
+// Collapse `tensor` into a 1-D tensor.
+static Value flattenTensor(Value tensor, Location loc, OpBuilder &b) {
+  auto type = cast<RankedTensorType>(tensor.getType());
+  if (type.getRank() == 1) {
+    return tensor;
+  }
+  ReassociationIndices dims(type.getRank());
+  std::iota(dims.begin(), dims.end(), 0);
+  return b.create<tensor::CollapseShapeOp>(
+      loc, tensor, ArrayRef<ReassociationIndices>{dims});
+}
+
+static int64_t getGatherScatterChunkSize(int64_t numElements) {
+  // Largest power of two dividing numElements, so that no chunk is partial.
+  return std::min(kGatherScatterChunkSize, numElements & -numElements);
+}
+
+// Read the chunk of the 1-D tensor `tensor` starting at `iv`.
+static Value readChunk(Value tensor, Value iv, int64_t chunkSize, Location loc,
+                       OpBuilder &b) {
+  auto elemType = cast<RankedTensorType>(tensor.getType()).getElementType();
+  auto vectorType = VectorType::get({chunkSize}, elemType);
+  Value padding =
+      b.create<arith::ConstantOp>(loc, cast<TypedAttr>(b.getZeroAttr(elemType)));
+  return b.create<vector::TransferReadOp>(loc, vectorType, tensor,
+                                          ValueRange{iv}, padding,
+                                          ArrayRef<bool>{true});
+}
+
+static Value getChunkMask(Value flatMask, Value iv, int64_t chunkSize,
+                          Location loc, OpBuilder &b) {
+  if (flatMask) {
+    return readChunk(flatMask, iv, chunkSize, loc, b);
+  }
+  auto maskType = VectorType::get({chunkSize}, b.getI1Type());
+  return b.create<arith::ConstantOp>(loc,
+                                     DenseElementsAttr::get(maskType, true));
+}
+
+struct GatherConverter : public OpConversionPattern<tts::GatherOp> {
+  using OpConversionPattern<tts::GatherOp>::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(tts::GatherOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto loc = op.getLoc();
+    auto resultType = cast<RankedTensorType>(op.getType());
+    auto elemType = resultType.getElementType();
+    if (!resultType.hasStaticShape() || !elemType.isIntOrFloat()) {
+      return rewriter.notifyMatchFailure(
+          op, "only statically shaped tensors of scalars can be gathered");
+    }
+    if (!isa<MemRefType>(adaptor.getBase().getType())) {
+      return rewriter.notifyMatchFailure(op, "base pointer is not converted");
+    }
+
+    int64_t numElements = resultType.getNumElements();
+    int64_t chunkSize = getGatherScatterChunkSize(numElements);
+    auto chunkType = VectorType::get({chunkSize}, elemType);
+
+    Value offsets = flattenTensor(op.getOffsets(), loc, rewriter);
+    Value mask = op.getMask() ? flattenTensor(op.getMask(), loc, rewriter)
+                              : Value();
+    Value other = op.getOther() ? flattenTensor(op.getOther(), loc, rewriter)
+                                : Value();
+
+    Value init = rewriter.create<tensor::EmptyOp>(
+        loc, ArrayRef<int64_t>{numElements}, elemType);
+    Value zero = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+    Value upper = rewriter.create<arith::ConstantIndexOp>(loc, numElements);
+    Value step = rewriter.create<arith::ConstantIndexOp>(loc, chunkSize);
+
+    auto forOp = rewriter.create<scf::ForOp>(
+        loc, zero, upper, step, ValueRange{init},
+        [&](OpBuilder &b, Location loc, Value iv, ValueRange iterArgs) {
+          Value chunkOffsets = readChunk(offsets, iv, chunkSize, loc, b);
+          Value chunkMask = getChunkMask(mask, iv, chunkSize, loc, b);
+          Value buffer = getGatherScatterBuffer(
+              adaptor.getBase(), elemType,
+              getChunkExtent(chunkOffsets, loc, b), loc, b);
+          Value passThru =
+              other ? readChunk(other, iv, chunkSize, loc, b)
+                    : b.create<arith::ConstantOp>(
+                          loc, cast<TypedAttr>(b.getZeroAttr(chunkType)));
+          Value gather = b.create<vector::GatherOp>(
+              loc, chunkType, buffer, ValueRange{zero}, chunkOffsets,
+              chunkMask, passThru);
+          Value result = b.create<vector::TransferWriteOp>(
+                              loc, gather, iterArgs[0], ValueRange{iv},
+                              ArrayRef<bool>{true})
+                             .getResult();
+          b.create<scf::YieldOp>(loc, result);
+        });
+
+    Value result = forOp.getResult(0);
+    if (resultType.getRank() > 1) {
+      ReassociationIndices dims(resultType.getRank());
+      std::iota(dims.begin(), dims.end(), 0);
+      result = rewriter.create<tensor::ExpandShapeOp>(
+          loc, resultType, result, ArrayRef<ReassociationIndices>{dims});
+    }
+
+    rewriter.replaceOp(op, result);
+    return success();
+  }
+};
+
+struct ScatterConverter : public OpConversionPattern<tts::ScatterOp> {
+  using OpConversionPattern<tts::ScatterOp>::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(tts::ScatterOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto loc = op.getLoc();
+    auto valueType = cast<RankedTensorType>(op.getValue().getType());
+    auto elemType = valueType.getElementType();
+    if (!valueType.hasStaticShape() || !elemType.isIntOrFloat()) {
+      return rewriter.notifyMatchFailure(
+          op, "only statically shaped tensors of scalars can be scattered");
+    }
+    if (!isa<MemRefType>(adaptor.getBase().getType())) {
+      return rewriter.notifyMatchFailure(op, "base pointer is not converted");
+    }
+
+    int64_t numElements = valueType.getNumElements();
+    int64_t chunkSize = getGatherScatterChunkSize(numElements);
+
+    Value offsets = flattenTensor(op.getOffsets(), loc, rewriter);
+    Value value = flattenTensor(op.getValue(), loc, rewriter);
+    Value mask = op.getMask() ? flattenTensor(op.getMask(), loc, rewriter)
+                              : Value();
+
+    Value zero = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+    Value upper = rewriter.create<arith::ConstantIndexOp>(loc, numElements);
+    Value step = rewriter.create<arith::ConstantIndexOp>(loc, chunkSize);
+
+    rewriter.create<scf::ForOp>(
+        loc, zero, upper, step, ValueRange{},
+        [&](OpBuilder &b, Location loc, Value iv, ValueRange iterArgs) {
+          Value chunkOffsets = readChunk(offsets, iv, chunkSize, loc, b);
+          Value chunkMask = getChunkMask(mask, iv, chunkSize, loc, b);
+          Value buffer = getGatherScatterBuffer(
+              adaptor.getBase(), elemType,
+              getChunkExtent(chunkOffsets, loc, b), loc, b);
+          Value chunkValue = readChunk(value, iv, chunkSize, loc, b);
+          b.create<vector::ScatterOp>(loc, buffer, ValueRange{zero},
+                                      chunkOffsets, chunkMask, chunkValue);
+          b.create<scf::YieldOp>(loc);
+        });
+
+    rewriter.eraseOp(op);
+    return success();
+  }
+};
+
+// Atomics update their elements one at a time with memref.atomic_rmw, or with
+// memref.generic_atomic_rmw (a compare-and-swap loop) for the operations
+// LLVM's atomicrmw does not have. x86 and AArch64 have no vector atomic
+// read-modify-write, so there is nothing to gain from vectors here. Both ops
+// lower to LLVM atomics with acquire-release ordering, at least as strong as
+// any memory semantics a Triton atomic can ask for.
+static std::optional<arith::AtomicRMWKind>
+getAtomicRMWKind(triton::RMWOp rmwOp, Type elemType) {
+  if (isa<FloatType>(elemType)) {
+    switch (rmwOp) {
+    case triton::RMWOp::ADD:
+    case triton::RMWOp::FADD:
+      return arith::AtomicRMWKind::addf;
+    case triton::RMWOp::XCHG:
+      return arith::AtomicRMWKind::assign;
+    default:
+      return std::nullopt;
+    }
+  }
+  switch (rmwOp) {
+  case triton::RMWOp::AND:
+    return arith::AtomicRMWKind::andi;
+  case triton::RMWOp::OR:
+    return arith::AtomicRMWKind::ori;
+  case triton::RMWOp::ADD:
+    return arith::AtomicRMWKind::addi;
+  case triton::RMWOp::MAX:
+    return arith::AtomicRMWKind::maxs;
+  case triton::RMWOp::MIN:
+    return arith::AtomicRMWKind::mins;
+  case triton::RMWOp::UMAX:
+    return arith::AtomicRMWKind::maxu;
+  case triton::RMWOp::UMIN:
+    return arith::AtomicRMWKind::minu;
+  case triton::RMWOp::XCHG:
+    return arith::AtomicRMWKind::assign;
+  default:
+    return std::nullopt;
+  }
+}
+
+static bool isSupportedAtomicRMW(triton::RMWOp rmwOp, Type elemType) {
+  if (!elemType.isIntOrFloat()) {
+    return false;
+  }
+  if (getAtomicRMWKind(rmwOp, elemType)) {
+    return true;
+  }
+  // Emitted as compare-and-swap loops by createAtomicRMW.
+  bool isFloat = isa<FloatType>(elemType);
+  return (rmwOp == triton::RMWOp::XOR && !isFloat) ||
+         ((rmwOp == triton::RMWOp::MAX || rmwOp == triton::RMWOp::MIN) &&
+          isFloat);
+}
+
+// Atomically apply `rmwOp` with `value` to buffer[index] and return the value
+// of the element before the update.
+static Value createAtomicRMW(triton::RMWOp rmwOp, Value buffer, Value index,
+                             Value value, Location loc, OpBuilder &b) {
+  if (auto kind = getAtomicRMWKind(rmwOp, value.getType())) {
+    return b.create<memref::AtomicRMWOp>(loc, *kind, value, buffer,
+                                         ValueRange{index});
+  }
+
+  auto genericOp =
+      b.create<memref::GenericAtomicRMWOp>(loc, buffer, ValueRange{index});
+  OpBuilder bodyBuilder =
+      OpBuilder::atBlockEnd(genericOp.getBody(), b.getListener());
+  Value current = genericOp.getCurrentValue();
+  Value updated;
+  switch (rmwOp) {
+  case triton::RMWOp::XOR:
+    updated = bodyBuilder.create<arith::XOrIOp>(loc, current, value);
+    break;
+  case triton::RMWOp::MAX:
+    updated = bodyBuilder.create<arith::MaximumFOp>(loc, current, value);
+    break;
+  case triton::RMWOp::MIN:
+    updated = bodyBuilder.create<arith::MinimumFOp>(loc, current, value);
+    break;
+  default:
+    llvm_unreachable("unsupported atomic rmw op");
+  }
+  bodyBuilder.create<memref::AtomicYieldOp>(loc, updated);
+  return genericOp.getResult();
+}
+
+// Atomically replace buffer[index] with `value` if it is equal to `cmp`, and
+// return the value of the element before the exchange. Floats are compared
+// bitwise, like the cmpxchg instruction does.
+static Value createAtomicCAS(Value buffer, Value index, Value cmp, Value value,
+                             Location loc, OpBuilder &b) {
+  auto genericOp =
+      b.create<memref::GenericAtomicRMWOp>(loc, buffer, ValueRange{index});
+  OpBuilder bodyBuilder =
+      OpBuilder::atBlockEnd(genericOp.getBody(), b.getListener());
+  Value current = genericOp.getCurrentValue();
+  Value lhs = current;
+  Value rhs = cmp;
+  if (isa<FloatType>(cmp.getType())) {
+    auto intType =
+        bodyBuilder.getIntegerType(cmp.getType().getIntOrFloatBitWidth());
+    lhs = bodyBuilder.create<arith::BitcastOp>(loc, intType, lhs);
+    rhs = bodyBuilder.create<arith::BitcastOp>(loc, intType, rhs);
+  }
+  Value equal = bodyBuilder.create<arith::CmpIOp>(
+      loc, arith::CmpIPredicate::eq, lhs, rhs);
+  Value updated =
+      bodyBuilder.create<arith::SelectOp>(loc, equal, value, current);
+  bodyBuilder.create<memref::AtomicYieldOp>(loc, updated);
+  return genericOp.getResult();
+}
+
+// Whether `mask` is known to be set for every element: the frontend passes an
+// all-true mask to atomics called without one, which reaches this pass as a
+// constant or, for tensors, a linalg.fill of a constant.
+static bool isAllTrueMask(Value mask) {
+  if (!mask || matchPattern(mask, m_One())) {
+    return true;
+  }
+  if (auto fillOp = mask.getDefiningOp<linalg::FillOp>()) {
+    return matchPattern(fillOp.getInputs()[0], m_One());
+  }
+  return false;
+}
+
+static Value extractElementIndex(Value offsets, Value iv, Location loc,
+                                 OpBuilder &b) {
+  Value offset = b.create<tensor::ExtractOp>(loc, offsets, iv);
+  return b.create<arith::IndexCastOp>(loc, b.getIndexType(), offset);
+}
+
+// The view of the buffer behind `base` in which the element `index` is
+// updated, see getGatherScatterBuffer.
+static Value getElementBuffer(Value base, Type elemType, Value index,
+                              Location loc, OpBuilder &b) {
+  Value one = b.create<arith::ConstantIndexOp>(loc, 1);
+  Value extent = b.create<arith::AddIOp>(loc, index, one);
+  return getGatherScatterBuffer(base, elemType, extent, loc, b);
+}
+
+struct AtomicRMWConverter : public OpConversionPattern<tts::AtomicRMWOp> {
+  using OpConversionPattern<tts::AtomicRMWOp>::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(tts::AtomicRMWOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto loc = op.getLoc();
+    auto resultType = cast<RankedTensorType>(op.getType());
+    auto elemType = resultType.getElementType();
+    auto rmwOp = op.getAtomicRmwOp();
+    if (!resultType.hasStaticShape() ||
+        !isSupportedAtomicRMW(rmwOp, elemType)) {
+      return rewriter.notifyMatchFailure(
+          op, "unsupported atomic rmw op or element type");
+    }
+    if (!isa<MemRefType>(adaptor.getBase().getType())) {
+      return rewriter.notifyMatchFailure(op, "base pointer is not converted");
+    }
+
+    int64_t numElements = resultType.getNumElements();
+    Value offsets = flattenTensor(op.getOffsets(), loc, rewriter);
+    Value value = flattenTensor(op.getValue(), loc, rewriter);
+    Value mask = isAllTrueMask(op.getMask())
+                     ? Value()
+                     : flattenTensor(op.getMask(), loc, rewriter);
+    // Atomics are mostly used for their side effect only.
+    bool needsResult = !op.getResult().use_empty();
+
+    SmallVector<Value> inits;
+    if (needsResult) {
+      inits.push_back(rewriter.create<tensor::EmptyOp>(
+          loc, ArrayRef<int64_t>{numElements}, elemType));
+    }
+    Value zero = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+    Value upper = rewriter.create<arith::ConstantIndexOp>(loc, numElements);
+    Value one = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+
+    auto forOp = rewriter.create<scf::ForOp>(
+        loc, zero, upper, one, inits,
+        [&](OpBuilder &b, Location loc, Value iv, ValueRange iterArgs) {
+          Value index = extractElementIndex(offsets, iv, loc, b);
+          Value buffer = getElementBuffer(adaptor.getBase(), elemType, index,
+                                          loc, b);
+          Value elem = b.create<tensor::ExtractOp>(loc, value, iv);
+          auto update = [&](OpBuilder &b, Location loc) {
+            return createAtomicRMW(rmwOp, buffer, index, elem, loc, b);
+          };
+
+          Value old;
+          if (!mask) {
+            old = update(b, loc);
+          } else {
+            Value elemMask = b.create<tensor::ExtractOp>(loc, mask, iv);
+            if (needsResult) {
+              old = b.create<scf::IfOp>(
+                         loc, elemMask,
+                         [&](OpBuilder &b, Location loc) {
+                           b.create<scf::YieldOp>(loc, update(b, loc));
+                         },
+                         [&](OpBuilder &b, Location loc) {
+                           Value undef = b.create<arith::ConstantOp>(
+                               loc, cast<TypedAttr>(b.getZeroAttr(elemType)));
+                           b.create<scf::YieldOp>(loc, undef);
+                         })
+                        .getResult(0);
+            } else {
+              b.create<scf::IfOp>(loc, elemMask,
+                                  [&](OpBuilder &b, Location loc) {
+                                    update(b, loc);
+                                    b.create<scf::YieldOp>(loc);
+                                  });
+            }
+          }
+
+          if (needsResult) {
+            Value result =
+                b.create<tensor::InsertOp>(loc, old, iterArgs[0], iv);
+            b.create<scf::YieldOp>(loc, result);
+          } else {
+            b.create<scf::YieldOp>(loc);
+          }
+        });
+
+    if (!needsResult) {
+      rewriter.eraseOp(op);
+      return success();
+    }
+
+    Value result = forOp.getResult(0);
+    if (resultType.getRank() > 1) {
+      ReassociationIndices dims(resultType.getRank());
+      std::iota(dims.begin(), dims.end(), 0);
+      result = rewriter.create<tensor::ExpandShapeOp>(
+          loc, resultType, result, ArrayRef<ReassociationIndices>{dims});
+    }
+    rewriter.replaceOp(op, result);
+    return success();
+  }
+};
+
+struct AtomicCASConverter : public OpConversionPattern<tts::AtomicCASOp> {
+  using OpConversionPattern<tts::AtomicCASOp>::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(tts::AtomicCASOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto loc = op.getLoc();
+    auto resultType = cast<RankedTensorType>(op.getType());
+    auto elemType = resultType.getElementType();
+    if (!resultType.hasStaticShape() || !elemType.isIntOrFloat()) {
+      return rewriter.notifyMatchFailure(
+          op, "only statically shaped tensors of scalars are supported");
+    }
+    if (!isa<MemRefType>(adaptor.getBase().getType())) {
+      return rewriter.notifyMatchFailure(op, "base pointer is not converted");
+    }
+
+    int64_t numElements = resultType.getNumElements();
+    Value offsets = flattenTensor(op.getOffsets(), loc, rewriter);
+    Value cmp = flattenTensor(op.getCmp(), loc, rewriter);
+    Value value = flattenTensor(op.getValue(), loc, rewriter);
+
+    Value init = rewriter.create<tensor::EmptyOp>(
+        loc, ArrayRef<int64_t>{numElements}, elemType);
+    Value zero = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+    Value upper = rewriter.create<arith::ConstantIndexOp>(loc, numElements);
+    Value one = rewriter.create<arith::ConstantIndexOp>(loc, 1);
+
+    auto forOp = rewriter.create<scf::ForOp>(
+        loc, zero, upper, one, ValueRange{init},
+        [&](OpBuilder &b, Location loc, Value iv, ValueRange iterArgs) {
+          Value index = extractElementIndex(offsets, iv, loc, b);
+          Value buffer = getElementBuffer(adaptor.getBase(), elemType, index,
+                                          loc, b);
+          Value elemCmp = b.create<tensor::ExtractOp>(loc, cmp, iv);
+          Value elem = b.create<tensor::ExtractOp>(loc, value, iv);
+          Value old = createAtomicCAS(buffer, index, elemCmp, elem, loc, b);
+          Value result = b.create<tensor::InsertOp>(loc, old, iterArgs[0], iv);
+          b.create<scf::YieldOp>(loc, result);
+        });
+
+    Value result = forOp.getResult(0);
+    if (resultType.getRank() > 1) {
+      ReassociationIndices dims(resultType.getRank());
+      std::iota(dims.begin(), dims.end(), 0);
+      result = rewriter.create<tensor::ExpandShapeOp>(
+          loc, resultType, result, ArrayRef<ReassociationIndices>{dims});
+    }
+    rewriter.replaceOp(op, result);
+    return success();
+  }
+};
+
+struct ScalarAtomicRMWConverter
+    : public OpConversionPattern<triton::AtomicRMWOp> {
+  using OpConversionPattern<triton::AtomicRMWOp>::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(triton::AtomicRMWOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto elemType = op.getType();
+    auto rmwOp = op.getAtomicRmwOp();
+    if (!elemType.isIntOrFloat() || !isSupportedAtomicRMW(rmwOp, elemType) ||
+        !isa<MemRefType>(adaptor.getPtr().getType())) {
+      return failure();
+    }
+
+    auto loc = op->getLoc();
+    Value buffer = adaptor.getPtr();
+    Value zero = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+    if (isAllTrueMask(op.getMask())) {
+      rewriter.replaceOp(op, createAtomicRMW(rmwOp, buffer, zero,
+                                             adaptor.getVal(), loc, rewriter));
+      return success();
+    }
+
+    auto ifOp = rewriter.create<scf::IfOp>(
+        loc, adaptor.getMask(),
+        [&](OpBuilder &b, Location loc) {
+          Value old =
+              createAtomicRMW(rmwOp, buffer, zero, adaptor.getVal(), loc, b);
+          b.create<scf::YieldOp>(loc, old);
+        },
+        [&](OpBuilder &b, Location loc) {
+          Value undef = b.create<arith::ConstantOp>(
+              loc, cast<TypedAttr>(b.getZeroAttr(elemType)));
+          b.create<scf::YieldOp>(loc, undef);
+        });
+    rewriter.replaceOp(op, ifOp.getResults());
+    return success();
+  }
+};
+
+struct ScalarAtomicCASConverter
+    : public OpConversionPattern<triton::AtomicCASOp> {
+  using OpConversionPattern<triton::AtomicCASOp>::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(triton::AtomicCASOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    if (!op.getType().isIntOrFloat() ||
+        !isa<MemRefType>(adaptor.getPtr().getType())) {
+      return failure();
+    }
+
+    auto loc = op->getLoc();
+    Value zero = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+    rewriter.replaceOp(op, createAtomicCAS(adaptor.getPtr(), zero,
+                                           adaptor.getCmp(), adaptor.getVal(),
+                                           loc, rewriter));
+    return success();
+  }
+};
+
 struct UnrealizedCastConverter
     : public OpConversionPattern<UnrealizedConversionCastOp> {
 private:
@@ -854,6 +1609,8 @@ void mlir::triton::populateStructuredToMemrefConversionPatterns(
     RewritePatternSet &patterns, TypeConverter &typeConverter) {
   patterns.add<UnrealizedCastConverter>(typeConverter, patterns.getContext());
   patterns.add<MakeTensorPtrConverter, LoadConverter, StoreConverter,
-               ScalarLoadConverter, ScalarStoreConverter>(
+               GatherConverter, ScatterConverter, AtomicRMWConverter,
+               AtomicCASConverter, ScalarLoadConverter, ScalarStoreConverter,
+               ScalarAtomicRMWConverter, ScalarAtomicCASConverter>(
       patterns.getContext());
 }
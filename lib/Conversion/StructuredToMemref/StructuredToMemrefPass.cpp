@@ -25,7 +25,11 @@
 #include "mlir/Dialect/Bufferization/IR/Bufferization.h"
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
 #include "mlir/Dialect/SCF/Transforms/Patterns.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
 #include "mlir/Dialect/Tensor/TransformOps/TensorTransformOps.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
+#include "mlir/Interfaces/DestinationStyleOpInterface.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Transforms/Passes.h"
 #include "triton/Dialect/Triton/IR/Types.h"
@@ -210,6 +214,75 @@ static std::optional<Value> buildCastOp(OpBuilder &builder, Type resultType,
       .getResult(0);
 }
 
+// Whether `op`, or an op nested in it, may read or write memory.
+static bool mayAccessMemory(Operation *op) {
+  WalkResult result = op->walk([](Operation *nested) {
+    if (auto iface = dyn_cast<MemoryEffectOpInterface>(nested)) {
+      SmallVector<MemoryEffects::EffectInstance> effects;
+      iface.getEffects(effects);
+      for (auto &effect : effects) {
+        if (isa<MemoryEffects::Read, MemoryEffects::Write>(
+                effect.getEffect())) {
+          return WalkResult::interrupt();
+        }
+      }
+      return WalkResult::advance();
+    }
+    if (nested->hasTrait<OpTrait::HasRecursiveMemoryEffects>()) {
+      return WalkResult::advance();
+    }
+    return WalkResult::interrupt();
+  });
+  return result.wasInterrupted();
+}
+
+// The tensor.empty that `value` is computed in through the inits of
+// destination-style ops, if each value of that chain has a single use.
+static tensor::EmptyOp getEmptyInit(Value value) {
+  while (auto result = dyn_cast<OpResult>(value)) {
+    if (!value.hasOneUse()) {
+      return {};
+    }
+    Operation *def = result.getOwner();
+    if (auto empty = dyn_cast<tensor::EmptyOp>(def)) {
+      return empty;
+    }
+    auto dps = dyn_cast<DestinationStyleOpInterface>(def);
+    if (!dps || !dps.hasPureTensorSemantics()) {
+      return {};
+    }
+    value = dps.getTiedOpOperand(result)->get();
+  }
+  return {};
+}
+
+// bufferization.materialize_in_destination only lets eliminate-empty-tensors
+// compute its source in the destination memref when it is `restrict`: the
+// tile is then written to the destination by the ops producing it instead
+// of into a new buffer copied at the store. Mark the stores for which this
+// is safe, those whose tile is computed from a tensor.empty in the same
+// block with nothing accessing memory between the two: a load of the
+// destination in between would otherwise see the tile before it is stored.
+static void markInPlaceStores(ModuleOp moduleOp) {
+  moduleOp.walk([](bufferization::MaterializeInDestinationOp op) {
+    if (!isa<BaseMemRefType>(op.getDest().getType()) || op.getRestrict()) {
+      return;
+    }
+    auto empty = getEmptyInit(op.getSource());
+    if (!empty || empty->getBlock() != op->getBlock() ||
+        !empty->isBeforeInBlock(op)) {
+      return;
+    }
+    for (Operation *it = empty->getNextNode(); it != op.getOperation();
+         it = it->getNextNode()) {
+      if (mayAccessMemory(it)) {
+        return;
+      }
+    }
+    op.setRestrict(true);
+  });
+}
+
 class StructuredToMemrefPass
     : public triton::impl::StructuredToMemrefBase<StructuredToMemrefPass> {
   using StructuredToMemrefBase<StructuredToMemrefPass>::StructuredToMemrefBase;
@@ -220,7 +293,8 @@ public:
                     linalg::LinalgDialect, affine::AffineDialect,
                     scf::SCFDialect, tensor::TensorDialect,
                     bufferization::BufferizationDialect, triton::TritonDialect,
-                    ttx::TritonTilingExtDialect, memref::MemRefDialect>();
+                    ttx::TritonTilingExtDialect, memref::MemRefDialect,
+                    vector::VectorDialect>();
   }
 
   LogicalResult convertArgsToMemrefType() {
@@ -377,7 +451,7 @@ public:
         linalg::LinalgDialect, affine::AffineDialect, scf::SCFDialect,
         cf::ControlFlowDialect, tensor::TensorDialect,
         bufferization::BufferizationDialect, ttx::TritonTilingExtDialect,
-        memref::MemRefDialect>();
+        memref::MemRefDialect, vector::VectorDialect>();
 
     target.addIllegalDialect<tts::TritonStructuredDialect>();
 
@@ -403,7 +477,10 @@ public:
     pm.addPass(createCanonicalizerPass());
     if (failed(runPipeline(pm, getOperation()))) {
       signalPassFailure();
+      return;
     }
+
+    markInPlaceStores(moduleOp);
   }
 };
 } // namespace
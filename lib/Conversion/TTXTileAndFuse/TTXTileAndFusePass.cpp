@@ -0,0 +1,230 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// TritonTilingExt ops implement the TilingInterface so that they can be tiled
+// and fused like linalg ops. This pass does so for the chains of elementwise
+// ops around each of them: every tile of rows goes through the producers, the
+// scan and the consumers before the next one is computed, instead of each op
+// of the chain reading and writing a full tensor.
+//
+//===----------------------------------------------------------------------===//
+
+#include "triton-shared/Conversion/TTXTileAndFuse/TTXTileAndFuse.h"
+#include "triton-shared/Dialect/TritonTilingExt/IR/TritonTilingExtDialect.h"
+
+#include "mlir/Dialect/Affine/IR/AffineOps.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/SCF/Transforms/TileUsingInterface.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "mlir/Interfaces/TilingInterface.h"
+
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/Support/Debug.h"
+
+#define DEBUG_TYPE "ttx-tile-and-fuse"
+
+using namespace mlir;
+using namespace triton;
+
+namespace mlir {
+namespace triton {
+#define GEN_PASS_DEF_TTXTILEANDFUSE
+#include "triton-shared/Conversion/TTXTileAndFuse/Passes.h.inc"
+} // namespace triton
+} // namespace mlir
+
+namespace {
+
+// Whether `op` is a linalg op on tensors with identity indexing maps and only
+// parallel iterators, the elementwise ops of a chain.
+static bool isIdentityElementwise(Operation *op) {
+  auto linalgOp = dyn_cast<linalg::LinalgOp>(op);
+  if (!linalgOp || !linalgOp.hasPureTensorSemantics() ||
+      linalgOp.getNumParallelLoops() != linalgOp.getNumLoops()) {
+    return false;
+  }
+  return llvm::all_of(linalgOp.getIndexingMapsArray(),
+                      [](AffineMap map) { return map.isIdentity(); });
+}
+
+// Whether the indexing maps of the operands of the TritonTilingExt op `op`
+// are identities, so that its iteration dimensions are those of its result.
+static bool hasIdentityMaps(ttx::TritonTilingExtInterface op,
+                            ArrayRef<OpFoldResult> sizes) {
+  auto dpsOp = cast<DestinationStyleOpInterface>(op.getOperation());
+  MLIRContext *context = op->getContext();
+  for (int64_t i = 0; i < dpsOp.getNumDpsInputs(); i++) {
+    if (!op.getInputIndexingMap(context, i, sizes).isIdentity()) {
+      return false;
+    }
+  }
+  for (int64_t i = 0; i < dpsOp.getNumDpsInits(); i++) {
+    if (!op.getOutputIndexingMap(context, i, sizes).isIdentity()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Whether `slice` reads the whole extent of `producer`'s result along the
+// reduction dimensions of the TritonTilingExt op `producer`.
+static bool coversReductionDims(tensor::ExtractSliceOp slice,
+                                TilingInterface producer) {
+  auto sourceType = slice.getSourceType();
+  auto offsets = slice.getMixedOffsets();
+  auto sizes = slice.getMixedSizes();
+  for (auto [dim, iterator] :
+       llvm::enumerate(producer.getLoopIteratorTypes())) {
+    if (iterator != utils::IteratorType::reduction) {
+      continue;
+    }
+    if (sourceType.isDynamicDim(dim) ||
+        getConstantIntValue(offsets[dim]) != 0 ||
+        getConstantIntValue(sizes[dim]) != sourceType.getDimSize(dim)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+class TTXTileAndFusePass
+    : public triton::impl::TTXTileAndFuseBase<TTXTileAndFusePass> {
+  using TTXTileAndFuseBase<TTXTileAndFusePass>::TTXTileAndFuseBase;
+
+public:
+  void runOnOperation() override {
+    if (llvm::any_of(tileSizes, [](int64_t size) { return size < 1; })) {
+      getOperation().emitError("ttx-tile-and-fuse: tile sizes must be "
+                               "positive");
+      return signalPassFailure();
+    }
+
+    SmallVector<std::pair<Operation *, SmallVector<OpFoldResult>>> roots;
+    getOperation().walk([&](ttx::TritonTilingExtInterface op) {
+      if (auto root = getRoot(op)) {
+        roots.push_back(*root);
+      }
+    });
+
+    // Later roots first: their loops may absorb the chains of earlier roots,
+    // which are then erased instead of being tiled on their own.
+    IRRewriter rewriter(&getContext());
+    llvm::DenseSet<Operation *> erased;
+    for (auto &[root, sizes] : llvm::reverse(roots)) {
+      if (erased.contains(root)) {
+        continue;
+      }
+      if (failed(tileAndFuse(rewriter, cast<TilingInterface>(root), sizes))) {
+        continue;
+      }
+      eraseDeadOps(root->getBlock(), erased);
+    }
+  }
+
+private:
+  // The op to tile for the chain of `op`, and its tile sizes.
+  std::optional<std::pair<Operation *, SmallVector<OpFoldResult>>>
+  getRoot(ttx::TritonTilingExtInterface op) {
+    auto tilingOp = dyn_cast<TilingInterface>(op.getOperation());
+    if (!tilingOp || op->getNumResults() != 1 ||
+        !isa<RankedTensorType>(op->getResult(0).getType())) {
+      return std::nullopt;
+    }
+
+    OpBuilder b(op);
+    SmallVector<OpFoldResult> sizes;
+    SmallVector<utils::IteratorType> iterators =
+        tilingOp.getLoopIteratorTypes();
+    int64_t parallelDim = 0;
+    for (auto iterator : iterators) {
+      int64_t size = 0;
+      if (iterator == utils::IteratorType::parallel) {
+        size = parallelDim < static_cast<int64_t>(tileSizes.size())
+                   ? tileSizes[parallelDim]
+                   : 1;
+        parallelDim++;
+      }
+      sizes.push_back(b.getIndexAttr(size));
+    }
+    if (parallelDim == 0 || !hasIdentityMaps(op, sizes)) {
+      return std::nullopt;
+    }
+
+    // Follow the chain of elementwise consumers, which have the iteration
+    // dimensions of `op`.
+    Operation *root = op;
+    while (root->getNumResults() == 1 && root->getResult(0).hasOneUse()) {
+      Operation *user = *root->getResult(0).getUsers().begin();
+      if (user->getBlock() != op->getBlock() || !isIdentityElementwise(user) ||
+          cast<linalg::LinalgOp>(user).getNumLoops() != iterators.size()) {
+        break;
+      }
+      root = user;
+    }
+    return std::make_pair(root, sizes);
+  }
+
+  LogicalResult tileAndFuse(RewriterBase &rewriter, TilingInterface root,
+                            ArrayRef<OpFoldResult> sizes) {
+    scf::SCFTilingOptions tilingOptions;
+    tilingOptions.setTileSizes(sizes);
+    scf::SCFTileAndFuseOptions options;
+    options.setTilingOptions(tilingOptions);
+    options.setFusionControlFn(
+        [](tensor::ExtractSliceOp slice, OpResult producer,
+           bool isDestinationOperand) -> std::tuple<bool, bool> {
+          // A tile of the result of a scan needs whole rows of its input.
+          Operation *owner = producer.getOwner();
+          if (isa<ttx::TritonTilingExtInterface>(owner) &&
+              !coversReductionDims(slice, cast<TilingInterface>(owner))) {
+            return {false, false};
+          }
+          return {true, false};
+        });
+
+    rewriter.setInsertionPoint(root);
+    FailureOr<scf::SCFTileAndFuseResult> result =
+        scf::tileConsumerAndFuseProducersUsingSCF(rewriter, root, options);
+    if (failed(result)) {
+      LLVM_DEBUG({
+        llvm::dbgs() << "failed to tile:\n";
+        root->dump();
+      });
+      return failure();
+    }
+    for (OpResult res : root->getResults()) {
+      if (Value replacement = result->replacements.lookup(res)) {
+        rewriter.replaceAllUsesWith(res, replacement);
+      }
+    }
+    LLVM_DEBUG(llvm::dbgs() << "tiled " << root->getName() << " and fused "
+                            << result->fusedProducers.size()
+                            << " producers\n");
+    return success();
+  }
+
+  // Erase the original ops of the chains, now computed tile by tile.
+  void eraseDeadOps(Block *block, llvm::DenseSet<Operation *> &erased) {
+    for (Operation &op : llvm::make_early_inc_range(llvm::reverse(*block))) {
+      if (isOpTriviallyDead(&op)) {
+        erased.insert(&op);
+        op.erase();
+      }
+    }
+  }
+};
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> triton::createTTXTileAndFusePass() {
+  return std::make_unique<TTXTileAndFusePass>();
+}
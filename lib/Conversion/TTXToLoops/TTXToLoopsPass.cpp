@@ -0,0 +1,206 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// TritonTilingExt ops only implement the TilingInterface, nothing lowers them
+// once they have been bufferized. This pass turns them into loops; the scan
+// axis of ttx.cumsum is processed a vector of elements at a time instead of
+// one element per iteration of a loop-carried dependency chain.
+//
+//===----------------------------------------------------------------------===//
+
+#include "triton-shared/Conversion/TTXToLoops/TTXToLoops.h"
+#include "triton-shared/Dialect/TritonTilingExt/IR/TritonTilingExtDialect.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/TypeUtilities.h"
+
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/MathExtras.h"
+
+#define DEBUG_TYPE "ttx-to-loops"
+
+using namespace mlir;
+using namespace triton;
+
+namespace mlir {
+namespace triton {
+#define GEN_PASS_DEF_TTXTOLOOPS
+#include "triton-shared/Conversion/TTXToLoops/Passes.h.inc"
+} // namespace triton
+} // namespace mlir
+
+namespace {
+
+static Value createAdd(OpBuilder &b, Location loc, Value lhs, Value rhs) {
+  if (isa<FloatType>(getElementTypeOrSelf(lhs.getType()))) {
+    return b.create<arith::AddFOp>(loc, lhs, rhs);
+  }
+  return b.create<arith::AddIOp>(loc, lhs, rhs);
+}
+
+// Scan input[batch..., lb:ub] into output[batch..., lb:ub] one element at a
+// time, starting from `carry`. Return the running sum after the last element.
+static Value createSequentialScan(OpBuilder &b, Location loc, Value input,
+                                  Value output, ValueRange batchIvs, Value lb,
+                                  Value ub, Value carry) {
+  Value one = b.create<arith::ConstantIndexOp>(loc, 1);
+  auto loop = b.create<scf::ForOp>(
+      loc, lb, ub, one, ValueRange{carry},
+      [&](OpBuilder &b, Location loc, Value iv, ValueRange iterArgs) {
+        SmallVector<Value> indices(batchIvs);
+        indices.push_back(iv);
+        Value x = b.create<memref::LoadOp>(loc, input, indices);
+        Value sum = createAdd(b, loc, iterArgs[0], x);
+        b.create<memref::StoreOp>(loc, sum, output, indices);
+        b.create<scf::YieldOp>(loc, sum);
+      });
+  return loop.getResult(0);
+}
+
+// Inclusive prefix sum of the lanes of `v`: at step k, every lane adds the
+// lane 2^k below it, so that after log2(n) steps lane i holds v[0] + ... +
+// v[i].
+static Value createInRegisterScan(OpBuilder &b, Location loc, Value v) {
+  auto type = cast<VectorType>(v.getType());
+  int64_t n = type.getNumElements();
+  Value zeros =
+      b.create<arith::ConstantOp>(loc, cast<TypedAttr>(b.getZeroAttr(type)));
+  for (int64_t shift = 1; shift < n; shift *= 2) {
+    // Lanes below `shift` are taken from `zeros`, the others from `v` moved
+    // up by `shift` lanes.
+    SmallVector<int64_t> mask;
+    for (int64_t i = 0; i < n; i++) {
+      mask.push_back(i < shift ? i : n + i - shift);
+    }
+    Value shifted = b.create<vector::ShuffleOp>(loc, zeros, v, mask);
+    v = createAdd(b, loc, v, shifted);
+  }
+  return v;
+}
+
+// Scan the full blocks of input[batch..., 0:ub] with vectors of `blockSize`
+// elements. Return the running sum and the end of the last full block.
+static std::pair<Value, Value>
+createBlockedScan(OpBuilder &b, Location loc, Value input, Value output,
+                  ValueRange batchIvs, Value ub, Value carry,
+                  int64_t blockSize) {
+  auto elemType = cast<MemRefType>(input.getType()).getElementType();
+  auto vectorType = VectorType::get({blockSize}, elemType);
+
+  Value zero = b.create<arith::ConstantIndexOp>(loc, 0);
+  Value step = b.create<arith::ConstantIndexOp>(loc, blockSize);
+  Value numBlocks = b.create<arith::DivUIOp>(loc, ub, step);
+  Value blockedEnd = b.create<arith::MulIOp>(loc, numBlocks, step);
+  Value padding = b.create<arith::ConstantOp>(
+      loc, cast<TypedAttr>(b.getZeroAttr(elemType)));
+
+  auto loop = b.create<scf::ForOp>(
+      loc, zero, blockedEnd, step, ValueRange{carry},
+      [&](OpBuilder &b, Location loc, Value iv, ValueRange iterArgs) {
+        SmallVector<Value> indices(batchIvs);
+        indices.push_back(iv);
+        Value block = b.create<vector::TransferReadOp>(
+            loc, vectorType, input, indices, padding, ArrayRef<bool>{true});
+        block = createInRegisterScan(b, loc, block);
+        Value carryBroadcast =
+            b.create<vector::BroadcastOp>(loc, vectorType, iterArgs[0]);
+        block = createAdd(b, loc, block, carryBroadcast);
+        b.create<vector::TransferWriteOp>(loc, block, output, indices,
+                                          ArrayRef<bool>{true});
+        Value nextCarry = b.create<vector::ExtractOp>(
+            loc, block, ArrayRef<int64_t>{blockSize - 1});
+        b.create<scf::YieldOp>(loc, nextCarry);
+      });
+  return {loop.getResult(0), blockedEnd};
+}
+
+// Vector transfers are only emitted on rows that are contiguous in memory.
+static bool hasUnitInnerStride(MemRefType type) {
+  SmallVector<int64_t> strides;
+  int64_t offset;
+  if (failed(getStridesAndOffset(type, strides, offset))) {
+    return false;
+  }
+  return !strides.empty() && strides.back() == 1;
+}
+
+class TTXToLoopsPass : public triton::impl::TTXToLoopsBase<TTXToLoopsPass> {
+  using TTXToLoopsBase<TTXToLoopsPass>::TTXToLoopsBase;
+
+public:
+  void runOnOperation() override {
+    if (blockSize < 2 || !llvm::isPowerOf2_64(blockSize)) {
+      getOperation().emitError("ttx-to-loops: block-size must be a power of "
+                               "two larger than 1");
+      return signalPassFailure();
+    }
+
+    SmallVector<ttx::CumSumOp> cumsums;
+    getOperation().walk([&](ttx::CumSumOp op) { cumsums.push_back(op); });
+    for (auto op : cumsums) {
+      if (failed(lowerCumSum(op))) {
+        return signalPassFailure();
+      }
+    }
+  }
+
+private:
+  LogicalResult lowerCumSum(ttx::CumSumOp op) {
+    auto inputType = dyn_cast<MemRefType>(op.getInput().getType());
+    auto outputType = dyn_cast<MemRefType>(op.getOutput().getType());
+    if (!inputType || !outputType) {
+      return op.emitError("ttx-to-loops expects a bufferized ttx.cumsum");
+    }
+
+    OpBuilder b(op);
+    Location loc = op.getLoc();
+    Value input = op.getInput();
+    Value output = op.getOutput();
+    int64_t rank = op.getRank();
+    int64_t axisSize = inputType.getShape().back();
+    bool blocked = !ShapedType::isDynamic(axisSize) &&
+                   axisSize > sequentialThreshold && axisSize >= blockSize &&
+                   hasUnitInnerStride(inputType) &&
+                   hasUnitInnerStride(outputType);
+
+    // One loop per batch dimension; rows are independent.
+    Value zero = b.create<arith::ConstantIndexOp>(loc, 0);
+    Value one = b.create<arith::ConstantIndexOp>(loc, 1);
+    SmallVector<Value> batchIvs;
+    for (int64_t i = 0; i < rank - 1; i++) {
+      Value ub = b.create<memref::DimOp>(loc, input, i);
+      auto loop = b.create<scf::ForOp>(loc, zero, ub, one);
+      b.setInsertionPointToStart(loop.getBody());
+      batchIvs.push_back(loop.getInductionVar());
+    }
+
+    Value axisUb = b.create<memref::DimOp>(loc, input, rank - 1);
+    Value carry = b.create<arith::ConstantOp>(
+        loc, cast<TypedAttr>(b.getZeroAttr(inputType.getElementType())));
+    Value tailStart = zero;
+    if (blocked) {
+      std::tie(carry, tailStart) = createBlockedScan(
+          b, loc, input, output, batchIvs, axisUb, carry, blockSize);
+    }
+    createSequentialScan(b, loc, input, output, batchIvs, tailStart, axisUb,
+                         carry);
+
+    op->erase();
+    return success();
+  }
+};
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> triton::createTTXToLoopsPass() {
+  return std::make_unique<TTXToLoopsPass>();
+}
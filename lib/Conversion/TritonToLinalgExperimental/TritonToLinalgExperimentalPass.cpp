@@ -15,9 +15,11 @@
 #include "mlir/Dialect/Affine/IR/AffineOps.h"
 #include "mlir/Dialect/Bufferization/IR/Bufferization.h"
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Linalg/Transforms/Transforms.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
 
 #include "mlir/Pass/PassManager.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
 #include "mlir/Transforms/Passes.h"
 
 using namespace mlir;
@@ -28,10 +30,128 @@ using namespace triton;
 
 namespace {
 
+// Fuse an elementwise producer into its consumer unless that duplicates
+// work: either the consumer is its only user, or the producer only moves its
+// input around (the linalg.generic of a tt.broadcast, or of a transpose, see
+// generalizeFusableTransposes), which costs nothing to recompute in every
+// consumer it is fused into. Splats are linalg.fill ops, which the fusion
+// patterns fold into their consumers regardless.
+static bool shouldFuseElementwise(OpOperand *fusedOperand) {
+  Operation *producer = fusedOperand->get().getDefiningOp();
+  if (!producer) {
+    return false;
+  }
+  if (producer->hasOneUse()) {
+    return true;
+  }
+  auto generic = dyn_cast<linalg::GenericOp>(producer);
+  if (!generic || generic.getNumDpsInputs() != 1) {
+    return false;
+  }
+  Block *body = generic.getBody();
+  return body->getOperations().size() == 1 &&
+         body->getTerminator()->getOperand(0) == body->getArgument(0);
+}
+
+// A tile loaded from memory and then transposed is copied out of memory
+// through a memref.transpose view instead, so the transposed tile is written
+// once rather than loaded and then transposed into a second buffer. Only
+// plain loads qualify: a buffer written by a single memref.copy whose tensor
+// is only read by the transpose.
+static void foldTransposedLoads(ModuleOp moduleOp) {
+  SmallVector<linalg::TransposeOp> transposes;
+  moduleOp.walk([&](linalg::TransposeOp op) { transposes.push_back(op); });
+
+  IRRewriter rewriter(moduleOp.getContext());
+  for (auto op : transposes) {
+    if (!op.hasPureTensorSemantics()) {
+      continue;
+    }
+    auto toTensor = op.getInput().getDefiningOp<bufferization::ToTensorOp>();
+    if (!toTensor || !toTensor->hasOneUse()) {
+      continue;
+    }
+    auto alloc = toTensor.getMemref().getDefiningOp<memref::AllocOp>();
+    if (!alloc) {
+      continue;
+    }
+    memref::CopyOp copy;
+    bool onlyCopied = llvm::all_of(alloc->getUsers(), [&](Operation *user) {
+      if (user == toTensor) {
+        return true;
+      }
+      auto userCopy = dyn_cast<memref::CopyOp>(user);
+      if (!userCopy || userCopy.getTarget() != alloc || copy) {
+        return false;
+      }
+      copy = userCopy;
+      return true;
+    });
+    if (!onlyCopied || !copy) {
+      continue;
+    }
+    auto layout = cast<MemRefType>(copy.getSource().getType()).getLayout();
+    if (!layout.isIdentity() && !isa<StridedLayoutAttr>(layout)) {
+      continue;
+    }
+
+    auto transposedType = cast<RankedTensorType>(op->getResult(0).getType());
+    rewriter.setInsertionPoint(alloc);
+    Value transposedAlloc = rewriter.create<memref::AllocOp>(
+        alloc.getLoc(), MemRefType::get(transposedType.getShape(),
+                                        transposedType.getElementType()));
+
+    rewriter.setInsertionPoint(copy);
+    auto permutation = AffineMap::getPermutationMap(op.getPermutation(),
+                                                    rewriter.getContext());
+    Value view = rewriter.create<memref::TransposeOp>(
+        copy.getLoc(), copy.getSource(), AffineMapAttr::get(permutation));
+    rewriter.create<memref::CopyOp>(copy.getLoc(), view, transposedAlloc);
+
+    rewriter.setInsertionPoint(toTensor);
+    Value tensor = rewriter.create<bufferization::ToTensorOp>(
+        toTensor.getLoc(), transposedType, transposedAlloc, true /* restrict */,
+        true /* writable */);
+    rewriter.replaceOp(op, tensor);
+    rewriter.eraseOp(toTensor);
+    rewriter.eraseOp(copy);
+    rewriter.eraseOp(alloc);
+  }
+}
+
+// A linalg.transpose only read by elementwise linalg.generic ops becomes a
+// linalg.generic itself, so that the fusion folds the permutation into the
+// indexing maps of its consumers instead of materializing the transposed
+// tensor.
+static void generalizeFusableTransposes(ModuleOp moduleOp) {
+  SmallVector<linalg::TransposeOp> transposes;
+  moduleOp.walk([&](linalg::TransposeOp op) {
+    auto isElementwise = [](Operation *user) {
+      auto generic = dyn_cast<linalg::GenericOp>(user);
+      return generic && generic.getNumLoops() == generic.getNumParallelLoops();
+    };
+    if (op.hasPureTensorSemantics() && !op->use_empty() &&
+        llvm::all_of(op->getUsers(), isElementwise)) {
+      transposes.push_back(op);
+    }
+  });
+
+  IRRewriter rewriter(moduleOp.getContext());
+  for (auto op : transposes) {
+    rewriter.setInsertionPoint(op);
+    (void)linalg::generalizeNamedOp(rewriter, op);
+  }
+}
+
 class TritonToLinalgExperimentalPass
     : public TritonToLinalgExperimentalBase<TritonToLinalgExperimentalPass> {
 
 public:
+  TritonToLinalgExperimentalPass() = default;
+  TritonToLinalgExperimentalPass(bool enableElementwiseFusion) {
+    this->enableElementwiseFusion = enableElementwiseFusion;
+  }
+
   void getDependentDialects(DialectRegistry &registry) const override {
     registry
         .insert<func::FuncDialect, arith::ArithDialect, math::MathDialect,
@@ -57,7 +177,26 @@ public:
     pm.addPass(createCanonicalizerPass());
 
     if (failed(runPipeline(pm, getOperation()))) {
-      signalPassFailure();
+      return signalPassFailure();
+    }
+
+    // Every elementwise tt op became its own linalg.generic writing a fresh
+    // tensor; fusing producers into consumers turns a chain such as
+    // exp(x - max) / sum into one loop nest with a single output buffer.
+    // Broadcasts and transposes are kept as indexing maps of their consumers
+    // or as strided views; they are only materialized for consumers that
+    // are not elementwise, such as linalg.matmul or linalg.reduce.
+    if (enableElementwiseFusion) {
+      foldTransposedLoads(moduleOp);
+      generalizeFusableTransposes(moduleOp);
+
+      RewritePatternSet patterns(&getContext());
+      linalg::populateElementwiseOpsFusionPatterns(patterns,
+                                                   shouldFuseElementwise);
+      linalg::populateEraseUnusedOperandsAndResultsPatterns(patterns);
+      if (failed(applyPatternsAndFoldGreedily(moduleOp, std::move(patterns)))) {
+        signalPassFailure();
+      }
     }
   }
 };
@@ -67,3 +206,9 @@ std::unique_ptr<OperationPass<ModuleOp>>
 triton::createTritonToLinalgExperimentalPass() {
   return std::make_unique<TritonToLinalgExperimentalPass>();
 }
+
+std::unique_ptr<OperationPass<ModuleOp>>
+triton::createTritonToLinalgExperimentalPass(bool enableElementwiseFusion) {
+  return std::make_unique<TritonToLinalgExperimentalPass>(
+      enableElementwiseFusion);
+}
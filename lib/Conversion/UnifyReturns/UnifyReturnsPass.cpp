@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+//
+//===----------------------------------------------------------------------===//
+//
+// Kernels with early returns have one func.return per return statement. This
+// pass merges them into a single exit block so that the passes that expect a
+// unique return op, such as eliminate-empty-tensors, can run on them.
+//
+//===----------------------------------------------------------------------===//
+
+#include "triton-shared/Conversion/UnifyReturns/UnifyReturns.h"
+
+#include "mlir/Dialect/ControlFlow/IR/ControlFlowOps.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+
+#include "llvm/Support/Debug.h"
+
+#define DEBUG_TYPE "unify-returns"
+
+using namespace mlir;
+using namespace triton;
+
+namespace mlir {
+namespace triton {
+#define GEN_PASS_DEF_UNIFYRETURNS
+#include "triton-shared/Conversion/UnifyReturns/Passes.h.inc"
+} // namespace triton
+} // namespace mlir
+
+namespace {
+
+class UnifyReturnsPass
+    : public triton::impl::UnifyReturnsBase<UnifyReturnsPass> {
+  using UnifyReturnsBase<UnifyReturnsPass>::UnifyReturnsBase;
+
+public:
+  void runOnOperation() override {
+    auto moduleOp = getOperation();
+    moduleOp.walk([&](func::FuncOp func) {
+      if (!func.isExternal()) {
+        unifyReturns(func);
+      }
+    });
+  }
+
+private:
+  void unifyReturns(func::FuncOp func) {
+    SmallVector<func::ReturnOp> returns;
+    for (Block &block : func.getBody()) {
+      if (block.empty()) {
+        continue;
+      }
+      if (auto returnOp = dyn_cast<func::ReturnOp>(block.back())) {
+        returns.push_back(returnOp);
+      }
+    }
+    if (returns.size() < 2) {
+      return;
+    }
+
+    LLVM_DEBUG(llvm::dbgs() << "merging " << returns.size()
+                            << " returns of " << func.getName() << "\n");
+
+    // The exit block takes the returned values as arguments.
+    Region &body = func.getBody();
+    auto resultTypes = func.getResultTypes();
+    SmallVector<Location> locs(resultTypes.size(), func.getLoc());
+    OpBuilder builder(func.getContext());
+    Block *exit = builder.createBlock(&body, body.end(), resultTypes, locs);
+    builder.create<func::ReturnOp>(func.getLoc(), exit->getArguments());
+
+    for (auto returnOp : returns) {
+      builder.setInsertionPoint(returnOp);
+      builder.create<cf::BranchOp>(returnOp.getLoc(), exit,
+                                   returnOp.getOperands());
+      returnOp.erase();
+    }
+  }
+};
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> triton::createUnifyReturnsPass() {
+  return std::make_unique<UnifyReturnsPass>();
+}
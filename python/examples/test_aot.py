@@ -0,0 +1,59 @@
+import subprocess
+
+import torch
+
+import triton
+import triton.language as tl
+
+from triton.backends.triton_shared import aot, driver, profiler
+from triton.backends.triton_shared.compiler import compile_many
+
+
+@triton.jit
+def scale_kernel(x_ptr, output_ptr, n_elements, scale, BLOCK_SIZE: tl.constexpr):
+    pid = tl.program_id(axis=0)
+    offsets = pid * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_elements
+    x = tl.load(x_ptr + offsets, mask=mask)
+    tl.store(output_ptr + offsets, x * scale, mask=mask)
+
+
+def _srcs(block_sizes):
+    return [
+        triton.compiler.ASTSource(
+            fn=scale_kernel,
+            signature="*fp32,*fp32,i32,fp32",
+            constants={"BLOCK_SIZE": block_size},
+        ) for block_size in block_sizes
+    ]
+
+
+def test_bundle(device, tmp_path, monkeypatch):
+    # Two specializations of the same kernel share its name in the bundle.
+    block_sizes = [64, 256]
+    path = str(tmp_path / "kernels.so")
+    aot.build_bundle(compile_many(_srcs(block_sizes)), path)
+
+    # Start over like a new process: an empty triton cache and no launcher.
+    monkeypatch.setenv("TRITON_CACHE_DIR", str(tmp_path / "cache"))
+    monkeypatch.setattr(driver, "_loaded_launchers", {})
+    assert aot.load_bundle(path) == ["scale_kernel"] * len(block_sizes)
+
+    def check_call(*args, **kwargs):
+        raise AssertionError(f"bundled kernels should not be built: {args}")
+
+    monkeypatch.setattr(subprocess, "check_call", check_call)
+    profiler.reset_compile_profiles()
+    profiler.enable_compile_profiling()
+    try:
+        size = 1000
+        x = torch.rand(size, device=device)
+        for block_size, src in zip(block_sizes, _srcs(block_sizes)):
+            kernel = triton.compile(src)
+            output = torch.empty_like(x)
+            kernel[(triton.cdiv(size, block_size), 1, 1)](x, output, size, 3.0)
+            torch.testing.assert_close(output, x * 3.0)
+        # Every stage was served from the cache filled by the bundle.
+        assert not profiler.get_compile_profiles()
+    finally:
+        profiler.disable_compile_profiling()
@@ -0,0 +1,27 @@
+import pytest
+import torch
+
+import triton
+import triton.language as tl
+
+
+@triton.jit
+def argmax_kernel(x_ptr, max_ptr, min_ptr, BLOCK_SIZE: tl.constexpr):
+    row = tl.program_id(0)
+    x = tl.load(x_ptr + row * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE))
+    tl.store(max_ptr + row, tl.argmax(x, axis=0))
+    tl.store(min_ptr + row, tl.argmin(x, axis=0))
+
+
+@pytest.mark.parametrize("n", [16, 256, 4096])
+def test_argmax_argmin(n, device):
+    torch.manual_seed(0)
+    n_rows = 4
+    # Few distinct values so that the extremes appear several times and the
+    # lowest-index tie-break is exercised across lanes.
+    x = torch.randint(0, 8, (n_rows, n), device=device).to(torch.float32)
+    max_idx = torch.empty(n_rows, dtype=torch.int32, device=device)
+    min_idx = torch.empty(n_rows, dtype=torch.int32, device=device)
+    argmax_kernel[(n_rows, )](x, max_idx, min_idx, BLOCK_SIZE=n)
+    torch.testing.assert_close(max_idx, torch.argmax(x, dim=1).to(torch.int32))
+    torch.testing.assert_close(min_idx, torch.argmin(x, dim=1).to(torch.int32))
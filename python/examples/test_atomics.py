@@ -0,0 +1,88 @@
+import pytest
+import torch
+
+import triton
+import triton.language as tl
+
+
+@triton.jit
+def histogram_kernel(x_ptr, bins_ptr, n_elements, BLOCK_SIZE: tl.constexpr):
+    pid = tl.program_id(axis=0)
+    offsets = pid * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_elements
+    x = tl.load(x_ptr + offsets, mask=mask)
+    tl.atomic_add(bins_ptr + x, 1, mask=mask)
+
+
+@triton.jit
+def split_sum_kernel(x_ptr, out_ptr, n_cols, BLOCK_SIZE: tl.constexpr):
+    # Every program adds its partial column sums of one block of rows to the
+    # same output row, like the reduction of a split-K matmul.
+    row = tl.program_id(axis=0)
+    cols = tl.arange(0, BLOCK_SIZE)
+    mask = cols < n_cols
+    x = tl.load(x_ptr + row * n_cols + cols, mask=mask)
+    tl.atomic_add(out_ptr + cols, x, mask=mask)
+
+
+@triton.jit
+def max_and_count_kernel(x_ptr, max_ptr, count_ptr, old_ptr, BLOCK_SIZE: tl.constexpr):
+    pid = tl.program_id(axis=0)
+    offsets = tl.arange(0, BLOCK_SIZE)
+    x = tl.load(x_ptr + pid * BLOCK_SIZE + offsets)
+    tl.atomic_max(max_ptr + offsets, x)
+    # Scalar atomic: the old values hand out distinct slots.
+    slot = tl.atomic_add(count_ptr, 1)
+    tl.store(old_ptr + pid, slot)
+
+
+@triton.jit
+def cas_kernel(flags_ptr, winners_ptr, BLOCK_SIZE: tl.constexpr):
+    # The first program to reach each flag claims it.
+    pid = tl.program_id(axis=0)
+    offsets = tl.arange(0, BLOCK_SIZE)
+    zeros = tl.zeros((BLOCK_SIZE, ), dtype=tl.int32)
+    old = tl.atomic_cas(flags_ptr + offsets, zeros, zeros + pid + 1)
+    tl.atomic_add(winners_ptr + offsets, tl.where(old == 0, 1, 0))
+
+
+@pytest.mark.parametrize("num_threads", [1, 0])
+def test_histogram(num_threads, device):
+    n = 10000
+    num_bins = 37
+    x = torch.randint(0, num_bins, (n, ), dtype=torch.int32, device=device)
+    bins = torch.zeros(num_bins, dtype=torch.int32, device=device)
+    grid = lambda meta: (triton.cdiv(n, meta["BLOCK_SIZE"]), )
+    histogram_kernel[grid](x, bins, n, BLOCK_SIZE=128, num_threads=num_threads)
+    torch.testing.assert_close(bins, torch.bincount(x, minlength=num_bins).to(torch.int32))
+
+
+@pytest.mark.parametrize("num_threads", [1, 0])
+def test_split_sum(num_threads, device):
+    n_rows, n_cols = 256, 100
+    # Integer values keep the float sums exact in any order.
+    x = torch.randint(-8, 8, (n_rows, n_cols), device=device).to(torch.float32)
+    out = torch.zeros(n_cols, device=device)
+    split_sum_kernel[(n_rows, )](x, out, n_cols, BLOCK_SIZE=128, num_threads=num_threads)
+    torch.testing.assert_close(out, x.sum(dim=0))
+
+
+def test_max_and_scalar_counter(device):
+    num_programs, block = 64, 32
+    x = torch.randint(-1000, 1000, (num_programs, block), dtype=torch.int32, device=device)
+    maxes = torch.full((block, ), -(2**31), dtype=torch.int32, device=device)
+    count = torch.zeros(1, dtype=torch.int32, device=device)
+    old = torch.empty(num_programs, dtype=torch.int32, device=device)
+    max_and_count_kernel[(num_programs, )](x, maxes, count, old, BLOCK_SIZE=block, num_threads=0)
+    torch.testing.assert_close(maxes, x.max(dim=0).values)
+    assert count.item() == num_programs
+    assert sorted(old.tolist()) == list(range(num_programs))
+
+
+def test_cas(device):
+    block = 16
+    flags = torch.zeros(block, dtype=torch.int32, device=device)
+    winners = torch.zeros(block, dtype=torch.int32, device=device)
+    cas_kernel[(50, )](flags, winners, BLOCK_SIZE=block, num_threads=0)
+    assert torch.all(winners == 1)
+    assert torch.all((flags >= 1) & (flags <= 50))
@@ -0,0 +1,37 @@
+import torch
+
+import triton
+import triton.language as tl
+
+from triton.backends.triton_shared.compiler import compile_many
+
+
+@triton.jit
+def add_kernel(x_ptr, y_ptr, output_ptr, n_elements, BLOCK_SIZE: tl.constexpr):
+    pid = tl.program_id(axis=0)
+    offsets = pid * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_elements
+    x = tl.load(x_ptr + offsets, mask=mask)
+    y = tl.load(y_ptr + offsets, mask=mask)
+    tl.store(output_ptr + offsets, x + y, mask=mask)
+
+
+def test_compile_many(device):
+    block_sizes = [64, 128, 256, 512, 1024]
+    srcs = [
+        triton.compiler.ASTSource(
+            fn=add_kernel,
+            signature="*fp32,*fp32,*fp32,i32",
+            constants={"BLOCK_SIZE": block_size},
+        ) for block_size in block_sizes
+    ]
+    kernels = compile_many(srcs, options=[{"num_threads": n} for n in range(len(srcs))], max_workers=4)
+    assert len(kernels) == len(srcs)
+
+    size = 10007
+    x = torch.rand(size, device=device)
+    y = torch.rand(size, device=device)
+    for block_size, kernel in zip(block_sizes, kernels):
+        output = torch.empty_like(x)
+        kernel[(triton.cdiv(size, block_size), 1, 1)](x, y, output, size)
+        torch.testing.assert_close(output, x + y)
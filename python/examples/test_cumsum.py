@@ -0,0 +1,32 @@
+import pytest
+import torch
+
+import triton
+import triton.language as tl
+
+
+@triton.jit
+def cumsum_kernel(input_ptr, output_ptr, n_cols, BLOCK_SIZE: tl.constexpr):
+    row = tl.program_id(axis=0)
+    offsets = row * n_cols + tl.arange(0, BLOCK_SIZE)
+    data = tl.load(input_ptr + offsets)
+    tl.store(output_ptr + offsets, tl.cumsum(data, axis=0))
+
+
+@pytest.mark.parametrize("n_cols", [32, 64, 4096, 8192])
+@pytest.mark.parametrize("dtype", [torch.float32, torch.int32])
+def test_cumsum(n_cols, dtype, device):
+    torch.manual_seed(0)
+    n_rows = 4
+    if dtype.is_floating_point:
+        x = torch.rand(n_rows, n_cols, dtype=dtype, device=device)
+    else:
+        x = torch.randint(-100, 100, (n_rows, n_cols), dtype=dtype, device=device)
+    output = torch.empty_like(x)
+    cumsum_kernel[(n_rows, )](x, output, n_cols, BLOCK_SIZE=n_cols)
+    expected = torch.cumsum(x, dim=1).to(dtype)
+    if dtype.is_floating_point:
+        # The blocked scan reassociates the additions.
+        torch.testing.assert_close(output, expected, rtol=1e-4, atol=1e-3)
+    else:
+        torch.testing.assert_close(output, expected)
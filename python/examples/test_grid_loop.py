@@ -0,0 +1,68 @@
+import pytest
+import torch
+
+import triton
+import triton.language as tl
+
+
+@triton.jit
+def program_id_kernel(out_ptr):
+    pid_x = tl.program_id(axis=0)
+    pid_y = tl.program_id(axis=1)
+    pid_z = tl.program_id(axis=2)
+    num_y = tl.num_programs(axis=1)
+    num_z = tl.num_programs(axis=2)
+    linear = (pid_x * num_y + pid_y) * num_z + pid_z
+    tl.store(out_ptr + linear, linear + 1)
+
+
+@pytest.mark.parametrize("num_threads", [1, 3])
+@pytest.mark.parametrize("launch_schedule", ["static", "chunked", "work_stealing"])
+def test_grid_loop_program_ids(num_threads, launch_schedule, device):
+    grid = (7, 5, 3)
+    n = grid[0] * grid[1] * grid[2]
+    output = torch.zeros(n, dtype=torch.int32, device=device)
+    program_id_kernel[grid](output, num_threads=num_threads, launch_schedule=launch_schedule, grid_loop=True)
+    expected = torch.arange(1, n + 1, dtype=torch.int32, device=device)
+    torch.testing.assert_close(output, expected)
+
+
+@triton.jit
+def scale_rows_kernel(x_ptr, out_ptr, stride, BLOCK_SIZE: tl.constexpr):
+    # The scale tensor does not depend on the program id and is computed once
+    # per range of programs.
+    scale = tl.arange(0, BLOCK_SIZE).to(tl.float32) + 1.0
+    row = tl.program_id(0)
+    offsets = tl.arange(0, BLOCK_SIZE)
+    x = tl.load(x_ptr + row * stride + offsets)
+    tl.store(out_ptr + row * stride + offsets, x * scale)
+
+
+@pytest.mark.parametrize("num_threads", [1, 4])
+def test_grid_loop_hoisted_constant(num_threads, device):
+    torch.manual_seed(0)
+    rows, cols = 257, 64
+    x = torch.rand((rows, cols), device=device)
+    output = torch.empty_like(x)
+    scale_rows_kernel[(rows, )](x, output, x.stride(0), BLOCK_SIZE=cols, num_threads=num_threads, grid_loop=True)
+    expected = x * (torch.arange(cols, device=device, dtype=torch.float32) + 1.0)
+    torch.testing.assert_close(output, expected)
+
+
+@triton.jit
+def early_return_kernel(in_ptr, out_ptr):
+    pid = tl.program_id(0)
+    value = tl.load(in_ptr + pid)
+    if value == -1:
+        return
+    tl.store(out_ptr + pid, value * 2)
+
+
+def test_grid_loop_early_return(device):
+    n = 16
+    input = torch.arange(n, dtype=torch.int32, device=device)
+    input[::3] = -1
+    output = torch.zeros(n, dtype=torch.int32, device=device)
+    early_return_kernel[(n, )](input, output, grid_loop=True)
+    expected = torch.where(input == -1, 0, input * 2).to(torch.int32)
+    torch.testing.assert_close(output, expected)
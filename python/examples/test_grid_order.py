@@ -0,0 +1,113 @@
+import pytest
+import torch
+
+import triton
+import triton.language as tl
+
+_GRID_ORDERS = ["row_major", "grouped", "morton", "hilbert"]
+
+
+@triton.jit
+def visit_order_kernel(counter_ptr, out_ptr):
+    pid_x = tl.program_id(axis=0)
+    pid_y = tl.program_id(axis=1)
+    pid_z = tl.program_id(axis=2)
+    num_y = tl.num_programs(axis=1)
+    num_z = tl.num_programs(axis=2)
+    linear = (pid_x * num_y + pid_y) * num_z + pid_z
+    # Position of the program in the launch, when the programs run serially.
+    position = tl.atomic_add(counter_ptr, 1)
+    tl.store(out_ptr + linear, position + 1)
+
+
+def _visit_positions(grid, device, **options):
+    n = grid[0] * grid[1] * grid[2]
+    counter = torch.zeros(1, dtype=torch.int32, device=device)
+    output = torch.zeros(n, dtype=torch.int32, device=device)
+    visit_order_kernel[grid](counter, output, **options)
+    return output.reshape(grid) - 1
+
+
+@pytest.mark.parametrize("grid_order", _GRID_ORDERS)
+@pytest.mark.parametrize("num_threads", [1, 3])
+@pytest.mark.parametrize("grid", [(7, 5, 3), (1, 9, 1), (13, 6, 1)])
+def test_grid_order_visits_every_program(grid_order, num_threads, grid, device):
+    positions = _visit_positions(grid, device, num_threads=num_threads, grid_order=grid_order)
+    n = grid[0] * grid[1] * grid[2]
+    assert sorted(positions.flatten().tolist()) == list(range(n))
+
+
+def test_grid_order_grouped(device):
+    grid = (5, 3, 1)
+    positions = _visit_positions(grid, device, grid_order="grouped", grid_group_size=2)
+    # Bands of 2 rows along x, x varying fastest; the last band has one row.
+    expected = torch.tensor([[0, 2, 4], [1, 3, 5], [6, 8, 10], [7, 9, 11], [12, 13, 14]], dtype=torch.int32)
+    torch.testing.assert_close(positions[:, :, 0].cpu(), expected)
+
+
+@pytest.mark.parametrize("grid_order", ["morton", "hilbert"])
+def test_grid_order_curves(grid_order, device):
+    grid = (8, 8, 1)
+    positions = _visit_positions(grid, device, grid_order=grid_order)[:, :, 0].cpu()
+    coords = sorted((positions[x, y].item(), x, y) for x in range(grid[0]) for y in range(grid[1]))
+    steps = [abs(x1 - x0) + abs(y1 - y0) for (_, x0, y0), (_, x1, y1) in zip(coords, coords[1:])]
+    if grid_order == "hilbert":
+        # Consecutive programs of a Hilbert curve are neighbours.
+        assert all(step == 1 for step in steps)
+    # Each quadrant of a square grid is visited before the next one.
+    quadrants = [(x >= 4) * 2 + (y >= 4) for _, x, y in coords]
+    assert all(q == quadrants[i * 16] for i in range(4) for q in quadrants[i * 16:(i + 1) * 16])
+
+
+@pytest.mark.parametrize("grid_order", ["morton", "hilbert"])
+@pytest.mark.parametrize("grid", [(4096, 2, 1), (4, 65536, 1)])
+def test_grid_order_curves_skewed(grid_order, grid, device):
+    # The curves cover the power of 2 square around the grid, 2^32 points for
+    # the second grid; only its 2^18 programs should be enumerated.
+    positions = _visit_positions(grid, device, grid_order=grid_order)
+    n = grid[0] * grid[1] * grid[2]
+    assert sorted(positions.flatten().tolist()) == list(range(n))
+
+
+@triton.jit
+def matmul_kernel_2d(a_ptr, b_ptr, c_ptr, M, N, K, stride_am, stride_ak, stride_bk, stride_bn, stride_cm, stride_cn,
+                     BLOCK_SIZE_M: tl.constexpr, BLOCK_SIZE_N: tl.constexpr, BLOCK_SIZE_K: tl.constexpr):
+    # One program per tile of C, the tiles of a row of C along axis 1; the
+    # launcher decides the order in which the tiles are computed.
+    pid_m = tl.program_id(axis=0)
+    pid_n = tl.program_id(axis=1)
+    offs_am = (pid_m * BLOCK_SIZE_M + tl.arange(0, BLOCK_SIZE_M)) % M
+    offs_bn = (pid_n * BLOCK_SIZE_N + tl.arange(0, BLOCK_SIZE_N)) % N
+    offs_k = tl.arange(0, BLOCK_SIZE_K)
+    a_ptrs = a_ptr + (offs_am[:, None] * stride_am + offs_k[None, :] * stride_ak)
+    b_ptrs = b_ptr + (offs_k[:, None] * stride_bk + offs_bn[None, :] * stride_bn)
+    accumulator = tl.zeros((BLOCK_SIZE_M, BLOCK_SIZE_N), dtype=tl.float32)
+    for k in range(0, tl.cdiv(K, BLOCK_SIZE_K)):
+        a = tl.load(a_ptrs, mask=offs_k[None, :] < K - k * BLOCK_SIZE_K, other=0.0)
+        b = tl.load(b_ptrs, mask=offs_k[:, None] < K - k * BLOCK_SIZE_K, other=0.0)
+        accumulator += tl.dot(a, b)
+        a_ptrs += BLOCK_SIZE_K * stride_ak
+        b_ptrs += BLOCK_SIZE_K * stride_bk
+    c = accumulator.to(c_ptr.dtype.element_ty)
+    offs_cm = pid_m * BLOCK_SIZE_M + tl.arange(0, BLOCK_SIZE_M)
+    offs_cn = pid_n * BLOCK_SIZE_N + tl.arange(0, BLOCK_SIZE_N)
+    c_ptrs = c_ptr + stride_cm * offs_cm[:, None] + stride_cn * offs_cn[None, :]
+    c_mask = (offs_cm[:, None] < M) & (offs_cn[None, :] < N)
+    tl.store(c_ptrs, c, mask=c_mask)
+
+
+def matmul_2d(a, b, c, **options):
+    (M, K), (_, N) = a.shape, b.shape
+    grid = (triton.cdiv(M, 32), triton.cdiv(N, 32))
+    matmul_kernel_2d[grid](a, b, c, M, N, K, a.stride(0), a.stride(1), b.stride(0), b.stride(1), c.stride(0),
+                           c.stride(1), BLOCK_SIZE_M=32, BLOCK_SIZE_N=32, BLOCK_SIZE_K=16, **options)
+
+
+@pytest.mark.parametrize("grid_order", _GRID_ORDERS)
+def test_grid_order_matmul(grid_order, device):
+    torch.manual_seed(0)
+    a = torch.randn((160, 64), device=device)
+    b = torch.randn((64, 96), device=device)
+    c = torch.empty((160, 96), device=device)
+    matmul_2d(a, b, c, num_threads=4, grid_order=grid_order, grid_group_size=2)
+    torch.testing.assert_close(c, a @ b, atol=1e-4, rtol=1e-4)
@@ -0,0 +1,53 @@
+import pytest
+import torch
+
+import triton
+import triton.language as tl
+
+
+@triton.jit
+def dot_kernel(a_ptr, b_ptr, c_ptr, M: tl.constexpr, N: tl.constexpr, K: tl.constexpr):
+    offs_m = tl.arange(0, M)
+    offs_n = tl.arange(0, N)
+    offs_k = tl.arange(0, K)
+    a = tl.load(a_ptr + offs_m[:, None] * K + offs_k[None, :])
+    b = tl.load(b_ptr + offs_k[:, None] * N + offs_n[None, :])
+    c = tl.dot(a, b)
+    tl.store(c_ptr + offs_m[:, None] * N + offs_n[None, :], c)
+
+
+@pytest.mark.parametrize("dtype", [torch.float16, torch.bfloat16])
+def test_half_dot(dtype, device):
+    torch.manual_seed(0)
+    M, N, K = 32, 32, 64
+    a = torch.randn((M, K), device=device, dtype=dtype)
+    b = torch.randn((K, N), device=device, dtype=dtype)
+    c = torch.empty((M, N), device=device, dtype=torch.float32)
+    dot_kernel[(1, )](a, b, c, M, N, K)
+    # The inputs are widened exactly, only the f32 accumulation order differs.
+    expected = torch.matmul(a.float(), b.float())
+    torch.testing.assert_close(c, expected, rtol=1e-4, atol=1e-4)
+
+
+@triton.jit
+def scale_kernel(x_ptr, y_ptr, n_elements, BLOCK_SIZE: tl.constexpr):
+    pid = tl.program_id(axis=0)
+    offsets = pid * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_elements
+    x = tl.load(x_ptr + offsets, mask=mask)
+    y = x.to(tl.float32) * 3.0 + 1.0
+    tl.store(y_ptr + offsets, y.to(y_ptr.dtype.element_ty), mask=mask)
+
+
+@pytest.mark.parametrize("dtype", [torch.float16, torch.bfloat16])
+@pytest.mark.parametrize("vectorize", [False, True])
+def test_half_conversions(dtype, vectorize, device):
+    torch.manual_seed(0)
+    size = 1000
+    x = torch.randn(size, device=device, dtype=dtype)
+    y = torch.empty_like(x)
+    grid = lambda meta: (triton.cdiv(size, meta["BLOCK_SIZE"]), )
+    scale_kernel[grid](x, y, size, BLOCK_SIZE=256, vectorize=vectorize)
+    # Conversions round to nearest even, like torch.
+    expected = (x.float() * 3.0 + 1.0).to(dtype)
+    torch.testing.assert_close(y, expected, rtol=0, atol=0)
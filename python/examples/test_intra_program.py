@@ -0,0 +1,49 @@
+import pytest
+import torch
+
+import triton
+import triton.language as tl
+
+
+@triton.jit
+def row_sum_kernel(x_ptr, output_ptr, BLOCK_M: tl.constexpr, BLOCK_N: tl.constexpr):
+    pid = tl.program_id(axis=0)
+    rows = pid * BLOCK_M + tl.arange(0, BLOCK_M)
+    cols = tl.arange(0, BLOCK_N)
+    x = tl.load(x_ptr + rows[:, None] * BLOCK_N + cols[None, :])
+    tl.store(output_ptr + rows, tl.sum(x * 2, axis=1))
+
+
+# One program with 4 threads runs its reduction on all of them, 8 programs
+# with 4 threads one program per thread.
+@pytest.mark.parametrize("num_programs", [1, 8])
+@pytest.mark.parametrize("num_threads", [4, 0])
+def test_intra_program_reduction(num_programs, num_threads, device):
+    BLOCK_M, BLOCK_N = 512, 256
+    torch.manual_seed(0)
+    x = torch.rand(num_programs * BLOCK_M, BLOCK_N, device=device)
+    output = torch.empty(num_programs * BLOCK_M, device=device)
+    row_sum_kernel[(num_programs, )](x, output, BLOCK_M=BLOCK_M, BLOCK_N=BLOCK_N, num_threads=num_threads,
+                                     intra_program_parallelism=True)
+    torch.testing.assert_close(output, (x * 2).sum(axis=1))
+
+
+@triton.jit
+def matmul_kernel(a_ptr, b_ptr, c_ptr, M: tl.constexpr, N: tl.constexpr, K: tl.constexpr):
+    rm = tl.arange(0, M)
+    rn = tl.arange(0, N)
+    rk = tl.arange(0, K)
+    a = tl.load(a_ptr + rm[:, None] * K + rk[None, :])
+    b = tl.load(b_ptr + rk[:, None] * N + rn[None, :])
+    tl.store(c_ptr + rm[:, None] * N + rn[None, :], tl.dot(a, b))
+
+
+def test_intra_program_matmul(device):
+    # A single program computing a 16x512x256 matmul.
+    M, N, K = 16, 512, 256
+    torch.manual_seed(0)
+    a = torch.rand(M, K, device=device)
+    b = torch.rand(K, N, device=device)
+    c = torch.empty(M, N, device=device)
+    matmul_kernel[(1, )](a, b, c, M=M, N=N, K=K, num_threads=4, intra_program_parallelism=True)
+    torch.testing.assert_close(c, a @ b, atol=1e-3, rtol=1e-3)
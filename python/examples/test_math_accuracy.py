@@ -0,0 +1,34 @@
+import pytest
+import torch
+
+import triton
+import triton.language as tl
+
+
+@triton.jit
+def math_kernel(x_ptr, exp_ptr, log_ptr, erf_ptr, sin_ptr, n_elements, BLOCK_SIZE: tl.constexpr):
+    pid = tl.program_id(axis=0)
+    offsets = pid * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_elements
+    x = tl.load(x_ptr + offsets, mask=mask)
+    tl.store(exp_ptr + offsets, tl.exp(x), mask=mask)
+    tl.store(log_ptr + offsets, tl.log(x), mask=mask)
+    tl.store(erf_ptr + offsets, tl.math.erf(x), mask=mask)
+    tl.store(sin_ptr + offsets, tl.sin(x), mask=mask)
+
+
+@pytest.mark.parametrize("math_accuracy", ["libm", "high", "low"])
+def test_math_accuracy(math_accuracy, device):
+    torch.manual_seed(0)
+    size = 4096
+    x = torch.rand(size, device=device) * 8 + 1e-3
+    outputs = [torch.empty_like(x) for _ in range(4)]
+    grid = lambda meta: (triton.cdiv(size, meta["BLOCK_SIZE"]), )
+    math_kernel[grid](x, *outputs, size, BLOCK_SIZE=1024, vectorize=True, math_accuracy=math_accuracy)
+    # The "low" approximations of erf and sin are compared with a looser
+    # tolerance.
+    rtol = 1e-3 if math_accuracy == "low" else 1e-5
+    expected = [torch.exp(x), torch.log(x), torch.erf(x), torch.sin(x)]
+    for i, (output, reference) in enumerate(zip(outputs, expected)):
+        tol = rtol if i >= 2 else 1e-5
+        torch.testing.assert_close(output, reference, rtol=tol, atol=tol)
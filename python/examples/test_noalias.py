@@ -0,0 +1,60 @@
+import pytest
+import torch
+
+import triton
+import triton.language as tl
+
+
+@triton.jit
+def add_kernel(x_ptr, y_ptr, output_ptr, n_elements, BLOCK_SIZE: tl.constexpr):
+    pid = tl.program_id(axis=0)
+    offsets = pid * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_elements
+    x = tl.load(x_ptr + offsets, mask=mask)
+    y = tl.load(y_ptr + offsets, mask=mask)
+    tl.store(output_ptr + offsets, x + y, mask=mask)
+
+
+@triton.jit
+def shift_kernel(x_ptr, output_ptr, n_elements, BLOCK_SIZE: tl.constexpr):
+    offsets = tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_elements
+    x = tl.load(x_ptr + offsets, mask=mask)
+    tl.store(output_ptr + offsets, x * 2, mask=mask)
+
+
+def test_noalias_disjoint(device):
+    torch.manual_seed(0)
+    size = 98432
+    x = torch.rand(size, device=device)
+    y = torch.rand(size, device=device)
+    output = torch.empty_like(x)
+    grid = lambda meta: (triton.cdiv(size, meta["BLOCK_SIZE"]), )
+    kernel = add_kernel[grid](x, y, output, size, BLOCK_SIZE=1024, noalias=True)
+    assert kernel.metadata.noalias_variant
+    torch.testing.assert_close(output, x + y)
+
+
+def test_noalias_in_place(device):
+    # The output is one of the inputs, the launcher must pick the conservative
+    # kernel.
+    torch.manual_seed(0)
+    size = 98432
+    x = torch.rand(size, device=device)
+    y = torch.rand(size, device=device)
+    expected = x + y
+    grid = lambda meta: (triton.cdiv(size, meta["BLOCK_SIZE"]), )
+    add_kernel[grid](x, y, x, size, BLOCK_SIZE=1024, noalias=True)
+    torch.testing.assert_close(x, expected)
+
+
+@pytest.mark.parametrize("shift", [0, 1, 7])
+def test_noalias_overlapping_views(shift, device):
+    # Views of the same storage overlap even if their data pointers differ.
+    torch.manual_seed(0)
+    size = 256
+    buffer = torch.rand(size + shift, device=device)
+    x = buffer[shift:]
+    expected = x * 2
+    shift_kernel[(1, )](x, buffer[:size], size, BLOCK_SIZE=256, noalias=True)
+    torch.testing.assert_close(buffer[:size], expected)
@@ -0,0 +1,58 @@
+import pytest
+import torch
+
+import triton
+import triton.language as tl
+
+
+@triton.jit
+def scale_kernel(x_ptr, out_ptr, n_elements, BLOCK_SIZE: tl.constexpr):
+    offsets = tl.program_id(axis=0) * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_elements
+    x = tl.load(x_ptr + offsets, mask=mask)
+    tl.store(out_ptr + offsets, x * 2.0, mask=mask)
+
+
+@triton.jit
+def scale_full_kernel(x_ptr, out_ptr, BLOCK_SIZE: tl.constexpr):
+    offsets = tl.program_id(axis=0) * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    x = tl.load(x_ptr + offsets)
+    tl.store(out_ptr + offsets, x * 2.0)
+
+
+@triton.jit
+def scale_inplace_kernel(x_ptr, BLOCK_SIZE: tl.constexpr):
+    offsets = tl.program_id(axis=0) * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    x = tl.load(x_ptr + offsets)
+    tl.store(x_ptr + offsets, x * 2.0)
+
+
+def test_nontemporal_stores(device):
+    x = torch.randn(4096, device=device)
+    out = torch.empty_like(x)
+    ret = scale_full_kernel[(16, )](x, out, BLOCK_SIZE=256, vectorize=True, nontemporal_stores=True)
+    torch.testing.assert_close(out, x * 2.0)
+    # The output is only written to, its stores are streamed.
+    assert "!nontemporal" in ret.asm["llir"]
+
+
+@pytest.mark.parametrize("n_elements", [4096, 1000, 7])
+@pytest.mark.parametrize("num_threads", [1, 4])
+def test_nontemporal_stores_masked(n_elements, num_threads, device):
+    x = torch.randn(n_elements, device=device)
+    out = torch.zeros(n_elements + 64, device=device)
+    grid = (triton.cdiv(n_elements, 256), )
+    scale_kernel[grid](x, out, n_elements, BLOCK_SIZE=256, vectorize=True, nontemporal_stores=True,
+                       num_threads=num_threads)
+    torch.testing.assert_close(out[:n_elements], x * 2.0)
+    # The elements past the mask are left alone.
+    assert torch.all(out[n_elements:] == 0)
+
+
+def test_nontemporal_stores_read_output(device):
+    x = torch.randn(1024, device=device)
+    expected = x * 2.0
+    ret = scale_inplace_kernel[(4, )](x, BLOCK_SIZE=256, vectorize=True, nontemporal_stores=True)
+    torch.testing.assert_close(x, expected)
+    # The kernel reads the buffer it writes to, whose stores are left alone.
+    assert "!nontemporal" not in ret.asm["llir"]
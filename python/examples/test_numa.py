@@ -0,0 +1,66 @@
+import mmap
+import os
+
+import pytest
+import torch
+
+import triton
+import triton.language as tl
+
+from triton.backends.triton_shared import numa
+
+
+@triton.jit
+def add_kernel(x_ptr, y_ptr, output_ptr, n_elements, BLOCK_SIZE: tl.constexpr):
+    pid = tl.program_id(axis=0)
+    offsets = pid * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_elements
+    x = tl.load(x_ptr + offsets, mask=mask)
+    y = tl.load(y_ptr + offsets, mask=mask)
+    tl.store(output_ptr + offsets, x + y, mask=mask)
+
+
+def test_topology():
+    nodes = numa.topology()
+    cpus = [cpu for node in nodes for cpu in node]
+    assert all(nodes)
+    assert len(set(cpus)) == len(cpus)
+    assert set(cpus) == os.sched_getaffinity(0)
+
+
+@pytest.mark.parametrize("thread_affinity", ["numa", "cores"])
+@pytest.mark.parametrize("launch_schedule", ["static", "chunked", "work_stealing"])
+def test_thread_affinity(thread_affinity, launch_schedule, device):
+    size = 100003
+    block_size = 256
+    x = torch.rand(size, device=device)
+    y = torch.rand(size, device=device)
+    num_programs = triton.cdiv(size, block_size)
+    output = numa.empty(size, device=device, num_threads=4, thread_affinity=thread_affinity,
+                        num_programs=num_programs)
+    affinity = os.sched_getaffinity(0)
+    add_kernel[(num_programs, )](x, y, output, size, BLOCK_SIZE=block_size, num_threads=4,
+                                 launch_schedule=launch_schedule, thread_affinity=thread_affinity)
+    torch.testing.assert_close(output, x + y)
+    # The launching thread is only pinned while the grid runs.
+    assert os.sched_getaffinity(0) == affinity
+
+
+def _guarded_first_touch(nbytes, **kwargs):
+    # Touch a buffer of nbytes between two guard pages filled with ones, and
+    # return the guards.
+    page = mmap.PAGESIZE
+    storage = torch.empty(nbytes + 2 * page, dtype=torch.uint8)
+    storage[:page] = 1
+    storage[-page:] = 1
+    numa.first_touch(storage[page:page + nbytes], num_threads=4, **kwargs)
+    return storage[:page], storage[-page:]
+
+
+@pytest.mark.parametrize("nbytes", [1, 4096 * 7 + 3, 3 << 30])
+@pytest.mark.parametrize("num_programs", [None, 3, 17])
+def test_first_touch_stays_in_buffer(nbytes, num_programs):
+    if nbytes >= 1 << 30 and os.sysconf("SC_PAGE_SIZE") * os.sysconf("SC_AVPHYS_PAGES") < 2 * nbytes:
+        pytest.skip("not enough memory")
+    before, after = _guarded_first_touch(nbytes, num_programs=num_programs)
+    assert torch.all(before == 1) and torch.all(after == 1)
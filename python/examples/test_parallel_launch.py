@@ -0,0 +1,27 @@
+import pytest
+import torch
+
+import triton
+import triton.language as tl
+
+
+@triton.jit
+def program_id_kernel(out_ptr):
+    pid_x = tl.program_id(axis=0)
+    pid_y = tl.program_id(axis=1)
+    pid_z = tl.program_id(axis=2)
+    num_y = tl.num_programs(axis=1)
+    num_z = tl.num_programs(axis=2)
+    linear = (pid_x * num_y + pid_y) * num_z + pid_z
+    tl.store(out_ptr + linear, linear + 1)
+
+
+@pytest.mark.parametrize("num_threads", [1, 0, 3])
+@pytest.mark.parametrize("launch_schedule", ["static", "chunked", "work_stealing"])
+def test_parallel_launch(num_threads, launch_schedule, device):
+    grid = (7, 5, 3)
+    n = grid[0] * grid[1] * grid[2]
+    output = torch.zeros(n, dtype=torch.int32, device=device)
+    program_id_kernel[grid](output, num_threads=num_threads, launch_schedule=launch_schedule)
+    expected = torch.arange(1, n + 1, dtype=torch.int32, device=device)
+    torch.testing.assert_close(output, expected)
@@ -0,0 +1,56 @@
+import torch
+
+import triton
+import triton.language as tl
+
+
+@triton.jit
+def axpy_kernel(x_ptr, y_ptr, output_ptr, a, n_elements, BLOCK_SIZE: tl.constexpr):
+    pid = tl.program_id(axis=0)
+    offsets = pid * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_elements
+    x = tl.load(x_ptr + offsets, mask=mask)
+    y = tl.load(y_ptr + offsets, mask=mask)
+    tl.store(output_ptr + offsets, a * x + y, mask=mask)
+
+
+class Pointer:
+    # Not a tensor, only a data_ptr method.
+    def __init__(self, tensor):
+        self.tensor = tensor
+        self.dtype = tensor.dtype
+
+    def data_ptr(self):
+        return self.tensor.data_ptr()
+
+
+class SubTensor(torch.Tensor):
+    pass
+
+
+def test_pointer_argument_kinds(device):
+    # The launcher caches the data_ptr method of the last tensor type it saw,
+    # alternate between types to go through both its fast and slow paths.
+    size = 1000
+    x = torch.rand(size, device=device)
+    y = torch.rand(size, device=device)
+    grid = lambda meta: (triton.cdiv(size, meta["BLOCK_SIZE"]), )
+    for _ in range(2):
+        output = torch.empty_like(x)
+        axpy_kernel[grid](x, y, output, 2.0, size, BLOCK_SIZE=256)
+        torch.testing.assert_close(output, 2.0 * x + y)
+
+        output = torch.empty_like(x)
+        axpy_kernel[grid](Pointer(x), y.as_subclass(SubTensor), Pointer(output), 3.0, size, BLOCK_SIZE=256)
+        torch.testing.assert_close(output, 3.0 * x + y)
+
+
+def test_pointer_argument_views(device):
+    size = 1000
+    x = torch.rand(2 * size, device=device)
+    y = torch.rand(size + 7, device=device)
+    output = torch.zeros(size + 3, device=device)
+    grid = lambda meta: (triton.cdiv(size, meta["BLOCK_SIZE"]), )
+    axpy_kernel[grid](x[size:], y[7:], output[3:], -1.0, size, BLOCK_SIZE=256)
+    torch.testing.assert_close(output[3:], y[7:] - x[size:])
+    assert torch.all(output[:3] == 0)
@@ -0,0 +1,32 @@
+import pytest
+import torch
+
+import triton
+import triton.language as tl
+
+
+@triton.jit
+def row_sum_kernel(x_ptr, output_ptr, n_cols, stride, BLOCK_M: tl.constexpr, BLOCK_N: tl.constexpr):
+    pid = tl.program_id(0)
+    offs_m = pid * BLOCK_M + tl.arange(0, BLOCK_M)
+    offs_n = tl.arange(0, BLOCK_N)
+    ptrs = x_ptr + offs_m[:, None] * stride + offs_n[None, :]
+    acc = tl.zeros((BLOCK_M, BLOCK_N), dtype=tl.float32)
+    for k in range(0, tl.cdiv(n_cols, BLOCK_N)):
+        # The loads of the next num_stages - 1 iterations are prefetched.
+        x = tl.load(ptrs, mask=offs_n[None, :] < n_cols - k * BLOCK_N, other=0.0)
+        acc += x
+        ptrs += BLOCK_N
+    tl.store(output_ptr + offs_m, tl.sum(acc, axis=1))
+
+
+@pytest.mark.parametrize("num_stages", [1, 2, 4])
+def test_row_sum(num_stages, device):
+    torch.manual_seed(0)
+    rows, cols = 64, 1000
+    x = torch.rand((rows, cols), device=device)
+    output = torch.empty(rows, device=device)
+    BLOCK_M = 16
+    row_sum_kernel[(rows // BLOCK_M, )](x, output, cols, x.stride(0), BLOCK_M=BLOCK_M, BLOCK_N=64,
+                                        num_stages=num_stages)
+    torch.testing.assert_close(output, x.sum(dim=1), rtol=1e-4, atol=1e-4)
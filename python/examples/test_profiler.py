@@ -0,0 +1,100 @@
+import pytest
+import torch
+
+import triton
+import triton.language as tl
+from triton.backends.triton_shared import profiler
+
+
+@triton.jit
+def add_kernel(x_ptr, y_ptr, output_ptr, n_elements, BLOCK_SIZE: tl.constexpr):
+    pid = tl.program_id(axis=0)
+    offsets = pid * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_elements
+    x = tl.load(x_ptr + offsets, mask=mask)
+    y = tl.load(y_ptr + offsets, mask=mask)
+    tl.store(output_ptr + offsets, x + y, mask=mask)
+
+
+@pytest.fixture
+def profiling():
+    was_enabled = profiler.is_enabled()
+    profiler.reset()
+    yield
+    profiler.reset()
+    if not was_enabled:
+        profiler.disable()
+
+
+@pytest.mark.parametrize("grid_loop", [False, True])
+@pytest.mark.parametrize("counters", [False, True])
+def test_profiler(grid_loop, counters, profiling, device):
+    profiler.enable(counters=counters)
+    size = 4096
+    x = torch.rand(size, device=device)
+    y = torch.rand(size, device=device)
+    output = torch.empty_like(x)
+    grid = lambda meta: (triton.cdiv(size, meta["BLOCK_SIZE"]), )
+    for _ in range(3):
+        add_kernel[grid](x, y, output, size, BLOCK_SIZE=256, num_threads=2, grid_loop=grid_loop)
+    torch.testing.assert_close(output, x + y)
+
+    profile = profiler.get_profiles()["add_kernel"]
+    assert profile.num_launches == 3
+    assert profile.num_programs == 3 * 16
+    assert sum(profile.latency_histogram) == profile.num_programs
+    assert 0 < profile.max_program_ns <= profile.program_ns
+    assert all(launch.wall_ns > 0 and launch.grid == (16, 1, 1) for launch in profile.launches)
+    if counters and profile.counters is not None:
+        assert profile.counters["instructions"] > 0
+    if not counters:
+        assert profile.counters is None
+    assert "add_kernel" in profiler.report()
+
+
+def test_profiler_disabled(profiling, device):
+    profiler.disable()
+    x = torch.rand(256, device=device)
+    output = torch.empty_like(x)
+    add_kernel[(1, )](x, x, output, 256, BLOCK_SIZE=256)
+    assert profiler.get_profiles() == {}
+
+
+@triton.jit
+def scale_kernel(x_ptr, output_ptr, scale, n_elements, BLOCK_SIZE: tl.constexpr):
+    pid = tl.program_id(axis=0)
+    offsets = pid * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_elements
+    x = tl.load(x_ptr + offsets, mask=mask)
+    tl.store(output_ptr + offsets, x * scale, mask=mask)
+
+
+def test_compile_profiler(monkeypatch, tmp_path, device):
+    # A fresh cache so that the kernel is compiled, and its launcher built.
+    monkeypatch.setenv("TRITON_CACHE_DIR", str(tmp_path))
+    monkeypatch.setenv("TRITON_SHARED_STAGE_CACHE", "0")
+    was_enabled = profiler.is_compile_profiling_enabled()
+    profiler.enable_compile_profiling()
+    profiler.reset_compile_profiles()
+    try:
+        x = torch.rand(1000, device=device)
+        output = torch.empty_like(x)
+        scale_kernel[(4, )](x, output, 2.0, 1000, BLOCK_SIZE=256)
+        torch.testing.assert_close(output, x * 2.0)
+        profiles = profiler.get_compile_profiles()["scale_kernel"]
+    finally:
+        if not was_enabled:
+            profiler.disable_compile_profiling()
+        profiler.reset_compile_profiles()
+
+    assert len(profiles) == 1
+    stages = [stage.stage for stage in profiles[0].stages]
+    assert stages == ["ttir", "ttsharedir", "llir", "cpuobj", "launcher"]
+    assert all(stage.seconds > 0 for stage in profiles[0].stages)
+    passes = {(p.stage, p.name) for p in profiles[0].passes}
+    assert ("ttsharedir", "triton-to-linalg-experimental") in passes
+    assert ("ttsharedir", "triton-to-structured") in passes
+    assert ("llir", "convert-func-to-llvm") in passes
+    nested = [p for p in profiles[0].passes if p.name == "triton-to-structured"]
+    assert nested[0].depth == 1 and nested[0].ops_before > 0
+    assert "scale_kernel" in profiler.compile_report(profiles[0])
@@ -54,4 +54,4 @@ def test(device):
     print(ret.asm["ttir"])
     print(ret.asm["ttsharedir"])
     print(ret.asm["llir"])
-    print(ret.asm["cpuasm"])
+    assert len(ret.asm["cpuobj"]) > 0
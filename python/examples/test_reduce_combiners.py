@@ -0,0 +1,81 @@
+import pytest
+import torch
+
+import triton
+import triton.language as tl
+
+
+@triton.jit
+def sum_kernel(x_ptr, output_ptr, BLOCK_SIZE: tl.constexpr):
+    x = tl.load(x_ptr + tl.arange(0, BLOCK_SIZE))
+    tl.store(output_ptr, tl.sum(x, axis=0))
+
+
+@pytest.mark.parametrize("n", [16, 128, 1024, 4096])
+def test_sum_1d(n, device):
+    torch.manual_seed(0)
+    x = torch.rand(n, device=device)
+    output = torch.empty(1, device=device)
+    sum_kernel[(1, )](x, output, BLOCK_SIZE=n)
+    # The partial sums reassociate the additions.
+    torch.testing.assert_close(output[0], x.sum(), rtol=1e-4, atol=1e-4)
+
+
+@triton.jit
+def xor_prod_kernel(x_ptr, y_ptr, xor_ptr, prod_ptr, BLOCK_SIZE: tl.constexpr):
+    offsets = tl.arange(0, BLOCK_SIZE)
+    x = tl.load(x_ptr + offsets)
+    y = tl.load(y_ptr + offsets)
+    tl.store(xor_ptr, tl.xor_sum(x, axis=0))
+    tl.store(prod_ptr, tl.reduce(y, 0, _mul))
+
+
+@triton.jit
+def _mul(a, b):
+    return a * b
+
+
+def test_xor_and_product(device):
+    torch.manual_seed(0)
+    n = 256
+    x = torch.randint(0, 2**16, (n, ), dtype=torch.int32, device=device)
+    y = 1 + (torch.rand(n, device=device) - 0.5) / 64
+    xor = torch.empty(1, dtype=torch.int32, device=device)
+    prod = torch.empty(1, device=device)
+    xor_prod_kernel[(1, )](x, y, xor, prod, BLOCK_SIZE=n)
+    expected_xor = 0
+    for v in x.tolist():
+        expected_xor ^= v
+    assert xor.item() == expected_xor
+    torch.testing.assert_close(prod[0], torch.prod(y), rtol=1e-4, atol=1e-5)
+
+
+@triton.jit
+def _welford_combine(mean_a, m2_a, weight_a, mean_b, m2_b, weight_b):
+    weight = weight_a + weight_b
+    w_b = tl.where(weight == 0.0, 0.0, weight_b / weight)
+    delta = mean_b - mean_a
+    mean = mean_a + delta * w_b
+    m2 = m2_a + m2_b + delta * delta * weight_a * w_b
+    return mean, m2, weight
+
+
+@triton.jit
+def welford_kernel(x_ptr, mean_ptr, var_ptr, N: tl.constexpr, BLOCK_SIZE: tl.constexpr):
+    row = tl.program_id(0)
+    offsets = tl.arange(0, BLOCK_SIZE)
+    x = tl.load(x_ptr + row * N + offsets)
+    mean, m2, weight = tl.reduce((x, tl.zeros_like(x), tl.full(x.shape, 1.0, tl.float32)), 0, _welford_combine)
+    tl.store(mean_ptr + row, mean)
+    tl.store(var_ptr + row, m2 / weight)
+
+
+def test_welford(device):
+    torch.manual_seed(0)
+    n_rows, n_cols = 8, 128
+    x = torch.randn(n_rows, n_cols, device=device)
+    mean = torch.empty(n_rows, device=device)
+    var = torch.empty(n_rows, device=device)
+    welford_kernel[(n_rows, )](x, mean, var, N=n_cols, BLOCK_SIZE=n_cols)
+    torch.testing.assert_close(mean, x.mean(dim=1), rtol=1e-4, atol=1e-4)
+    torch.testing.assert_close(var, x.var(dim=1, unbiased=False), rtol=1e-4, atol=1e-4)
@@ -0,0 +1,73 @@
+import torch
+
+import triton
+import triton.language as tl
+from triton.backends.triton_shared import stream as cpu_stream
+
+
+@triton.jit
+def axpy_kernel(x_ptr, y_ptr, output_ptr, a, n_elements, BLOCK_SIZE: tl.constexpr):
+    pid = tl.program_id(axis=0)
+    offsets = pid * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_elements
+    x = tl.load(x_ptr + offsets, mask=mask)
+    y = tl.load(y_ptr + offsets, mask=mask)
+    tl.store(output_ptr + offsets, a * x + y, mask=mask)
+
+
+@triton.jit
+def scale_kernel(x_ptr, output_ptr, a, n_elements, BLOCK_SIZE: tl.constexpr):
+    pid = tl.program_id(axis=0)
+    offsets = pid * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_elements
+    x = tl.load(x_ptr + offsets, mask=mask)
+    tl.store(output_ptr + offsets, a * x, mask=mask)
+
+
+def test_stream_in_order(device):
+    size = 5000
+    x = torch.rand(size, device=device)
+    y = torch.rand(size, device=device)
+    grid = lambda meta: (triton.cdiv(size, meta["BLOCK_SIZE"]), )
+    # Each launch reads the output of the previous one.
+    stream = cpu_stream.Stream()
+    a = y.clone()
+    b = torch.empty_like(y)
+    with stream:
+        for _ in range(5):
+            axpy_kernel[grid](x, a, b, 1.0, size, BLOCK_SIZE=256)
+            scale_kernel[grid](b, a, 0.5, size, BLOCK_SIZE=256)
+    event = stream.record_event()
+    event.result()
+    expected = y.clone()
+    for _ in range(5):
+        expected = (x + expected) * 0.5
+    torch.testing.assert_close(a, expected)
+    stream.synchronize()
+    assert stream.query()
+
+
+def test_graph_replay(device):
+    size = 5000
+    x = torch.rand(size, device=device)
+    y = torch.rand(size, device=device)
+    tmp = torch.empty_like(x)
+    output = torch.zeros_like(x)
+    grid = lambda meta: (triton.cdiv(size, meta["BLOCK_SIZE"]), )
+    graph = cpu_stream.Graph()
+    with graph.capture():
+        axpy_kernel[grid](x, y, tmp, 2.0, size, BLOCK_SIZE=256)
+        scale_kernel[grid](tmp, output, 3.0, size, BLOCK_SIZE=256)
+    assert len(graph) == 2
+    # Nothing ran while capturing.
+    assert torch.all(output == 0)
+
+    graph.replay()
+    torch.testing.assert_close(output, (2.0 * x + y) * 3.0)
+
+    # The launches read the captured tensors again.
+    x.copy_(torch.rand(size, device=device))
+    stream = cpu_stream.Stream()
+    graph.replay(stream)
+    stream.synchronize()
+    torch.testing.assert_close(output, (2.0 * x + y) * 3.0)
@@ -0,0 +1,51 @@
+import pytest
+import torch
+
+import triton
+import triton.language as tl
+
+
+# Without do_not_specialize triton would compile the strides equal to 1 as
+# constants in the first place.
+@triton.jit(do_not_specialize=["stride_xm", "stride_xn", "stride_om", "stride_on"])
+def scale_kernel(x_ptr, output_ptr, stride_xm, stride_xn, stride_om, stride_on, BLOCK_M: tl.constexpr,
+                 BLOCK_N: tl.constexpr):
+    pid = tl.program_id(axis=0)
+    rows = pid * BLOCK_M + tl.arange(0, BLOCK_M)
+    cols = tl.arange(0, BLOCK_N)
+    x = tl.load(x_ptr + rows[:, None] * stride_xm + cols[None, :] * stride_xn)
+    tl.store(output_ptr + rows[:, None] * stride_om + cols[None, :] * stride_on, x * 2)
+
+
+def test_unit_stride_contiguous(device):
+    torch.manual_seed(0)
+    x = torch.rand(128, 64, device=device)
+    output = torch.empty_like(x)
+    grid = lambda meta: (triton.cdiv(x.shape[0], meta["BLOCK_M"]), )
+    kernel = scale_kernel[grid](x, output, x.stride(0), x.stride(1), output.stride(0), output.stride(1),
+                                BLOCK_M=16, BLOCK_N=64, unit_stride=True)
+    # stride_xn and stride_on, counting the pointers.
+    assert kernel.metadata.unit_stride_args == [3, 5]
+    torch.testing.assert_close(output, x * 2)
+
+
+@pytest.mark.parametrize("transpose_input", [True, False])
+def test_unit_stride_strided(transpose_input, device):
+    # Either the input or the output is a transposed view: the launcher must
+    # run the generic kernel.
+    torch.manual_seed(0)
+    x = torch.rand(64, 128, device=device).t() if transpose_input else torch.rand(128, 64, device=device)
+    output = torch.empty(128, 64, device=device) if transpose_input else torch.empty(64, 128, device=device).t()
+    grid = lambda meta: (triton.cdiv(x.shape[0], meta["BLOCK_M"]), )
+    scale_kernel[grid](x, output, x.stride(0), x.stride(1), output.stride(0), output.stride(1), BLOCK_M=16,
+                       BLOCK_N=64, unit_stride=True)
+    torch.testing.assert_close(output, x * 2)
+
+
+def test_unit_stride_disabled(device):
+    x = torch.rand(16, 64, device=device)
+    output = torch.empty_like(x)
+    kernel = scale_kernel[(1, )](x, output, x.stride(0), x.stride(1), output.stride(0), output.stride(1),
+                                 BLOCK_M=16, BLOCK_N=64)
+    assert kernel.metadata.unit_stride_args == []
+    torch.testing.assert_close(output, x * 2)
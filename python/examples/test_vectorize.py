@@ -0,0 +1,51 @@
+import pytest
+import torch
+
+import triton
+import triton.language as tl
+
+
+@triton.jit
+def add_kernel(x_ptr, y_ptr, output_ptr, n_elements, BLOCK_SIZE: tl.constexpr):
+    pid = tl.program_id(axis=0)
+    offsets = pid * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_elements
+    x = tl.load(x_ptr + offsets, mask=mask)
+    y = tl.load(y_ptr + offsets, mask=mask)
+    tl.store(output_ptr + offsets, x + y, mask=mask)
+
+
+@triton.jit
+def softmax_kernel(output_ptr, input_ptr, input_row_stride, output_row_stride, n_cols, BLOCK_SIZE: tl.constexpr):
+    row_idx = tl.program_id(0)
+    col_offsets = tl.arange(0, BLOCK_SIZE)
+    input_ptrs = input_ptr + row_idx * input_row_stride + col_offsets
+    row = tl.load(input_ptrs, mask=col_offsets < n_cols, other=-float('inf'))
+    row_minus_max = row - tl.max(row, axis=0)
+    numerator = tl.exp(row_minus_max)
+    denominator = tl.sum(numerator, axis=0)
+    output_ptrs = output_ptr + row_idx * output_row_stride + col_offsets
+    tl.store(output_ptrs, numerator / denominator, mask=col_offsets < n_cols)
+
+
+@pytest.mark.parametrize("vector_width", [0, 128])
+def test_vectorized_add(vector_width, device):
+    torch.manual_seed(0)
+    size = 98432
+    x = torch.rand(size, device=device)
+    y = torch.rand(size, device=device)
+    output = torch.empty_like(x)
+    grid = lambda meta: (triton.cdiv(size, meta["BLOCK_SIZE"]), )
+    add_kernel[grid](x, y, output, size, BLOCK_SIZE=1024, vectorize=True, vector_width=vector_width)
+    torch.testing.assert_close(output, x + y)
+
+
+@pytest.mark.parametrize("vector_width", [0, 128])
+def test_vectorized_softmax(vector_width, device):
+    torch.manual_seed(0)
+    x = torch.randn(123, 781, device=device)
+    y = torch.empty_like(x)
+    n_rows, n_cols = x.shape
+    softmax_kernel[(n_rows, )](y, x, x.stride(0), y.stride(0), n_cols, BLOCK_SIZE=triton.next_power_of_2(n_cols),
+                               vectorize=True, vector_width=vector_width)
+    torch.testing.assert_close(y, torch.softmax(x, axis=1))
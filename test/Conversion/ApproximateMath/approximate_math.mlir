@@ -0,0 +1,62 @@
+// RUN: triton-shared-opt --split-input-file --approximate-math %s | FileCheck %s
+// RUN: triton-shared-opt --split-input-file --approximate-math="accuracy=low" %s | FileCheck %s --check-prefix=LOW
+// RUN: triton-shared-opt --split-input-file --approximate-math="accuracy=libm" %s | FileCheck %s --check-prefix=LIBM
+
+#map = affine_map<(d0) -> (d0)>
+module {
+  func.func @gelu_like(%arg0: tensor<128xf32>) -> tensor<128xf32> {
+    %0 = tensor.empty() : tensor<128xf32>
+    %1 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel"]} ins(%arg0 : tensor<128xf32>) outs(%0 : tensor<128xf32>) {
+    ^bb0(%in: f32, %out: f32):
+      %2 = math.tanh %in : f32
+      %3 = math.exp %2 : f32
+      %4 = math.erf %3 : f32
+      %5 = math.sin %4 : f32
+      linalg.yield %5 : f32
+    } -> tensor<128xf32>
+    return %1 : tensor<128xf32>
+  }
+}
+
+// CHECK-LABEL:  func.func @gelu_like
+// CHECK-NOT:       math.tanh
+// CHECK-NOT:       math.exp
+// CHECK:           math.erf
+// CHECK:           math.sin
+// CHECK:           linalg.yield
+
+// LOW-LABEL:    func.func @gelu_like
+// LOW-NOT:         math.tanh
+// LOW-NOT:         math.exp
+// LOW-NOT:         math.erf
+// LOW-NOT:         math.sin
+// LOW:             linalg.yield
+
+// LIBM-LABEL:   func.func @gelu_like
+// LIBM:            math.tanh
+// LIBM:            math.exp
+// LIBM:            math.erf
+// LIBM:            math.sin
+// LIBM:            linalg.yield
+
+// -----
+
+// f16 operands are computed in f32.
+#map = affine_map<(d0) -> (d0)>
+module {
+  func.func @exp_f16(%arg0: tensor<64xf16>) -> tensor<64xf16> {
+    %0 = tensor.empty() : tensor<64xf16>
+    %1 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel"]} ins(%arg0 : tensor<64xf16>) outs(%0 : tensor<64xf16>) {
+    ^bb0(%in: f16, %out: f16):
+      %2 = math.exp %in : f16
+      linalg.yield %2 : f16
+    } -> tensor<64xf16>
+    return %1 : tensor<64xf16>
+  }
+}
+
+// CHECK-LABEL:  func.func @exp_f16
+// CHECK:           arith.extf {{.*}} : f16 to f32
+// CHECK-NOT:       math.exp
+// CHECK:           arith.truncf {{.*}} : f32 to f16
+// CHECK:           linalg.yield
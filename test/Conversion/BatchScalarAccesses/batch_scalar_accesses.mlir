@@ -0,0 +1,117 @@
+// RUN: triton-shared-opt --split-input-file --batch-scalar-accesses %s | FileCheck %s
+
+// Fields of a parameter struct, read through ptr + 0, ptr + 1 and ptr + 2.
+module {
+  func.func @load_params(%arg0: memref<*xi32>, %arg1: memref<*xi32>) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %c2 = arith.constant 2 : index
+    %reinterpret_cast = memref.reinterpret_cast %arg0 to offset: [%c0], sizes: [1], strides: [1] : memref<*xi32> to memref<1xi32, strided<[1], offset: ?>>
+    %0 = affine.load %reinterpret_cast[0] : memref<1xi32, strided<[1], offset: ?>>
+    %reinterpret_cast_0 = memref.reinterpret_cast %arg0 to offset: [%c1], sizes: [1], strides: [1] : memref<*xi32> to memref<1xi32, strided<[1], offset: ?>>
+    %1 = affine.load %reinterpret_cast_0[0] : memref<1xi32, strided<[1], offset: ?>>
+    %reinterpret_cast_1 = memref.reinterpret_cast %arg0 to offset: [%c2], sizes: [1], strides: [1] : memref<*xi32> to memref<1xi32, strided<[1], offset: ?>>
+    %2 = affine.load %reinterpret_cast_1[0] : memref<1xi32, strided<[1], offset: ?>>
+    %3 = arith.addi %0, %1 : i32
+    %4 = arith.muli %3, %2 : i32
+    %reinterpret_cast_2 = memref.reinterpret_cast %arg1 to offset: [%c0], sizes: [1], strides: [1] : memref<*xi32> to memref<1xi32, strided<[1], offset: ?>>
+    affine.store %4, %reinterpret_cast_2[0] : memref<1xi32, strided<[1], offset: ?>>
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @load_params
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<*xi32>, [[PARAM_1_:%.+]]: memref<*xi32>) {
+// CHECK:           [[VAR_view_:%.+]] = memref.reinterpret_cast [[PARAM_0_]] to offset: [0], sizes: [3], strides: [1] : memref<*xi32> to memref<3xi32, strided<[1]>>
+// CHECK:           [[VAR_0_:%.+]] = vector.load [[VAR_view_]][{{%.+}}] : memref<3xi32, strided<[1]>>, vector<3xi32>
+// CHECK-DAG:       [[VAR_1_:%.+]] = vector.extract [[VAR_0_]][0] : i32 from vector<3xi32>
+// CHECK-DAG:       [[VAR_2_:%.+]] = vector.extract [[VAR_0_]][1] : i32 from vector<3xi32>
+// CHECK-DAG:       [[VAR_3_:%.+]] = vector.extract [[VAR_0_]][2] : i32 from vector<3xi32>
+// CHECK-NOT:       affine.load
+// CHECK:           [[VAR_4_:%.+]] = arith.addi [[VAR_1_]], [[VAR_2_]] : i32
+// CHECK:           [[VAR_5_:%.+]] = arith.muli [[VAR_4_]], [[VAR_3_]] : i32
+// CHECK:           affine.store [[VAR_5_]], {{%.+}}[0] : memref<1xi32, strided<[1], offset: ?>>
+// CHECK:           return
+
+// -----
+
+// Stores of consecutive elements at a dynamic offset.
+module {
+  func.func @store_pair(%arg0: memref<*xf32>, %arg1: f32, %arg2: f32, %arg3: index) {
+    %c1 = arith.constant 1 : index
+    %reinterpret_cast = memref.reinterpret_cast %arg0 to offset: [%arg3], sizes: [1], strides: [1] : memref<*xf32> to memref<1xf32, strided<[1], offset: ?>>
+    affine.store %arg1, %reinterpret_cast[0] : memref<1xf32, strided<[1], offset: ?>>
+    %0 = arith.addi %arg3, %c1 : index
+    %reinterpret_cast_0 = memref.reinterpret_cast %arg0 to offset: [%0], sizes: [1], strides: [1] : memref<*xf32> to memref<1xf32, strided<[1], offset: ?>>
+    affine.store %arg2, %reinterpret_cast_0[0] : memref<1xf32, strided<[1], offset: ?>>
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @store_pair
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<*xf32>, [[PARAM_1_:%.+]]: f32, [[PARAM_2_:%.+]]: f32, [[PARAM_3_:%.+]]: index) {
+// CHECK-NOT:       affine.store
+// CHECK:           [[VAR_0_:%.+]] = vector.broadcast [[PARAM_1_]] : f32 to vector<2xf32>
+// CHECK:           [[VAR_1_:%.+]] = vector.insert [[PARAM_2_]], [[VAR_0_]] [1] : f32 into vector<2xf32>
+// CHECK:           [[VAR_view_:%.+]] = memref.reinterpret_cast [[PARAM_0_]] to offset: {{.}}[[PARAM_3_]]{{.}}, sizes: [2], strides: [1] : memref<*xf32> to memref<2xf32, strided<[1], offset: ?>>
+// CHECK:           vector.store [[VAR_1_]], [[VAR_view_]][{{%.+}}] : memref<2xf32, strided<[1], offset: ?>>, vector<2xf32>
+// CHECK-NOT:       affine.store
+// CHECK:           return
+
+// -----
+
+// A store between two loads may write the second element: the loads stay
+// scalar.
+module {
+  func.func @store_between_loads(%arg0: memref<*xf32>, %arg1: memref<*xf32>) -> f32 {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %reinterpret_cast = memref.reinterpret_cast %arg0 to offset: [%c0], sizes: [1], strides: [1] : memref<*xf32> to memref<1xf32, strided<[1], offset: ?>>
+    %0 = affine.load %reinterpret_cast[0] : memref<1xf32, strided<[1], offset: ?>>
+    %reinterpret_cast_0 = memref.reinterpret_cast %arg1 to offset: [%c0], sizes: [1], strides: [1] : memref<*xf32> to memref<1xf32, strided<[1], offset: ?>>
+    affine.store %0, %reinterpret_cast_0[0] : memref<1xf32, strided<[1], offset: ?>>
+    %reinterpret_cast_1 = memref.reinterpret_cast %arg0 to offset: [%c1], sizes: [1], strides: [1] : memref<*xf32> to memref<1xf32, strided<[1], offset: ?>>
+    %1 = affine.load %reinterpret_cast_1[0] : memref<1xf32, strided<[1], offset: ?>>
+    return %1 : f32
+  }
+}
+
+// CHECK-LABEL:  func.func @store_between_loads
+// CHECK-NOT:       vector.load
+// CHECK:           affine.load
+// CHECK:           affine.store
+// CHECK:           affine.load
+// CHECK:           return
+
+// -----
+
+// A loop that does not write memory reads the same scalar at every iteration.
+module {
+  func.func @invariant_load(%arg0: memref<*xf32>, %arg1: i32) -> f32 {
+    %c0 = arith.constant 0 : index
+    %c0_i32 = arith.constant 0 : i32
+    %c1_i32 = arith.constant 1 : i32
+    %cst = arith.constant 0.000000e+00 : f32
+    %0 = scf.for %arg2 = %c0_i32 to %arg1 step %c1_i32 iter_args(%arg3 = %cst) -> (f32)  : i32 {
+      %reinterpret_cast = memref.reinterpret_cast %arg0 to offset: [%c0], sizes: [1], strides: [1] : memref<*xf32> to memref<1xf32, strided<[1], offset: ?>>
+      %1 = affine.load %reinterpret_cast[0] : memref<1xf32, strided<[1], offset: ?>>
+      %2 = arith.addf %arg3, %1 : f32
+      scf.yield %2 : f32
+    }
+    return %0 : f32
+  }
+}
+
+// CHECK-LABEL:  func.func @invariant_load
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<*xf32>, [[PARAM_1_:%.+]]: i32) -> f32 {
+// CHECK:           [[VAR_reinterpret_cast_:%.+]] = memref.reinterpret_cast [[PARAM_0_]]
+// CHECK:           [[VAR_0_:%.+]] = arith.cmpi slt, {{%.+}}, [[PARAM_1_]] : i32
+// CHECK:           [[VAR_1_:%.+]] = scf.if [[VAR_0_]] -> (f32) {
+// CHECK:             [[LOAD_:%.+]] = affine.load [[VAR_reinterpret_cast_]][0]
+// CHECK:             scf.yield [[LOAD_]] : f32
+// CHECK:           } else {
+// CHECK:             scf.yield {{%.+}} : f32
+// CHECK:           }
+// CHECK:           scf.for
+// CHECK-NOT:         affine.load
+// CHECK:             arith.addf {{%.+}}, [[VAR_1_]] : f32
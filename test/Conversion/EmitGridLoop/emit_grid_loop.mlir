@@ -0,0 +1,71 @@
+// RUN: triton-shared-opt --split-input-file --emit-grid-loop %s | FileCheck %s
+
+module {
+  func.func @add_pid(%arg0: memref<*xi32>, %arg1: i32, %arg2: i32, %arg3: i32, %arg4: i32, %arg5: i32, %arg6: i32) {
+    %c4_i32 = arith.constant 4 : i32
+    %0 = arith.muli %arg1, %c4_i32 : i32
+    %1 = arith.addi %arg4, %0 : i32
+    %2 = arith.index_cast %arg4 : i32 to index
+    %reinterpret_cast = memref.reinterpret_cast %arg0 to offset: [%2], sizes: [1], strides: [1] : memref<*xi32> to memref<1xi32, strided<[1], offset: ?>>
+    %c0 = arith.constant 0 : index
+    memref.store %1, %reinterpret_cast[%c0] : memref<1xi32, strided<[1], offset: ?>>
+    return
+  }
+}
+
+// CHECK:        func.func private @triton_shared_arena_release(i64)
+// CHECK:        func.func private @triton_shared_arena_mark() -> i64
+// CHECK-LABEL:  func.func @add_pid
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<*xi32>, [[PARAM_1_:%.+]]: i32, [[PARAM_2_:%.+]]: i32, [[PARAM_3_:%.+]]: i32, [[PARAM_4_:%.+]]: i64, [[PARAM_5_:%.+]]: i64) {
+// CHECK-DAG:       [[VAR_grid_y_:%.+]] = arith.index_cast [[PARAM_2_]] : i32 to index
+// CHECK-DAG:       [[VAR_grid_z_:%.+]] = arith.index_cast [[PARAM_3_]] : i32 to index
+// CHECK-DAG:       [[VAR_begin_:%.+]] = arith.index_cast [[PARAM_4_]] : i64 to index
+// CHECK-DAG:       [[VAR_end_:%.+]] = arith.index_cast [[PARAM_5_]] : i64 to index
+// CHECK-DAG:       [[CST_1_:%.+]] = arith.constant 1 : index
+// CHECK:           scf.for [[VAR_pid_:%.+]] = [[VAR_begin_]] to [[VAR_end_]] step [[CST_1_]] {
+// CHECK:             [[VAR_yz_:%.+]] = arith.muli [[VAR_grid_y_]], [[VAR_grid_z_]] : index
+// CHECK:             [[VAR_x_:%.+]] = arith.divui [[VAR_pid_]], [[VAR_yz_]] : index
+// CHECK:             arith.index_cast [[VAR_x_]] : index to i32
+// CHECK:             [[VAR_mark_:%.+]] = func.call @triton_shared_arena_mark() : () -> i64
+// CHECK:             [[VAR_offset_:%.+]] = arith.muli [[PARAM_1_]], {{.*}} : i32
+// CHECK:             memref.store
+// CHECK:             func.call @triton_shared_arena_release([[VAR_mark_]]) : (i64) -> ()
+// CHECK:           }
+// CHECK:           return
+// CHECK:         }
+
+// -----
+
+// Kernels with early returns keep their blocks in an scf.execute_region.
+module {
+  func.func @early_return(%arg0: memref<*xf32>, %arg1: i32, %arg2: i32, %arg3: i32, %arg4: i32, %arg5: i32, %arg6: i32) {
+    %c0_i32 = arith.constant 0 : i32
+    %0 = arith.cmpi eq, %arg4, %c0_i32 : i32
+    cf.cond_br %0, ^bb1, ^bb2
+  ^bb1:
+    return
+  ^bb2:
+    %cst = arith.constant 1.000000e+00 : f32
+    %1 = arith.index_cast %arg4 : i32 to index
+    %reinterpret_cast = memref.reinterpret_cast %arg0 to offset: [%1], sizes: [1], strides: [1] : memref<*xf32> to memref<1xf32, strided<[1], offset: ?>>
+    %c0 = arith.constant 0 : index
+    memref.store %cst, %reinterpret_cast[%c0] : memref<1xf32, strided<[1], offset: ?>>
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @early_return
+// CHECK-SAME:   ({{.*}}: i64, {{.*}}: i64) {
+// CHECK:           scf.for
+// CHECK:             [[VAR_mark_:%.+]] = func.call @triton_shared_arena_mark() : () -> i64
+// CHECK:             scf.execute_region {
+// CHECK:               cf.cond_br {{.*}}, ^bb1, ^bb2
+// CHECK:             ^bb1:
+// CHECK-NEXT:          scf.yield
+// CHECK:             ^bb2:
+// CHECK:               memref.store
+// CHECK-NEXT:          scf.yield
+// CHECK:             }
+// CHECK:             func.call @triton_shared_arena_release([[VAR_mark_]]) : (i64) -> ()
+// CHECK:           }
+// CHECK:           return
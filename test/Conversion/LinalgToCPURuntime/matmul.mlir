@@ -0,0 +1,85 @@
+// RUN: triton-shared-opt --split-input-file --linalg-to-cpu-runtime %s | FileCheck %s
+
+module {
+  func.func @matmul_f32(%arg0: memref<128x64xf32>, %arg1: memref<64x32xf32, strided<[?, 1], offset: ?>>, %arg2: memref<128x32xf32>) {
+    linalg.matmul ins(%arg0, %arg1 : memref<128x64xf32>, memref<64x32xf32, strided<[?, 1], offset: ?>>) outs(%arg2 : memref<128x32xf32>)
+    linalg.matmul ins(%arg0, %arg1 : memref<128x64xf32>, memref<64x32xf32, strided<[?, 1], offset: ?>>) outs(%arg2 : memref<128x32xf32>)
+    return
+  }
+}
+
+// CHECK: module {
+// CHECK:   func.func private @triton_shared_matmul_f32(memref<?x?xf32, strided<[?, ?], offset: ?>>, memref<?x?xf32, strided<[?, ?], offset: ?>>, memref<?x?xf32, strided<[?, ?], offset: ?>>) attributes {llvm.emit_c_interface}
+// CHECK-NOT: func.func private @triton_shared_matmul_f32
+// CHECK:   func.func @matmul_f32([[PARAM_0_:%.+]]: memref<128x64xf32>, [[PARAM_1_:%.+]]: memref<64x32xf32, strided<[?, 1], offset: ?>>, [[PARAM_2_:%.+]]: memref<128x32xf32>) {
+// CHECK-DAG:   [[VAR_A_:%.+]] = memref.cast [[PARAM_0_]] : memref<128x64xf32> to memref<?x?xf32, strided<[?, ?], offset: ?>>
+// CHECK-DAG:   [[VAR_B_:%.+]] = memref.cast [[PARAM_1_]] : memref<64x32xf32, strided<[?, 1], offset: ?>> to memref<?x?xf32, strided<[?, ?], offset: ?>>
+// CHECK-DAG:   [[VAR_C_:%.+]] = memref.cast [[PARAM_2_]] : memref<128x32xf32> to memref<?x?xf32, strided<[?, ?], offset: ?>>
+// CHECK:       call @triton_shared_matmul_f32([[VAR_A_]], [[VAR_B_]], [[VAR_C_]])
+// CHECK:       call @triton_shared_matmul_f32
+// CHECK-NOT:   linalg.matmul
+// CHECK:       return
+
+// -----
+
+module {
+  func.func @matmul_f64(%arg0: memref<16x8xf64>, %arg1: memref<8x4xf64>, %arg2: memref<16x4xf64>) {
+    linalg.matmul ins(%arg0, %arg1 : memref<16x8xf64>, memref<8x4xf64>) outs(%arg2 : memref<16x4xf64>)
+    return
+  }
+}
+
+// CHECK: func.func private @triton_shared_matmul_f64(memref<?x?xf64, strided<[?, ?], offset: ?>>, memref<?x?xf64, strided<[?, ?], offset: ?>>, memref<?x?xf64, strided<[?, ?], offset: ?>>) attributes {llvm.emit_c_interface}
+// CHECK: func.func @matmul_f64
+// CHECK: call @triton_shared_matmul_f64
+
+// -----
+
+// 16-bit inputs accumulated into f32 are widened by the runtime.
+module {
+  func.func @matmul_f16_f32(%arg0: memref<16x16xf16>, %arg1: memref<16x16xf16, strided<[?, 1], offset: ?>>, %arg2: memref<16x16xf32>) {
+    linalg.matmul ins(%arg0, %arg1 : memref<16x16xf16>, memref<16x16xf16, strided<[?, 1], offset: ?>>) outs(%arg2 : memref<16x16xf32>)
+    return
+  }
+  func.func @matmul_bf16_f32(%arg0: memref<16x16xbf16>, %arg1: memref<16x16xbf16>, %arg2: memref<16x16xf32>) {
+    linalg.matmul ins(%arg0, %arg1 : memref<16x16xbf16>, memref<16x16xbf16>) outs(%arg2 : memref<16x16xf32>)
+    return
+  }
+}
+
+// CHECK-DAG: func.func private @triton_shared_matmul_f16_f32(memref<?x?xf16, strided<[?, ?], offset: ?>>, memref<?x?xf16, strided<[?, ?], offset: ?>>, memref<?x?xf32, strided<[?, ?], offset: ?>>) attributes {llvm.emit_c_interface}
+// CHECK-DAG: func.func private @triton_shared_matmul_bf16_f32(memref<?x?xbf16, strided<[?, ?], offset: ?>>, memref<?x?xbf16, strided<[?, ?], offset: ?>>, memref<?x?xf32, strided<[?, ?], offset: ?>>) attributes {llvm.emit_c_interface}
+// CHECK:   func.func @matmul_f16_f32([[PARAM_0_:%.+]]: memref<16x16xf16>, [[PARAM_1_:%.+]]: memref<16x16xf16, strided<[?, 1], offset: ?>>, [[PARAM_2_:%.+]]: memref<16x16xf32>) {
+// CHECK-DAG:   [[VAR_A_:%.+]] = memref.cast [[PARAM_0_]] : memref<16x16xf16> to memref<?x?xf16, strided<[?, ?], offset: ?>>
+// CHECK-DAG:   [[VAR_B_:%.+]] = memref.cast [[PARAM_1_]] : memref<16x16xf16, strided<[?, 1], offset: ?>> to memref<?x?xf16, strided<[?, ?], offset: ?>>
+// CHECK-DAG:   [[VAR_C_:%.+]] = memref.cast [[PARAM_2_]] : memref<16x16xf32> to memref<?x?xf32, strided<[?, ?], offset: ?>>
+// CHECK:       call @triton_shared_matmul_f16_f32([[VAR_A_]], [[VAR_B_]], [[VAR_C_]])
+// CHECK:   func.func @matmul_bf16_f32
+// CHECK:       call @triton_shared_matmul_bf16_f32
+// CHECK-NOT:   linalg.matmul
+
+// -----
+
+// Other mixed precision matmuls and tensor matmuls keep the default lowering.
+module {
+  func.func @matmul_f16_f16(%arg0: memref<16x16xf16>, %arg1: memref<16x16xf16>, %arg2: memref<16x16xf16>) {
+    linalg.matmul ins(%arg0, %arg1 : memref<16x16xf16>, memref<16x16xf16>) outs(%arg2 : memref<16x16xf16>)
+    return
+  }
+  func.func @matmul_mixed(%arg0: memref<16x16xf16>, %arg1: memref<16x16xbf16>, %arg2: memref<16x16xf32>) {
+    linalg.matmul ins(%arg0, %arg1 : memref<16x16xf16>, memref<16x16xbf16>) outs(%arg2 : memref<16x16xf32>)
+    return
+  }
+  func.func @matmul_tensor(%arg0: tensor<16x16xf32>, %arg1: tensor<16x16xf32>, %arg2: tensor<16x16xf32>) -> tensor<16x16xf32> {
+    %0 = linalg.matmul ins(%arg0, %arg1 : tensor<16x16xf32>, tensor<16x16xf32>) outs(%arg2 : tensor<16x16xf32>) -> tensor<16x16xf32>
+    return %0 : tensor<16x16xf32>
+  }
+}
+
+// CHECK-NOT: call @triton_shared_matmul
+// CHECK: func.func @matmul_f16_f16
+// CHECK:   linalg.matmul
+// CHECK: func.func @matmul_mixed
+// CHECK:   linalg.matmul
+// CHECK: func.func @matmul_tensor
+// CHECK:   linalg.matmul
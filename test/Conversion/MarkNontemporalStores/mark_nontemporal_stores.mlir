@@ -0,0 +1,120 @@
+// RUN: triton-shared-opt --split-input-file --mark-nontemporal-stores %s | FileCheck %s
+
+// %arg1 is only written to, through views of it: its vector stores become
+// nontemporal. %arg0 is read, its stores are left alone.
+module {
+  func.func @scale(%arg0: memref<*xf32>, %arg1: memref<*xf32>, %arg2: index) {
+    %c0 = arith.constant 0 : index
+    %c8 = arith.constant 8 : index
+    %c1024 = arith.constant 1024 : index
+    %cst = arith.constant dense<2.000000e+00> : vector<8xf32>
+    %in = memref.reinterpret_cast %arg0 to offset: [%arg2], sizes: [1024], strides: [1] : memref<*xf32> to memref<1024xf32, strided<[1], offset: ?>>
+    %out = memref.reinterpret_cast %arg1 to offset: [%arg2], sizes: [1024], strides: [1] : memref<*xf32> to memref<1024xf32, strided<[1], offset: ?>>
+    scf.for %i = %c0 to %c1024 step %c8 {
+      %0 = vector.load %in[%i] : memref<1024xf32, strided<[1], offset: ?>>, vector<8xf32>
+      %1 = arith.mulf %0, %cst : vector<8xf32>
+      vector.store %1, %out[%i] : memref<1024xf32, strided<[1], offset: ?>>, vector<8xf32>
+      vector.store %1, %in[%i] : memref<1024xf32, strided<[1], offset: ?>>, vector<8xf32>
+    }
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @scale
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<*xf32>, [[PARAM_1_:%.+]]: memref<*xf32>, [[PARAM_2_:%.+]]: index) {
+// CHECK-DAG:      [[VAR_in_:%.+]] = memref.reinterpret_cast [[PARAM_0_]]
+// CHECK-DAG:      [[VAR_out_:%.+]] = memref.reinterpret_cast [[PARAM_1_]]
+// CHECK:          scf.for [[I_0_:%.+]] =
+// CHECK:            vector.store {{%.+}}, [[VAR_out_]]{{.}}[[I_0_]]{{.}} {nontemporal = true} : memref<1024xf32, strided<[1], offset: ?>>, vector<8xf32>
+// CHECK:            vector.store {{%.+}}, [[VAR_in_]]{{.}}[[I_0_]]{{.}} : memref<1024xf32, strided<[1], offset: ?>>, vector<8xf32>
+// CHECK:          }
+// CHECK:          llvm.fence seq_cst
+// CHECK-NEXT:     return
+
+// -----
+
+// In-bounds transfer_write ops of the innermost, contiguous dimension become
+// nontemporal vector.store ops, the others store nontemporally the vectors
+// that fit in the buffer.
+module {
+  func.func @transfer_writes(%arg0: memref<64x?xf32, strided<[?, 1]>>, %arg1: memref<64x?xf32, strided<[1, ?]>>, %arg2: vector<8xf32>, %arg3: index) {
+    %c0 = arith.constant 0 : index
+    vector.transfer_write %arg2, %arg0[%c0, %arg3] {in_bounds = [true]} : vector<8xf32>, memref<64x?xf32, strided<[?, 1]>>
+    vector.transfer_write %arg2, %arg0[%c0, %arg3] : vector<8xf32>, memref<64x?xf32, strided<[?, 1]>>
+    vector.transfer_write %arg2, %arg1[%c0, %arg3] {in_bounds = [true]} : vector<8xf32>, memref<64x?xf32, strided<[1, ?]>>
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @transfer_writes
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<64x?xf32, strided<[?, 1]>>, [[PARAM_1_:%.+]]: memref<64x?xf32, strided<[1, ?]>>, [[PARAM_2_:%.+]]: vector<8xf32>, [[PARAM_3_:%.+]]: index) {
+// CHECK:          vector.store [[PARAM_2_]], [[PARAM_0_]]{{.}}{{%.+}}, [[PARAM_3_]]{{.}} {nontemporal = true}
+// CHECK:          [[VAR_0_:%.+]] = memref.dim [[PARAM_0_]], {{%.+}} : memref<64x?xf32, strided<[?, 1]>>
+// CHECK:          [[VAR_1_:%.+]] = arith.addi [[PARAM_3_]], {{%.+}} : index
+// CHECK:          [[VAR_2_:%.+]] = arith.cmpi sle, [[VAR_1_]], [[VAR_0_]] : index
+// CHECK:          scf.if [[VAR_2_]] {
+// CHECK:            vector.store [[PARAM_2_]], [[PARAM_0_]]{{.}}{{%.+}}, [[PARAM_3_]]{{.}} {nontemporal = true}
+// CHECK:          } else {
+// CHECK:            vector.transfer_write [[PARAM_2_]], [[PARAM_0_]]{{.}}{{%.+}}, [[PARAM_3_]]{{.}} : vector<8xf32>, memref<64x?xf32, strided<[?, 1]>>
+// CHECK:          }
+// CHECK:          vector.transfer_write [[PARAM_2_]], [[PARAM_1_]]{{.}}{{%.+}}, [[PARAM_3_]]{{.}} {in_bounds = [true]} : vector<8xf32>, memref<64x?xf32, strided<[1, ?]>>
+// CHECK:          llvm.fence seq_cst
+// CHECK-NEXT:     return
+
+// -----
+
+// Copying from an argument reads it; the target of the copy is written to.
+module {
+  func.func @copy(%arg0: memref<128xf32>, %arg1: memref<128xf32>, %arg2: vector<8xf32>) {
+    %c0 = arith.constant 0 : index
+    memref.copy %arg0, %arg1 : memref<128xf32> to memref<128xf32>
+    vector.store %arg2, %arg0[%c0] : memref<128xf32>, vector<8xf32>
+    vector.store %arg2, %arg1[%c0] : memref<128xf32>, vector<8xf32>
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @copy
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<128xf32>, [[PARAM_1_:%.+]]: memref<128xf32>, [[PARAM_2_:%.+]]: vector<8xf32>) {
+// CHECK:          vector.store [[PARAM_2_]], [[PARAM_0_]]{{.}}{{%.+}}{{.}} : memref<128xf32>, vector<8xf32>
+// CHECK:          vector.store [[PARAM_2_]], [[PARAM_1_]]{{.}}{{%.+}}{{.}} {nontemporal = true} : memref<128xf32>, vector<8xf32>
+// CHECK:          llvm.fence seq_cst
+// CHECK-NEXT:     return
+
+// -----
+
+// The iterations of an scf.forall run on other threads: they fence their own
+// streaming stores.
+module {
+  func.func @forall(%arg0: memref<4x8xf32>, %arg1: vector<8xf32>) {
+    %c0 = arith.constant 0 : index
+    scf.forall (%i) in (4) {
+      vector.store %arg1, %arg0[%i, %c0] : memref<4x8xf32>, vector<8xf32>
+    }
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @forall
+// CHECK:          scf.forall
+// CHECK:            vector.store {{.*}} {nontemporal = true} : memref<4x8xf32>, vector<8xf32>
+// CHECK-NEXT:       llvm.fence seq_cst
+// CHECK-NEXT:     }
+// CHECK-NEXT:     llvm.fence seq_cst
+// CHECK-NEXT:     return
+
+// -----
+
+// Without streaming stores, the stores of the function need no fence.
+module {
+  func.func @no_streaming(%arg0: memref<128xf32>, %arg1: vector<8xf32>) {
+    %c0 = arith.constant 0 : index
+    %0 = vector.load %arg0[%c0] : memref<128xf32>, vector<8xf32>
+    vector.store %arg1, %arg0[%c0] : memref<128xf32>, vector<8xf32>
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @no_streaming
+// CHECK-NOT:      llvm.fence
+// CHECK:          return
@@ -0,0 +1,67 @@
+// RUN: triton-shared-opt --split-input-file --outline-parallel-loops %s | FileCheck %s
+
+module {
+  func.func @scale_rows(%arg0: memref<512x256xf32>, %arg1: f32) {
+    %c0 = arith.constant 0 : index
+    scf.forall (%i) in (512) {
+      %0 = memref.load %arg0[%i, %c0] : memref<512x256xf32>
+      %1 = arith.mulf %0, %arg1 : f32
+      memref.store %1, %arg0[%i, %c0] : memref<512x256xf32>
+    }
+    return
+  }
+}
+
+// CHECK:        func.func private @triton_shared_parallel_for(i64, !llvm.ptr, !llvm.ptr)
+// CHECK-LABEL:  func.func @scale_rows
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<512x256xf32>, [[PARAM_1_:%.+]]: f32) {
+// CHECK:          [[VAR_0_:%.+]] = llvm.mlir.constant(1 : i64) : i64
+// CHECK:          [[VAR_1_:%.+]] = llvm.alloca [[VAR_0_]] x !llvm.struct<(struct<(ptr, ptr, i64, array<2 x i64>, array<2 x i64>)>, f32)> : (i64) -> !llvm.ptr
+// CHECK:          [[VAR_2_:%.+]] = llvm.mlir.undef : !llvm.struct<(struct<(ptr, ptr, i64, array<2 x i64>, array<2 x i64>)>, f32)>
+// CHECK:          [[VAR_3_:%.+]] = builtin.unrealized_conversion_cast [[PARAM_0_]] : memref<512x256xf32> to !llvm.struct<(ptr, ptr, i64, array<2 x i64>, array<2 x i64>)>
+// CHECK:          [[VAR_4_:%.+]] = llvm.insertvalue [[VAR_3_]], [[VAR_2_]][0]
+// CHECK:          [[VAR_5_:%.+]] = llvm.insertvalue [[PARAM_1_]], [[VAR_4_]][1]
+// CHECK:          llvm.store [[VAR_5_]], [[VAR_1_]]
+// CHECK:          [[VAR_6_:%.+]] = arith.index_cast {{%.+}} : index to i64
+// CHECK:          [[VAR_7_:%.+]] = constant @scale_rows_parallel0 : (!llvm.ptr, i64, i64) -> ()
+// CHECK:          [[VAR_8_:%.+]] = builtin.unrealized_conversion_cast [[VAR_7_]] : (!llvm.ptr, i64, i64) -> () to !llvm.ptr
+// CHECK:          call @triton_shared_parallel_for([[VAR_6_]], [[VAR_8_]], [[VAR_1_]]) : (i64, !llvm.ptr, !llvm.ptr) -> ()
+// CHECK-NOT:      scf.forall
+// CHECK:          return
+
+// CHECK-LABEL:  func.func private @scale_rows_parallel0
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: !llvm.ptr, [[PARAM_1_:%.+]]: i64, [[PARAM_2_:%.+]]: i64) attributes {llvm.linkage = #llvm.linkage<internal>} {
+// CHECK:          [[VAR_0_:%.+]] = llvm.load [[PARAM_0_]]
+// CHECK:          [[VAR_1_:%.+]] = llvm.extractvalue [[VAR_0_]][0]
+// CHECK:          [[VAR_2_:%.+]] = builtin.unrealized_conversion_cast [[VAR_1_]] : !llvm.struct<(ptr, ptr, i64, array<2 x i64>, array<2 x i64>)> to memref<512x256xf32>
+// CHECK:          [[VAR_3_:%.+]] = llvm.extractvalue [[VAR_0_]][1]
+// CHECK:          [[CST_0_:%.+]] = arith.constant 0 : index
+// CHECK:          [[VAR_4_:%.+]] = arith.index_cast [[PARAM_1_]] : i64 to index
+// CHECK:          [[VAR_5_:%.+]] = arith.index_cast [[PARAM_2_]] : i64 to index
+// CHECK:          scf.for [[I_0_:%.+]] = [[VAR_4_]] to [[VAR_5_]] step {{%.+}} {
+// CHECK:            [[VAR_6_:%.+]] = memref.load [[VAR_2_]]{{.}}[[I_0_]], [[CST_0_]]{{.}} : memref<512x256xf32>
+// CHECK:            [[VAR_7_:%.+]] = arith.mulf [[VAR_6_]], [[VAR_3_]] : f32
+// CHECK:            memref.store [[VAR_7_]], [[VAR_2_]]{{.}}[[I_0_]], [[CST_0_]]{{.}} : memref<512x256xf32>
+// CHECK:          }
+// CHECK:          return
+
+// -----
+
+// A body without captured values gets a null context.
+module {
+  func.func @fill(%arg0: i32) {
+    scf.forall (%i) in (4) {
+      %0 = memref.alloc() : memref<16xf32>
+      memref.dealloc %0 : memref<16xf32>
+    }
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @fill
+// CHECK:          [[VAR_0_:%.+]] = llvm.mlir.zero : !llvm.ptr
+// CHECK:          call @triton_shared_parallel_for({{%.+}}, {{%.+}}, [[VAR_0_]])
+// CHECK-LABEL:  func.func private @fill_parallel0
+// CHECK-NOT:      llvm.load
+// CHECK:          scf.for
+// CHECK:            memref.alloc
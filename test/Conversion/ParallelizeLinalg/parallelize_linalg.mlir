@@ -0,0 +1,63 @@
+// RUN: triton-shared-opt --split-input-file --parallelize-linalg %s | FileCheck %s
+
+// A row reduction of a 512x256 block is split into one iteration per row.
+module {
+  func.func @reduce_rows(%arg0: memref<512x256xf32>, %arg1: memref<512xf32>) {
+    linalg.reduce ins(%arg0 : memref<512x256xf32>) outs(%arg1 : memref<512xf32>) dimensions = [1]
+      (%in: f32, %init: f32) {
+        %0 = arith.addf %in, %init : f32
+        linalg.yield %0 : f32
+      }
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @reduce_rows
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<512x256xf32>, [[PARAM_1_:%.+]]: memref<512xf32>) {
+// CHECK:          scf.forall ([[I_0_:%.+]]) in (512) {
+// CHECK-DAG:        [[VAR_0_:%.+]] = memref.subview [[PARAM_0_]]{{.}}[[I_0_]], 0] [1, 256] [1, 1]
+// CHECK-DAG:        [[VAR_1_:%.+]] = memref.subview [[PARAM_1_]]{{.}}[[I_0_]]] [1] [1]
+// CHECK:            linalg.reduce ins([[VAR_0_]] : memref<1x256xf32, strided<[256, 1], offset: ?>>) outs([[VAR_1_]] : memref<1xf32, strided<[1], offset: ?>>) dimensions = [1]
+// CHECK:          }
+// CHECK-NEXT:     return
+
+// -----
+
+// The outermost dimension has a single iteration: split the next one.
+module {
+  func.func @scale(%arg0: memref<1x65536xf32>) {
+    %cst = arith.constant 2.000000e+00 : f32
+    linalg.generic {indexing_maps = [affine_map<(d0, d1) -> (d0, d1)>], iterator_types = ["parallel", "parallel"]} outs(%arg0 : memref<1x65536xf32>) {
+    ^bb0(%out: f32):
+      %0 = arith.mulf %out, %cst : f32
+      linalg.yield %0 : f32
+    }
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @scale
+// CHECK:          scf.forall ([[I_0_:%.+]]) in (65536) {
+// CHECK:            memref.subview {{%.+}}[0, [[I_0_]]] [1, 1] [1, 1]
+// CHECK:            linalg.generic
+// CHECK:              arith.mulf
+
+// -----
+
+// Small ops, full reductions and ops with dynamic shapes are left alone.
+module {
+  func.func @left_alone(%arg0: memref<16x16xf32>, %arg1: memref<65536xf32>, %arg2: memref<f32>, %arg3: memref<?x1024xf32>) {
+    %cst = arith.constant 0.000000e+00 : f32
+    linalg.fill ins(%cst : f32) outs(%arg0 : memref<16x16xf32>)
+    linalg.reduce ins(%arg1 : memref<65536xf32>) outs(%arg2 : memref<f32>) dimensions = [0]
+      (%in: f32, %init: f32) {
+        %0 = arith.addf %in, %init : f32
+        linalg.yield %0 : f32
+      }
+    linalg.fill ins(%cst : f32) outs(%arg3 : memref<?x1024xf32>)
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @left_alone
+// CHECK-NOT:      scf.forall
@@ -0,0 +1,153 @@
+// RUN: triton-shared-opt --split-input-file --prefetch-loop-loads="distance=2" %s | FileCheck %s
+
+// The tile loaded from a loop-carried offset is prefetched from the offset it
+// will have two iterations later, one cache line at a time. The rows may not
+// start on a line, so their last element is prefetched too.
+module {
+  func.func @loop_carried_offset(%arg0: memref<*xf32>, %arg1: i32, %arg2: index) -> tensor<16x32xf32> {
+    %c0 = arith.constant 0 : index
+    %c64 = arith.constant 64 : index
+    %c0_i32 = arith.constant 0 : i32
+    %c1_i32 = arith.constant 1 : i32
+    %0 = tensor.empty() : tensor<16x32xf32>
+    %1:2 = scf.for %arg3 = %c0_i32 to %arg1 step %c1_i32 iter_args(%arg4 = %0, %arg5 = %c0) -> (tensor<16x32xf32>, index)  : i32 {
+      %reinterpret_cast = memref.reinterpret_cast %arg0 to offset: [%arg5], sizes: [16, 32], strides: [%arg2, 1] : memref<*xf32> to memref<16x32xf32, strided<[?, 1], offset: ?>>
+      %alloc = memref.alloc() : memref<16x32xf32>
+      memref.copy %reinterpret_cast, %alloc : memref<16x32xf32, strided<[?, 1], offset: ?>> to memref<16x32xf32>
+      %2 = bufferization.to_tensor %alloc restrict writable : memref<16x32xf32>
+      %3 = arith.addf %arg4, %2 : tensor<16x32xf32>
+      %4 = arith.addi %arg5, %c64 : index
+      scf.yield %3, %4 : tensor<16x32xf32>, index
+    }
+    return %1#0 : tensor<16x32xf32>
+  }
+}
+
+// CHECK-LABEL:  func.func @loop_carried_offset
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<*xf32>, [[PARAM_1_:%.+]]: i32, [[PARAM_2_:%.+]]: index) -> tensor<16x32xf32> {
+// CHECK:           scf.for {{.*}} iter_args({{.*}}, [[VAR_arg5_:%.+]] = {{.*}}) -> (tensor<16x32xf32>, index)  : i32 {
+// CHECK-DAG:         [[VAR_reinterpret_cast_:%.+]] = memref.reinterpret_cast [[PARAM_0_]] to offset: {{.}}[[VAR_arg5_]]{{.}}
+// CHECK-DAG:         [[RES_:%.+]] = memref.alloc() : memref<16x32xf32>
+// CHECK-DAG:         [[CST_128_:%.+]] = arith.constant 128 : index
+// CHECK:             [[VAR_next_:%.+]] = arith.addi [[VAR_arg5_]], [[CST_128_]] : index
+// CHECK:             [[VAR_next_tile_:%.+]] = memref.reinterpret_cast [[PARAM_0_]] to offset: {{.}}[[VAR_next_]]{{.}}, sizes: [16, 32], strides: {{.}}[[PARAM_2_]], 1] : memref<*xf32> to memref<16x32xf32, strided<[?, 1], offset: ?>>
+// CHECK-DAG:         [[CST_0_:%.+]] = arith.constant 0 : index
+// CHECK-DAG:         [[CST_1_:%.+]] = arith.constant 1 : index
+// CHECK-DAG:         [[CST_16_:%.+]] = arith.constant 16 : index
+// CHECK:             scf.for [[I_:%.+]] = [[CST_0_]] to [[CST_16_]] step [[CST_1_]] {
+// CHECK-DAG:           [[CST_32_:%.+]] = arith.constant 32 : index
+// CHECK-DAG:           [[CST_16_1_:%.+]] = arith.constant 16 : index
+// CHECK:               scf.for [[J_:%.+]] = [[CST_0_]] to [[CST_32_]] step [[CST_16_1_]] {
+// CHECK:                 memref.prefetch [[VAR_next_tile_]]{{.}}[[I_]], [[J_]]{{.}}, read, locality<3>, data
+// CHECK:               }
+// CHECK:               [[CST_31_:%.+]] = arith.constant 31 : index
+// CHECK:               memref.prefetch [[VAR_next_tile_]]{{.}}[[I_]], [[CST_31_]]{{.}}, read, locality<3>, data
+// CHECK:             }
+// CHECK:             memref.copy [[VAR_reinterpret_cast_]], [[RES_]]
+
+// -----
+
+// Offsets computed from the induction variable are recomputed for a later
+// iteration; the subview of a masked load is prefetched as the full tile.
+module {
+  func.func @induction_variable_offset(%arg0: memref<*xf16>, %arg1: index, %arg2: index) -> tensor<128xf16> {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %c128 = arith.constant 128 : index
+    %0 = tensor.empty() : tensor<128xf16>
+    %1 = scf.for %arg3 = %c0 to %arg1 step %c1 iter_args(%arg4 = %0) -> (tensor<128xf16>) {
+      %2 = arith.muli %arg3, %c128 : index
+      %reinterpret_cast = memref.reinterpret_cast %arg0 to offset: [%2], sizes: [128], strides: [1] : memref<*xf16> to memref<128xf16, strided<[1], offset: ?>>
+      %alloc = memref.alloc() : memref<128xf16>
+      %subview = memref.subview %reinterpret_cast[0] [%arg2] [1] : memref<128xf16, strided<[1], offset: ?>> to memref<?xf16, strided<[1], offset: ?>>
+      %subview_0 = memref.subview %alloc[0] [%arg2] [1] : memref<128xf16> to memref<?xf16, strided<[1]>>
+      memref.copy %subview, %subview_0 : memref<?xf16, strided<[1], offset: ?>> to memref<?xf16, strided<[1]>>
+      %3 = bufferization.to_tensor %alloc restrict writable : memref<128xf16>
+      %4 = arith.addf %arg4, %3 : tensor<128xf16>
+      scf.yield %4 : tensor<128xf16>
+    }
+    return %1 : tensor<128xf16>
+  }
+}
+
+// CHECK-LABEL:  func.func @induction_variable_offset
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<*xf16>, [[PARAM_1_:%.+]]: index, [[PARAM_2_:%.+]]: index) -> tensor<128xf16> {
+// CHECK:           scf.for [[VAR_arg3_:%.+]] = {{.*}} iter_args
+// CHECK:             [[CST_2_:%.+]] = arith.constant 2 : index
+// CHECK:             [[VAR_iv_:%.+]] = arith.addi [[VAR_arg3_]], [[CST_2_]] : index
+// CHECK:             [[VAR_offset_:%.+]] = arith.muli [[VAR_iv_]], {{%.+}} : index
+// CHECK:             [[VAR_next_tile_:%.+]] = memref.reinterpret_cast [[PARAM_0_]] to offset: {{.}}[[VAR_offset_]]{{.}}, sizes: [128], strides: [1]
+// CHECK:             [[CST_32_:%.+]] = arith.constant 32 : index
+// CHECK:             scf.for [[I_:%.+]] = {{.*}} step [[CST_32_]] {
+// CHECK:               memref.prefetch [[VAR_next_tile_]]{{.}}[[I_]]{{.}}, read, locality<3>, data
+// CHECK:             }
+// CHECK:             [[CST_127_:%.+]] = arith.constant 127 : index
+// CHECK:             memref.prefetch [[VAR_next_tile_]]{{.}}[[CST_127_]]{{.}}, read, locality<3>, data
+// CHECK:             memref.copy
+
+// -----
+
+// Rows that are not contiguous are prefetched one element at a time.
+module {
+  func.func @strided_rows(%arg0: memref<*xf32>, %arg1: i32, %arg2: index) -> tensor<4x8xf32> {
+    %c0 = arith.constant 0 : index
+    %c32 = arith.constant 32 : index
+    %c0_i32 = arith.constant 0 : i32
+    %c1_i32 = arith.constant 1 : i32
+    %0 = tensor.empty() : tensor<4x8xf32>
+    %1:2 = scf.for %arg3 = %c0_i32 to %arg1 step %c1_i32 iter_args(%arg4 = %0, %arg5 = %c0) -> (tensor<4x8xf32>, index)  : i32 {
+      %reinterpret_cast = memref.reinterpret_cast %arg0 to offset: [%arg5], sizes: [4, 8], strides: [1, %arg2] : memref<*xf32> to memref<4x8xf32, strided<[1, ?], offset: ?>>
+      %alloc = memref.alloc() : memref<4x8xf32>
+      memref.copy %reinterpret_cast, %alloc : memref<4x8xf32, strided<[1, ?], offset: ?>> to memref<4x8xf32>
+      %2 = bufferization.to_tensor %alloc restrict writable : memref<4x8xf32>
+      %3 = arith.addf %arg4, %2 : tensor<4x8xf32>
+      %4 = arith.addi %arg5, %c32 : index
+      scf.yield %3, %4 : tensor<4x8xf32>, index
+    }
+    return %1#0 : tensor<4x8xf32>
+  }
+}
+
+// CHECK-LABEL:  func.func @strided_rows
+// CHECK:             [[VAR_next_tile_:%.+]] = memref.reinterpret_cast {{.*}} sizes: [4, 8], strides: [1, {{%.+}}]
+// CHECK-DAG:         [[CST_1_:%.+]] = arith.constant 1 : index
+// CHECK:             scf.for [[I_:%.+]] = {{.*}} step [[CST_1_]] {
+// CHECK-DAG:           [[CST_8_:%.+]] = arith.constant 8 : index
+// CHECK-DAG:           [[CST_1_1_:%.+]] = arith.constant 1 : index
+// CHECK:               scf.for [[J_:%.+]] = {{.*}} to [[CST_8_]] step [[CST_1_1_]] {
+// CHECK:                 memref.prefetch [[VAR_next_tile_]]{{.}}[[I_]], [[J_]]{{.}}, read, locality<3>, data
+// CHECK:               }
+// CHECK-NOT:           memref.prefetch
+// CHECK:             }
+// CHECK:             memref.copy
+
+// -----
+
+// Loop-invariant tiles and offsets that are not advanced by a loop-invariant
+// amount are not prefetched.
+module {
+  func.func @no_prefetch(%arg0: memref<*xf32>, %arg1: index, %arg2: index) -> tensor<16xf32> {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %reinterpret_cast = memref.reinterpret_cast %arg0 to offset: [%arg2], sizes: [16], strides: [1] : memref<*xf32> to memref<16xf32, strided<[1], offset: ?>>
+    %0 = tensor.empty() : tensor<16xf32>
+    %1:2 = scf.for %arg3 = %c0 to %arg1 step %c1 iter_args(%arg4 = %0, %arg5 = %c1) -> (tensor<16xf32>, index) {
+      %alloc = memref.alloc() : memref<16xf32>
+      memref.copy %reinterpret_cast, %alloc : memref<16xf32, strided<[1], offset: ?>> to memref<16xf32>
+      %2 = bufferization.to_tensor %alloc restrict writable : memref<16xf32>
+      %reinterpret_cast_0 = memref.reinterpret_cast %arg0 to offset: [%arg5], sizes: [16], strides: [1] : memref<*xf32> to memref<16xf32, strided<[1], offset: ?>>
+      %alloc_1 = memref.alloc() : memref<16xf32>
+      memref.copy %reinterpret_cast_0, %alloc_1 : memref<16xf32, strided<[1], offset: ?>> to memref<16xf32>
+      %3 = bufferization.to_tensor %alloc_1 restrict writable : memref<16xf32>
+      %4 = arith.addf %2, %3 : tensor<16xf32>
+      %5 = arith.addf %arg4, %4 : tensor<16xf32>
+      %6 = arith.muli %arg5, %arg5 : index
+      scf.yield %5, %6 : tensor<16xf32>, index
+    }
+    return %1#0 : tensor<16xf32>
+  }
+}
+
+// CHECK-LABEL:  func.func @no_prefetch
+// CHECK-NOT:       memref.prefetch
+// CHECK:           return
@@ -0,0 +1,76 @@
+// RUN: triton-shared-opt --split-input-file --promote-allocs-to-stack %s | FileCheck %s
+
+module {
+  func.func @loop_temporaries(%arg0: memref<128x64xf32>, %arg1: memref<128xf32>, %arg2: i32) {
+    %c0 = arith.constant 0 : i32
+    %c1 = arith.constant 1 : i32
+    scf.for %i = %c0 to %arg2 step %c1 : i32 {
+      %alloc = memref.alloc() {alignment = 64 : i64} : memref<128x64xf32>
+      memref.copy %arg0, %alloc : memref<128x64xf32> to memref<128x64xf32>
+      %alloc_0 = memref.alloc() : memref<128xf32>
+      linalg.reduce ins(%alloc : memref<128x64xf32>) outs(%alloc_0 : memref<128xf32>) dimensions = [1]
+        (%in: f32, %init: f32) {
+          %0 = arith.addf %in, %init : f32
+          linalg.yield %0 : f32
+        }
+      memref.copy %alloc_0, %arg1 : memref<128xf32> to memref<128xf32>
+      memref.dealloc %alloc_0 : memref<128xf32>
+    }
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @loop_temporaries
+// CHECK-NEXT:     [[VAR_alloca_:%.+]] = memref.alloca() {alignment = 64 : i64} : memref<128x64xf32>
+// CHECK-NEXT:     [[VAR_alloca_0_:%.+]] = memref.alloca() : memref<128xf32>
+// CHECK:          scf.for
+// CHECK:            memref.copy {{.*}}, [[VAR_alloca_]]
+// CHECK:            linalg.reduce ins([[VAR_alloca_]] : memref<128x64xf32>) outs([[VAR_alloca_0_]] : memref<128xf32>)
+// CHECK:            memref.copy [[VAR_alloca_0_]]
+// CHECK-NOT:        memref.alloc()
+// CHECK-NOT:        memref.dealloc
+
+// -----
+
+module {
+  func.func @kept_on_heap(%arg0: index) -> memref<4xf32> {
+    // Too large for the default threshold.
+    %large = memref.alloc() : memref<256x256xf32>
+    // Dynamically shaped.
+    %dynamic = memref.alloc(%arg0) : memref<?xf32>
+    // Passed to a call.
+    %called = memref.alloc() : memref<16xf32>
+    %cast = memref.cast %called : memref<16xf32> to memref<?xf32>
+    func.call @use(%cast) : (memref<?xf32>) -> ()
+    // Returned through a view.
+    %returned = memref.alloc() : memref<2x2xf32>
+    %collapsed = memref.collapse_shape %returned [[0, 1]] : memref<2x2xf32> into memref<4xf32>
+    return %collapsed : memref<4xf32>
+  }
+  func.func private @use(memref<?xf32>)
+}
+
+// CHECK-LABEL:  func.func @kept_on_heap
+// CHECK-NOT:      memref.alloca
+// CHECK:          memref.alloc() : memref<256x256xf32>
+// CHECK:          memref.alloc({{.*}}) : memref<?xf32>
+// CHECK:          memref.alloc() : memref<16xf32>
+// CHECK:          memref.alloc() : memref<2x2xf32>
+
+// -----
+
+module {
+  func.func @parallel_loop(%arg0: index) {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    scf.parallel (%i) = (%c0) to (%arg0) step (%c1) {
+      %alloc = memref.alloc() : memref<8xf32>
+      scf.reduce
+    }
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @parallel_loop
+// CHECK-NOT:      memref.alloca
+// CHECK:          memref.alloc() : memref<8xf32>
@@ -0,0 +1,35 @@
+// RUN: triton-shared-opt --split-input-file --promote-half-args %s | FileCheck %s
+
+module {
+  func.func @kernel(%arg0: memref<*xf16>, %arg1: f16, %arg2: bf16, %arg3: f32, %arg4: i32) {
+    %c0 = arith.constant 0 : index
+    %0 = memref.reinterpret_cast %arg0 to offset: [0], sizes: [1], strides: [1] : memref<*xf16> to memref<1xf16>
+    %1 = arith.truncf %arg3 : f32 to bf16
+    %2 = arith.addf %arg2, %1 : bf16
+    %3 = arith.extf %2 : bf16 to f32
+    %4 = arith.truncf %3 : f32 to f16
+    %5 = arith.mulf %arg1, %4 : f16
+    memref.store %5, %0[%c0] : memref<1xf16>
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @kernel
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<*xf16>, [[PARAM_1_:%.+]]: f32, [[PARAM_2_:%.+]]: f32, [[PARAM_3_:%.+]]: f32, [[PARAM_4_:%.+]]: i32) {
+// CHECK-DAG:     [[VAR_0_:%.+]] = arith.truncf [[PARAM_1_]] : f32 to f16
+// CHECK-DAG:     [[VAR_1_:%.+]] = arith.truncf [[PARAM_2_]] : f32 to bf16
+// CHECK:         arith.addf [[VAR_1_]], {{%.+}} : bf16
+// CHECK:         arith.mulf [[VAR_0_]], {{%.+}} : f16
+
+// -----
+
+// Private functions keep their signature.
+module {
+  func.func private @helper(%arg0: f16) -> f16 {
+    return %arg0 : f16
+  }
+}
+
+// CHECK:         func.func private @helper([[PARAM_0_:%.+]]: f16) -> f16 {
+// CHECK-NOT:     arith.truncf
+// CHECK:           return [[PARAM_0_]] : f16
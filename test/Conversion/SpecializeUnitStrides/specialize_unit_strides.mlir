@@ -0,0 +1,52 @@
+// RUN: triton-shared-opt --split-input-file --specialize-unit-strides %s | FileCheck %s
+
+module {
+  func.func @scale_rows(%arg0: memref<*xf32>, %arg1: i32, %arg2: i32, %arg3: i32, %arg4: i32, %arg5: i32, %arg6: i32, %arg7: i32, %arg8: i32) {
+    %cst = arith.constant 2.000000e+00 : f32
+    %0 = arith.index_cast %arg1 : i32 to index
+    %1 = arith.index_cast %arg2 : i32 to index
+    %reinterpret_cast = memref.reinterpret_cast %arg0 to offset: [0], sizes: [4, 8], strides: [%0, %1] : memref<*xf32> to memref<4x8xf32, strided<[?, ?]>>
+    linalg.generic {indexing_maps = [affine_map<(d0, d1) -> (d0, d1)>], iterator_types = ["parallel", "parallel"]} outs(%reinterpret_cast : memref<4x8xf32, strided<[?, ?]>>) {
+    ^bb0(%out: f32):
+      %2 = arith.mulf %out, %cst : f32
+      linalg.yield %2 : f32
+    }
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @scale_rows
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<*xf32>, [[PARAM_1_:%.+]]: i32, [[PARAM_2_:%.+]]: i32,
+// CHECK-NOT:      passthrough
+// CHECK:          [[VAR_0_:%.+]] = arith.index_cast [[PARAM_2_]] : i32 to index
+// CHECK:          memref.reinterpret_cast [[PARAM_0_]] to offset: [0], sizes: [4, 8], strides: [{{%.+}}, [[VAR_0_]]] : memref<*xf32> to memref<4x8xf32, strided<[?, ?]>>
+// CHECK:          return
+
+// CHECK-LABEL:  func.func @scale_rows_unitstride
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<*xf32>, [[PARAM_1_:%.+]]: i32, [[PARAM_2_:%.+]]: i32,
+// CHECK-SAME:   passthrough = {{\[}}["triton-shared-unit-stride-args", "2"]]
+// CHECK:          [[VAR_0_:%.+]] = arith.index_cast [[PARAM_1_]] : i32 to index
+// CHECK:          memref.reinterpret_cast [[PARAM_0_]] to offset: [0], sizes: [4, 8], strides: {{\[}}[[VAR_0_]], 1] : memref<*xf32> to memref<4x8xf32, strided<[?, 1]>>
+// CHECK:          return
+
+// -----
+
+// Kernels whose innermost strides are static or computed are left alone.
+module {
+  func.func @computed_stride(%arg0: memref<*xf32>, %arg1: i32, %arg2: i32, %arg3: i32, %arg4: i32, %arg5: i32, %arg6: i32, %arg7: i32) {
+    %c0 = arith.constant 0 : index
+    %cst = arith.constant 0.000000e+00 : f32
+    %c2_i32 = arith.constant 2 : i32
+    %0 = arith.muli %arg1, %c2_i32 : i32
+    %1 = arith.index_cast %0 : i32 to index
+    %reinterpret_cast = memref.reinterpret_cast %arg0 to offset: [0], sizes: [4], strides: [%1] : memref<*xf32> to memref<4xf32, strided<[?]>>
+    memref.store %cst, %reinterpret_cast[%c0] : memref<4xf32, strided<[?]>>
+    %2 = arith.index_cast %arg1 : i32 to index
+    %reinterpret_cast_0 = memref.reinterpret_cast %arg0 to offset: [0], sizes: [4, 4], strides: [%2, 1] : memref<*xf32> to memref<4x4xf32, strided<[?, 1]>>
+    memref.store %cst, %reinterpret_cast_0[%c0, %c0] : memref<4x4xf32, strided<[?, 1]>>
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @computed_stride
+// CHECK-NOT:    func.func @computed_stride_unitstride
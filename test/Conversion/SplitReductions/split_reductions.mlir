@@ -0,0 +1,131 @@
+// RUN: triton-shared-opt --split-input-file --split-reductions="num-accumulators=2 vector-bits=128" %s | FileCheck %s
+
+module {
+  func.func @sum_f32(%arg0: tensor<128xf32>, %arg1: tensor<f32>) -> tensor<f32> {
+    %reduced = linalg.reduce ins(%arg0 : tensor<128xf32>) outs(%arg1 : tensor<f32>) dimensions = [0]
+      (%in: f32, %init: f32) {
+        %0 = arith.addf %in, %init : f32
+        linalg.yield %0 : f32
+      }
+    return %reduced : tensor<f32>
+  }
+}
+
+// CHECK-LABEL:  func.func @sum_f32
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: tensor<128xf32>, [[PARAM_1_:%.+]]: tensor<f32>) -> tensor<f32> {
+// CHECK-DAG:       [[VAR_expanded_:%.+]] = tensor.expand_shape [[PARAM_0_]] {{\[\[}}0, 1{{\]\]}} {{.*}}: tensor<128xf32> into tensor<16x8xf32>
+// CHECK-DAG:       [[CST_0_:%.+]] = arith.constant {{-?}}0.000000e+00 : f32
+// CHECK-DAG:       [[VAR_0_:%.+]] = tensor.empty() : tensor<8xf32>
+// CHECK:           [[VAR_1_:%.+]] = linalg.fill ins([[CST_0_]] : f32) outs([[VAR_0_]] : tensor<8xf32>) -> tensor<8xf32>
+// CHECK:           [[VAR_reduced_:%.+]] = linalg.reduce ins([[VAR_expanded_]] : tensor<16x8xf32>) outs([[VAR_1_]] : tensor<8xf32>) dimensions = [0]
+// CHECK:             ([[in_:%.+]]: f32, [[init_:%.+]]: f32) {
+// CHECK:               [[VAR_2_:%.+]] = arith.addf [[in_]], [[init_]] : f32
+// CHECK:               linalg.yield [[VAR_2_]] : f32
+// CHECK:             }
+// CHECK:           [[VAR_reduced_0_:%.+]] = linalg.reduce ins([[VAR_reduced_]] : tensor<8xf32>) outs([[PARAM_1_]] : tensor<f32>) dimensions = [0]
+// CHECK:             ([[in_0_:%.+]]: f32, [[init_0_:%.+]]: f32) {
+// CHECK:               [[VAR_3_:%.+]] = arith.addf [[in_0_]], [[init_0_]] : f32
+// CHECK:               linalg.yield [[VAR_3_]] : f32
+// CHECK:             }
+// CHECK:           return [[VAR_reduced_0_]] : tensor<f32>
+
+// -----
+
+// bf16 elements accumulated in f32: 12 rows of 8 lanes, the last 4 elements
+// go into the accumulator before the partial results.
+module {
+  func.func @sum_bf16_tail(%arg0: tensor<100xbf16>, %arg1: tensor<f32>) -> tensor<f32> {
+    %reduced = linalg.reduce ins(%arg0 : tensor<100xbf16>) outs(%arg1 : tensor<f32>) dimensions = [0]
+      (%in: bf16, %init: f32) {
+        %0 = arith.extf %in : bf16 to f32
+        %1 = arith.addf %0, %init : f32
+        linalg.yield %1 : f32
+      }
+    return %reduced : tensor<f32>
+  }
+}
+
+// CHECK-LABEL:  func.func @sum_bf16_tail
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: tensor<100xbf16>, [[PARAM_1_:%.+]]: tensor<f32>) -> tensor<f32> {
+// CHECK:           [[VAR_head_:%.+]] = tensor.extract_slice [[PARAM_0_]][0] [96] [1] : tensor<100xbf16> to tensor<96xbf16>
+// CHECK:           [[VAR_expanded_:%.+]] = tensor.expand_shape [[VAR_head_]] {{.*}}: tensor<96xbf16> into tensor<12x8xbf16>
+// CHECK:           [[VAR_partials_:%.+]] = linalg.reduce ins([[VAR_expanded_]] : tensor<12x8xbf16>) outs({{.*}} : tensor<8xf32>) dimensions = [0]
+// CHECK:               arith.extf
+// CHECK:               arith.addf
+// CHECK:           [[VAR_tail_:%.+]] = tensor.extract_slice [[PARAM_0_]][96] [4] [1] : tensor<100xbf16> to tensor<4xbf16>
+// CHECK:           [[VAR_acc_:%.+]] = linalg.reduce ins([[VAR_tail_]] : tensor<4xbf16>) outs([[PARAM_1_]] : tensor<f32>) dimensions = [0]
+// CHECK:               arith.extf
+// CHECK:               arith.addf
+// CHECK:           [[VAR_result_:%.+]] = linalg.reduce ins([[VAR_partials_]] : tensor<8xf32>) outs([[VAR_acc_]] : tensor<f32>) dimensions = [0]
+// CHECK:             ([[in_:%.+]]: f32, [[init_:%.+]]: f32) {
+// CHECK-NOT:           arith.extf
+// CHECK:               [[VAR_0_:%.+]] = arith.addf [[in_]], [[init_]] : f32
+// CHECK:               linalg.yield [[VAR_0_]] : f32
+// CHECK:             }
+// CHECK:           return [[VAR_result_]] : tensor<f32>
+
+// -----
+
+// Too short for two rows, and a body that is not a plain combiner.
+module {
+  func.func @unchanged(%arg0: tensor<8xf32>, %arg1: tensor<256xf32>, %arg2: tensor<f32>) -> (tensor<f32>, tensor<f32>) {
+    %reduced = linalg.reduce ins(%arg0 : tensor<8xf32>) outs(%arg2 : tensor<f32>) dimensions = [0]
+      (%in: f32, %init: f32) {
+        %0 = arith.addf %in, %init : f32
+        linalg.yield %0 : f32
+      }
+    %reduced_0 = linalg.reduce ins(%arg1 : tensor<256xf32>) outs(%arg2 : tensor<f32>) dimensions = [0]
+      (%in: f32, %init: f32) {
+        %0 = arith.mulf %in, %in : f32
+        %1 = arith.addf %0, %init : f32
+        linalg.yield %1 : f32
+      }
+    return %reduced, %reduced_0 : tensor<f32>, tensor<f32>
+  }
+}
+
+// CHECK-LABEL:  func.func @unchanged
+// CHECK-NOT:       tensor.expand_shape
+// CHECK:           linalg.reduce ins({{.*}} : tensor<8xf32>)
+// CHECK-NOT:       tensor.expand_shape
+// CHECK:           linalg.reduce ins({{.*}} : tensor<256xf32>)
+// CHECK-NOT:       linalg.reduce
+
+// -----
+
+// argmax: every lane tracks a value and an index, the lanes are combined with
+// the same lowest-index tie-break.
+module {
+  func.func @argmax(%arg0: tensor<64xf32>, %arg1: tensor<64xi32>, %arg2: tensor<f32>, %arg3: tensor<i32>) -> (tensor<f32>, tensor<i32>) {
+    %reduced:2 = linalg.reduce ins(%arg0, %arg1 : tensor<64xf32>, tensor<64xi32>) outs(%arg2, %arg3 : tensor<f32>, tensor<i32>) dimensions = [0]
+      (%in: f32, %in_0: i32, %init: f32, %init_1: i32) {
+        %0 = arith.cmpf oeq, %in, %init : f32
+        %1 = arith.cmpi slt, %in_0, %init_1 : i32
+        %2 = arith.andi %0, %1 : i1
+        %3 = arith.cmpf ogt, %in, %init : f32
+        %4 = arith.ori %3, %2 : i1
+        %5 = arith.select %4, %in, %init : f32
+        %6 = arith.select %4, %in_0, %init_1 : i32
+        linalg.yield %5, %6 : f32, i32
+      }
+    return %reduced#0, %reduced#1 : tensor<f32>, tensor<i32>
+  }
+}
+
+// CHECK-LABEL:  func.func @argmax
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: tensor<64xf32>, [[PARAM_1_:%.+]]: tensor<64xi32>, [[PARAM_2_:%.+]]: tensor<f32>, [[PARAM_3_:%.+]]: tensor<i32>) -> (tensor<f32>, tensor<i32>) {
+// CHECK-DAG:       [[VAR_values_:%.+]] = tensor.expand_shape [[PARAM_0_]] {{.*}}: tensor<64xf32> into tensor<8x8xf32>
+// CHECK-DAG:       [[VAR_indices_:%.+]] = tensor.expand_shape [[PARAM_1_]] {{.*}}: tensor<64xi32> into tensor<8x8xi32>
+// CHECK-DAG:       [[VAR_init_value_:%.+]] = tensor.extract [[PARAM_2_]][] : tensor<f32>
+// CHECK-DAG:       [[VAR_init_index_:%.+]] = tensor.extract [[PARAM_3_]][] : tensor<i32>
+// CHECK-DAG:       [[VAR_lane_values_:%.+]] = linalg.fill ins([[VAR_init_value_]] : f32) outs({{.*}} : tensor<8xf32>) -> tensor<8xf32>
+// CHECK-DAG:       [[VAR_lane_indices_:%.+]] = linalg.fill ins([[VAR_init_index_]] : i32) outs({{.*}} : tensor<8xi32>) -> tensor<8xi32>
+// CHECK:           [[VAR_partials_:%.+]]:2 = linalg.reduce ins([[VAR_values_]], [[VAR_indices_]] : tensor<8x8xf32>, tensor<8x8xi32>) outs([[VAR_lane_values_]], [[VAR_lane_indices_]] : tensor<8xf32>, tensor<8xi32>) dimensions = [0]
+// CHECK:               arith.cmpf ogt
+// CHECK:               arith.select
+// CHECK:               arith.select
+// CHECK:           [[VAR_result_:%.+]]:2 = linalg.reduce ins([[VAR_partials_]]#0, [[VAR_partials_]]#1 : tensor<8xf32>, tensor<8xi32>) outs([[PARAM_2_]], [[PARAM_3_]] : tensor<f32>, tensor<i32>) dimensions = [0]
+// CHECK:               arith.cmpf oeq
+// CHECK:               arith.cmpi slt
+// CHECK:               arith.cmpf ogt
+// CHECK:           return [[VAR_result_]]#0, [[VAR_result_]]#1 : tensor<f32>, tensor<i32>
@@ -0,0 +1,90 @@
+// RUN: triton-shared-opt --split-input-file --triton-to-linalg-experimental %s | FileCheck %s
+
+// Histogram: bins[idx[i]] += 1 for i < n. The result is unused, each element
+// is a single masked memref.atomic_rmw.
+module {
+  tt.func @histogram(%arg0 : !tt.ptr<i32>, %arg1 : !tt.ptr<f32>, %arg2 : i32) {
+    %0 = tt.make_range {end = 64 : i32, start = 0 : i32}:tensor<64xi32>
+    %1 = tt.splat %arg2 : i32 -> tensor<64xi32>
+    %2 = arith.cmpi slt, %0, %1 : tensor<64xi32>
+    %3 = tt.splat %arg0 : !tt.ptr<i32> -> tensor<64x!tt.ptr<i32>>
+    %4 = tt.addptr %3, %0 : tensor<64x!tt.ptr<i32>>, tensor<64xi32>
+    %idx = tt.load %4, %2 : tensor<64x!tt.ptr<i32>>
+    %ones = arith.constant dense<1.000000e+00> : tensor<64xf32>
+    %5 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<64x!tt.ptr<f32>>
+    %6 = tt.addptr %5, %idx : tensor<64x!tt.ptr<f32>>, tensor<64xi32>
+    %7 = tt.atomic_rmw fadd, acq_rel, gpu, %6, %ones, %2 : (tensor<64x!tt.ptr<f32>>, tensor<64xf32>, tensor<64xi1>) -> tensor<64xf32>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:  func.func @histogram
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<*xi32>, [[PARAM_1_:%.+]]: memref<*xf32>, [[PARAM_2_:%.+]]: i32
+// CHECK:           scf.for [[I_:%.+]] =
+// CHECK:             [[VAR_idx_:%.+]] = arith.index_cast {{.*}} : i32 to index
+// CHECK:             [[VAR_extent_:%.+]] = arith.addi [[VAR_idx_]], {{.*}} : index
+// CHECK:             [[VAR_bins_:%.+]] = memref.reinterpret_cast [[PARAM_1_]] to offset: [0], sizes: {{.}}[[VAR_extent_]]{{.}}, strides: [1] : memref<*xf32> to memref<?xf32, strided<[1]>>
+// CHECK:             scf.if {{.*}} {
+// CHECK:               {{.*}} = memref.atomic_rmw addf {{.*}}, [[VAR_bins_]]{{.}}[[VAR_idx_]]{{.}} : (f32, memref<?xf32, strided<[1]>>) -> f32
+// CHECK:             }
+// CHECK-NOT:       tts.
+// CHECK:           return
+
+// -----
+
+// The old values of a 2-D unmasked atomic max and of an xor, which has no
+// atomicrmw counterpart and goes through a compare-and-swap loop.
+module {
+  tt.func @rmw_results(%arg0 : !tt.ptr<i32>, %arg1 : !tt.ptr<i32>) {
+    %0 = tt.make_range {end = 4 : i32, start = 0 : i32}:tensor<4xi32>
+    %1 = tt.expand_dims %0 {axis = 1 : i32} : tensor<4xi32> -> tensor<4x1xi32>
+    %2 = tt.broadcast %1 : tensor<4x1xi32> -> tensor<4x4xi32>
+    %3 = tt.splat %arg0 : !tt.ptr<i32> -> tensor<4x4x!tt.ptr<i32>>
+    %4 = tt.addptr %3, %2 : tensor<4x4x!tt.ptr<i32>>, tensor<4x4xi32>
+    %true = arith.constant dense<true> : tensor<4x4xi1>
+    %5 = tt.atomic_rmw max, acq_rel, gpu, %4, %2, %true : (tensor<4x4x!tt.ptr<i32>>, tensor<4x4xi32>, tensor<4x4xi1>) -> tensor<4x4xi32>
+    %6 = tt.atomic_rmw xor, acq_rel, gpu, %4, %5, %true : (tensor<4x4x!tt.ptr<i32>>, tensor<4x4xi32>, tensor<4x4xi1>) -> tensor<4x4xi32>
+    %7 = tt.splat %arg1 : !tt.ptr<i32> -> tensor<4x4x!tt.ptr<i32>>
+    %8 = tt.addptr %7, %2 : tensor<4x4x!tt.ptr<i32>>, tensor<4x4xi32>
+    tt.store %8, %6 : tensor<4x4x!tt.ptr<i32>>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:  func.func @rmw_results
+// CHECK:           [[VAR_max_:%.+]] = scf.for {{.*}} -> (tensor<16xi32>) {
+// CHECK-NOT:         scf.if
+// CHECK:             [[VAR_old_:%.+]] = memref.atomic_rmw maxs
+// CHECK:             tensor.insert [[VAR_old_]]
+// CHECK:           tensor.expand_shape [[VAR_max_]] {{.*}} : tensor<16xi32> into tensor<4x4xi32>
+// CHECK:           scf.for {{.*}} -> (tensor<16xi32>) {
+// CHECK:             memref.generic_atomic_rmw
+// CHECK:             ^bb0([[CUR_:%.+]]: i32):
+// CHECK:               [[VAR_xor_:%.+]] = arith.xori [[CUR_]], {{.*}} : i32
+// CHECK:               memref.atomic_yield [[VAR_xor_]] : i32
+// CHECK-NOT:       tts.
+// CHECK:           return
+
+// -----
+
+// Compare-and-swap on a scalar pointer, e.g. a spin lock.
+module {
+  tt.func @lock(%arg0 : !tt.ptr<i32>, %arg1 : !tt.ptr<f32>, %arg2 : f32) {
+    %c0 = arith.constant 0 : i32
+    %c1 = arith.constant 1 : i32
+    %0 = tt.atomic_cas acq_rel, gpu, %arg0, %c0, %c1 : (!tt.ptr<i32>, i32, i32) -> i32
+    %true = arith.constant true
+    %1 = tt.atomic_rmw fadd, relaxed, gpu, %arg1, %arg2, %true : (!tt.ptr<f32>, f32, i1) -> f32
+    tt.return
+  }
+}
+
+// CHECK-LABEL:  func.func @lock
+// CHECK:           memref.generic_atomic_rmw
+// CHECK:             ^bb0([[CUR_:%.+]]: i32):
+// CHECK:               [[VAR_eq_:%.+]] = arith.cmpi eq, [[CUR_]], {{.*}} : i32
+// CHECK:               [[VAR_new_:%.+]] = arith.select [[VAR_eq_]], {{.*}}, [[CUR_]] : i32
+// CHECK:               memref.atomic_yield [[VAR_new_]] : i32
+// CHECK:           memref.atomic_rmw addf
+// CHECK-NOT:       tt.atomic
+// CHECK:           return
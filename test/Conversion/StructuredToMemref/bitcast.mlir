@@ -38,6 +38,6 @@ module {
 // CHECK:             [[VAR_3_:%.+]] = arith.bitcast [[IN_0_]] : i32 to f32
 // CHECK:             linalg.yield [[VAR_3_]] : f32
 // CHECK:           } -> tensor<1024xf32>
-// CHECK:           bufferization.materialize_in_destination [[VAR_2_]] in writable [[VAR_reinterpret_cast_0_]] : (tensor<1024xf32>, memref<1024xf32, strided<[1]>>) -> ()
+// CHECK:           bufferization.materialize_in_destination [[VAR_2_]] in restrict writable [[VAR_reinterpret_cast_0_]] : (tensor<1024xf32>, memref<1024xf32, strided<[1]>>) -> ()
 // CHECK:           return
 // CHECK:         }
@@ -61,6 +61,6 @@ module {
 // CHECK:             [[VAR_7_:%.+]] = arith.fptosi [[IN_0_]] : f32 to i32
 // CHECK:             linalg.yield [[VAR_7_]] : i32
 // CHECK:           } -> tensor<4096xi32>
-// CHECK:           bufferization.materialize_in_destination [[VAR_6_]] in writable [[VAR_reinterpret_cast_0_]] : (tensor<4096xi32>, memref<4096xi32, strided<[1], offset: ?>>) -> ()
+// CHECK:           bufferization.materialize_in_destination [[VAR_6_]] in restrict writable [[VAR_reinterpret_cast_0_]] : (tensor<4096xi32>, memref<4096xi32, strided<[1], offset: ?>>) -> ()
 // CHECK:           return
 // CHECK:         }
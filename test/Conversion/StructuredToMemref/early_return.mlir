@@ -66,6 +66,6 @@ module {
 // CHECK:             [[VAR_9_2_:%.+]] = arith.sitofp [[IN_4_]] : i32 to f32
 // CHECK:             linalg.yield [[VAR_9_2_]] : f32
 // CHECK:           } -> tensor<4xf32>
-// CHECK:           bufferization.materialize_in_destination [[VAR_8_]] in writable [[VAR_reinterpret_cast_0_]] : (tensor<4xf32>, memref<4xf32, strided<[1]>>) -> ()
+// CHECK:           bufferization.materialize_in_destination [[VAR_8_]] in restrict writable [[VAR_reinterpret_cast_0_]] : (tensor<4xf32>, memref<4xf32, strided<[1]>>) -> ()
 // CHECK:           return
 // CHECK:         }
@@ -0,0 +1,143 @@
+// RUN: triton-shared-opt --split-input-file --triton-to-linalg-experimental="enable-elementwise-fusion=true" %s | FileCheck %s
+
+module {
+  tt.func public @softmax_kernel_012345(%arg0: !tt.ptr<f32>, %arg1: !tt.ptr<f32>, %arg2: i32, %arg3: i32, %arg4: i32) {
+    %cst = arith.constant 0xFF800000 : f32
+    %0 = tt.get_program_id x : i32
+    %1 = arith.muli %0, %arg2 : i32
+    %2 = tt.addptr %arg1, %1 : !tt.ptr<f32>, i32
+    %3 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+    %4 = tt.splat %2 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %5 = tt.addptr %4, %3 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %6 = tt.splat %arg4 : i32 -> tensor<128xi32>
+    %7 = arith.cmpi slt, %3, %6 : tensor<128xi32>
+    %8 = tt.splat %cst : f32 -> tensor<128xf32>
+    %9 = tt.load %5, %7, %8 : tensor<128x!tt.ptr<f32>>
+    %10 = "tt.reduce"(%9) ({
+    ^bb0(%arg5: f32, %arg6: f32):
+      %21 = arith.maxnumf %arg5, %arg6 : f32
+      tt.reduce.return %21 : f32
+    }) {axis = 0 : i32} : (tensor<128xf32>) -> f32
+    %11 = tt.splat %10 : f32 -> tensor<128xf32>
+    %12 = arith.subf %9, %11 : tensor<128xf32>
+    %13 = math.exp %12 : tensor<128xf32>
+    %14 = "tt.reduce"(%13) ({
+    ^bb0(%arg5: f32, %arg6: f32):
+      %21 = arith.addf %arg5, %arg6 : f32
+      tt.reduce.return %21 : f32
+    }) {axis = 0 : i32} : (tensor<128xf32>) -> f32
+    %15 = tt.splat %14 : f32 -> tensor<128xf32>
+    %16 = arith.divf %13, %15 : tensor<128xf32>
+    %17 = arith.muli %0, %arg3 : i32
+    %18 = tt.addptr %arg0, %17 : !tt.ptr<f32>, i32
+    %19 = tt.splat %18 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %20 = tt.addptr %19, %3 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    tt.store %20, %16, %7 : tensor<128x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// x - max and exp run in one loop nest, the splats of the reduction results
+// are folded into the loop bodies. exp(x - max) feeds both the sum and the
+// division, so it is not recomputed in the division.
+// CHECK-LABEL:  func.func @softmax_kernel_012345
+// CHECK:           linalg.reduce
+// CHECK:           [[VAR_max_:%.+]] = tensor.extract
+// CHECK:           [[VAR_exp_:%.+]] = linalg.generic {{.*}} ins({{.*}} : tensor<128xf32>) outs({{.*}} : tensor<128xf32>)
+// CHECK:             [[VAR_sub_:%.+]] = arith.subf {{.*}}, [[VAR_max_]] : f32
+// CHECK:             [[VAR_e_:%.+]] = math.exp [[VAR_sub_]] : f32
+// CHECK:             linalg.yield [[VAR_e_]] : f32
+// CHECK:           linalg.reduce ins([[VAR_exp_]] : tensor<128xf32>)
+// CHECK:           [[VAR_sum_:%.+]] = tensor.extract
+// CHECK:           linalg.generic {{.*}} ins([[VAR_exp_]] : tensor<128xf32>) outs({{.*}} : tensor<128xf32>)
+// CHECK:             arith.divf {{.*}}, [[VAR_sum_]] : f32
+// CHECK-NOT:       linalg.generic
+// CHECK:           return
+
+// -----
+
+// A broadcast is duplicated into each of its consumers rather than
+// materialized.
+module {
+  tt.func public @broadcast_two_uses(%arg0: tensor<16x1xf32>, %arg1: tensor<16x32xf32>, %arg2: tensor<16x32xf32>) -> (tensor<16x32xf32>, tensor<16x32xf32>) {
+    %0 = tt.broadcast %arg0 : tensor<16x1xf32> -> tensor<16x32xf32>
+    %1 = arith.subf %arg1, %0 : tensor<16x32xf32>
+    %2 = arith.mulf %arg2, %0 : tensor<16x32xf32>
+    tt.return %1, %2 : tensor<16x32xf32>, tensor<16x32xf32>
+  }
+}
+
+// CHECK-LABEL:  func.func @broadcast_two_uses
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: tensor<16x1xf32>, [[PARAM_1_:%.+]]: tensor<16x32xf32>, [[PARAM_2_:%.+]]: tensor<16x32xf32>, {{.*}})
+// CHECK-NOT:       linalg.generic {{.*}} ins([[PARAM_0_]] : tensor<16x1xf32>)
+// CHECK:           linalg.generic {{.*}} ins([[PARAM_1_]], [[PARAM_0_]] : tensor<16x32xf32>, tensor<16x1xf32>)
+// CHECK:             arith.subf
+// CHECK:           linalg.generic {{.*}} ins([[PARAM_2_]], [[PARAM_0_]] : tensor<16x32xf32>, tensor<16x1xf32>)
+// CHECK:             arith.mulf
+// CHECK-NOT:       linalg.generic
+// CHECK:           return
+
+// -----
+
+// The transpose of a tensor argument becomes a permuted indexing map of the
+// add.
+module {
+  tt.func public @transpose_add(%arg0: tensor<32x16xf32>, %arg1: tensor<16x32xf32>) -> tensor<16x32xf32> {
+    %0 = tt.trans %arg0 {order = array<i32: 1, 0>} : tensor<32x16xf32> -> tensor<16x32xf32>
+    %1 = arith.addf %arg1, %0 : tensor<16x32xf32>
+    tt.return %1 : tensor<16x32xf32>
+  }
+}
+
+// CHECK-DAG:   [[MAP_ID_:#.+]] = affine_map<(d0, d1) -> (d0, d1)>
+// CHECK-DAG:   [[MAP_T_:#.+]] = affine_map<(d0, d1) -> (d1, d0)>
+// CHECK-LABEL:  func.func @transpose_add
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: tensor<32x16xf32>, [[PARAM_1_:%.+]]: tensor<16x32xf32>, {{.*}})
+// CHECK-NOT:       linalg.transpose
+// CHECK:           linalg.generic {indexing_maps = {{\[}}[[MAP_ID_]], [[MAP_T_]], [[MAP_ID_]]{{\]}}, iterator_types = ["parallel", "parallel"]} ins([[PARAM_1_]], [[PARAM_0_]] : tensor<16x32xf32>, tensor<32x16xf32>)
+// CHECK:             arith.addf
+// CHECK-NOT:       linalg.generic
+// CHECK:           return
+
+// -----
+
+// A loaded tile that is transposed is copied through a transposed view of the
+// kernel argument instead of into a buffer that is then transposed.
+module {
+  tt.func public @transposed_load(%arg0: !tt.ptr<f32>, %arg1: !tt.ptr<f32>) {
+    %cst = arith.constant dense<32> : tensor<16x1xi32>
+    %cst_0 = arith.constant dense<16> : tensor<32x1xi32>
+    %0 = tt.make_range {end = 16 : i32, start = 0 : i32} : tensor<16xi32>
+    %1 = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32>
+    %2 = tt.expand_dims %0 {axis = 1 : i32} : tensor<16xi32> -> tensor<16x1xi32>
+    %3 = arith.muli %2, %cst : tensor<16x1xi32>
+    %4 = tt.expand_dims %1 {axis = 0 : i32} : tensor<32xi32> -> tensor<1x32xi32>
+    %5 = tt.broadcast %3 : tensor<16x1xi32> -> tensor<16x32xi32>
+    %6 = tt.broadcast %4 : tensor<1x32xi32> -> tensor<16x32xi32>
+    %7 = arith.addi %5, %6 : tensor<16x32xi32>
+    %8 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<16x32x!tt.ptr<f32>>
+    %9 = tt.addptr %8, %7 : tensor<16x32x!tt.ptr<f32>>, tensor<16x32xi32>
+    %10 = tt.load %9 : tensor<16x32x!tt.ptr<f32>>
+    %11 = tt.trans %10 {order = array<i32: 1, 0>} : tensor<16x32xf32> -> tensor<32x16xf32>
+    %12 = tt.expand_dims %1 {axis = 1 : i32} : tensor<32xi32> -> tensor<32x1xi32>
+    %13 = arith.muli %12, %cst_0 : tensor<32x1xi32>
+    %14 = tt.expand_dims %0 {axis = 0 : i32} : tensor<16xi32> -> tensor<1x16xi32>
+    %15 = tt.broadcast %13 : tensor<32x1xi32> -> tensor<32x16xi32>
+    %16 = tt.broadcast %14 : tensor<1x16xi32> -> tensor<32x16xi32>
+    %17 = arith.addi %15, %16 : tensor<32x16xi32>
+    %18 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<32x16x!tt.ptr<f32>>
+    %19 = tt.addptr %18, %17 : tensor<32x16x!tt.ptr<f32>>, tensor<32x16xi32>
+    tt.store %19, %11 : tensor<32x16x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:  func.func @transposed_load
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<*xf32>, [[PARAM_1_:%.+]]: memref<*xf32>, {{.*}})
+// CHECK-DAG:       [[VAR_src_:%.+]] = memref.reinterpret_cast [[PARAM_0_]] to {{.*}}sizes: [16, 32], strides: [32, 1]
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc() : memref<32x16xf32>
+// CHECK:           [[VAR_view_:%.+]] = memref.transpose [[VAR_src_]] (d0, d1) -> (d1, d0)
+// CHECK:           memref.copy [[VAR_view_]], [[RES_]]
+// CHECK:           [[VAR_tile_:%.+]] = bufferization.to_tensor [[RES_]] restrict writable
+// CHECK-NOT:       linalg.transpose
+// CHECK:           bufferization.materialize_in_destination [[VAR_tile_]]
@@ -0,0 +1,81 @@
+// RUN: triton-shared-opt --split-input-file --triton-to-linalg-experimental %s | FileCheck %s
+
+// Indirect 1-D load and store: out[idx[i]] = in[idx[i]] for i < n.
+module {
+  tt.func @kernel(%arg0 : !tt.ptr<i32>, %arg1 : !tt.ptr<f32>, %arg2 : !tt.ptr<f32>, %arg3 : i32) {
+    %0 = tt.make_range {end = 64 : i32, start = 0 : i32}:tensor<64xi32>
+    %1 = tt.splat %arg3 : i32 -> tensor<64xi32>
+    %2 = arith.cmpi slt, %0, %1 : tensor<64xi32>
+    %3 = tt.splat %arg0 : !tt.ptr<i32> -> tensor<64x!tt.ptr<i32>>
+    %4 = tt.addptr %3, %0 : tensor<64x!tt.ptr<i32>>, tensor<64xi32>
+    %idx = tt.load %4, %2 : tensor<64x!tt.ptr<i32>>
+    %cst = arith.constant dense<0.000000e+00> : tensor<64xf32>
+    %5 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<64x!tt.ptr<f32>>
+    %6 = tt.addptr %5, %idx : tensor<64x!tt.ptr<f32>>, tensor<64xi32>
+    %7 = tt.load %6, %2, %cst : tensor<64x!tt.ptr<f32>>
+    %8 = tt.splat %arg2 : !tt.ptr<f32> -> tensor<64x!tt.ptr<f32>>
+    %9 = tt.addptr %8, %idx : tensor<64x!tt.ptr<f32>>, tensor<64xi32>
+    tt.store %9, %7, %2 : tensor<64x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:  func.func @kernel
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<*xi32>, [[PARAM_1_:%.+]]: memref<*xf32>, [[PARAM_2_:%.+]]: memref<*xf32>, [[PARAM_3_:%.+]]: i32
+// CHECK:           [[VAR_gather_:%.+]] = scf.for [[I_:%.+]] = {{.*}} iter_args([[ACC_:%.+]] = {{.*}}) -> (tensor<64xf32>) {
+// CHECK-DAG:         [[VAR_idx_:%.+]] = vector.transfer_read {{.*}}{{.}}[[I_]]{{.}}, {{.*}} {in_bounds = [true]} : tensor<64xi32>, vector<16xi32>
+// CHECK-DAG:         [[VAR_max_:%.+]] = vector.reduction <maxsi>, [[VAR_idx_]] : vector<16xi32> into i32
+// CHECK-DAG:         [[VAR_mask_:%.+]] = vector.transfer_read {{.*}}{{.}}[[I_]]{{.}}, {{.*}} {in_bounds = [true]} : tensor<64xi1>, vector<16xi1>
+// CHECK:             [[VAR_in_:%.+]] = memref.reinterpret_cast [[PARAM_1_]] to offset: [0], sizes: {{.}}{{%.+}}{{.}}, strides: [1] : memref<*xf32> to memref<?xf32, strided<[1]>>
+// CHECK:             [[VAR_val_:%.+]] = vector.gather [[VAR_in_]]{{.}}{{.*}}{{.}} {{.}}[[VAR_idx_]]{{.}}, [[VAR_mask_]], {{.*}} : memref<?xf32, strided<[1]>>, vector<16xi32>, vector<16xi1>, vector<16xf32> into vector<16xf32>
+// CHECK:             vector.transfer_write [[VAR_val_]], [[ACC_]]{{.}}[[I_]]{{.}} {in_bounds = [true]} : vector<16xf32>, tensor<64xf32>
+// CHECK:           scf.for [[J_:%.+]] =
+// CHECK:             [[VAR_out_:%.+]] = memref.reinterpret_cast [[PARAM_2_]] to offset: [0], sizes: {{.}}{{%.+}}{{.}}, strides: [1] : memref<*xf32> to memref<?xf32, strided<[1]>>
+// CHECK:             vector.scatter [[VAR_out_]]{{.}}{{.*}}{{.}} {{.}}{{.*}}{{.}}, {{.*}}, {{.*}} : memref<?xf32, strided<[1]>>, vector<16xi32>, vector<16xi1>, vector<16xf32>
+// CHECK-NOT:       tts.
+// CHECK:           return
+
+// -----
+
+// Embedding lookup: out[i, :] = table[ids[i] * 32 + :] with the table pointer
+// offset by a scalar, gathered as a single 8x32 tensor.
+module {
+  tt.func @embedding(%arg0 : !tt.ptr<i64>, %arg1 : !tt.ptr<bf16>, %arg2 : !tt.ptr<bf16>, %arg3 : i32) {
+    %0 = tt.make_range {end = 8 : i32, start = 0 : i32}:tensor<8xi32>
+    %1 = tt.splat %arg0 : !tt.ptr<i64> -> tensor<8x!tt.ptr<i64>>
+    %2 = tt.addptr %1, %0 : tensor<8x!tt.ptr<i64>>, tensor<8xi32>
+    %ids = tt.load %2 : tensor<8x!tt.ptr<i64>>
+    %c32 = arith.constant dense<32> : tensor<8xi64>
+    %3 = arith.muli %ids, %c32 : tensor<8xi64>
+    %4 = tt.expand_dims %3 {axis = 1 : i32} : tensor<8xi64> -> tensor<8x1xi64>
+    %5 = tt.broadcast %4 : tensor<8x1xi64> -> tensor<8x32xi64>
+    %6 = tt.make_range {end = 32 : i32, start = 0 : i32}:tensor<32xi32>
+    %7 = tt.expand_dims %6 {axis = 0 : i32} : tensor<32xi32> -> tensor<1x32xi32>
+    %8 = tt.broadcast %7 : tensor<1x32xi32> -> tensor<8x32xi32>
+    %table = tt.addptr %arg1, %arg3 : !tt.ptr<bf16>, i32
+    %9 = tt.splat %table : !tt.ptr<bf16> -> tensor<8x32x!tt.ptr<bf16>>
+    %10 = tt.addptr %9, %5 : tensor<8x32x!tt.ptr<bf16>>, tensor<8x32xi64>
+    %11 = tt.addptr %10, %8 : tensor<8x32x!tt.ptr<bf16>>, tensor<8x32xi32>
+    %12 = tt.load %11 : tensor<8x32x!tt.ptr<bf16>>
+    %13 = tt.expand_dims %0 {axis = 1 : i32} : tensor<8xi32> -> tensor<8x1xi32>
+    %c32_i32 = arith.constant dense<32> : tensor<8x1xi32>
+    %14 = arith.muli %13, %c32_i32 : tensor<8x1xi32>
+    %15 = tt.broadcast %14 : tensor<8x1xi32> -> tensor<8x32xi32>
+    %16 = arith.addi %15, %8 : tensor<8x32xi32>
+    %17 = tt.splat %arg2 : !tt.ptr<bf16> -> tensor<8x32x!tt.ptr<bf16>>
+    %18 = tt.addptr %17, %16 : tensor<8x32x!tt.ptr<bf16>>, tensor<8x32xi32>
+    tt.store %18, %12 : tensor<8x32x!tt.ptr<bf16>>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:  func.func @embedding
+// CHECK:           [[VAR_offset_:%.+]] = arith.index_cast [[PARAM_3_:%.+]] : i32 to index
+// CHECK:           scf.for
+// CHECK:             [[VAR_table_:%.+]] = memref.reinterpret_cast {{.*}} to offset: {{.}}[[VAR_offset_]]{{.}}, sizes: {{.}}{{%.+}}{{.}}, strides: [1] : memref<*xbf16> to memref<?xbf16, strided<[1], offset: ?>>
+// CHECK:             vector.gather [[VAR_table_]]{{.}}{{.*}}{{.}} {{.}}{{.*}}{{.}}, {{.*}}, {{.*}} : memref<?xbf16, strided<[1], offset: ?>>, vector<16xi64>, vector<16xi1>, vector<16xbf16> into vector<16xbf16>
+// CHECK:           tensor.expand_shape {{.*}} {{.}}[0, 1]{{.}} output_shape [8, 32] : tensor<256xbf16> into tensor<8x32xbf16>
+// CHECK:           memref.reinterpret_cast {{.*}} to offset: [0], sizes: [8, 32], strides: [32, 1]
+// CHECK:           bufferization.materialize_in_destination
+// CHECK-NOT:       tts.
+// CHECK:           return
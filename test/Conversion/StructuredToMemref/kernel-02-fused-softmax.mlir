@@ -54,7 +54,8 @@ module {
 // CHECK-DAG:       [[RES_:%.+]] = memref.alloc() : memref<128xf32>
 // CHECK:           [[VAR_5_:%.+]] = arith.cmpi slt, [[VAR_4_]], [[CST_128_]] : index
 // CHECK:           scf.if [[VAR_5_]] {
-// CHECK:             linalg.fill ins([[CST_0_1_]] : f32) outs([[RES_]] : memref<128xf32>)
+// CHECK:             [[VAR_slab_0_:%.+]] = memref.subview [[RES_]]{{.*}} : memref<128xf32> to memref<{{.*}}>
+// CHECK:             linalg.fill ins([[CST_0_1_]] : f32) outs([[VAR_slab_0_]] : memref<{{.*}}>)
 // CHECK:           }
 // CHECK-DAG:       [[VAR_subview_:%.+]] = memref.subview [[VAR_reinterpret_cast_]][0] {{.}}[[VAR_4_]]{{.}} [1] : memref<128xf32, strided<[1], offset: ?>> to memref<?xf32, strided<[1], offset: ?>>
 // CHECK-DAG:       [[VAR_subview_1_:%.+]] = memref.subview [[RES_]][0] {{.}}[[VAR_4_]]{{.}} [1] : memref<128xf32> to memref<?xf32, strided<[1]>>
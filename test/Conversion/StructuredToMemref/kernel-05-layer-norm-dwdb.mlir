@@ -96,7 +96,10 @@ module {
 // CHECK:             [[VAR_28_:%.+]] = arith.cmpi slt, [[VAR_26_]], [[CST_256_1_]] : index
 // CHECK:             [[VAR_29_:%.+]] = arith.ori [[VAR_27_]], [[VAR_28_]] : i1
 // CHECK:             scf.if [[VAR_29_]] {
-// CHECK:               linalg.fill ins([[CST_0_dot_000000_]] : f32) outs([[RES_]] : memref<256x256xf32>)
+// CHECK:               [[VAR_slab_0_:%.+]] = memref.subview [[RES_]]{{.*}} : memref<256x256xf32> to memref<{{.*}}>
+// CHECK:               linalg.fill ins([[CST_0_dot_000000_]] : f32) outs([[VAR_slab_0_]] : memref<{{.*}}>)
+// CHECK:               [[VAR_slab_1_:%.+]] = memref.subview [[RES_]]{{.*}} : memref<256x256xf32> to memref<{{.*}}>
+// CHECK:               linalg.fill ins([[CST_0_dot_000000_]] : f32) outs([[VAR_slab_1_]] : memref<{{.*}}>)
 // CHECK:             }
 // CHECK-DAG:         [[VAR_subview_5_:%.+]] = memref.subview [[VAR_reinterpret_cast_4_]][0, 0] {{.}}[[VAR_25_]], [[VAR_26_]]{{.}} [1, 1] : memref<256x256xf32, strided<[?, 1], offset: ?>> to memref<?x?xf32, strided<[?, 1], offset: ?>>
 // CHECK-DAG:         [[VAR_subview_6_:%.+]] = memref.subview [[RES_]][0, 0] {{.}}[[VAR_25_]], [[VAR_26_]]{{.}} [1, 1] : memref<256x256xf32> to memref<?x?xf32, strided<[256, 1]>>
@@ -110,7 +113,10 @@ module {
 // CHECK-DAG:         [[VAR_reinterpret_cast_7_:%.+]] = memref.reinterpret_cast [[PARAM_1_]] to offset: {{.}}[[VAR_15_]]{{.}}, sizes: [256, 256], strides: {{.}}[[VAR_13_]], 1] : memref<*xf32> to memref<256x256xf32, strided<[?, 1], offset: ?>>
 // CHECK-DAG:         [[RES_1_:%.+]] = memref.alloc() : memref<256x256xf32>
 // CHECK:             scf.if [[VAR_29_]] {
-// CHECK:               linalg.fill ins([[CST_0_dot_000000_]] : f32) outs([[RES_1_]] : memref<256x256xf32>)
+// CHECK:               [[VAR_slab_2_:%.+]] = memref.subview [[RES_1_]]{{.*}} : memref<256x256xf32> to memref<{{.*}}>
+// CHECK:               linalg.fill ins([[CST_0_dot_000000_]] : f32) outs([[VAR_slab_2_]] : memref<{{.*}}>)
+// CHECK:               [[VAR_slab_3_:%.+]] = memref.subview [[RES_1_]]{{.*}} : memref<256x256xf32> to memref<{{.*}}>
+// CHECK:               linalg.fill ins([[CST_0_dot_000000_]] : f32) outs([[VAR_slab_3_]] : memref<{{.*}}>)
 // CHECK:             }
 // CHECK-DAG:         [[VAR_subview_9_:%.+]] = memref.subview [[VAR_reinterpret_cast_7_]][0, 0] {{.}}[[VAR_25_]], [[VAR_26_]]{{.}} [1, 1] : memref<256x256xf32, strided<[?, 1], offset: ?>> to memref<?x?xf32, strided<[?, 1], offset: ?>>
 // CHECK-DAG:         [[VAR_subview_10_:%.+]] = memref.subview [[RES_1_]][0, 0] {{.}}[[VAR_25_]], [[VAR_26_]]{{.}} [1, 1] : memref<256x256xf32> to memref<?x?xf32, strided<[256, 1]>>
@@ -122,7 +122,8 @@ module {
 // CHECK-DAG:         [[RES_:%.+]] = memref.alloc() : memref<256xf32>
 // CHECK:             [[VAR_27_:%.+]] = arith.cmpi slt, [[VAR_26_]], [[CST_256_1_]] : index
 // CHECK:             scf.if [[VAR_27_]] {
-// CHECK:               linalg.fill ins([[CST_0_dot_000000_]] : f32) outs([[RES_]] : memref<256xf32>)
+// CHECK:               [[VAR_slab_0_:%.+]] = memref.subview [[RES_]]{{.*}} : memref<256xf32> to memref<{{.*}}>
+// CHECK:               linalg.fill ins([[CST_0_dot_000000_]] : f32) outs([[VAR_slab_0_]] : memref<{{.*}}>)
 // CHECK:             }
 // CHECK-DAG:         [[VAR_subview_:%.+]] = memref.subview [[VAR_reinterpret_cast_5_]][0] {{.}}[[VAR_26_]]{{.}} [1] : memref<256xf32, strided<[1], offset: ?>> to memref<?xf32, strided<[1], offset: ?>>
 // CHECK-DAG:         [[VAR_subview_6_:%.+]] = memref.subview [[RES_]][0] {{.}}[[VAR_26_]]{{.}} [1] : memref<256xf32> to memref<?xf32, strided<[1]>>
@@ -170,7 +171,8 @@ module {
 // CHECK-DAG:         [[RES_1_:%.+]] = memref.alloc() : memref<256xf32>
 // CHECK:             [[VAR_31_:%.+]] = arith.cmpi slt, [[VAR_30_1_]], [[CST_256_1_]] : index
 // CHECK:             scf.if [[VAR_31_]] {
-// CHECK:               linalg.fill ins([[CST_0_dot_000000_]] : f32) outs([[RES_1_]] : memref<256xf32>)
+// CHECK:               [[VAR_slab_1_:%.+]] = memref.subview [[RES_1_]]{{.*}} : memref<256xf32> to memref<{{.*}}>
+// CHECK:               linalg.fill ins([[CST_0_dot_000000_]] : f32) outs([[VAR_slab_1_]] : memref<{{.*}}>)
 // CHECK:             }
 // CHECK-DAG:         [[VAR_subview_1_:%.+]] = memref.subview [[VAR_reinterpret_cast_5_1_]][0] {{.}}[[VAR_30_1_]]{{.}} [1] : memref<256xf32, strided<[1], offset: ?>> to memref<?xf32, strided<[1], offset: ?>>
 // CHECK-DAG:         [[VAR_subview_6_1_:%.+]] = memref.subview [[RES_1_]][0] {{.}}[[VAR_30_1_]]{{.}} [1] : memref<256xf32> to memref<?xf32, strided<[1]>>
@@ -243,7 +245,8 @@ module {
 // CHECK-DAG:         [[RES_4_:%.+]] = memref.alloc() : memref<256xf32>
 // CHECK-DAG:         [[VAR_29_2_:%.+]] = arith.cmpi slt, [[VAR_25_2_]], [[CST_256_1_]] : index
 // CHECK:             scf.if [[VAR_29_2_]] {
-// CHECK:               linalg.fill ins([[CST_0_dot_000000_]] : f32) outs([[RES_4_]] : memref<256xf32>)
+// CHECK:               [[VAR_slab_2_:%.+]] = memref.subview [[RES_4_]]{{.*}} : memref<256xf32> to memref<{{.*}}>
+// CHECK:               linalg.fill ins([[CST_0_dot_000000_]] : f32) outs([[VAR_slab_2_]] : memref<{{.*}}>)
 // CHECK:             }
 // CHECK-DAG:         [[VAR_subview_13_:%.+]] = memref.subview [[VAR_reinterpret_cast_11_]][0] {{.}}[[VAR_25_2_]]{{.}} [1] : memref<256xf32, strided<[1], offset: ?>> to memref<?xf32, strided<[1], offset: ?>>
 // CHECK-DAG:         [[VAR_subview_14_:%.+]] = memref.subview [[RES_4_]][0] {{.}}[[VAR_25_2_]]{{.}} [1] : memref<256xf32> to memref<?xf32, strided<[1]>>
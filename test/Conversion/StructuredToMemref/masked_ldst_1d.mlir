@@ -33,7 +33,8 @@ module {
 // CHECK-DAG:       [[RES_:%.+]] = memref.alloc() : memref<128xbf16>
 // CHECK:           [[VAR_3_:%.+]] = arith.cmpi slt, [[VAR_2_]], [[CST_128_]] : index
 // CHECK:           scf.if [[VAR_3_]] {
-// CHECK:             linalg.fill ins([[CST_0_1_]] : bf16) outs([[RES_]] : memref<128xbf16>)
+// CHECK:             [[VAR_slab_0_:%.+]] = memref.subview [[RES_]]{{.*}} : memref<128xbf16> to memref<{{.*}}>
+// CHECK:             linalg.fill ins([[CST_0_1_]] : bf16) outs([[VAR_slab_0_]] : memref<{{.*}}>)
 // CHECK:           }
 // CHECK-DAG:       [[VAR_subview_:%.+]] = memref.subview [[VAR_reinterpret_cast_]][0] {{.}}[[VAR_2_]]{{.}} [1] : memref<128xbf16, strided<[1]>> to memref<?xbf16, strided<[1]>>
 // CHECK-DAG:       [[VAR_subview_1_:%.+]] = memref.subview [[RES_]][0] {{.}}[[VAR_2_]]{{.}} [1] : memref<128xbf16> to memref<?xbf16, strided<[1]>>
@@ -92,7 +92,10 @@ module {
 // CHECK:           [[VAR_11_:%.+]] = arith.cmpi slt, [[VAR_9_]], [[CST_256_]] : index
 // CHECK:           [[VAR_12_:%.+]] = arith.ori [[VAR_10_]], [[VAR_11_]] : i1
 // CHECK:           scf.if [[VAR_12_]] {
-// CHECK:             linalg.fill ins([[CST_0_]] : bf16) outs([[RES_]] : memref<128x256xbf16>)
+// CHECK:             [[VAR_slab_0_:%.+]] = memref.subview [[RES_]]{{.*}} : memref<128x256xbf16> to memref<{{.*}}>
+// CHECK:             linalg.fill ins([[CST_0_]] : bf16) outs([[VAR_slab_0_]] : memref<{{.*}}>)
+// CHECK:             [[VAR_slab_1_:%.+]] = memref.subview [[RES_]]{{.*}} : memref<128x256xbf16> to memref<{{.*}}>
+// CHECK:             linalg.fill ins([[CST_0_]] : bf16) outs([[VAR_slab_1_]] : memref<{{.*}}>)
 // CHECK:           }
 // CHECK-DAG:       [[VAR_subview_:%.+]] = memref.subview [[VAR_reinterpret_cast_]][0, 0] {{.}}[[VAR_8_]], [[VAR_9_]]{{.}} [1, 1] : memref<128x256xbf16, strided<[1, ?], offset: ?>> to memref<?x?xbf16, strided<[1, ?], offset: ?>>
 // CHECK-DAG:       [[VAR_subview_1_:%.+]] = memref.subview [[RES_]][0, 0] {{.}}[[VAR_8_]], [[VAR_9_]]{{.}} [1, 1] : memref<128x256xbf16> to memref<?x?xbf16, strided<[256, 1]>>
@@ -48,6 +48,6 @@ module {
 // CHECK:               [[VAR_3_:%.+]] = arith.addf [[in_]], [[init_]] : bf16
 // CHECK:               linalg.yield [[VAR_3_]] : bf16
 // CHECK:             }
-// CHECK:           bufferization.materialize_in_destination [[VAR_reduced_]] in writable [[VAR_reinterpret_cast_0_]] : (tensor<256xbf16>, memref<256xbf16, strided<[1]>>) -> ()
+// CHECK:           bufferization.materialize_in_destination [[VAR_reduced_]] in restrict writable [[VAR_reinterpret_cast_0_]] : (tensor<256xbf16>, memref<256xbf16, strided<[1]>>) -> ()
 // CHECK:           return
 // CHECK:         }
@@ -51,6 +51,6 @@ module {
 // CHECK:               [[VAR_4_:%.+]] = arith.addf [[in_]], [[init_]] : bf16
 // CHECK:               linalg.yield [[VAR_4_]] : bf16
 // CHECK:             }
-// CHECK:           bufferization.materialize_in_destination [[VAR_reduced_]] in writable [[VAR_reinterpret_cast_0_]] : (tensor<512xbf16>, memref<512xbf16, strided<[1]>>) -> ()
+// CHECK:           bufferization.materialize_in_destination [[VAR_reduced_]] in restrict writable [[VAR_reinterpret_cast_0_]] : (tensor<512xbf16>, memref<512xbf16, strided<[1]>>) -> ()
 // CHECK:           return
 // CHECK:         }
@@ -51,6 +51,6 @@ module {
 // CHECK:               [[VAR_4_:%.+]] = arith.addf [[in_]], [[init_]] : f32
 // CHECK:               linalg.yield [[VAR_4_]] : f32
 // CHECK:             }
-// CHECK:           bufferization.materialize_in_destination [[VAR_reduced_]] in writable [[VAR_reinterpret_cast_0_]] : (tensor<512xf32>, memref<512xf32, strided<[1]>>) -> ()
+// CHECK:           bufferization.materialize_in_destination [[VAR_reduced_]] in restrict writable [[VAR_reinterpret_cast_0_]] : (tensor<512xf32>, memref<512xf32, strided<[1]>>) -> ()
 // CHECK:           return
 // CHECK:         }
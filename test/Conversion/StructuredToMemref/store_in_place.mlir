@@ -0,0 +1,62 @@
+// RUN: triton-shared-opt --split-input-file --triton-to-linalg-experimental --unify-returns --eliminate-empty-tensors --empty-tensor-to-alloc-tensor --one-shot-bufferize --canonicalize %s | FileCheck %s
+
+// The tile stored to %b is computed in %b directly: no buffer is allocated
+// for it and it is not copied at the store.
+module {
+  tt.func @in_place(%a : !tt.ptr<i32>, %b : !tt.ptr<f32>) -> () {
+    %0 = tt.make_range {end = 1024 : i32, start = 0 : i32} : tensor<1024xi32>
+    %1 = tt.splat %a : !tt.ptr<i32> -> tensor<1024x!tt.ptr<i32>>
+    %2 = tt.addptr %1, %0 : tensor<1024x!tt.ptr<i32>>, tensor<1024xi32>
+    %3 = tt.splat %b : !tt.ptr<f32> -> tensor<1024x!tt.ptr<f32>>
+    %4 = tt.addptr %3, %0 : tensor<1024x!tt.ptr<f32>>, tensor<1024xi32>
+    %5 = tt.load %2 : tensor<1024x!tt.ptr<i32>>
+    %6 = tt.bitcast %5 : tensor<1024xi32> -> tensor<1024xf32>
+    tt.store %4, %6 : tensor<1024x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:  func.func @in_place
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<*xi32>, [[PARAM_1_:%.+]]: memref<*xf32>
+// CHECK-DAG:       [[VAR_reinterpret_cast_:%.+]] = memref.reinterpret_cast [[PARAM_0_]] to offset: [0], sizes: [1024], strides: [1] : memref<*xi32> to memref<1024xi32, strided<[1]>>
+// CHECK-DAG:       [[VAR_reinterpret_cast_0_:%.+]] = memref.reinterpret_cast [[PARAM_1_]] to offset: [0], sizes: [1024], strides: [1] : memref<*xf32> to memref<1024xf32, strided<[1]>>
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc() : memref<1024xi32>
+// CHECK:           memref.copy [[VAR_reinterpret_cast_]], [[RES_]] : memref<1024xi32, strided<[1]>> to memref<1024xi32>
+// CHECK-NOT:       memref.alloc
+// CHECK:           linalg.generic {{.*}} ins([[RES_]] : memref<1024xi32>) outs([[VAR_reinterpret_cast_0_]] : memref<1024xf32, strided<[1]>>)
+// CHECK:             arith.bitcast
+// CHECK-NOT:       memref.copy
+// CHECK:           return
+
+// -----
+
+// %b is loaded after the tile stored to it is computed: the tile is kept in
+// its own buffer and copied to %b at the store.
+module {
+  tt.func @read_before_store(%a : !tt.ptr<i32>, %b : !tt.ptr<f32>, %c : !tt.ptr<f32>) -> () {
+    %0 = tt.make_range {end = 1024 : i32, start = 0 : i32} : tensor<1024xi32>
+    %1 = tt.splat %a : !tt.ptr<i32> -> tensor<1024x!tt.ptr<i32>>
+    %2 = tt.addptr %1, %0 : tensor<1024x!tt.ptr<i32>>, tensor<1024xi32>
+    %3 = tt.splat %b : !tt.ptr<f32> -> tensor<1024x!tt.ptr<f32>>
+    %4 = tt.addptr %3, %0 : tensor<1024x!tt.ptr<f32>>, tensor<1024xi32>
+    %5 = tt.splat %c : !tt.ptr<f32> -> tensor<1024x!tt.ptr<f32>>
+    %6 = tt.addptr %5, %0 : tensor<1024x!tt.ptr<f32>>, tensor<1024xi32>
+    %7 = tt.load %2 : tensor<1024x!tt.ptr<i32>>
+    %8 = arith.sitofp %7 : tensor<1024xi32> to tensor<1024xf32>
+    %9 = tt.load %4 : tensor<1024x!tt.ptr<f32>>
+    tt.store %4, %8 : tensor<1024x!tt.ptr<f32>>
+    tt.store %6, %9 : tensor<1024x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:  func.func @read_before_store
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<*xi32>, [[PARAM_1_:%.+]]: memref<*xf32>, [[PARAM_2_:%.+]]: memref<*xf32>
+// CHECK-DAG:       [[VAR_reinterpret_cast_0_:%.+]] = memref.reinterpret_cast [[PARAM_1_]] to offset: [0], sizes: [1024], strides: [1] : memref<*xf32> to memref<1024xf32, strided<[1]>>
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc() : memref<1024xi32>
+// CHECK-DAG:       [[RES_1_:%.+]] = memref.alloc() : memref<1024xf32>
+// CHECK:           linalg.generic {{.*}} ins([[RES_]] : memref<1024xi32>) outs([[RES_1_]] : memref<1024xf32>)
+// CHECK:             arith.sitofp
+// CHECK:           memref.copy [[VAR_reinterpret_cast_0_]], {{%.+}} : memref<1024xf32, strided<[1]>> to memref<1024xf32>
+// CHECK:           memref.copy [[RES_1_]], [[VAR_reinterpret_cast_0_]] : memref<1024xf32> to memref<1024xf32, strided<[1]>>
+// CHECK:           return
@@ -0,0 +1,53 @@
+// RUN: triton-shared-opt --split-input-file --ttx-tile-and-fuse="tile-sizes=2" %s | FileCheck %s
+
+// exp(x) -> cumsum -> * 2, the chain is computed two rows at a time.
+module {
+  func.func @scan_chain(%arg0: tensor<8x128xf32>) -> tensor<8x128xf32> {
+    %cst = arith.constant 2.000000e+00 : f32
+    %0 = tensor.empty() : tensor<8x128xf32>
+    %1 = linalg.generic {indexing_maps = [affine_map<(d0, d1) -> (d0, d1)>, affine_map<(d0, d1) -> (d0, d1)>], iterator_types = ["parallel", "parallel"]} ins(%arg0 : tensor<8x128xf32>) outs(%0 : tensor<8x128xf32>) {
+    ^bb0(%in: f32, %out: f32):
+      %5 = math.exp %in : f32
+      linalg.yield %5 : f32
+    } -> tensor<8x128xf32>
+    %2 = tensor.empty() : tensor<8x128xf32>
+    %3 = ttx.cumsum {axis = 1 : ui32, operandSegmentSizes = array<i32: 1, 1>} ins(%1 : tensor<8x128xf32>) outs(%2 : tensor<8x128xf32>) -> tensor<8x128xf32>
+    %4 = linalg.generic {indexing_maps = [affine_map<(d0, d1) -> (d0, d1)>, affine_map<(d0, d1) -> (d0, d1)>], iterator_types = ["parallel", "parallel"]} ins(%3 : tensor<8x128xf32>) outs(%0 : tensor<8x128xf32>) {
+    ^bb0(%in: f32, %out: f32):
+      %5 = arith.mulf %in, %cst : f32
+      linalg.yield %5 : f32
+    } -> tensor<8x128xf32>
+    return %4 : tensor<8x128xf32>
+  }
+}
+
+// CHECK-LABEL:  func.func @scan_chain
+// CHECK:           [[VAR_0_:%.+]] = scf.for [[VAR_arg1_:%.+]] = {{%.+}} to {{%.+}} step {{%.+}} iter_args([[VAR_arg2_:%.+]] = {{%.+}}) -> (tensor<8x128xf32>) {
+// CHECK:             tensor.extract_slice [[PARAM_0_:%.+]][[[VAR_arg1_]], 0] [2, 128] [1, 1] : tensor<8x128xf32> to tensor<2x128xf32>
+// CHECK:             linalg.generic
+// CHECK:               math.exp
+// CHECK:             } -> tensor<2x128xf32>
+// CHECK:             ttx.cumsum {axis = 1 : ui32, {{.*}}} ins({{%.+}} : tensor<2x128xf32>) outs({{%.+}} : tensor<2x128xf32>) -> tensor<2x128xf32>
+// CHECK:             linalg.generic
+// CHECK:               arith.mulf
+// CHECK:             } -> tensor<2x128xf32>
+// CHECK:             tensor.insert_slice {{%.+}} into [[VAR_arg2_]][[[VAR_arg1_]], 0] [2, 128] [1, 1] : tensor<2x128xf32> into tensor<8x128xf32>
+// CHECK:           }
+// CHECK-NOT:       ttx.cumsum
+// CHECK-NOT:       linalg.generic
+// CHECK:           return [[VAR_0_]] : tensor<8x128xf32>
+
+// -----
+
+// A rank-1 scan has no parallel dimension to tile.
+module {
+  func.func @scan_1d(%arg0: tensor<128xf32>) -> tensor<128xf32> {
+    %0 = tensor.empty() : tensor<128xf32>
+    %1 = ttx.cumsum {axis = 0 : ui32, operandSegmentSizes = array<i32: 1, 1>} ins(%arg0 : tensor<128xf32>) outs(%0 : tensor<128xf32>) -> tensor<128xf32>
+    return %1 : tensor<128xf32>
+  }
+}
+
+// CHECK-LABEL:  func.func @scan_1d
+// CHECK-NOT:       scf.for
+// CHECK:           ttx.cumsum {{.*}} ins({{%.+}} : tensor<128xf32>)
@@ -0,0 +1,50 @@
+// RUN: triton-shared-opt --split-input-file --ttx-to-loops %s | FileCheck %s
+
+module {
+  func.func @cumsum_blocked(%arg0: memref<4096xf32>, %arg1: memref<4096xf32>) {
+    ttx.cumsum {axis = 0 : ui32, operandSegmentSizes = array<i32: 1, 1>} ins(%arg0 : memref<4096xf32>) outs(%arg1 : memref<4096xf32>)
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @cumsum_blocked
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<4096xf32>, [[PARAM_1_:%.+]]: memref<4096xf32>) {
+// CHECK-NOT:       ttx.cumsum
+// CHECK:           [[VAR_blocks_:%.+]] = scf.for [[I_0_:%.+]] = {{.*}} to [[VAR_end_:%.+]] step {{.*}} iter_args([[CARRY_:%.+]] = {{.*}}) -> (f32) {
+// CHECK:             [[VAR_block_:%.+]] = vector.transfer_read [[PARAM_0_]]{{.}}[[I_0_]]{{.}}, {{.*}} {in_bounds = [true]} : memref<4096xf32>, vector<16xf32>
+// CHECK:             [[VAR_shift_1_:%.+]] = vector.shuffle {{.*}}, [[VAR_block_]] [0, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30] : vector<16xf32>, vector<16xf32>
+// CHECK:             [[VAR_scan_1_:%.+]] = arith.addf [[VAR_block_]], [[VAR_shift_1_]] : vector<16xf32>
+// CHECK:             vector.shuffle {{.*}}, [[VAR_scan_1_]] [0, 1, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29] : vector<16xf32>, vector<16xf32>
+// CHECK:             vector.shuffle
+// CHECK:             vector.shuffle
+// CHECK-NOT:         vector.shuffle
+// CHECK:             [[VAR_carry_:%.+]] = vector.broadcast [[CARRY_]] : f32 to vector<16xf32>
+// CHECK:             [[VAR_sum_:%.+]] = arith.addf {{.*}}, [[VAR_carry_]] : vector<16xf32>
+// CHECK:             vector.transfer_write [[VAR_sum_]], [[PARAM_1_]]{{.}}[[I_0_]]{{.}} {in_bounds = [true]} : vector<16xf32>, memref<4096xf32>
+// CHECK:             [[VAR_next_:%.+]] = vector.extract [[VAR_sum_]][15] : {{.*}}vector<16xf32>
+// CHECK:             scf.yield [[VAR_next_]] : f32
+// CHECK:           }
+// CHECK:           scf.for [[I_1_:%.+]] = [[VAR_end_]] to {{.*}} step {{.*}} iter_args({{.*}} = [[VAR_blocks_]]) -> (f32) {
+// CHECK:             memref.load [[PARAM_0_]]{{.}}[[I_1_]]{{.}} : memref<4096xf32>
+// CHECK:             memref.store {{.*}}, [[PARAM_1_]]{{.}}[[I_1_]]{{.}} : memref<4096xf32>
+// CHECK:           return
+
+// -----
+
+// Short rows and integer scans keep the sequential loop.
+module {
+  func.func @cumsum_sequential(%arg0: memref<4x32xi32>, %arg1: memref<4x32xi32>) {
+    ttx.cumsum {axis = 1 : ui32, operandSegmentSizes = array<i32: 1, 1>} ins(%arg0 : memref<4x32xi32>) outs(%arg1 : memref<4x32xi32>)
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @cumsum_sequential
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<4x32xi32>, [[PARAM_1_:%.+]]: memref<4x32xi32>) {
+// CHECK-NOT:       vector.transfer_read
+// CHECK:           scf.for [[I_0_:%.+]] =
+// CHECK:             scf.for [[I_1_:%.+]] = {{.*}} iter_args([[CARRY_:%.+]] = {{.*}}) -> (i32) {
+// CHECK:               [[VAR_x_:%.+]] = memref.load [[PARAM_0_]]{{.}}[[I_0_]], [[I_1_]]{{.}} : memref<4x32xi32>
+// CHECK:               [[VAR_sum_:%.+]] = arith.addi [[CARRY_]], [[VAR_x_]] : i32
+// CHECK:               memref.store [[VAR_sum_]], [[PARAM_1_]]{{.}}[[I_0_]], [[I_1_]]{{.}} : memref<4x32xi32>
+// CHECK:               scf.yield [[VAR_sum_]] : i32
@@ -0,0 +1,81 @@
+// RUN: triton-shared-opt --triton-arith-to-linalg --split-input-file %s | FileCheck %s
+
+module {
+  tt.func public @xori(%arg0: !tt.ptr<i32>, %arg1: tensor<256xi32>) {
+    %0 = "tt.reduce"(%arg1) ({
+    ^bb0(%arg2: i32, %arg3: i32):
+      %1 = arith.xori %arg2, %arg3 : i32
+      tt.reduce.return %1 : i32
+    }) {axis = 0 : i32} : (tensor<256xi32>) -> i32
+    tt.store %arg0, %0 : !tt.ptr<i32>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:  func.func @xori
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: !tt.ptr<i32>, [[PARAM_1_:%.+]]: tensor<256xi32>, {{.*}}) {
+// CHECK-DAG:       [[CST_0_:%.+]] = arith.constant 0 : i32
+// CHECK-DAG:       [[VAR_0_:%.+]] = bufferization.alloc_tensor() : tensor<i32>
+// CHECK:           [[VAR_inserted_:%.+]] = tensor.insert [[CST_0_]] into [[VAR_0_]][] : tensor<i32>
+// CHECK:           [[VAR_reduced_:%.+]] = linalg.reduce ins([[PARAM_1_]] : tensor<256xi32>) outs([[VAR_inserted_]] : tensor<i32>) dimensions = [0]
+// CHECK:               arith.xori
+// CHECK:           [[VAR_extracted_:%.+]] = tensor.extract [[VAR_reduced_]][] : tensor<i32>
+// CHECK:           tt.store [[PARAM_0_]], [[VAR_extracted_]] : !tt.ptr<i32>
+
+// -----
+
+module {
+  tt.func public @prod(%arg0: !tt.ptr<f32>, %arg1: tensor<32x64xf32>) {
+    %0 = "tt.reduce"(%arg1) ({
+    ^bb0(%arg2: f32, %arg3: f32):
+      %1 = arith.mulf %arg2, %arg3 : f32
+      tt.reduce.return %1 : f32
+    }) {axis = 0 : i32} : (tensor<32x64xf32>) -> tensor<64xf32>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:  func.func @prod
+// CHECK-DAG:       [[CST_1_:%.+]] = arith.constant 1.000000e+00 : f32
+// CHECK-DAG:       [[VAR_0_:%.+]] = tensor.empty() : tensor<64xf32>
+// CHECK:           [[VAR_1_:%.+]] = linalg.fill ins([[CST_1_]] : f32) outs([[VAR_0_]] : tensor<64xf32>) -> tensor<64xf32>
+// CHECK:           linalg.reduce ins({{.*}} : tensor<32x64xf32>) outs([[VAR_1_]] : tensor<64xf32>) dimensions = [0]
+// CHECK:               arith.mulf
+
+// -----
+
+// Welford-style combiner with two results and several ops: seeded with the
+// first column, the other 31 columns are combined into it.
+module {
+  tt.func public @welford(%arg0: tensor<64x32xf32>, %arg1: tensor<64x32xf32>) -> (tensor<64xf32>, tensor<64xf32>) {
+    %0:2 = "tt.reduce"(%arg0, %arg1) <{axis = 1 : i32}> ({
+    ^bb0(%arg2: f32, %arg3: f32, %arg4: f32, %arg5: f32):
+      %1 = arith.subf %arg4, %arg2 : f32
+      %2 = arith.mulf %1, %1 : f32
+      %3 = arith.addf %arg2, %arg4 : f32
+      %4 = arith.addf %arg3, %arg5 : f32
+      %5 = arith.addf %4, %2 : f32
+      tt.reduce.return %3, %5 : f32, f32
+    }) : (tensor<64x32xf32>, tensor<64x32xf32>) -> (tensor<64xf32>, tensor<64xf32>)
+    tt.return %0#0, %0#1 : tensor<64xf32>, tensor<64xf32>
+  }
+}
+
+// CHECK-LABEL:  func.func @welford
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: tensor<64x32xf32>, [[PARAM_1_:%.+]]: tensor<64x32xf32>, {{.*}}) -> (tensor<64xf32>, tensor<64xf32>) {
+// CHECK:           [[VAR_transposed_:%.+]] = linalg.transpose ins([[PARAM_0_]] : tensor<64x32xf32>) outs({{.*}} : tensor<32x64xf32>) permutation = [1, 0]
+// CHECK:           [[VAR_transposed_1_:%.+]] = linalg.transpose ins([[PARAM_1_]] : tensor<64x32xf32>) outs({{.*}} : tensor<32x64xf32>) permutation = [1, 0]
+// CHECK-DAG:       [[VAR_init_0_:%.+]] = tensor.extract_slice [[VAR_transposed_]][0, 0] [1, 64] [1, 1] : tensor<32x64xf32> to tensor<64xf32>
+// CHECK-DAG:       [[VAR_rest_0_:%.+]] = tensor.extract_slice [[VAR_transposed_]][1, 0] [31, 64] [1, 1] : tensor<32x64xf32> to tensor<31x64xf32>
+// CHECK-DAG:       [[VAR_init_1_:%.+]] = tensor.extract_slice [[VAR_transposed_1_]][0, 0] [1, 64] [1, 1] : tensor<32x64xf32> to tensor<64xf32>
+// CHECK-DAG:       [[VAR_rest_1_:%.+]] = tensor.extract_slice [[VAR_transposed_1_]][1, 0] [31, 64] [1, 1] : tensor<32x64xf32> to tensor<31x64xf32>
+// CHECK:           [[VAR_reduced_:%.+]]:2 = linalg.reduce ins([[VAR_rest_0_]], [[VAR_rest_1_]] : tensor<31x64xf32>, tensor<31x64xf32>) outs([[VAR_init_0_]], [[VAR_init_1_]] : tensor<64xf32>, tensor<64xf32>) dimensions = [0]
+// CHECK:             ([[in_0_:%.+]]: f32, [[in_1_:%.+]]: f32, [[init_0_:%.+]]: f32, [[init_1_:%.+]]: f32) {
+// CHECK:               [[VAR_1_:%.+]] = arith.subf [[in_0_]], [[init_0_]] : f32
+// CHECK:               [[VAR_2_:%.+]] = arith.mulf [[VAR_1_]], [[VAR_1_]] : f32
+// CHECK:               [[VAR_3_:%.+]] = arith.addf [[init_0_]], [[in_0_]] : f32
+// CHECK:               [[VAR_4_:%.+]] = arith.addf [[init_1_]], [[in_1_]] : f32
+// CHECK:               [[VAR_5_:%.+]] = arith.addf [[VAR_4_]], [[VAR_2_]] : f32
+// CHECK:               linalg.yield [[VAR_3_]], [[VAR_5_]] : f32, f32
+// CHECK:             }
+// CHECK:           return [[VAR_reduced_]]#0, [[VAR_reduced_]]#1 : tensor<64xf32>, tensor<64xf32>
@@ -0,0 +1,40 @@
+// RUN: triton-shared-opt --triton-to-linalg %s | FileCheck %s
+
+module {
+  tt.func @kernel(
+  %arg0 : !tt.ptr<bf16>,
+  %arg1 : !tt.ptr<bf16>
+  )
+  {
+    %0 = tt.splat %arg0 : !tt.ptr<bf16> -> tensor<128x!tt.ptr<bf16>>
+    %1 = tt.splat %arg1 : !tt.ptr<bf16> -> tensor<128x!tt.ptr<bf16>>
+    %2 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+    %ldptr = tt.addptr %0, %2 : tensor<128x!tt.ptr<bf16>>, tensor<128xi32>
+    %stptr = tt.addptr %1, %2 : tensor<128x!tt.ptr<bf16>>, tensor<128xi32>
+    %nans = arith.constant dense<0xFF80> : tensor<128xbf16>
+    %c16 = arith.constant dense<16> : tensor<128xi32>
+    %c100 = arith.constant dense<100> : tensor<128xi32>
+    %lower = arith.cmpi sge, %2, %c16 : tensor<128xi32>
+    %upper = arith.cmpi slt, %2, %c100 : tensor<128xi32>
+    // The box [16, 100) is loaded to and stored from offset 16.
+    %mask = arith.andi %lower, %upper : tensor<128xi1>
+    %buff = tt.load %ldptr, %mask, %nans : tensor<128x!tt.ptr<bf16>>
+    tt.store %stptr, %buff, %mask : tensor<128x!tt.ptr<bf16>>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:  func.func @kernel
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: memref<*xbf16>, [[PARAM_1_:%.+]]: memref<*xbf16>, {{.+}}) {
+// CHECK-DAG:       [[VAR_reinterpret_cast_:%.+]] = memref.reinterpret_cast [[PARAM_0_]] to offset: [0], sizes: [128], strides: [1] : memref<*xbf16> to memref<128xbf16, strided<[1]>>
+// CHECK-DAG:       [[VAR_reinterpret_cast_0_:%.+]] = memref.reinterpret_cast [[PARAM_1_]] to offset: [0], sizes: [128], strides: [1] : memref<*xbf16> to memref<128xbf16, strided<[1]>>
+// CHECK-DAG:       [[RES_:%.+]] = memref.alloc() : memref<128xbf16>
+// CHECK:           linalg.fill ins({{%.+}} : bf16) outs([[RES_]] : memref<128xbf16>)
+// CHECK-DAG:       [[VAR_subview_:%.+]] = memref.subview [[VAR_reinterpret_cast_]][16] [84] [1] : memref<128xbf16, strided<[1]>> to memref<84xbf16, strided<[1], offset: 16>>
+// CHECK-DAG:       [[VAR_subview_1_:%.+]] = memref.subview [[RES_]][16] [84] [1] : memref<128xbf16> to memref<84xbf16, strided<[1], offset: 16>>
+// CHECK:           memref.copy [[VAR_subview_]], [[VAR_subview_1_]] : memref<84xbf16, strided<[1], offset: 16>> to memref<84xbf16, strided<[1], offset: 16>>
+// CHECK:           [[VAR_0_:%.+]] = bufferization.to_tensor [[RES_]] restrict writable : memref<128xbf16>
+// CHECK-DAG:       [[VAR_extracted_slice_:%.+]] = tensor.extract_slice [[VAR_0_]][16] [84] [1] : tensor<128xbf16> to tensor<84xbf16>
+// CHECK-DAG:       [[VAR_subview_2_:%.+]] = memref.subview [[VAR_reinterpret_cast_0_]][16] [84] [1] : memref<128xbf16, strided<[1]>> to memref<84xbf16, strided<[1], offset: 16>>
+// CHECK:           bufferization.materialize_in_destination [[VAR_extracted_slice_]] in writable [[VAR_subview_2_]] : (tensor<84xbf16>, memref<84xbf16, strided<[1], offset: 16>>) -> ()
+// CHECK:           return
@@ -0,0 +1,64 @@
+// RUN: triton-shared-opt --triton-to-structured --remove-dead-values --canonicalize %s | FileCheck %s
+
+// The loop carries the linear offset of the 2-d pointer in a single iter-arg,
+// which starts at the sum of the offsets of the pointer, 0 + 8, and is
+// advanced by the increment of the pointer.
+module {
+  tt.func @kernel(
+    %arg0 : !tt.ptr<f32>,
+    %arg1 : !tt.ptr<f32>,
+    %arg2 : i32
+  )
+  {
+    %0 = tt.make_range {end = 4 : i32, start = 0 : i32}:tensor<4xi32>
+    %1 = tt.expand_dims %0 {axis = 1 : i32} : tensor<4xi32> -> tensor<4x1xi32>
+    %stride = tt.splat %arg2 : i32 -> tensor<4x1xi32>
+    %2 = arith.muli %1, %stride : tensor<4x1xi32>
+    %3 = tt.broadcast %2 : tensor<4x1xi32> -> tensor<4x8xi32>
+    // offset = [0, 0], size = [4, 8], stride = [%arg2, 0]
+    %4 = tt.make_range {end = 16 : i32, start = 8 : i32}:tensor<8xi32>
+    %5 = tt.expand_dims %4 {axis = 0 : i32} : tensor<8xi32> -> tensor<1x8xi32>
+    %6 = tt.broadcast %5 : tensor<1x8xi32> -> tensor<4x8xi32>
+    // offset = [0, 8], size = [4, 8], stride = [0, 1]
+    %7 = arith.addi %3, %6 : tensor<4x8xi32>
+    // offset = [0, 8], size = [4, 8], stride = [%arg2, 1]
+    %8 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<4x8x!tt.ptr<f32>>
+    %9 = tt.addptr %8, %7 : tensor<4x8x!tt.ptr<f32>>, tensor<4x8xi32>
+    %c0 = arith.constant 0 : index
+    %c12 = arith.constant 12 : index
+    %c3 = arith.constant 3 : index
+    %i_c16 = arith.constant 16 : i32
+    %zero = arith.constant dense<0.000000e+00> : tensor<4x8xf32>
+    %sum_out, %_ptr = scf.for %i = %c0 to %c12 step %c3 iter_args(%sum_iter = %zero, %ptr_iter = %9) -> (tensor<4x8xf32>, tensor<4x8x!tt.ptr<f32>>) {
+        %10 = tt.load %ptr_iter : tensor<4x8x!tt.ptr<f32>>
+        %sum = arith.addf %sum_iter, %10 : tensor<4x8xf32>
+        %11 = tt.splat %i_c16 : i32 -> tensor<4x8xi32>
+        // offset = [16, 0], size = [4, 8], stride = [0, 0]
+        %ptr = tt.addptr %ptr_iter, %11 : tensor<4x8x!tt.ptr<f32>>, tensor<4x8xi32>
+        // source: %arg0, offset = [linear + 16, 0], size = [4, 8], stride = [%arg2, 1]
+        scf.yield %sum, %ptr : tensor<4x8xf32>, tensor<4x8x!tt.ptr<f32>>
+    }
+    %12 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<4x8x!tt.ptr<f32>>
+    %13 = tt.addptr %12, %7 : tensor<4x8x!tt.ptr<f32>>, tensor<4x8xi32>
+    tt.store %13, %sum_out : tensor<4x8x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// CHECK:         tt.func @kernel([[PARAM_0_:%.+]]: !tt.ptr<f32>, [[PARAM_1_:%.+]]: !tt.ptr<f32>, [[PARAM_2_:%.+]]: i32) {
+// CHECK-DAG:       [[CST_16_:%.+]] = arith.constant 16 : index
+// CHECK-DAG:       [[CST_8_:%.+]] = arith.constant 8 : index
+// CHECK-DAG:       [[CST_1_:%.+]] = arith.constant 1 : index
+// CHECK-DAG:       [[CST_0_:%.+]] = arith.constant 0 : index
+// CHECK-DAG:       [[VAR_0_:%.+]] = arith.index_cast [[PARAM_2_]] : i32 to index
+// CHECK:           [[VAR_1_:%.+]]:2 = scf.for {{.+}} iter_args([[VAR_arg4_:%.+]] = {{.+}}, [[VAR_arg5_:%.+]] = [[CST_8_]]) -> (tensor<4x8xf32>, index) {
+// CHECK:             [[VAR_2_:%.+]] = tts.make_tptr [[PARAM_0_]] to sizes: [4, 8], strides: {{.}}[[VAR_0_]], [[CST_1_]]{{.}}, offsets: {{.}}[[VAR_arg5_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<4x8x!tt.ptr<f32>>
+// CHECK:             [[VAR_3_:%.+]] = "tts.load"([[VAR_2_]])
+// CHECK-DAG:         [[VAR_4_:%.+]] = arith.addf [[VAR_arg4_]], [[VAR_3_]] : tensor<4x8xf32>
+// CHECK-DAG:         [[VAR_5_:%.+]] = arith.addi [[VAR_arg5_]], [[CST_16_]] : index
+// CHECK:             scf.yield [[VAR_4_]], [[VAR_5_]] : tensor<4x8xf32>, index
+// CHECK:           }
+// CHECK:           [[VAR_6_:%.+]] = tts.make_tptr [[PARAM_1_]] to sizes: [4, 8], strides: {{.}}[[VAR_0_]], 1], offsets: [0, 8], shape: [0, 0], order: [] : <f32> to tensor<4x8x!tt.ptr<f32>>
+// CHECK:           "tts.store"([[VAR_6_]], [[VAR_1_]]#0)
+// CHECK:           tt.return
+// CHECK:         }
@@ -0,0 +1,41 @@
+// RUN: triton-shared-opt --triton-to-structured --canonicalize --cse %s | FileCheck %s
+
+// Atomics on tensors of pointers are rewritten to tts.atomic_rmw and
+// tts.atomic_cas on the base pointer and element offsets; atomics on scalar
+// pointers are left alone.
+module {
+  tt.func @kernel(
+  %arg0 : !tt.ptr<i32>,
+  %arg1 : !tt.ptr<f32>,
+  %arg2 : !tt.ptr<i32>,
+  %arg3 : i32
+  ) {
+    %0 = tt.make_range {end = 64 : i32, start = 0 : i32}:tensor<64xi32>
+    %1 = tt.splat %arg3 : i32 -> tensor<64xi32>
+    %2 = arith.cmpi slt, %0, %1 : tensor<64xi32>
+    %3 = tt.splat %arg0 : !tt.ptr<i32> -> tensor<64x!tt.ptr<i32>>
+    %4 = tt.addptr %3, %0 : tensor<64x!tt.ptr<i32>>, tensor<64xi32>
+    %idx = tt.load %4, %2 : tensor<64x!tt.ptr<i32>>
+    %ones = arith.constant dense<1.000000e+00> : tensor<64xf32>
+    %5 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<64x!tt.ptr<f32>>
+    %6 = tt.addptr %5, %idx : tensor<64x!tt.ptr<f32>>, tensor<64xi32>
+    %7 = tt.atomic_rmw fadd, acq_rel, gpu, %6, %ones, %2 : (tensor<64x!tt.ptr<f32>>, tensor<64xf32>, tensor<64xi1>) -> tensor<64xf32>
+    %8 = tt.atomic_cas acq_rel, gpu, %4, %idx, %0 : (tensor<64x!tt.ptr<i32>>, tensor<64xi32>, tensor<64xi32>) -> tensor<64xi32>
+    %c1 = arith.constant 1 : i32
+    %true = arith.constant true
+    %9 = tt.atomic_rmw add, relaxed, gpu, %arg2, %c1, %true : (!tt.ptr<i32>, i32, i1) -> i32
+    tt.return
+  }
+}
+
+// CHECK:         tt.func @kernel([[PARAM_0_:%.+]]: !tt.ptr<i32>, [[PARAM_1_:%.+]]: !tt.ptr<f32>, [[PARAM_2_:%.+]]: !tt.ptr<i32>, [[PARAM_3_:%.+]]: i32) {
+// CHECK-DAG:       [[VAR_ones_:%.+]] = arith.constant dense<1.000000e+00> : tensor<64xf32>
+// CHECK-DAG:       [[VAR_0_:%.+]] = tt.make_range {end = 64 : i32, start = 0 : i32} : tensor<64xi32>
+// CHECK-DAG:       [[VAR_2_:%.+]] = arith.cmpi slt, [[VAR_0_]], {{.*}} : tensor<64xi32>
+// CHECK:           [[VAR_idx_:%.+]] = "tts.load"
+// CHECK:           {{.*}} = tts.atomic_rmw fadd, acq_rel, gpu, [[PARAM_1_]]{{.}}[[VAR_idx_]]{{.}}, [[VAR_ones_]], mask = [[VAR_2_]] : (!tt.ptr<f32>, tensor<64xi32>, tensor<64xf32>, tensor<64xi1>) -> tensor<64xf32>
+// CHECK:           {{.*}} = tts.atomic_cas acq_rel, gpu, [[PARAM_0_]]{{.}}{{.*}}{{.}}, [[VAR_idx_]], [[VAR_0_]] : (!tt.ptr<i32>, tensor<64xi32>, tensor<64xi32>, tensor<64xi32>) -> tensor<64xi32>
+// CHECK:           {{.*}} = tt.atomic_rmw add, relaxed, gpu, [[PARAM_2_]], {{.*}} : (!tt.ptr<i32>, i32, i1) -> i32
+// CHECK-NOT:       tt.atomic_cas
+// CHECK:           tt.return
+// CHECK:         }
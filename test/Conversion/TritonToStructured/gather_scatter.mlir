@@ -0,0 +1,41 @@
+// RUN: triton-shared-opt --triton-to-structured --canonicalize --cse %s | FileCheck %s
+
+// Pointers indexed by the result of another load are not structured, the
+// accesses through them are rewritten to tts.gather and tts.scatter.
+module {
+  tt.func @kernel(
+  %arg0 : !tt.ptr<i32>,
+  %arg1 : !tt.ptr<f32>,
+  %arg2 : !tt.ptr<f32>,
+  %arg3 : i32
+  ) {
+    %0 = tt.make_range {end = 64 : i32, start = 0 : i32}:tensor<64xi32>
+    %1 = tt.splat %arg3 : i32 -> tensor<64xi32>
+    %2 = arith.cmpi slt, %0, %1 : tensor<64xi32>
+    %3 = tt.splat %arg0 : !tt.ptr<i32> -> tensor<64x!tt.ptr<i32>>
+    %4 = tt.addptr %3, %0 : tensor<64x!tt.ptr<i32>>, tensor<64xi32>
+    %idx = tt.load %4, %2 : tensor<64x!tt.ptr<i32>>
+    %cst = arith.constant dense<0.000000e+00> : tensor<64xf32>
+    %5 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<64x!tt.ptr<f32>>
+    %6 = tt.addptr %5, %idx : tensor<64x!tt.ptr<f32>>, tensor<64xi32>
+    %7 = tt.load %6, %2, %cst : tensor<64x!tt.ptr<f32>>
+    %8 = tt.splat %arg2 : !tt.ptr<f32> -> tensor<64x!tt.ptr<f32>>
+    %9 = tt.addptr %8, %idx : tensor<64x!tt.ptr<f32>>, tensor<64xi32>
+    tt.store %9, %7, %2 : tensor<64x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// CHECK:         tt.func @kernel([[PARAM_0_:%.+]]: !tt.ptr<i32>, [[PARAM_1_:%.+]]: !tt.ptr<f32>, [[PARAM_2_:%.+]]: !tt.ptr<f32>, [[PARAM_3_:%.+]]: i32) {
+// CHECK-DAG:       [[VAR_cst_:%.+]] = arith.constant dense<0.000000e+00> : tensor<64xf32>
+// CHECK-DAG:       [[VAR_0_:%.+]] = tt.make_range {end = 64 : i32, start = 0 : i32} : tensor<64xi32>
+// CHECK-DAG:       [[VAR_1_:%.+]] = tt.splat [[PARAM_3_]] : i32 -> tensor<64xi32>
+// CHECK-DAG:       [[VAR_2_:%.+]] = arith.cmpi slt, [[VAR_0_]], [[VAR_1_]] : tensor<64xi32>
+// CHECK-DAG:       [[VAR_3_:%.+]] = tts.make_tptr [[PARAM_0_]] to sizes: [64], strides: [1], offsets: [0], shape: [0], order: [] : <i32> to tensor<64x!tt.ptr<i32>>
+// CHECK:           [[VAR_4_:%.+]] = "tts.load"([[VAR_3_]]
+// CHECK:           [[VAR_5_:%.+]] = tts.gather [[PARAM_1_]]{{.}}[[VAR_4_]]{{.}}, mask = [[VAR_2_]], other = [[VAR_cst_]] : (!tt.ptr<f32>, tensor<64xi32>, tensor<64xi1>, tensor<64xf32>) -> tensor<64xf32>
+// CHECK:           tts.scatter [[PARAM_2_]]{{.}}[[VAR_4_]]{{.}}, [[VAR_5_]], mask = [[VAR_2_]] : (!tt.ptr<f32>, tensor<64xi32>, tensor<64xf32>, tensor<64xi1>) -> ()
+// CHECK-NOT:       tt.load
+// CHECK-NOT:       tt.store
+// CHECK:           tt.return
+// CHECK:         }
@@ -29,8 +29,6 @@ module {
 // CHECK-DAG:       [[CST_1024_1_:%.+]] = arith.constant 1024 : i32
 // CHECK-DAG:       [[VAR_0_:%.+]] = tt.get_program_id x : i32
 // CHECK:           [[VAR_1_:%.+]] = arith.muli [[VAR_0_]], [[CST_1024_1_]] : i32
-// CHECK-DAG:       [[VAR_2_:%.+]] = arith.index_cast [[VAR_1_]] : i32 to index
-// CHECK-DAG:       [[VAR_3_:%.+]] = arith.index_cast [[VAR_1_]] : i32 to index
 // CHECK-DAG:       [[VAR_4_:%.+]] = arith.index_cast [[VAR_1_]] : i32 to index
 // CHECK-NOT: separator of consecutive DAGs
 // CHECK-DAG:       [[VAR_5_:%.+]] = tts.make_tptr [[PARAM_0_]] to sizes: [1024], strides: [1], offsets: {{.}}[[VAR_4_]]{{.}}, shape: [0], order: [] : <f32> to tensor<1024x!tt.ptr<f32>>
@@ -42,7 +40,7 @@ module {
 // CHECK:           [[VAR_10_:%.+]] = arith.maxsi [[VAR_9_]], [[VAR_6_]] : index
 // CHECK:           [[VAR_11_:%.+]] = arith.subi [[VAR_10_]], [[VAR_6_]] : index
 // CHECK-DAG:       [[VAR_12_:%.+]] = "tts.load"([[VAR_5_]], [[VAR_11_]]) <{operandSegmentSizes = array<i32: 1, 1, 0>, static_mask_dims = array<i64: -9223372036854775808>}> : (tensor<1024x!tt.ptr<f32>>, index) -> tensor<1024xf32>
-// CHECK-DAG:       [[VAR_13_:%.+]] = tts.make_tptr [[PARAM_1_]] to sizes: [1024], strides: [1], offsets: {{.}}[[VAR_3_]]{{.}}, shape: [0], order: [] : <f32> to tensor<1024x!tt.ptr<f32>>
+// CHECK-DAG:       [[VAR_13_:%.+]] = tts.make_tptr [[PARAM_1_]] to sizes: [1024], strides: [1], offsets: {{.}}[[VAR_4_]]{{.}}, shape: [0], order: [] : <f32> to tensor<1024x!tt.ptr<f32>>
 // CHECK-DAG:       [[VAR_14_:%.+]] = arith.index_cast [[VAR_1_]] : i32 to index
 // CHECK-NOT: separator of consecutive DAGs
 // CHECK-DAG:       [[VAR_15_:%.+]] = arith.addi [[VAR_14_]], [[CST_1024_]] : index
@@ -52,7 +50,7 @@ module {
 // CHECK:           [[VAR_19_:%.+]] = arith.subi [[VAR_18_]], [[VAR_14_]] : index
 // CHECK:           [[VAR_20_:%.+]] = "tts.load"([[VAR_13_]], [[VAR_19_]]) <{operandSegmentSizes = array<i32: 1, 1, 0>, static_mask_dims = array<i64: -9223372036854775808>}> : (tensor<1024x!tt.ptr<f32>>, index) -> tensor<1024xf32>
 // CHECK-DAG:       [[VAR_21_:%.+]] = arith.addf [[VAR_12_]], [[VAR_20_]] : tensor<1024xf32>
-// CHECK-DAG:       [[VAR_22_:%.+]] = tts.make_tptr [[PARAM_2_]] to sizes: [1024], strides: [1], offsets: {{.}}[[VAR_2_]]{{.}}, shape: [0], order: [] : <f32> to tensor<1024x!tt.ptr<f32>>
+// CHECK-DAG:       [[VAR_22_:%.+]] = tts.make_tptr [[PARAM_2_]] to sizes: [1024], strides: [1], offsets: {{.}}[[VAR_4_]]{{.}}, shape: [0], order: [] : <f32> to tensor<1024x!tt.ptr<f32>>
 // CHECK-DAG:       [[VAR_23_:%.+]] = arith.index_cast [[VAR_1_]] : i32 to index
 // CHECK-NOT: separator of consecutive DAGs
 // CHECK-DAG:       [[VAR_24_:%.+]] = arith.addi [[VAR_23_]], [[CST_1024_]] : index
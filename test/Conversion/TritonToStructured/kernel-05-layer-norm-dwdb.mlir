@@ -68,9 +68,6 @@ module {
 // CHECK-DAG:       [[CST_256_1_:%.+]] = arith.constant 256 : i32
 // CHECK-DAG:       [[VAR_0_:%.+]] = tt.get_program_id x : i32
 // CHECK:           [[VAR_1_:%.+]] = arith.muli [[VAR_0_]], [[CST_256_1_]] : i32
-// CHECK-DAG:       [[VAR_2_:%.+]] = arith.index_cast [[VAR_1_]] : i32 to index
-// CHECK-DAG:       [[VAR_3_:%.+]] = arith.index_cast [[VAR_1_]] : i32 to index
-// CHECK-DAG:       [[VAR_4_:%.+]] = arith.index_cast [[VAR_1_]] : i32 to index
 // CHECK-DAG:       [[VAR_5_:%.+]] = arith.index_cast [[VAR_1_]] : i32 to index
 // CHECK-DAG:       [[VAR_6_:%.+]]:2 = scf.for [[VAR_arg6_:%.+]] = [[CST_0_]] to [[PARAM_4_]] step [[CST_256_1_]] iter_args([[VAR_arg7_:%.+]] = [[VAR_cst_0_]], [[VAR_arg8_:%.+]] = [[VAR_cst_0_]]) -> (tensor<256x256xf32>, tensor<256x256xf32>)  : i32 {
 // CHECK-DAG:         [[VAR_23_:%.+]] = arith.index_cast [[VAR_arg6_]] : i32 to index
@@ -95,10 +92,7 @@ module {
 // CHECK:             [[VAR_40_:%.+]] = arith.minsi [[VAR_38_]], [[CST_256_]] : index
 // CHECK:             [[VAR_41_:%.+]] = "tts.load"([[VAR_26_]], [[VAR_39_]], [[VAR_40_]], [[CST_0_dot_000000_]]) <{operandSegmentSizes = array<i32: 1, 2, 1>, static_mask_dims = array<i64: -9223372036854775808, -9223372036854775808>}> : (tensor<256x256x!tt.ptr<f32>>, index, index, f32) -> tensor<256x256xf32>
 // CHECK-DAG:         [[VAR_42_:%.+]] = arith.addf [[VAR_arg7_]], [[VAR_41_]] : tensor<256x256xf32>
-// CHECK-DAG:         [[VAR_43_:%.+]] = arith.index_cast [[VAR_arg6_]] : i32 to index
-// CHECK-DAG:         [[VAR_44_:%.+]] = arith.index_cast [[PARAM_5_]] : i32 to index
-// CHECK:             [[VAR_45_:%.+]] = arith.muli [[VAR_43_]], [[VAR_44_]] : index
-// CHECK-DAG:         [[VAR_46_:%.+]] = tts.make_tptr [[PARAM_1_]] to sizes: [256, 256], strides: {{.}}[[VAR_44_]], 1], offsets: {{.}}[[VAR_45_]], [[VAR_4_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<256x256x!tt.ptr<f32>>
+// CHECK-DAG:         [[VAR_46_:%.+]] = tts.make_tptr [[PARAM_1_]] to sizes: [256, 256], strides: {{.}}[[VAR_24_]], 1], offsets: {{.}}[[VAR_25_]], [[VAR_5_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<256x256x!tt.ptr<f32>>
 // CHECK-DAG:         [[VAR_47_:%.+]] = arith.index_cast [[VAR_arg6_]] : i32 to index
 // CHECK-NOT: separator of consecutive DAGs
 // CHECK-DAG:         [[VAR_48_:%.+]] = arith.addi [[VAR_47_]], [[CST_256_]] : index
@@ -129,7 +123,7 @@ module {
 // CHECK:             [[VAR_23_2_:%.+]] = arith.addf [[VAR_arg6_1_]], [[VAR_arg7_1_]] : f32
 // CHECK:             tt.reduce.return [[VAR_23_2_]] : f32
 // CHECK:           }) : (tensor<256x256xf32>) -> tensor<256xf32>
-// CHECK-DAG:       [[VAR_9_:%.+]] = tts.make_tptr [[PARAM_2_]] to sizes: [256], strides: [1], offsets: {{.}}[[VAR_3_]]{{.}}, shape: [0], order: [] : <f32> to tensor<256x!tt.ptr<f32>>
+// CHECK-DAG:       [[VAR_9_:%.+]] = tts.make_tptr [[PARAM_2_]] to sizes: [256], strides: [1], offsets: {{.}}[[VAR_5_]]{{.}}, shape: [0], order: [] : <f32> to tensor<256x!tt.ptr<f32>>
 // CHECK-DAG:       [[VAR_10_:%.+]] = arith.index_cast [[VAR_1_]] : i32 to index
 // CHECK-NOT: separator of consecutive DAGs
 // CHECK-DAG:       [[VAR_11_:%.+]] = arith.addi [[VAR_10_]], [[CST_256_]] : index
@@ -138,7 +132,7 @@ module {
 // CHECK:           [[VAR_14_:%.+]] = arith.maxsi [[VAR_13_]], [[VAR_10_]] : index
 // CHECK:           [[VAR_15_:%.+]] = arith.subi [[VAR_14_]], [[VAR_10_]] : index
 // CHECK:           "tts.store"([[VAR_9_]], [[VAR_7_]], [[VAR_15_]]) <{static_mask_dims = array<i64: -9223372036854775808>}> : (tensor<256x!tt.ptr<f32>>, tensor<256xf32>, index) -> ()
-// CHECK-DAG:       [[VAR_16_:%.+]] = tts.make_tptr [[PARAM_3_]] to sizes: [256], strides: [1], offsets: {{.}}[[VAR_2_]]{{.}}, shape: [0], order: [] : <f32> to tensor<256x!tt.ptr<f32>>
+// CHECK-DAG:       [[VAR_16_:%.+]] = tts.make_tptr [[PARAM_3_]] to sizes: [256], strides: [1], offsets: {{.}}[[VAR_5_]]{{.}}, shape: [0], order: [] : <f32> to tensor<256x!tt.ptr<f32>>
 // CHECK-DAG:       [[VAR_17_:%.+]] = arith.index_cast [[VAR_1_]] : i32 to index
 // CHECK-NOT: separator of consecutive DAGs
 // CHECK-DAG:       [[VAR_18_:%.+]] = arith.addi [[VAR_17_]], [[CST_256_]] : index
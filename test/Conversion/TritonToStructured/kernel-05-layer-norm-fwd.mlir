@@ -98,7 +98,6 @@ module {
 // CHECK-DAG:       [[VAR_0_:%.+]] = tt.get_program_id x : i32
 // CHECK:           [[VAR_1_:%.+]] = arith.muli [[VAR_0_]], [[PARAM_6_]] : i32
 // CHECK-DAG:       [[VAR_2_:%.+]] = arith.index_cast [[VAR_1_]] : i32 to index
-// CHECK-DAG:       [[VAR_3_:%.+]] = arith.index_cast [[VAR_1_]] : i32 to index
 // CHECK-DAG:       [[VAR_4_:%.+]] = scf.for [[VAR_arg9_:%.+]] = [[CST_0_]] to [[PARAM_7_]] step [[CST_256_1_]] iter_args([[VAR_arg10_:%.+]] = [[VAR_cst_0_]]) -> (tensor<256xf32>)  : i32 {
 // CHECK-DAG:         [[VAR_21_:%.+]] = arith.index_cast [[VAR_arg9_]] : i32 to index
 // CHECK:             [[VAR_22_:%.+]] = arith.addi [[VAR_2_]], [[VAR_21_]] : index
@@ -172,9 +171,8 @@ module {
 // CHECK:             [[VAR_27_2_:%.+]] = arith.maxsi [[VAR_26_2_]], [[VAR_23_2_]] : index
 // CHECK:             [[VAR_28_2_:%.+]] = arith.subi [[VAR_27_2_]], [[VAR_23_2_]] : index
 // CHECK-DAG:         [[VAR_29_2_:%.+]] = "tts.load"([[VAR_22_2_]], [[VAR_28_2_]]) <{operandSegmentSizes = array<i32: 1, 1, 0>, static_mask_dims = array<i64: -9223372036854775808>}> : (tensor<256x!tt.ptr<f32>>, index) -> tensor<256xf32>
-// CHECK-DAG:         [[VAR_30_2_:%.+]] = arith.index_cast [[VAR_arg9_2_1_]] : i32 to index
 // CHECK-NOT: separator of consecutive DAGs
-// CHECK-DAG:         [[VAR_31_2_:%.+]] = tts.make_tptr [[PARAM_3_]] to sizes: [256], strides: [1], offsets: {{.}}[[VAR_30_2_]]{{.}}, shape: [0], order: [] : <f32> to tensor<256x!tt.ptr<f32>>
+// CHECK-DAG:         [[VAR_31_2_:%.+]] = tts.make_tptr [[PARAM_3_]] to sizes: [256], strides: [1], offsets: {{.}}[[VAR_21_4_]]{{.}}, shape: [0], order: [] : <f32> to tensor<256x!tt.ptr<f32>>
 // CHECK-DAG:         [[VAR_32_1_:%.+]] = arith.index_cast [[VAR_arg9_2_1_]] : i32 to index
 // CHECK-NOT: separator of consecutive DAGs
 // CHECK-DAG:         [[VAR_33_1_:%.+]] = arith.addi [[VAR_32_1_]], [[CST_256_]] : index
@@ -183,8 +181,7 @@ module {
 // CHECK:             [[VAR_36_1_:%.+]] = arith.maxsi [[VAR_35_1_]], [[VAR_32_1_]] : index
 // CHECK:             [[VAR_37_1_:%.+]] = arith.subi [[VAR_36_1_]], [[VAR_32_1_]] : index
 // CHECK-DAG:         [[VAR_38_:%.+]] = "tts.load"([[VAR_31_2_]], [[VAR_37_1_]]) <{operandSegmentSizes = array<i32: 1, 1, 0>, static_mask_dims = array<i64: -9223372036854775808>}> : (tensor<256x!tt.ptr<f32>>, index) -> tensor<256xf32>
-// CHECK-DAG:         [[VAR_39_:%.+]] = arith.index_cast [[VAR_arg9_2_1_]] : i32 to index
-// CHECK:             [[VAR_40_:%.+]] = arith.addi [[VAR_2_]], [[VAR_39_]] : index
+// CHECK:             [[VAR_40_:%.+]] = arith.addi [[VAR_2_]], [[VAR_21_4_]] : index
 // CHECK-DAG:         [[VAR_41_:%.+]] = tts.make_tptr [[PARAM_0_]] to sizes: [256], strides: [1], offsets: {{.}}[[VAR_40_]]{{.}}, shape: [0], order: [] : <f32> to tensor<256x!tt.ptr<f32>>
 // CHECK-DAG:         [[VAR_42_:%.+]] = arith.index_cast [[VAR_arg9_2_1_]] : i32 to index
 // CHECK-NOT: separator of consecutive DAGs
@@ -198,8 +195,7 @@ module {
 // CHECK:             [[VAR_50_:%.+]] = arith.mulf [[VAR_49_]], [[VAR_20_]] : tensor<256xf32>
 // CHECK:             [[VAR_51_:%.+]] = arith.mulf [[VAR_50_]], [[VAR_29_2_]] : tensor<256xf32>
 // CHECK-DAG:         [[VAR_52_:%.+]] = arith.addf [[VAR_51_]], [[VAR_38_]] : tensor<256xf32>
-// CHECK-DAG:         [[VAR_53_:%.+]] = arith.index_cast [[VAR_arg9_2_1_]] : i32 to index
-// CHECK:             [[VAR_54_:%.+]] = arith.addi [[VAR_3_]], [[VAR_53_]] : index
+// CHECK:             [[VAR_54_:%.+]] = arith.addi [[VAR_2_]], [[VAR_21_4_]] : index
 // CHECK-DAG:         [[VAR_55_:%.+]] = tts.make_tptr [[PARAM_1_]] to sizes: [256], strides: [1], offsets: {{.}}[[VAR_54_]]{{.}}, shape: [0], order: [] : <f32> to tensor<256x!tt.ptr<f32>>
 // CHECK-DAG:         [[VAR_56_:%.+]] = arith.index_cast [[VAR_arg9_2_1_]] : i32 to index
 // CHECK-NOT: separator of consecutive DAGs
@@ -0,0 +1,354 @@
+// RUN: triton-shared-opt --split-input-file --triton-to-structured --remove-dead-values --canonicalize %s | FileCheck %s
+// RUN: triton-shared-opt --split-input-file --triton-to-structured %s 2>&1 >/dev/null | FileCheck %s --check-prefix=ERR
+
+module {
+  tt.func @kernel(
+  %arg0 : !tt.ptr<bf16>,
+  %arg1 : !tt.ptr<bf16>,
+  %arg2 : i32
+  )
+  {
+    %0 = tt.splat %arg0 : !tt.ptr<bf16> -> tensor<128x!tt.ptr<bf16>>
+    %1 = tt.splat %arg1 : !tt.ptr<bf16> -> tensor<128x!tt.ptr<bf16>>
+    %2 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+    %ldptr = tt.addptr %0, %2 : tensor<128x!tt.ptr<bf16>>, tensor<128xi32>
+    %stptr = tt.addptr %1, %2 : tensor<128x!tt.ptr<bf16>>, tensor<128xi32>
+    %nans = arith.constant dense<0xFF80> : tensor<128xbf16>
+    %false = arith.constant dense<false> : tensor<128xi1>
+    %c16 = arith.constant dense<16> : tensor<128xi32>
+    %5 = tt.splat %arg2 : i32 -> tensor<128xi32>
+    %lower = arith.cmpi sge, %2, %c16 : tensor<128xi32>
+    %upper = arith.cmpi slt, %2, %5 : tensor<128xi32>
+    %ldmask = arith.andi %lower, %upper : tensor<128xi1>
+    %buff = tt.load %ldptr, %ldmask, %nans : tensor<128x!tt.ptr<bf16>>
+    %stmask = arith.select %upper, %lower, %false : tensor<128xi1>, tensor<128xi1>
+    tt.store %stptr, %buff, %stmask : tensor<128x!tt.ptr<bf16>>
+    tt.return
+  }
+}
+
+// CHECK:         tt.func @kernel([[PARAM_0_:%.+]]: !tt.ptr<bf16>, [[PARAM_1_:%.+]]: !tt.ptr<bf16>, [[PARAM_2_:%.+]]: i32) {
+// CHECK-DAG:       [[CST_0_:%.+]] = arith.constant 0xFF80 : bf16
+// CHECK-DAG:       [[VAR_ldptr_:%.+]] = tts.make_tptr [[PARAM_0_]] to sizes: [128], strides: [1], offsets: [{{.+}}], shape: [0], order: [] : <bf16> to tensor<128x!tt.ptr<bf16>>
+// CHECK:           [[VAR_load_:%.+]] = "tts.load"([[VAR_ldptr_]], [[VAR_ldsize_:%.+]], [[CST_0_]]) <{operandSegmentSizes = array<i32: 1, 1, 1>, static_mask_dims = array<i64: -9223372036854775808>}> : (tensor<128x!tt.ptr<bf16>>, index, bf16) -> tensor<128xbf16>
+// CHECK-DAG:       [[VAR_splat_:%.+]] = tt.splat [[CST_0_]] : bf16 -> tensor<128xbf16>
+// CHECK-DAG:       [[VAR_box_:%.+]] = tensor.extract_slice [[VAR_load_]][0] {{.}}[[VAR_ldsize_]]{{.}} [1] : tensor<128xbf16> to tensor<?xbf16>
+// CHECK:           [[VAR_buff_:%.+]] = tensor.insert_slice [[VAR_box_]] into [[VAR_splat_]][16] {{.}}[[VAR_ldsize_]]{{.}} [1] : tensor<?xbf16> into tensor<128xbf16>
+// CHECK-DAG:       [[VAR_stptr_:%.+]] = tts.make_tptr [[PARAM_1_]] to sizes: [128], strides: [1], offsets: [{{.+}}], shape: [0], order: [] : <bf16> to tensor<128x!tt.ptr<bf16>>
+// CHECK:           [[VAR_stbox_:%.+]] = tensor.extract_slice [[VAR_buff_]][16] {{.}}[[VAR_stsize_:%.+]]{{.}} [1] : tensor<128xbf16> to tensor<?xbf16>
+// CHECK:           [[VAR_val_:%.+]] = tensor.insert_slice [[VAR_stbox_]] into [[VAR_buff_]][0] {{.}}[[VAR_stsize_]]{{.}} [1] : tensor<?xbf16> into tensor<128xbf16>
+// CHECK:           "tts.store"([[VAR_stptr_]], [[VAR_val_]], [[VAR_stsize_]]) <{static_mask_dims = array<i64: -9223372036854775808>}> : (tensor<128x!tt.ptr<bf16>>, tensor<128xbf16>, index) -> ()
+// CHECK:           tt.return
+// CHECK:         }
+
+// -----
+
+// `offs < 32 || offs < 64` is the larger box.
+module {
+  tt.func @or_contained(%arg0 : !tt.ptr<f32>, %arg1 : !tt.ptr<f32>) {
+    %0 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %1 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %2 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+    %ldptr = tt.addptr %0, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %stptr = tt.addptr %1, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %val = tt.load %ldptr : tensor<128x!tt.ptr<f32>>
+    %c32 = arith.constant dense<32> : tensor<128xi32>
+    %c64 = arith.constant dense<64> : tensor<128xi32>
+    %lt32 = arith.cmpi slt, %2, %c32 : tensor<128xi32>
+    %lt64 = arith.cmpi slt, %2, %c64 : tensor<128xi32>
+    %mask = arith.ori %lt32, %lt64 : tensor<128xi1>
+    tt.store %stptr, %val, %mask : tensor<128x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:   tt.func @or_contained
+// CHECK-SAME:    ([[PARAM_0_:%.+]]: !tt.ptr<f32>, [[PARAM_1_:%.+]]: !tt.ptr<f32>) {
+// CHECK-DAG:       [[VAR_val_:%.+]] = "tts.load"
+// CHECK-DAG:       [[VAR_stptr_:%.+]] = tts.make_tptr [[PARAM_1_]] to sizes: [128], strides: [1], offsets: [0], shape: [0], order: [] : <f32> to tensor<128x!tt.ptr<f32>>
+// CHECK-NOT:       tensor.extract_slice
+// CHECK:           "tts.store"([[VAR_stptr_]], [[VAR_val_]]) <{static_mask_dims = array<i64: 64>}> : (tensor<128x!tt.ptr<f32>>, tensor<128xf32>) -> ()
+
+// -----
+
+// `16 <= offs < 48 || 48 <= offs < 80` is the box [16, 80).
+module {
+  tt.func @or_adjacent(%arg0 : !tt.ptr<f32>, %arg1 : !tt.ptr<f32>) {
+    %0 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %1 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %2 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+    %ldptr = tt.addptr %0, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %stptr = tt.addptr %1, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %val = tt.load %ldptr : tensor<128x!tt.ptr<f32>>
+    %c16 = arith.constant dense<16> : tensor<128xi32>
+    %c48 = arith.constant dense<48> : tensor<128xi32>
+    %c80 = arith.constant dense<80> : tensor<128xi32>
+    %ge16 = arith.cmpi sge, %2, %c16 : tensor<128xi32>
+    %lt48 = arith.cmpi slt, %2, %c48 : tensor<128xi32>
+    %ge48 = arith.cmpi sge, %2, %c48 : tensor<128xi32>
+    %lt80 = arith.cmpi slt, %2, %c80 : tensor<128xi32>
+    %lo = arith.andi %ge16, %lt48 : tensor<128xi1>
+    %hi = arith.andi %ge48, %lt80 : tensor<128xi1>
+    %mask = arith.ori %lo, %hi : tensor<128xi1>
+    tt.store %stptr, %val, %mask : tensor<128x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:   tt.func @or_adjacent
+// CHECK-SAME:    ([[PARAM_0_:%.+]]: !tt.ptr<f32>, [[PARAM_1_:%.+]]: !tt.ptr<f32>) {
+// CHECK:           [[VAR_val_:%.+]] = "tts.load"
+// CHECK:           [[VAR_stptr_:%.+]] = tts.make_tptr [[PARAM_1_]] to sizes: [128], strides: [1], offsets: [{{.+}}], shape: [0], order: [] : <f32> to tensor<128x!tt.ptr<f32>>
+// CHECK:           [[VAR_box_:%.+]] = tensor.extract_slice [[VAR_val_]][16] [64] [1] : tensor<128xf32> to tensor<64xf32>
+// CHECK:           [[VAR_moved_:%.+]] = tensor.insert_slice [[VAR_box_]] into [[VAR_val_]][0] [64] [1] : tensor<64xf32> into tensor<128xf32>
+// CHECK:           "tts.store"([[VAR_stptr_]], [[VAR_moved_]]) <{static_mask_dims = array<i64: 64>}> : (tensor<128x!tt.ptr<f32>>, tensor<128xf32>) -> ()
+
+// -----
+
+// `offs < 16 || offs >= 32` leaves a hole and is not a box.
+module {
+  tt.func @or_not_contiguous(%arg0 : !tt.ptr<f32>, %arg1 : !tt.ptr<f32>) {
+    %0 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %1 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %2 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+    %ldptr = tt.addptr %0, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %stptr = tt.addptr %1, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %val = tt.load %ldptr : tensor<128x!tt.ptr<f32>>
+    %c16 = arith.constant dense<16> : tensor<128xi32>
+    %c32 = arith.constant dense<32> : tensor<128xi32>
+    %lt16 = arith.cmpi slt, %2, %c16 : tensor<128xi32>
+    %ge32 = arith.cmpi sge, %2, %c32 : tensor<128xi32>
+    %mask = arith.ori %lt16, %ge32 : tensor<128xi1>
+    tt.store %stptr, %val, %mask : tensor<128x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:   tt.func @or_not_contiguous
+// CHECK-SAME:    ([[PARAM_0_:%.+]]: !tt.ptr<f32>, [[PARAM_1_:%.+]]: !tt.ptr<f32>) {
+// CHECK:           tt.store
+// CHECK-NOT:       "tts.store"
+
+// ERR:             error: Unsupported ori of masks whose union is not contiguous
+// ERR:             remark: MaskAnalysis failed
+
+// -----
+
+// `select(offs < 32, true, 32 <= offs < 64)` is `offs < 64`.
+module {
+  tt.func @select_or(%arg0 : !tt.ptr<f32>, %arg1 : !tt.ptr<f32>) {
+    %0 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %1 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %2 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+    %ldptr = tt.addptr %0, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %stptr = tt.addptr %1, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %val = tt.load %ldptr : tensor<128x!tt.ptr<f32>>
+    %true = arith.constant dense<true> : tensor<128xi1>
+    %c32 = arith.constant dense<32> : tensor<128xi32>
+    %c64 = arith.constant dense<64> : tensor<128xi32>
+    %lt32 = arith.cmpi slt, %2, %c32 : tensor<128xi32>
+    %ge32 = arith.cmpi sge, %2, %c32 : tensor<128xi32>
+    %lt64 = arith.cmpi slt, %2, %c64 : tensor<128xi32>
+    %mid = arith.andi %ge32, %lt64 : tensor<128xi1>
+    %mask = arith.select %lt32, %true, %mid : tensor<128xi1>, tensor<128xi1>
+    tt.store %stptr, %val, %mask : tensor<128x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:   tt.func @select_or
+// CHECK-SAME:    ([[PARAM_0_:%.+]]: !tt.ptr<f32>, [[PARAM_1_:%.+]]: !tt.ptr<f32>) {
+// CHECK-DAG:       [[VAR_val_:%.+]] = "tts.load"
+// CHECK-DAG:       [[VAR_stptr_:%.+]] = tts.make_tptr [[PARAM_1_]] to sizes: [128], strides: [1], offsets: [0], shape: [0], order: [] : <f32> to tensor<128x!tt.ptr<f32>>
+// CHECK-NOT:       tensor.extract_slice
+// CHECK:           "tts.store"([[VAR_stptr_]], [[VAR_val_]]) <{static_mask_dims = array<i64: 64>}> : (tensor<128x!tt.ptr<f32>>, tensor<128xf32>) -> ()
+
+// -----
+
+// `offs > 15 && offs <= 99` is the box [16, 100).
+module {
+  tt.func @sgt_sle(%arg0 : !tt.ptr<f32>, %arg1 : !tt.ptr<f32>) {
+    %0 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %1 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %2 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+    %ldptr = tt.addptr %0, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %stptr = tt.addptr %1, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %val = tt.load %ldptr : tensor<128x!tt.ptr<f32>>
+    %c15 = arith.constant dense<15> : tensor<128xi32>
+    %c99 = arith.constant dense<99> : tensor<128xi32>
+    %gt15 = arith.cmpi sgt, %2, %c15 : tensor<128xi32>
+    %le99 = arith.cmpi sle, %2, %c99 : tensor<128xi32>
+    %mask = arith.andi %gt15, %le99 : tensor<128xi1>
+    tt.store %stptr, %val, %mask : tensor<128x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:   tt.func @sgt_sle
+// CHECK-SAME:    ([[PARAM_0_:%.+]]: !tt.ptr<f32>, [[PARAM_1_:%.+]]: !tt.ptr<f32>) {
+// CHECK:           [[VAR_val_:%.+]] = "tts.load"
+// CHECK:           [[VAR_stptr_:%.+]] = tts.make_tptr [[PARAM_1_]] to sizes: [128], strides: [1], offsets: [{{.+}}], shape: [0], order: [] : <f32> to tensor<128x!tt.ptr<f32>>
+// CHECK:           [[VAR_box_:%.+]] = tensor.extract_slice [[VAR_val_]][16] [84] [1] : tensor<128xf32> to tensor<84xf32>
+// CHECK:           [[VAR_moved_:%.+]] = tensor.insert_slice [[VAR_box_]] into [[VAR_val_]][0] [84] [1] : tensor<84xf32> into tensor<128xf32>
+// CHECK:           "tts.store"([[VAR_stptr_]], [[VAR_moved_]]) <{static_mask_dims = array<i64: 84>}> : (tensor<128x!tt.ptr<f32>>, tensor<128xf32>) -> ()
+
+// -----
+
+// Unsigned bounds: `offs >=u 16 && offs <u 100` is the box [16, 100).
+module {
+  tt.func @unsigned(%arg0 : !tt.ptr<f32>, %arg1 : !tt.ptr<f32>) {
+    %0 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %1 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %2 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+    %ldptr = tt.addptr %0, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %stptr = tt.addptr %1, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %val = tt.load %ldptr : tensor<128x!tt.ptr<f32>>
+    %c16 = arith.constant dense<16> : tensor<128xi32>
+    %c100 = arith.constant dense<100> : tensor<128xi32>
+    %ge16 = arith.cmpi uge, %2, %c16 : tensor<128xi32>
+    %lt100 = arith.cmpi ult, %2, %c100 : tensor<128xi32>
+    %mask = arith.andi %ge16, %lt100 : tensor<128xi1>
+    tt.store %stptr, %val, %mask : tensor<128x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:   tt.func @unsigned
+// CHECK-SAME:    ([[PARAM_0_:%.+]]: !tt.ptr<f32>, [[PARAM_1_:%.+]]: !tt.ptr<f32>) {
+// CHECK:           [[VAR_val_:%.+]] = "tts.load"
+// CHECK:           [[VAR_stptr_:%.+]] = tts.make_tptr [[PARAM_1_]] to sizes: [128], strides: [1], offsets: [{{.+}}], shape: [0], order: [] : <f32> to tensor<128x!tt.ptr<f32>>
+// CHECK:           [[VAR_box_:%.+]] = tensor.extract_slice [[VAR_val_]][16] [84] [1] : tensor<128xf32> to tensor<84xf32>
+// CHECK:           [[VAR_moved_:%.+]] = tensor.insert_slice [[VAR_box_]] into [[VAR_val_]][0] [84] [1] : tensor<84xf32> into tensor<128xf32>
+// CHECK:           "tts.store"([[VAR_stptr_]], [[VAR_moved_]]) <{static_mask_dims = array<i64: 84>}> : (tensor<128x!tt.ptr<f32>>, tensor<128xf32>) -> ()
+
+// -----
+
+// Bounds written with the scalar on the left: `16 <= offs && 100 > offs`.
+module {
+  tt.func @scalar_lhs(%arg0 : !tt.ptr<f32>, %arg1 : !tt.ptr<f32>) {
+    %0 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %1 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %2 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+    %ldptr = tt.addptr %0, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %stptr = tt.addptr %1, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %val = tt.load %ldptr : tensor<128x!tt.ptr<f32>>
+    %c16 = arith.constant dense<16> : tensor<128xi32>
+    %c100 = arith.constant dense<100> : tensor<128xi32>
+    %ge16 = arith.cmpi sle, %c16, %2 : tensor<128xi32>
+    %lt100 = arith.cmpi sgt, %c100, %2 : tensor<128xi32>
+    %mask = arith.andi %ge16, %lt100 : tensor<128xi1>
+    tt.store %stptr, %val, %mask : tensor<128x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:   tt.func @scalar_lhs
+// CHECK-SAME:    ([[PARAM_0_:%.+]]: !tt.ptr<f32>, [[PARAM_1_:%.+]]: !tt.ptr<f32>) {
+// CHECK:           [[VAR_val_:%.+]] = "tts.load"
+// CHECK:           [[VAR_stptr_:%.+]] = tts.make_tptr [[PARAM_1_]] to sizes: [128], strides: [1], offsets: [{{.+}}], shape: [0], order: [] : <f32> to tensor<128x!tt.ptr<f32>>
+// CHECK:           [[VAR_box_:%.+]] = tensor.extract_slice [[VAR_val_]][16] [84] [1] : tensor<128xf32> to tensor<84xf32>
+// CHECK:           [[VAR_moved_:%.+]] = tensor.insert_slice [[VAR_box_]] into [[VAR_val_]][0] [84] [1] : tensor<84xf32> into tensor<128xf32>
+// CHECK:           "tts.store"([[VAR_stptr_]], [[VAR_moved_]]) <{static_mask_dims = array<i64: 84>}> : (tensor<128x!tt.ptr<f32>>, tensor<128xf32>) -> ()
+
+// -----
+
+// `(offs + 256) % 256 < 100`: the range stays within one period of the
+// divisor and is brought back to [0, 128).
+module {
+  tt.func @remsi(%arg0 : !tt.ptr<f32>, %arg1 : !tt.ptr<f32>) {
+    %0 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %1 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %2 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+    %ldptr = tt.addptr %0, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %stptr = tt.addptr %1, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %val = tt.load %ldptr : tensor<128x!tt.ptr<f32>>
+    %c256 = arith.constant dense<256> : tensor<128xi32>
+    %c100 = arith.constant dense<100> : tensor<128xi32>
+    %shifted = arith.addi %2, %c256 : tensor<128xi32>
+    %rem = arith.remsi %shifted, %c256 : tensor<128xi32>
+    %mask = arith.cmpi slt, %rem, %c100 : tensor<128xi32>
+    tt.store %stptr, %val, %mask : tensor<128x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:   tt.func @remsi
+// CHECK-SAME:    ([[PARAM_0_:%.+]]: !tt.ptr<f32>, [[PARAM_1_:%.+]]: !tt.ptr<f32>) {
+// CHECK-DAG:       [[VAR_val_:%.+]] = "tts.load"
+// CHECK-DAG:       [[VAR_stptr_:%.+]] = tts.make_tptr [[PARAM_1_]] to sizes: [128], strides: [1], offsets: [0], shape: [0], order: [] : <f32> to tensor<128x!tt.ptr<f32>>
+// CHECK-NOT:       tensor.extract_slice
+// CHECK:           "tts.store"([[VAR_stptr_]], [[VAR_val_]]) <{static_mask_dims = array<i64: 100>}> : (tensor<128x!tt.ptr<f32>>, tensor<128xf32>) -> ()
+
+// -----
+
+// `(offs + 192) % 256 < 100`: the range [192, 320) wraps around at 256.
+module {
+  tt.func @remsi_wraparound(%arg0 : !tt.ptr<f32>, %arg1 : !tt.ptr<f32>) {
+    %0 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %1 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %2 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+    %ldptr = tt.addptr %0, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %stptr = tt.addptr %1, %2 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %val = tt.load %ldptr : tensor<128x!tt.ptr<f32>>
+    %c192 = arith.constant dense<192> : tensor<128xi32>
+    %c256 = arith.constant dense<256> : tensor<128xi32>
+    %c100 = arith.constant dense<100> : tensor<128xi32>
+    %shifted = arith.addi %2, %c192 : tensor<128xi32>
+    %rem = arith.remsi %shifted, %c256 : tensor<128xi32>
+    %mask = arith.cmpi slt, %rem, %c100 : tensor<128xi32>
+    tt.store %stptr, %val, %mask : tensor<128x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:   tt.func @remsi_wraparound
+// CHECK-SAME:    ([[PARAM_0_:%.+]]: !tt.ptr<f32>, [[PARAM_1_:%.+]]: !tt.ptr<f32>) {
+// CHECK:           tt.store
+// CHECK-NOT:       "tts.store"
+
+// ERR:             error: Unsupported remsi of a range that may wrap around
+// ERR:             remark: MaskAnalysis failed
+
+// -----
+
+// The intersection of `rows >= 2`, `cols >= 4` and `rows < 6` is the box of
+// rows [2, 6) and columns [4, 16).
+module {
+  tt.func @intersect_2d(%arg0 : !tt.ptr<f32>, %arg1 : !tt.ptr<f32>) {
+    %c16 = arith.constant dense<16> : tensor<8x1xi32>
+    %c2 = arith.constant dense<2> : tensor<8x1xi32>
+    %c6 = arith.constant dense<6> : tensor<8x1xi32>
+    %c4 = arith.constant dense<4> : tensor<1x16xi32>
+    %0 = tt.make_range {end = 8 : i32, start = 0 : i32} : tensor<8xi32>
+    %1 = tt.make_range {end = 16 : i32, start = 0 : i32} : tensor<16xi32>
+    %rows = tt.expand_dims %0 {axis = 1 : i32} : tensor<8xi32> -> tensor<8x1xi32>
+    %cols = tt.expand_dims %1 {axis = 0 : i32} : tensor<16xi32> -> tensor<1x16xi32>
+    %2 = arith.muli %rows, %c16 : tensor<8x1xi32>
+    %3 = tt.broadcast %2 : tensor<8x1xi32> -> tensor<8x16xi32>
+    %4 = tt.broadcast %cols : tensor<1x16xi32> -> tensor<8x16xi32>
+    %index = arith.addi %3, %4 : tensor<8x16xi32>
+    %5 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<8x16x!tt.ptr<f32>>
+    %6 = tt.splat %arg1 : !tt.ptr<f32> -> tensor<8x16x!tt.ptr<f32>>
+    %ldptr = tt.addptr %5, %index : tensor<8x16x!tt.ptr<f32>>, tensor<8x16xi32>
+    %stptr = tt.addptr %6, %index : tensor<8x16x!tt.ptr<f32>>, tensor<8x16xi32>
+    %val = tt.load %ldptr : tensor<8x16x!tt.ptr<f32>>
+    %7 = arith.cmpi sge, %rows, %c2 : tensor<8x1xi32>
+    %rowlo = tt.broadcast %7 : tensor<8x1xi1> -> tensor<8x16xi1>
+    %8 = arith.cmpi sge, %cols, %c4 : tensor<1x16xi32>
+    %collo = tt.broadcast %8 : tensor<1x16xi1> -> tensor<8x16xi1>
+    %9 = arith.cmpi slt, %rows, %c6 : tensor<8x1xi32>
+    %rowhi = tt.broadcast %9 : tensor<8x1xi1> -> tensor<8x16xi1>
+    %lo = arith.andi %rowlo, %collo : tensor<8x16xi1>
+    %mask = arith.andi %lo, %rowhi : tensor<8x16xi1>
+    tt.store %stptr, %val, %mask : tensor<8x16x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// CHECK-LABEL:   tt.func @intersect_2d
+// CHECK-SAME:    ([[PARAM_0_:%.+]]: !tt.ptr<f32>, [[PARAM_1_:%.+]]: !tt.ptr<f32>) {
+// CHECK:           [[VAR_val_:%.+]] = "tts.load"
+// CHECK:           [[VAR_stptr_:%.+]] = tts.make_tptr [[PARAM_1_]] to sizes: [8, 16]
+// CHECK:           [[VAR_box_:%.+]] = tensor.extract_slice [[VAR_val_]][2, 4] [4, 12] [1, 1] : tensor<8x16xf32> to tensor<4x12xf32>
+// CHECK:           [[VAR_moved_:%.+]] = tensor.insert_slice [[VAR_box_]] into [[VAR_val_]][0, 0] [4, 12] [1, 1] : tensor<4x12xf32> into tensor<8x16xf32>
+// CHECK:           "tts.store"([[VAR_stptr_]], [[VAR_moved_]]) <{static_mask_dims = array<i64: 4, 12>}> : (tensor<8x16x!tt.ptr<f32>>, tensor<8x16xf32>) -> ()
@@ -163,42 +163,11 @@ module {
 // CHECK-DAG:       [[CST_2_:%.+]] = arith.constant 2 : i32
 // CHECK-DAG:       [[VAR_0_:%.+]] = arith.index_cast [[arg2_]] : i32 to index
 // CHECK-DAG:       [[VAR_1_:%.+]] = arith.index_cast [[arg3_]] : i32 to index
-// CHECK-DAG:       [[VAR_2_:%.+]] = arith.index_cast [[arg2_]] : i32 to index
-// CHECK-DAG:       [[VAR_3_:%.+]] = arith.index_cast [[arg3_]] : i32 to index
 // CHECK:           [[VAR_4_:%.+]] = arith.muli [[arg3_]], [[CST_2_]] : i32
 // CHECK-DAG:       [[VAR_5_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_6_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_7_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_8_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_9_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_10_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_11_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_12_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_13_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_14_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_15_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_16_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_17_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_18_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_19_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_20_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_21_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_22_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_23_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_24_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_25_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_26_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_27_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_28_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_29_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
-// CHECK-DAG:       [[VAR_30_:%.+]] = arith.index_cast [[VAR_4_]] : i32 to index
 // CHECK-DAG:       [[VAR_31_:%.+]] = arith.muli [[arg3_]], [[CST_2_]] : i32
 // CHECK-NOT: separator of consecutive DAGs
 // CHECK-DAG:       [[VAR_32_:%.+]] = arith.index_cast [[VAR_31_]] : i32 to index
-// CHECK-DAG:       [[VAR_33_:%.+]] = arith.index_cast [[VAR_31_]] : i32 to index
-// CHECK-DAG:       [[VAR_34_:%.+]] = arith.index_cast [[VAR_31_]] : i32 to index
-// CHECK-DAG:       [[VAR_35_:%.+]] = arith.index_cast [[VAR_31_]] : i32 to index
-// CHECK-DAG:       [[VAR_36_:%.+]] = arith.index_cast [[VAR_31_]] : i32 to index
 // CHECK-DAG:       [[VAR_37_:%.+]] = arith.muli [[arg3_]], [[CST_2_]] : i32
 // CHECK-NOT: separator of consecutive DAGs
 // CHECK-DAG:       [[VAR_38_:%.+]] = arith.index_cast [[VAR_37_]] : i32 to index
@@ -209,83 +178,83 @@ module {
 // CHECK-DAG:         [[VAR_42_:%.+]] = tts.make_tptr [[arg0_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_arg5_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:             [[VAR_43_:%.+]] = "tts.load"([[VAR_42_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK-DAG:         [[VAR_44_:%.+]]:3 = scf.for [[VAR_arg7_:%.+]] = [[CST_0_1_]] to [[CST_2_]] step [[CST_1_]] iter_args([[VAR_arg8_:%.+]] = [[VAR_arg5_]], [[VAR_arg9_:%.+]] = [[VAR_arg6_]], [[VAR_arg10_:%.+]] = [[VAR_43_]]) -> (index, index, tensor<2x2xf32>)  : i32 {
-// CHECK-DAG:           [[VAR_47_:%.+]] = arith.addi [[VAR_arg8_]], [[VAR_30_]] : index
+// CHECK-DAG:           [[VAR_47_:%.+]] = arith.addi [[VAR_arg8_]], [[VAR_5_]] : index
 // CHECK:               [[VAR_48_:%.+]] = tts.make_tptr [[arg0_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_47_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:               [[VAR_49_:%.+]] = "tts.load"([[VAR_48_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK-DAG:           [[VAR_50_:%.+]]:4 = scf.for [[VAR_arg11_:%.+]] = [[CST_0_1_]] to [[CST_2_]] step [[CST_1_]] iter_args([[VAR_arg12_:%.+]] = [[VAR_47_]], [[VAR_arg13_:%.+]] = [[VAR_arg9_]], [[VAR_arg14_:%.+]] = [[VAR_arg10_]], [[VAR_arg15_:%.+]] = [[VAR_49_]]) -> (index, index, tensor<2x2xf32>, tensor<2x2xf32>)  : i32 {
-// CHECK-DAG:             [[VAR_52_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_arg13_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
-// CHECK-DAG:             [[VAR_53_:%.+]] = arith.addi [[VAR_arg12_]], [[VAR_29_]] : index
+// CHECK-DAG:             [[VAR_52_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_arg13_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK-DAG:             [[VAR_53_:%.+]] = arith.addi [[VAR_arg12_]], [[VAR_5_]] : index
 // CHECK:                 [[VAR_54_:%.+]] = tts.make_tptr [[arg0_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_53_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                 [[VAR_55_:%.+]] = "tts.load"([[VAR_54_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK:                 "tts.store"([[VAR_52_]], [[VAR_arg14_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
-// CHECK:                 [[VAR_56_:%.+]] = arith.addi [[VAR_arg13_]], [[VAR_28_]] : index
-// CHECK:                 [[VAR_57_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_56_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK:                 [[VAR_56_:%.+]] = arith.addi [[VAR_arg13_]], [[VAR_5_]] : index
+// CHECK:                 [[VAR_57_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_56_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                 "tts.store"([[VAR_57_]], [[VAR_arg15_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
-// CHECK:                 [[VAR_58_:%.+]] = arith.addi [[VAR_56_]], [[VAR_27_]] : index
-// CHECK:                 [[VAR_59_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_58_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK:                 [[VAR_58_:%.+]] = arith.addi [[VAR_56_]], [[VAR_5_]] : index
+// CHECK:                 [[VAR_59_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_58_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                 "tts.store"([[VAR_59_]], [[VAR_55_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
-// CHECK:                 [[VAR_60_:%.+]] = arith.addi [[VAR_58_]], [[VAR_26_]] : index
+// CHECK:                 [[VAR_60_:%.+]] = arith.addi [[VAR_58_]], [[VAR_5_]] : index
 // CHECK-DAG:             [[VAR_61_:%.+]]:4 = scf.for [[VAR_arg16_:%.+]] = [[CST_0_1_]] to [[CST_2_]] step [[CST_1_]] iter_args([[VAR_arg17_:%.+]] = [[VAR_arg14_]], [[VAR_arg18_:%.+]] = [[VAR_53_]], [[VAR_arg19_:%.+]] = [[VAR_arg15_]], [[VAR_arg20_:%.+]] = [[VAR_60_]]) -> (tensor<2x2xf32>, index, tensor<2x2xf32>, index)  : i32 {
 // CHECK-DAG:               [[VAR_63_:%.+]] = tts.make_tptr [[arg0_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_arg18_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                   [[VAR_64_:%.+]] = "tts.load"([[VAR_63_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK-DAG:               [[VAR_65_:%.+]]:4 = scf.for [[VAR_arg21_:%.+]] = [[CST_0_1_]] to [[CST_2_]] step [[CST_1_]] iter_args([[VAR_arg22_:%.+]] = [[VAR_arg18_]], [[VAR_arg23_:%.+]] = [[VAR_arg19_]], [[VAR_arg24_:%.+]] = [[VAR_arg20_]], [[VAR_arg25_:%.+]] = [[VAR_64_]]) -> (index, tensor<2x2xf32>, index, tensor<2x2xf32>)  : i32 {
-// CHECK-DAG:                 [[VAR_66_:%.+]] = arith.addi [[VAR_arg22_]], [[VAR_25_]] : index
+// CHECK-DAG:                 [[VAR_66_:%.+]] = arith.addi [[VAR_arg22_]], [[VAR_5_]] : index
 // CHECK:                     [[VAR_67_:%.+]] = tts.make_tptr [[arg0_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_66_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                     [[VAR_68_:%.+]] = "tts.load"([[VAR_67_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK-DAG:                 [[VAR_69_:%.+]]:4 = scf.for [[VAR_arg26_:%.+]] = [[CST_0_1_]] to [[CST_2_]] step [[CST_1_]] iter_args([[VAR_arg27_:%.+]] = [[VAR_66_]], [[VAR_arg28_:%.+]] = [[VAR_arg24_]], [[VAR_arg29_:%.+]] = [[VAR_arg25_]], [[VAR_arg30_:%.+]] = [[VAR_68_]]) -> (index, index, tensor<2x2xf32>, tensor<2x2xf32>)  : i32 {
-// CHECK-DAG:                   [[VAR_70_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_arg28_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
-// CHECK-DAG:                   [[VAR_71_:%.+]] = arith.addi [[VAR_arg27_]], [[VAR_24_]] : index
+// CHECK-DAG:                   [[VAR_70_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_arg28_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK-DAG:                   [[VAR_71_:%.+]] = arith.addi [[VAR_arg27_]], [[VAR_5_]] : index
 // CHECK:                       [[VAR_72_:%.+]] = tts.make_tptr [[arg0_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_71_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                       [[VAR_73_:%.+]] = "tts.load"([[VAR_72_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK:                       "tts.store"([[VAR_70_]], [[VAR_arg29_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
-// CHECK:                       [[VAR_74_:%.+]] = arith.addi [[VAR_arg28_]], [[VAR_23_]] : index
-// CHECK:                       [[VAR_75_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_74_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK:                       [[VAR_74_:%.+]] = arith.addi [[VAR_arg28_]], [[VAR_5_]] : index
+// CHECK:                       [[VAR_75_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_74_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                       "tts.store"([[VAR_75_]], [[VAR_arg30_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
-// CHECK:                       [[VAR_76_:%.+]] = arith.addi [[VAR_74_]], [[VAR_22_]] : index
-// CHECK:                       [[VAR_77_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_76_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK:                       [[VAR_76_:%.+]] = arith.addi [[VAR_74_]], [[VAR_5_]] : index
+// CHECK:                       [[VAR_77_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_76_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                       "tts.store"([[VAR_77_]], [[VAR_73_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
-// CHECK:                       [[VAR_78_:%.+]] = arith.addi [[VAR_76_]], [[VAR_21_]] : index
+// CHECK:                       [[VAR_78_:%.+]] = arith.addi [[VAR_76_]], [[VAR_5_]] : index
 // CHECK-DAG:                   [[VAR_79_:%.+]]:4 = scf.for [[VAR_arg31_:%.+]] = [[CST_0_1_]] to [[CST_2_]] step [[CST_1_]] iter_args([[VAR_arg32_:%.+]] = [[VAR_arg29_]], [[VAR_arg33_:%.+]] = [[VAR_71_]], [[VAR_arg34_:%.+]] = [[VAR_arg30_]], [[VAR_arg35_:%.+]] = [[VAR_78_]]) -> (tensor<2x2xf32>, index, tensor<2x2xf32>, index)  : i32 {
 // CHECK-DAG:                     [[VAR_80_:%.+]] = tts.make_tptr [[arg0_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_arg33_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                         [[VAR_81_:%.+]] = "tts.load"([[VAR_80_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK-DAG:                     [[VAR_82_:%.+]]:4 = scf.for [[VAR_arg36_:%.+]] = [[CST_0_1_]] to [[CST_2_]] step [[CST_1_]] iter_args([[VAR_arg37_:%.+]] = [[VAR_arg33_]], [[VAR_arg38_:%.+]] = [[VAR_arg34_]], [[VAR_arg39_:%.+]] = [[VAR_arg35_]], [[VAR_arg40_:%.+]] = [[VAR_81_]]) -> (index, tensor<2x2xf32>, index, tensor<2x2xf32>)  : i32 {
-// CHECK-DAG:                       [[VAR_83_:%.+]] = arith.addi [[VAR_arg37_]], [[VAR_20_]] : index
+// CHECK-DAG:                       [[VAR_83_:%.+]] = arith.addi [[VAR_arg37_]], [[VAR_5_]] : index
 // CHECK:                           [[VAR_84_:%.+]] = tts.make_tptr [[arg0_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_83_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                           [[VAR_85_:%.+]] = "tts.load"([[VAR_84_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK-DAG:                       [[VAR_86_:%.+]]:4 = scf.for [[VAR_arg41_:%.+]] = [[CST_0_1_]] to [[CST_2_]] step [[CST_1_]] iter_args([[VAR_arg42_:%.+]] = [[VAR_83_]], [[VAR_arg43_:%.+]] = [[VAR_arg39_]], [[VAR_arg44_:%.+]] = [[VAR_arg40_]], [[VAR_arg45_:%.+]] = [[VAR_85_]]) -> (index, index, tensor<2x2xf32>, tensor<2x2xf32>)  : i32 {
-// CHECK-DAG:                         [[VAR_87_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_arg43_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
-// CHECK-DAG:                         [[VAR_88_:%.+]] = arith.addi [[VAR_arg42_]], [[VAR_19_]] : index
+// CHECK-DAG:                         [[VAR_87_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_arg43_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK-DAG:                         [[VAR_88_:%.+]] = arith.addi [[VAR_arg42_]], [[VAR_5_]] : index
 // CHECK:                             [[VAR_89_:%.+]] = tts.make_tptr [[arg0_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_88_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                             [[VAR_90_:%.+]] = "tts.load"([[VAR_89_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK:                             "tts.store"([[VAR_87_]], [[VAR_arg44_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
-// CHECK:                             [[VAR_91_:%.+]] = arith.addi [[VAR_arg43_]], [[VAR_18_]] : index
-// CHECK:                             [[VAR_92_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_91_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK:                             [[VAR_91_:%.+]] = arith.addi [[VAR_arg43_]], [[VAR_5_]] : index
+// CHECK:                             [[VAR_92_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_91_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                             "tts.store"([[VAR_92_]], [[VAR_arg45_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
-// CHECK:                             [[VAR_93_:%.+]] = arith.addi [[VAR_91_]], [[VAR_17_]] : index
-// CHECK:                             [[VAR_94_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_93_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK:                             [[VAR_93_:%.+]] = arith.addi [[VAR_91_]], [[VAR_5_]] : index
+// CHECK:                             [[VAR_94_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_93_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                             "tts.store"([[VAR_94_]], [[VAR_90_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
-// CHECK:                             [[VAR_95_:%.+]] = arith.addi [[VAR_93_]], [[VAR_16_]] : index
+// CHECK:                             [[VAR_95_:%.+]] = arith.addi [[VAR_93_]], [[VAR_5_]] : index
 // CHECK-DAG:                         [[VAR_96_:%.+]]:4 = scf.for [[VAR_arg46_:%.+]] = [[CST_0_1_]] to [[CST_2_]] step [[CST_1_]] iter_args([[VAR_arg47_:%.+]] = [[VAR_arg44_]], [[VAR_arg48_:%.+]] = [[VAR_88_]], [[VAR_arg49_:%.+]] = [[VAR_arg45_]], [[VAR_arg50_:%.+]] = [[VAR_95_]]) -> (tensor<2x2xf32>, index, tensor<2x2xf32>, index)  : i32 {
 // CHECK-DAG:                           [[VAR_97_:%.+]] = tts.make_tptr [[arg0_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_arg48_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK-NOT: separator of consecutive DAGs
 // CHECK-DAG:                           [[VAR_98_:%.+]] = "tts.load"([[VAR_97_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK-DAG:                           [[VAR_99_:%.+]]:3 = scf.for [[VAR_arg51_:%.+]] = [[CST_0_1_]] to [[CST_2_]] step [[CST_1_]] iter_args([[VAR_arg52_:%.+]] = [[VAR_arg48_]], [[VAR_arg53_:%.+]] = [[VAR_arg49_]], [[VAR_arg54_:%.+]] = [[VAR_arg50_]]) -> (index, tensor<2x2xf32>, index)  : i32 {
-// CHECK-DAG:                             [[VAR_100_:%.+]] = arith.addi [[VAR_arg52_]], [[VAR_15_]] : index
+// CHECK-DAG:                             [[VAR_100_:%.+]] = arith.addi [[VAR_arg52_]], [[VAR_5_]] : index
 // CHECK:                                 [[VAR_101_:%.+]] = tts.make_tptr [[arg0_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_100_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK-DAG:                             [[VAR_102_:%.+]] = "tts.load"([[VAR_101_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK-DAG:                             [[VAR_103_:%.+]]:2 = scf.for [[VAR_arg55_:%.+]] = [[CST_0_1_]] to [[CST_2_]] step [[CST_1_]] iter_args([[VAR_arg56_:%.+]] = [[VAR_100_]], [[VAR_arg57_:%.+]] = [[VAR_arg54_]]) -> (index, index)  : i32 {
-// CHECK-DAG:                               [[VAR_104_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_arg57_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
-// CHECK-DAG:                               [[VAR_105_:%.+]] = arith.addi [[VAR_arg56_]], [[VAR_14_]] : index
+// CHECK-DAG:                               [[VAR_104_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_arg57_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK-DAG:                               [[VAR_105_:%.+]] = arith.addi [[VAR_arg56_]], [[VAR_5_]] : index
 // CHECK:                                   [[VAR_106_:%.+]] = tts.make_tptr [[arg0_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_105_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                                   [[VAR_107_:%.+]] = "tts.load"([[VAR_106_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK:                                   "tts.store"([[VAR_104_]], [[VAR_98_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
-// CHECK:                                   [[VAR_108_:%.+]] = arith.addi [[VAR_arg57_]], [[VAR_13_]] : index
-// CHECK:                                   [[VAR_109_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_108_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK:                                   [[VAR_108_:%.+]] = arith.addi [[VAR_arg57_]], [[VAR_5_]] : index
+// CHECK:                                   [[VAR_109_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_108_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                                   "tts.store"([[VAR_109_]], [[VAR_102_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
-// CHECK:                                   [[VAR_110_:%.+]] = arith.addi [[VAR_108_]], [[VAR_12_]] : index
-// CHECK:                                   [[VAR_111_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_110_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK:                                   [[VAR_110_:%.+]] = arith.addi [[VAR_108_]], [[VAR_5_]] : index
+// CHECK:                                   [[VAR_111_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_110_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                                   "tts.store"([[VAR_111_]], [[VAR_107_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
-// CHECK:                                   [[VAR_112_:%.+]] = arith.addi [[VAR_110_]], [[VAR_11_]] : index
+// CHECK:                                   [[VAR_112_:%.+]] = arith.addi [[VAR_110_]], [[VAR_5_]] : index
 // CHECK:                                   scf.yield [[VAR_105_]], [[VAR_112_]] : index, index
 // CHECK:                                 }
 // CHECK:                                 scf.yield [[VAR_103_]]#0, [[VAR_102_]], [[VAR_103_]]#1 : index, tensor<2x2xf32>, index
@@ -309,22 +278,22 @@ module {
 // CHECK-NOT: separator of consecutive DAGs
 // CHECK-DAG:               [[VAR_64_1_:%.+]] = "tts.load"([[VAR_63_1_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK-DAG:               [[VAR_65_1_:%.+]]:3 = scf.for [[VAR_arg21_1_:%.+]] = [[CST_0_1_]] to [[CST_2_]] step [[CST_1_]] iter_args([[VAR_arg22_1_:%.+]] = [[VAR_arg18_1_]], [[VAR_arg23_1_:%.+]] = [[VAR_arg19_1_]], [[VAR_arg24_1_:%.+]] = [[VAR_arg20_1_]]) -> (index, tensor<2x2xf32>, index)  : i32 {
-// CHECK-DAG:                 [[VAR_66_1_:%.+]] = arith.addi [[VAR_arg22_1_]], [[VAR_10_]] : index
+// CHECK-DAG:                 [[VAR_66_1_:%.+]] = arith.addi [[VAR_arg22_1_]], [[VAR_5_]] : index
 // CHECK:                     [[VAR_67_1_:%.+]] = tts.make_tptr [[arg0_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_66_1_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK-DAG:                 [[VAR_68_1_:%.+]] = "tts.load"([[VAR_67_1_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK-DAG:                 [[VAR_69_1_:%.+]]:2 = scf.for [[VAR_arg25_1_:%.+]] = [[CST_0_1_]] to [[CST_2_]] step [[CST_1_]] iter_args([[VAR_arg26_1_:%.+]] = [[VAR_66_1_]], [[VAR_arg27_1_:%.+]] = [[VAR_arg24_1_]]) -> (index, index)  : i32 {
-// CHECK-DAG:                   [[VAR_70_1_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_arg27_1_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
-// CHECK-DAG:                   [[VAR_71_1_:%.+]] = arith.addi [[VAR_arg26_1_]], [[VAR_9_]] : index
+// CHECK-DAG:                   [[VAR_70_1_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_arg27_1_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK-DAG:                   [[VAR_71_1_:%.+]] = arith.addi [[VAR_arg26_1_]], [[VAR_5_]] : index
 // CHECK:                       [[VAR_72_1_:%.+]] = tts.make_tptr [[arg0_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_71_1_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                       [[VAR_73_1_:%.+]] = "tts.load"([[VAR_72_1_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK:                       "tts.store"([[VAR_70_1_]], [[VAR_64_1_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
-// CHECK:                       [[VAR_74_1_:%.+]] = arith.addi [[VAR_arg27_1_]], [[VAR_8_]] : index
-// CHECK:                       [[VAR_75_1_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_74_1_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK:                       [[VAR_74_1_:%.+]] = arith.addi [[VAR_arg27_1_]], [[VAR_5_]] : index
+// CHECK:                       [[VAR_75_1_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_74_1_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                       "tts.store"([[VAR_75_1_]], [[VAR_68_1_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
-// CHECK:                       [[VAR_76_1_:%.+]] = arith.addi [[VAR_74_1_]], [[VAR_7_]] : index
-// CHECK:                       [[VAR_77_1_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_76_1_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK:                       [[VAR_76_1_:%.+]] = arith.addi [[VAR_74_1_]], [[VAR_5_]] : index
+// CHECK:                       [[VAR_77_1_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_76_1_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                       "tts.store"([[VAR_77_1_]], [[VAR_73_1_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
-// CHECK:                       [[VAR_78_1_:%.+]] = arith.addi [[VAR_76_1_]], [[VAR_6_]] : index
+// CHECK:                       [[VAR_78_1_:%.+]] = arith.addi [[VAR_76_1_]], [[VAR_5_]] : index
 // CHECK:                       scf.yield [[VAR_71_1_]], [[VAR_78_1_]] : index, index
 // CHECK:                     }
 // CHECK:                     scf.yield [[VAR_69_1_]]#0, [[VAR_68_1_]], [[VAR_69_1_]]#1 : index, tensor<2x2xf32>, index
@@ -341,20 +310,20 @@ module {
 // CHECK-NOT: separator of consecutive DAGs
 // CHECK-DAG:           [[VAR_48_1_:%.+]] = "tts.load"([[VAR_47_1_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK-DAG:           [[VAR_49_1_:%.+]]:2 = scf.for [[VAR_arg10_1_:%.+]] = [[CST_0_1_]] to [[CST_2_]] step [[CST_1_]] iter_args([[VAR_arg11_1_:%.+]] = [[VAR_arg8_1_]], [[VAR_arg12_1_:%.+]] = [[VAR_arg9_1_]]) -> (index, index)  : i32 {
-// CHECK-DAG:             [[VAR_51_1_:%.+]] = arith.addi [[VAR_arg11_1_]], [[VAR_36_]] : index
+// CHECK-DAG:             [[VAR_51_1_:%.+]] = arith.addi [[VAR_arg11_1_]], [[VAR_32_]] : index
 // CHECK:                 [[VAR_52_1_:%.+]] = tts.make_tptr [[arg0_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_51_1_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK-DAG:             [[VAR_53_1_:%.+]] = "tts.load"([[VAR_52_1_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK-DAG:             [[VAR_54_1_:%.+]]:2 = scf.for [[VAR_arg13_1_:%.+]] = [[CST_0_1_]] to [[CST_2_]] step [[CST_1_]] iter_args([[VAR_arg14_1_:%.+]] = [[VAR_51_1_]], [[VAR_arg15_1_:%.+]] = [[VAR_arg12_1_]]) -> (index, index)  : i32 {
-// CHECK-DAG:               [[VAR_55_1_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_arg15_1_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
-// CHECK-DAG:               [[VAR_56_1_:%.+]] = arith.addi [[VAR_arg14_1_]], [[VAR_35_]] : index
+// CHECK-DAG:               [[VAR_55_1_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_arg15_1_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK-DAG:               [[VAR_56_1_:%.+]] = arith.addi [[VAR_arg14_1_]], [[VAR_32_]] : index
 // CHECK:                   [[VAR_57_1_:%.+]] = tts.make_tptr [[arg0_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_56_1_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                   [[VAR_58_1_:%.+]] = "tts.load"([[VAR_57_1_]]) <{operandSegmentSizes = array<i32: 1, 0, 0>, static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>) -> tensor<2x2xf32>
 // CHECK:                   "tts.store"([[VAR_55_1_]], [[VAR_48_1_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
-// CHECK:                   [[VAR_59_1_:%.+]] = arith.addi [[VAR_arg15_1_]], [[VAR_34_]] : index
-// CHECK:                   [[VAR_60_1_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_59_1_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK:                   [[VAR_59_1_:%.+]] = arith.addi [[VAR_arg15_1_]], [[VAR_32_]] : index
+// CHECK:                   [[VAR_60_1_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_59_1_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                   "tts.store"([[VAR_60_1_]], [[VAR_53_1_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
-// CHECK:                   [[VAR_61_1_:%.+]] = arith.addi [[VAR_59_1_]], [[VAR_33_]] : index
-// CHECK:                   [[VAR_62_1_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_2_]], [[VAR_3_]]{{.}}, offsets: {{.}}[[VAR_61_1_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
+// CHECK:                   [[VAR_61_1_:%.+]] = arith.addi [[VAR_59_1_]], [[VAR_32_]] : index
+// CHECK:                   [[VAR_62_1_:%.+]] = tts.make_tptr [[arg1_]] to sizes: [2, 2], strides: {{.}}[[VAR_0_]], [[VAR_1_]]{{.}}, offsets: {{.}}[[VAR_61_1_]], [[CST_0_]]{{.}}, shape: [0, 0], order: [] : <f32> to tensor<2x2x!tt.ptr<f32>>
 // CHECK:                   "tts.store"([[VAR_62_1_]], [[VAR_58_1_]]) <{static_mask_dims = array<i64>}> : (tensor<2x2x!tt.ptr<f32>>, tensor<2x2xf32>) -> ()
 // CHECK:                   [[VAR_63_2_:%.+]] = arith.addi [[VAR_61_1_]], [[VAR_32_]] : index
 // CHECK:                   scf.yield [[VAR_56_1_]], [[VAR_63_2_]] : index, index
@@ -0,0 +1,68 @@
+// RUN: triton-shared-opt --split-input-file --unify-returns %s | FileCheck %s
+
+module {
+  func.func @early_return(%arg0: memref<*xf32>, %arg1: memref<*xf32>, %arg2: i32, %arg3: i32, %arg4: i32, %arg5: i32, %arg6: i32, %arg7: i32) {
+    %cst = arith.constant -1.000000e+00 : f32
+    %0 = arith.index_cast %arg5 : i32 to index
+    %reinterpret_cast = memref.reinterpret_cast %arg0 to offset: [%0], sizes: [1], strides: [1] : memref<*xf32> to memref<1xf32, strided<[1], offset: ?>>
+    %1 = affine.load %reinterpret_cast[0] : memref<1xf32, strided<[1], offset: ?>>
+    %2 = arith.cmpf oeq, %1, %cst : f32
+    cf.cond_br %2, ^bb1, ^bb2
+  ^bb1:  // pred: ^bb0
+    return
+  ^bb2:  // pred: ^bb0
+    %3 = tensor.empty() : tensor<4xf32>
+    %4 = linalg.fill ins(%cst : f32) outs(%3 : tensor<4xf32>) -> tensor<4xf32>
+    %reinterpret_cast_0 = memref.reinterpret_cast %arg1 to offset: [0], sizes: [4], strides: [1] : memref<*xf32> to memref<4xf32, strided<[1]>>
+    bufferization.materialize_in_destination %4 in writable %reinterpret_cast_0 : (tensor<4xf32>, memref<4xf32, strided<[1]>>) -> ()
+    return
+  }
+}
+
+// CHECK-LABEL:  func.func @early_return
+// CHECK:           cf.cond_br {{%.+}}, ^bb1, ^bb2
+// CHECK:         ^bb1:
+// CHECK-NEXT:      cf.br ^bb3
+// CHECK:         ^bb2:
+// CHECK:           bufferization.materialize_in_destination
+// CHECK-NEXT:      cf.br ^bb3
+// CHECK:         ^bb3:
+// CHECK-NEXT:      return
+// CHECK-NOT:       return
+
+// -----
+
+// The returned values become arguments of the exit block.
+module {
+  func.func @select_value(%arg0: i1, %arg1: f32, %arg2: f32) -> f32 {
+    cf.cond_br %arg0, ^bb1, ^bb2
+  ^bb1:  // pred: ^bb0
+    return %arg1 : f32
+  ^bb2:  // pred: ^bb0
+    %0 = arith.addf %arg1, %arg2 : f32
+    return %0 : f32
+  }
+}
+
+// CHECK-LABEL:  func.func @select_value
+// CHECK-SAME:   ([[PARAM_0_:%.+]]: i1, [[PARAM_1_:%.+]]: f32, [[PARAM_2_:%.+]]: f32) -> f32 {
+// CHECK:         ^bb1:
+// CHECK-NEXT:      cf.br ^bb3([[PARAM_1_]] : f32)
+// CHECK:         ^bb2:
+// CHECK-NEXT:      [[VAR_0_:%.+]] = arith.addf [[PARAM_1_]], [[PARAM_2_]] : f32
+// CHECK-NEXT:      cf.br ^bb3([[VAR_0_]] : f32)
+// CHECK:         ^bb3([[VAR_1_:%.+]]: f32):
+// CHECK-NEXT:      return [[VAR_1_]] : f32
+
+// -----
+
+// Functions with a single return are unchanged.
+module {
+  func.func @single_return(%arg0: f32) -> f32 {
+    return %arg0 : f32
+  }
+}
+
+// CHECK-LABEL:  func.func @single_return
+// CHECK-NOT:       cf.br
+// CHECK:           return
@@ -1,10 +1,16 @@
 #pragma once
+#include "mlir/Dialect/Affine/IR/AffineOps.h"
 #include "mlir/Dialect/Bufferization/IR/Bufferization.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
 #include "mlir/Dialect/Linalg/Passes.h"
 #include "mlir/Dialect/MemRef/IR/MemRef.h"
 #include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "triton-shared/Conversion/ApproximateMath/Passes.h"
+#include "triton-shared/Conversion/BatchScalarAccesses/Passes.h"
+#include "triton-shared/Conversion/EmitGridLoop/Passes.h"
+#include "triton-shared/Conversion/PrefetchLoopLoads/Passes.h"
+#include "triton-shared/Conversion/SplitReductions/Passes.h"
 #include "triton-shared/Conversion/StructuredToMemref/Passes.h"
 #include "triton/Dialect/Triton/IR/Dialect.h"
 #include "triton/Dialect/TritonGPU/IR/Dialect.h"
@@ -14,11 +20,21 @@
 
 #include "triton/Conversion/TritonToTritonGPU/Passes.h"
 
+#include "triton-shared/Conversion/LinalgToCPURuntime/Passes.h"
+#include "triton-shared/Conversion/MarkNontemporalStores/Passes.h"
+#include "triton-shared/Conversion/OutlineParallelLoops/Passes.h"
+#include "triton-shared/Conversion/ParallelizeLinalg/Passes.h"
+#include "triton-shared/Conversion/PromoteAllocsToStack/Passes.h"
+#include "triton-shared/Conversion/PromoteHalfArgs/Passes.h"
+#include "triton-shared/Conversion/SpecializeUnitStrides/Passes.h"
 #include "triton-shared/Conversion/StructuredToMemref/Passes.h"
+#include "triton-shared/Conversion/TTXTileAndFuse/Passes.h"
+#include "triton-shared/Conversion/TTXToLoops/Passes.h"
 #include "triton-shared/Conversion/TritonArithToLinalg/Passes.h"
 #include "triton-shared/Conversion/TritonToLinalg/Passes.h"
 #include "triton-shared/Conversion/TritonToLinalgExperimental/Passes.h"
 #include "triton-shared/Conversion/TritonToStructured/Passes.h"
+#include "triton-shared/Conversion/UnifyReturns/Passes.h"
 #include "triton-shared/Dialect/TritonStructured/IR/TritonStructuredDialect.h"
 #include "triton-shared/Dialect/TritonTilingExt/IR/TritonTilingExtDialect.h"
 
@@ -48,6 +64,21 @@ inline void registerTritonSharedDialects(mlir::DialectRegistry &registry) {
   mlir::triton::registerTritonArithToLinalgPasses();
   mlir::triton::registerConvertTritonToTritonGPUPass();
   mlir::triton::registerStructuredToMemrefPasses();
+  mlir::triton::registerLinalgToCPURuntimePass();
+  mlir::triton::registerPromoteAllocsToStackPass();
+  mlir::triton::registerTTXToLoopsPass();
+  mlir::triton::registerSplitReductionsPass();
+  mlir::triton::registerPrefetchLoopLoadsPass();
+  mlir::triton::registerEmitGridLoopPass();
+  mlir::triton::registerApproximateMathPass();
+  mlir::triton::registerPromoteHalfArgsPass();
+  mlir::triton::registerSpecializeUnitStridesPass();
+  mlir::triton::registerUnifyReturnsPass();
+  mlir::triton::registerBatchScalarAccessesPass();
+  mlir::triton::registerTTXTileAndFusePass();
+  mlir::triton::registerParallelizeLinalgPass();
+  mlir::triton::registerOutlineParallelLoopsPass();
+  mlir::triton::registerMarkNontemporalStoresPass();
 
   // TODO: register Triton & TritonGPU passes
   registry.insert<
@@ -57,5 +88,6 @@ inline void registerTritonSharedDialects(mlir::DialectRegistry &registry) {
       mlir::arith::ArithDialect, mlir::scf::SCFDialect, mlir::gpu::GPUDialect,
       mlir::linalg::LinalgDialect, mlir::func::FuncDialect,
       mlir::tensor::TensorDialect, mlir::memref::MemRefDialect,
-      mlir::bufferization::BufferizationDialect>();
+      mlir::bufferization::BufferizationDialect,
+      mlir::affine::AffineDialect>();
 }
@@ -1,8 +1,502 @@
 ﻿#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/DialectRegistry.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/InitAllDialects.h"
+#include "mlir/InitAllExtensions.h"
+#include "mlir/InitAllPasses.h"
+#include "mlir/Pass/PassInstrumentation.h"
+#include "mlir/Pass/PassManager.h"
+#include "mlir/Pass/PassRegistry.h"
+
+#include "triton-shared/Conversion/ApproximateMath/Passes.h"
+#include "triton-shared/Conversion/BatchScalarAccesses/Passes.h"
+#include "triton-shared/Conversion/EmitGridLoop/Passes.h"
+#include "triton-shared/Conversion/LinalgToCPURuntime/Passes.h"
+#include "triton-shared/Conversion/MarkNontemporalStores/Passes.h"
+#include "triton-shared/Conversion/OutlineParallelLoops/Passes.h"
+#include "triton-shared/Conversion/ParallelizeLinalg/Passes.h"
+#include "triton-shared/Conversion/PrefetchLoopLoads/Passes.h"
+#include "triton-shared/Conversion/PromoteAllocsToStack/Passes.h"
+#include "triton-shared/Conversion/PromoteHalfArgs/Passes.h"
+#include "triton-shared/Conversion/SpecializeUnitStrides/Passes.h"
+#include "triton-shared/Conversion/SplitReductions/Passes.h"
+#include "triton-shared/Conversion/TTXTileAndFuse/Passes.h"
+#include "triton-shared/Conversion/TTXToLoops/Passes.h"
+#include "triton-shared/Conversion/TritonToLinalgExperimental/Passes.h"
+#include "triton-shared/Conversion/UnifyReturns/Passes.h"
+#include "triton-shared/Dialect/TritonStructured/IR/TritonStructuredDialect.h"
+#include "triton-shared/Dialect/TritonTilingExt/IR/TritonTilingExtDialect.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/InstIterator.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/MDBuilder.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/PassInstrumentation.h"
+#include "llvm/IR/PassManager.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/MC/TargetRegistry.h"
+#include "llvm/Passes/OptimizationLevel.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Passes/StandardInstrumentations.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+#include "llvm/Target/TargetOptions.h"
+#include "llvm/TargetParser/Host.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace py = pybind11;
 
-// The CPU backend with triton_shared doesn't do compilation from within python
-// but rather externally through triton-shared-opt, so we leave this function
-// blank.
-void init_triton_triton_shared(py::module &&m) {}
+namespace {
+
+// Kernels carrying this function attribute may assume that the buffers behind
+// distinct pointer arguments do not overlap. The launcher only calls them
+// after checking that this holds.
+constexpr llvm::StringLiteral kNoAliasArgsAttr = "triton-shared-noalias-args";
+
+// Name suffix of the variant of a kernel compiled with kNoAliasArgsAttr, must
+// be kept in sync with backend/compiler.py and backend/driver.py.
+constexpr llvm::StringLiteral kNoAliasSuffix = "_noalias";
+
+// Pointer arguments reach the kernel as pointers to memref descriptors from
+// which the body loads the data pointers, so `noalias` parameter attributes
+// would not say anything about the buffers. Instead, every memory access that
+// is based on the data pointer of a single argument is put in an alias scope
+// of that argument and marked as not aliasing the scopes of the others.
+struct NoAliasArgsPass : llvm::PassInfoMixin<NoAliasArgsPass> {
+  llvm::PreservedAnalyses run(llvm::Function &f,
+                              llvm::FunctionAnalysisManager &) {
+    if (!f.hasFnAttribute(kNoAliasArgsAttr)) {
+      return llvm::PreservedAnalyses::all();
+    }
+
+    llvm::SmallVector<const llvm::Argument *> descriptors;
+    for (const llvm::Argument &arg : f.args()) {
+      if (arg.getType()->isPointerTy()) {
+        descriptors.push_back(&arg);
+      }
+    }
+    if (descriptors.size() < 2) {
+      return llvm::PreservedAnalyses::all();
+    }
+
+    // Pointers loaded from a descriptor, mapped to the index of its argument.
+    llvm::DenseMap<const llvm::Value *, unsigned> dataPtrs;
+    for (llvm::Instruction &inst : llvm::instructions(f)) {
+      auto load = llvm::dyn_cast<llvm::LoadInst>(&inst);
+      if (!load || !load->getType()->isPointerTy()) {
+        continue;
+      }
+      const llvm::Value *object =
+          llvm::getUnderlyingObject(load->getPointerOperand());
+      auto it = llvm::find(descriptors, object);
+      if (it != descriptors.end()) {
+        dataPtrs[load] = std::distance(descriptors.begin(), it);
+      }
+    }
+
+    llvm::LLVMContext &context = f.getContext();
+    llvm::MDBuilder mdBuilder(context);
+    llvm::MDNode *domain =
+        mdBuilder.createAnonymousAliasScopeDomain(f.getName());
+    llvm::SmallVector<llvm::MDNode *> scopes;
+    for (unsigned i = 0; i < descriptors.size(); i++) {
+      scopes.push_back(mdBuilder.createAnonymousAliasScope(
+          domain, "arg" + std::to_string(i)));
+    }
+
+    bool changed = false;
+    for (llvm::Instruction &inst : llvm::instructions(f)) {
+      llvm::Value *ptr = llvm::getLoadStorePointerOperand(&inst);
+      if (!ptr) {
+        continue;
+      }
+
+      llvm::SmallVector<const llvm::Value *> objects;
+      llvm::getUnderlyingObjects(ptr, objects);
+      std::optional<unsigned> argIdx;
+      for (const llvm::Value *object : objects) {
+        auto it = dataPtrs.find(object);
+        if (it == dataPtrs.end() || (argIdx && *argIdx != it->second)) {
+          argIdx = std::nullopt;
+          break;
+        }
+        argIdx = it->second;
+      }
+      if (!argIdx) {
+        continue;
+      }
+
+      llvm::SmallVector<llvm::Metadata *> others;
+      for (unsigned i = 0; i < scopes.size(); i++) {
+        if (i != *argIdx) {
+          others.push_back(scopes[i]);
+        }
+      }
+      inst.setMetadata(llvm::LLVMContext::MD_alias_scope,
+                       llvm::MDNode::concatenate(
+                           inst.getMetadata(llvm::LLVMContext::MD_alias_scope),
+                           llvm::MDNode::get(context, {scopes[*argIdx]})));
+      inst.setMetadata(llvm::LLVMContext::MD_noalias,
+                       llvm::MDNode::concatenate(
+                           inst.getMetadata(llvm::LLVMContext::MD_noalias),
+                           llvm::MDNode::get(context, others)));
+      changed = true;
+    }
+
+    if (!changed) {
+      return llvm::PreservedAnalyses::all();
+    }
+    llvm::PreservedAnalyses preserved;
+    preserved.preserveSet<llvm::CFGAnalyses>();
+    return preserved;
+  }
+};
+
+// Add a copy of every kernel defined in `module` that assumes its pointer
+// arguments do not alias, see NoAliasArgsPass.
+void addNoAliasVariants(llvm::Module &module) {
+  llvm::SmallVector<llvm::Function *> kernels;
+  for (llvm::Function &f : module) {
+    if (!f.isDeclaration() && f.hasExternalLinkage() &&
+        f.getReturnType()->isVoidTy()) {
+      kernels.push_back(&f);
+    }
+  }
+  for (llvm::Function *f : kernels) {
+    llvm::ValueToValueMapTy map;
+    llvm::Function *variant = llvm::CloneFunction(f, map);
+    variant->setName(f->getName() + kNoAliasSuffix);
+    variant->addFnAttr(kNoAliasArgsAttr);
+  }
+}
+
+// Wall time and IR size of the passes run by an instrumented pass manager,
+// see enable_pass_profiling. Nested pipelines, such as the one run by
+// TritonToLinalgExperimental, are recorded with a larger depth.
+struct PassProfile {
+  struct Record {
+    std::string pass;
+    int depth;
+    double seconds;
+    int64_t opsBefore;
+    int64_t opsAfter;
+  };
+
+  std::mutex mutex;
+  std::vector<Record> records;
+};
+
+class PassProfiler : public mlir::PassInstrumentation {
+public:
+  explicit PassProfiler(std::shared_ptr<PassProfile> profile)
+      : profile(std::move(profile)) {}
+
+  void runBeforePass(mlir::Pass *pass, mlir::Operation *op) override {
+    // Pipeline adaptors have no argument; the passes they run are recorded.
+    if (pass->getArgument().empty()) {
+      return;
+    }
+    int64_t ops = countOps(op);
+    stack().push_back({pass, ops, std::chrono::steady_clock::now()});
+  }
+
+  void runAfterPass(mlir::Pass *pass, mlir::Operation *op) override {
+    finish(pass, op);
+  }
+
+  void runAfterPassFailed(mlir::Pass *pass, mlir::Operation *op) override {
+    finish(pass, op);
+  }
+
+private:
+  struct Running {
+    mlir::Pass *pass;
+    int64_t opsBefore;
+    std::chrono::steady_clock::time_point start;
+  };
+
+  // Passes on different operations may run on different threads.
+  static std::vector<Running> &stack() {
+    thread_local std::vector<Running> running;
+    return running;
+  }
+
+  static int64_t countOps(mlir::Operation *op) {
+    int64_t n = 0;
+    op->walk([&](mlir::Operation *) { n++; });
+    return n;
+  }
+
+  void finish(mlir::Pass *pass, mlir::Operation *op) {
+    auto &running = stack();
+    if (running.empty() || running.back().pass != pass) {
+      return;
+    }
+    auto end = std::chrono::steady_clock::now();
+    Running entry = running.back();
+    running.pop_back();
+    PassProfile::Record record{
+        pass->getArgument().str(), static_cast<int>(running.size()),
+        std::chrono::duration<double>(end - entry.start).count(),
+        entry.opsBefore, countOps(op)};
+    std::lock_guard<std::mutex> lock(profile->mutex);
+    profile->records.push_back(std::move(record));
+  }
+
+  std::shared_ptr<PassProfile> profile;
+};
+
+// Time spent in each LLVM pass, summed over all the functions and loops it
+// ran on. Pass managers and adaptors are not recorded, the passes they run
+// are.
+struct LLVMPassTimes {
+  static bool isRecorded(llvm::StringRef pass) {
+    return !llvm::isSpecialPass(
+        pass, {"PassManager", "PassAdaptor", "AnalysisManagerProxy"});
+  }
+
+  void registerCallbacks(llvm::PassInstrumentationCallbacks &pic) {
+    pic.registerBeforeNonSkippedPassCallback(
+        [this](llvm::StringRef pass, llvm::Any) {
+          if (isRecorded(pass)) {
+            starts.push_back(std::chrono::steady_clock::now());
+          }
+        });
+    auto after = [this](llvm::StringRef pass) {
+      if (!isRecorded(pass) || starts.empty()) {
+        return;
+      }
+      auto &entry = times[pass.str()];
+      entry.first += std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - starts.back())
+                         .count();
+      entry.second++;
+      starts.pop_back();
+    };
+    pic.registerAfterPassCallback(
+        [after](llvm::StringRef pass, llvm::Any,
+                const llvm::PreservedAnalyses &) { after(pass); });
+    pic.registerAfterPassInvalidatedCallback(
+        [after](llvm::StringRef pass, const llvm::PreservedAnalyses &) {
+          after(pass);
+        });
+  }
+
+  std::vector<std::chrono::steady_clock::time_point> starts;
+  // Pass name -> (seconds, number of runs).
+  std::map<std::string, std::pair<double, int64_t>> times;
+};
+
+} // namespace
+
+// The CPU backend compiles kernels in-process: the TritonToLinalgExperimental
+// pipeline and the upstream MLIR lowering to the LLVM dialect run on the
+// module owned by the triton compiler through the bindings below. Translation
+// to LLVM IR and assembly reuses the `llvm` bindings of libtriton.
+void init_triton_triton_shared(py::module &&m) {
+  m.def("load_dialects", [](mlir::MLIRContext &context) {
+    mlir::DialectRegistry registry;
+    // Lowering to LLVM goes through most of the upstream dialects, and
+    // one-shot-bufferize relies on the external models registered along with
+    // them; mirror what mlir-opt registers.
+    mlir::registerAllDialects(registry);
+    mlir::registerAllExtensions(registry);
+    registry.insert<mlir::tts::TritonStructuredDialect,
+                    mlir::ttx::TritonTilingExtDialect>();
+    mlir::ttx::registerBufferizableOpInterfaceExternalModels(registry);
+    context.appendDialectRegistry(registry);
+    context.loadAllAvailableDialects();
+  });
+
+  m.def("get_host_target_triple",
+        []() { return llvm::sys::getDefaultTargetTriple(); });
+
+  m.def("get_host_cpu_name",
+        []() { return llvm::sys::getHostCPUName().str(); });
+
+  // Same as `pass_manager.run`, but the GIL is released while the passes run
+  // so that several kernels can be lowered concurrently from python threads
+  // (see compile_many in backend/compiler.py). Every kernel is compiled in its
+  // own MLIRContext.
+  m.def("run_pass_manager", [](mlir::PassManager &pm, mlir::ModuleOp &mod) {
+    mlir::LogicalResult result = mlir::failure();
+    {
+      py::gil_scoped_release allow_threads;
+      result = pm.run(mod.getOperation());
+    }
+    if (mlir::failed(result)) {
+      throw std::runtime_error("PassManager::run failed");
+    }
+  });
+
+  // Run the default LLVM middle-end pipeline of `optLevel` (1 to 3) on the
+  // textual module `llvmIR`, with the cost models of the given target, and
+  // return the optimized module. Targets must have been initialized with
+  // `llvm.init_targets()`.
+  // When `noalias` is set, a variant of the kernel that assumes its pointer
+  // arguments do not alias is added to the module, see NoAliasArgsPass.
+  // With `collectPassTimes`, return the optimized module together with the
+  // (pass, seconds, runs) of every LLVM pass that ran.
+  m.def("optimize_llir", [](const std::string &llvmIR, int optLevel,
+                            const std::string &triple, const std::string &cpu,
+                            const std::string &features, bool noalias,
+                            bool collectPassTimes) -> py::object {
+    std::string result;
+    std::string error;
+    LLVMPassTimes passTimes;
+    {
+      py::gil_scoped_release allow_threads;
+      llvm::LLVMContext context;
+      llvm::SMDiagnostic diagnostic;
+      std::unique_ptr<llvm::Module> module = llvm::parseIR(
+          llvm::MemoryBufferRef(llvmIR, "llir"), diagnostic, context);
+      const llvm::Target *target =
+          module ? llvm::TargetRegistry::lookupTarget(triple, error) : nullptr;
+      if (!module) {
+        llvm::raw_string_ostream os(error);
+        diagnostic.print("llir", os);
+      } else if (target) {
+        std::unique_ptr<llvm::TargetMachine> machine(
+            target->createTargetMachine(triple, cpu, features,
+                                        llvm::TargetOptions(),
+                                        llvm::Reloc::PIC_));
+        module->setTargetTriple(triple);
+        module->setDataLayout(machine->createDataLayout());
+        if (noalias) {
+          addNoAliasVariants(*module);
+        }
+
+        llvm::LoopAnalysisManager lam;
+        llvm::FunctionAnalysisManager fam;
+        llvm::CGSCCAnalysisManager cgam;
+        llvm::ModuleAnalysisManager mam;
+        llvm::PipelineTuningOptions tuningOptions;
+        tuningOptions.LoopVectorization = optLevel >= 2;
+        tuningOptions.SLPVectorization = optLevel >= 2;
+        llvm::PassInstrumentationCallbacks pic;
+        if (collectPassTimes) {
+          passTimes.registerCallbacks(pic);
+        }
+        llvm::PassBuilder pb(machine.get(), tuningOptions, std::nullopt,
+                             &pic);
+        // Alias scopes are added once the loops are in their final form, right
+        // before they are vectorized.
+        pb.registerVectorizerStartEPCallback(
+            [](llvm::FunctionPassManager &fpm, llvm::OptimizationLevel) {
+              fpm.addPass(NoAliasArgsPass());
+            });
+        pb.registerModuleAnalyses(mam);
+        pb.registerCGSCCAnalyses(cgam);
+        pb.registerFunctionAnalyses(fam);
+        pb.registerLoopAnalyses(lam);
+        pb.crossRegisterProxies(lam, fam, cgam, mam);
+
+        llvm::OptimizationLevel level = llvm::OptimizationLevel::O3;
+        if (optLevel <= 1) {
+          level = llvm::OptimizationLevel::O1;
+        } else if (optLevel == 2) {
+          level = llvm::OptimizationLevel::O2;
+        }
+        llvm::ModulePassManager mpm = pb.buildPerModuleDefaultPipeline(level);
+        mpm.run(*module, mam);
+
+        llvm::raw_string_ostream os(result);
+        module->print(os, nullptr);
+      }
+    }
+    if (!error.empty()) {
+      throw std::runtime_error("failed to optimize LLVM IR: " + error);
+    }
+    if (!collectPassTimes) {
+      return py::str(result);
+    }
+    py::list times;
+    for (auto &[pass, entry] : passTimes.times) {
+      times.append(py::make_tuple(pass, entry.first, entry.second));
+    }
+    return py::make_tuple(result, times);
+  }, py::arg("llvm_ir"), py::arg("opt_level"), py::arg("triple"),
+     py::arg("cpu"), py::arg("features"), py::arg("noalias"),
+     py::arg("collect_pass_times") = false);
+
+  // Record the wall time and the number of operations before and after every
+  // pass run by `pm`. The returned profile lists them, in the order they
+  // finished, as (pass, depth, seconds, ops_before, ops_after) tuples.
+  py::class_<PassProfile, std::shared_ptr<PassProfile>>(m, "PassProfile")
+      .def("records", [](PassProfile &profile) {
+        std::lock_guard<std::mutex> lock(profile.mutex);
+        py::list records;
+        for (const auto &r : profile.records) {
+          records.append(py::make_tuple(r.pass, r.depth, r.seconds,
+                                        r.opsBefore, r.opsAfter));
+        }
+        return records;
+      });
+  m.def("enable_pass_profiling", [](mlir::PassManager &pm) {
+    auto profile = std::make_shared<PassProfile>();
+    pm.addInstrumentation(std::make_unique<PassProfiler>(profile));
+    return profile;
+  });
+
+  auto passes = m.def_submodule("passes");
+
+  passes.def(
+      "add_triton_to_linalg_experimental",
+      [](mlir::PassManager &pm, bool enableElementwiseFusion) {
+        pm.addPass(mlir::triton::createTritonToLinalgExperimentalPass(
+            enableElementwiseFusion));
+      },
+      py::arg("pm"), py::arg("enable_elementwise_fusion") = false);
+
+  // Append a textual pass pipeline, e.g.
+  // "convert-linalg-to-affine-loops,lower-affine", to `pm`. This lets the
+  // python side keep a single description of the lowering pipeline for both
+  // the in-process and the mlir-opt based compilation.
+  passes.def("add_pipeline", [](mlir::PassManager &pm,
+                                const std::string &pipeline) {
+    static std::once_flag registered;
+    std::call_once(registered, [] {
+      mlir::registerAllPasses();
+      mlir::triton::registerLinalgToCPURuntimePass();
+      mlir::triton::registerPromoteAllocsToStackPass();
+      mlir::triton::registerTTXToLoopsPass();
+      mlir::triton::registerSplitReductionsPass();
+      mlir::triton::registerPrefetchLoopLoadsPass();
+      mlir::triton::registerEmitGridLoopPass();
+      mlir::triton::registerApproximateMathPass();
+      mlir::triton::registerPromoteHalfArgsPass();
+      mlir::triton::registerSpecializeUnitStridesPass();
+      mlir::triton::registerUnifyReturnsPass();
+      mlir::triton::registerBatchScalarAccessesPass();
+      mlir::triton::registerTTXTileAndFusePass();
+      mlir::triton::registerParallelizeLinalgPass();
+      mlir::triton::registerOutlineParallelLoopsPass();
+      mlir::triton::registerMarkNontemporalStoresPass();
+    });
+
+    std::string error;
+    llvm::raw_string_ostream os(error);
+    if (mlir::failed(mlir::parsePassPipeline(pipeline, pm, os))) {
+      throw std::runtime_error("failed to parse pass pipeline '" + pipeline +
+                               "': " + os.str());
+    }
+  });
+}